@@ -9,9 +9,7 @@
 #include "GradientMorphological.hpp"
 #include "MultiImage.hpp"
 #include "RealColor.hpp"
-#include "SegmentationFSum.hpp"
 #include "SegmentationGeoStar.hpp"
-#include "SegmentationWatershed.hpp"
 #include "guiimage.h"
 #include "segmentationtool.h"
 #include <QDebug>
@@ -182,6 +180,39 @@ void SegmentationTool::clearSeeds( ) {
   emit guiImage->imageUpdated( );
 }
 
+template< class S >
+Bial::Image< int > SegmentationTool::runSession( std::unique_ptr< S > &session ) {
+  if( !session ) {
+    session.reset( new S( gradient, Bial::AdjacencyType::HyperSpheric( 1.0, gradient.Dims( ) ) ) );
+  }
+  /* Only the seeds edited since the previous segmentation are sent to the differential IFT. */
+  Bial::Vector< size_t > obj_seed;
+  Bial::Vector< size_t > bkg_seed;
+  Bial::Vector< size_t > removed;
+  const Bial::Image< int > &label( session->Label( ) );
+  for( size_t i = 0; i < seeds.size( ); ++i ) {
+    bool is_seed = session->Seed( i );
+    if( seeds[ i ] == 1 ) {
+      if( !is_seed || ( label[ i ] != 1 ) ) {
+        obj_seed.push_back( i );
+      }
+    }
+    else if( seeds[ i ] == 2 ) {
+      if( !is_seed || ( label[ i ] != 0 ) ) {
+        bkg_seed.push_back( i );
+      }
+    }
+    else if( is_seed ) {
+      removed.push_back( i );
+    }
+  }
+  session->RemoveSeeds( removed );
+  session->AddSeeds( obj_seed, 1 );
+  session->AddSeeds( bkg_seed, 0 );
+  session->Run( );
+  return( session->Label( ) );
+}
+
 Bial::Image< int > SegmentationTool::segmentationOGS( int pf_type, double alpha, double beta ) {
   Bial::Vector< size_t > obj_seed;
   Bial::Vector< size_t > bkg_seed;
@@ -220,13 +251,17 @@ Bial::Image< int > SegmentationTool::segmentationOGS( int pf_type, double alpha,
         break;
     }
     case 1: {
-        Bial::Image< int > grad( Bial::Gradient::Morphological( img ) );
-        res = Bial::Segmentation::Watershed( grad, obj_seed, bkg_seed );
+        if( !maxSession ) {
+          gradient = Bial::Gradient::Morphological( img );
+        }
+        res = runSession( maxSession );
         break;
     }
     default: {
-        Bial::Image< int > grad( Bial::Gradient::Morphological( img ) );
-        res = Bial::Segmentation::FSum( grad, obj_seed, bkg_seed );
+        if( !sumSession ) {
+          gradient = Bial::Gradient::Morphological( img );
+        }
+        res = runSession( sumSession );
     }
     }
     mask = Bial::Gradient::Morphological( res );
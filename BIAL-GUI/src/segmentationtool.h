@@ -2,7 +2,11 @@
 #define SEGMENTATIONTOOL_H
 
 #include "Common.hpp"
+#include "DifferentialImageIFT.hpp"
+#include "MaxPathFunction.hpp"
+#include "SumPathFunction.hpp"
 #include "tool.h"
+#include <memory>
 
 class SegmentationTool : public Tool {
 private:
@@ -20,6 +24,13 @@ private:
   int thickness;
   std::array< QPixmap, 4 > pixmaps;
   std::array< bool, 4 > needUpdate;
+  /* Gradient and differential IFT forests, kept between segmentations. */
+  Bial::Image< int > gradient;
+  std::unique_ptr< Bial::DifferentialImageIFT< int, Bial::MaxPathFunction< Bial::Image, int > > > maxSession;
+  std::unique_ptr< Bial::DifferentialImageIFT< int, Bial::SumPathFunction< Bial::Image, int > > > sumSession;
+
+  template< class S >
+  Bial::Image< int > runSession( std::unique_ptr< S > &session );
 
 public:
   enum { Type = 1 };
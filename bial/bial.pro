@@ -95,6 +95,7 @@ HEADERS += \
     inc/AdjacencyGrayCode.hpp \
     inc/AdjacencyIterator.hpp \
     inc/AdjacencyMarchingCube.hpp \
+    inc/AdjacencyOffset.hpp \
     inc/AdjacencyRound.hpp \
     inc/Array.hpp \
     inc/BinaryCOG.hpp \
@@ -109,6 +110,7 @@ HEADERS += \
     inc/BucketQueue.hpp \
     inc/BucketQueueElements.hpp \
     inc/ChessBoardDistanceFunction.hpp \
+    inc/ChunkedImage.hpp \
     inc/CityBlockDistanceFunction.hpp \
     inc/ClusteringIFT.hpp \
     inc/Color.hpp \
@@ -124,10 +126,13 @@ HEADERS += \
     inc/DegeneratedIFT.hpp \
     inc/DFIDE.hpp \
     inc/DicomHeader.hpp \
+    inc/DicomSlice.hpp \
+    inc/DifferentialImageIFT.hpp \
     inc/DiffPathFunction.hpp \
     inc/DiffusionFunction.hpp \
     inc/Display.hpp \
     inc/DistanceFunction.hpp \
+    inc/DistanceKernel.hpp \
     inc/DrawBox.hpp \
     inc/DrawCircle.hpp \
     inc/DrawFigure.hpp \
@@ -142,9 +147,11 @@ HEADERS += \
     inc/EdgeMaxPathFunction.hpp \
     inc/EdgeRiverBed.hpp \
     inc/EuclideanDistanceFunction.hpp \
+    inc/Expression.hpp \
     inc/Feature.hpp \
     inc/FeaturePathFunction.hpp \
     inc/FeatureResize.hpp \
+    inc/FFT.hpp \
     inc/File.hpp \
     inc/FileBMP.hpp \
     inc/FileDicom.hpp \
@@ -179,6 +186,7 @@ HEADERS += \
     inc/GradientSobel.hpp \
     inc/Graph.hpp \
     inc/GraphAdjacency.hpp \
+    inc/GzipBlock.hpp \
     inc/gzstream.hpp \
     inc/HeartCOG.hpp \
     inc/HeartSegmentation.hpp \
@@ -196,10 +204,13 @@ HEADERS += \
     inc/ImageROI.hpp \
     inc/ImageSplit.hpp \
     inc/ImageSwapDims.hpp \
+    inc/ImageUnionFind.hpp \
     inc/InfBucketQueue.hpp \
+    inc/IntegerBucketQueue.hpp \
     inc/Integral.hpp \
     inc/IntensityGlobals.hpp \
     inc/IntensityLocals.hpp \
+    inc/KdTree.hpp \
     inc/Kernel.hpp \
     inc/KernelBox.hpp \
     inc/KernelGabor.hpp \
@@ -210,13 +221,16 @@ HEADERS += \
     inc/KnnGraphAdjacency.hpp \
     inc/LocalMaxPathFunction.hpp \
     inc/LSHGraphAdjacency.hpp \
+    inc/MappedFile.hpp \
     inc/MarchingCubes.hpp \
     inc/Matrix.hpp \
     inc/MatrixDeterminant.hpp \
     inc/MatrixIdentity.hpp \
     inc/MatrixInverse.hpp \
+    inc/MatrixMultiply.hpp \
     inc/MatrixPolar.hpp \
     inc/MatrixResize.hpp \
+    inc/MatrixSolve.hpp \
     inc/MatrixTranspose.hpp \
     inc/MaxPathFunction.hpp \
     inc/MaxSumPathFunction.hpp \
@@ -225,15 +239,19 @@ HEADERS += \
     inc/MinPathFunction.hpp \
     inc/MorphologyDilation.hpp \
     inc/MorphologyErosion.hpp \
+    inc/MorphologyLines.hpp \
     inc/MRIModality.hpp \
     inc/MultiImage.hpp \
     inc/NiftiHeader.hpp \
+    inc/NiftiMapping.hpp \
+    inc/NNDescent.hpp \
     inc/OPFClusterMatching.hpp \
     inc/OPFHierarchicalClustering.hpp \
     inc/OPFSpatialClustering.hpp \
     inc/OPFSpectralClustering.hpp \
     inc/OrientedExternPathFunction.hpp \
     inc/OrientedInternPathFunction.hpp \
+    inc/ParallelImageIFT.hpp \
     inc/PathFunction.hpp \
     inc/PixelInterpolation.hpp \
     inc/Plotting.hpp \
@@ -266,10 +284,12 @@ HEADERS += \
     inc/SignalMedianFilter.hpp \
     inc/SignalNormalize.hpp \
     inc/SignalOtsuThreshold.hpp \
+    inc/SlidingHistogram.hpp \
     inc/SortingBinarySearch.hpp \
     inc/SortingSort.hpp \
     inc/SpatialFeature.hpp \
     inc/SquareEuclideanDistanceFunction.hpp \
+    inc/StaticImageIFT.hpp \
     inc/StatisticsAverage.hpp \
     inc/StatisticsBaddeley.hpp \
     inc/StatisticsDice.hpp \
@@ -279,9 +299,12 @@ HEADERS += \
     inc/StatisticsObsAgree.hpp \
     inc/StatisticsPosNeg.hpp \
     inc/StatisticsStdDev.hpp \
+    inc/Storage.hpp \
+    inc/StreamFilter.hpp \
     inc/SumPathFunction.hpp \
     inc/Superpixel.hpp \
     inc/Table.hpp \
+    inc/ThreadPool.hpp \
     inc/TransformEuclDist.hpp \
     inc/TransformEuclDistInv.hpp \
     inc/Vector.hpp \
@@ -293,6 +316,7 @@ SOURCES += \
     src/AdjacencyGrayCode.cpp \
     src/AdjacencyIterator.cpp \
     src/AdjacencyMarchingCube.cpp \
+    src/AdjacencyOffset.cpp \
     src/AdjacencyRound.cpp \
     src/BinaryCOG.cpp \
     src/BinaryComplement.cpp \
@@ -305,6 +329,7 @@ SOURCES += \
     src/BSpline.cpp \
     src/BucketQueue.cpp \
     src/ChessBoardDistanceFunction.cpp \
+    src/ChunkedImage.cpp \
     src/CityBlockDistanceFunction.cpp \
     src/ClusteringIFT.cpp \
     src/Color.cpp \
@@ -320,9 +345,12 @@ SOURCES += \
     src/DegeneratedIFT.cpp \
     src/DFIDE.cpp \
     src/DicomHeader.cpp \
+    src/DicomSlice.cpp \
+    src/DifferentialImageIFT.cpp \
     src/DiffPathFunction.cpp \
     src/DiffusionFunction.cpp \
     src/Display.cpp \
+    src/DistanceKernel.cpp \
     src/DrawBox.cpp \
     src/DrawCircle.cpp \
     src/DrawIntersection.cpp \
@@ -339,6 +367,7 @@ SOURCES += \
     src/Feature.cpp \
     src/FeaturePathFunction.cpp \
     src/FeatureResize.cpp \
+    src/FFT.cpp \
     src/File.cpp \
     src/FileFeature.cpp \
     src/FileSignal.cpp \
@@ -364,6 +393,7 @@ SOURCES += \
     src/GradientScaleCanny.cpp \
     src/GradientSobel.cpp \
     src/Graph.cpp \
+    src/GzipBlock.cpp \
     src/HeartCOG.cpp \
     src/HeartSegmentation.cpp \
     src/HierarchicalGraph.cpp \
@@ -380,10 +410,13 @@ SOURCES += \
     src/ImageROI.cpp \
     src/ImageSplit.cpp \
     src/ImageSwapDims.cpp \
+    src/ImageUnionFind.cpp \
     src/InfBucketQueue.cpp \
+    src/IntegerBucketQueue.cpp \
     src/Integral.cpp \
     src/IntensityGlobals.cpp \
     src/IntensityLocals.cpp \
+    src/KdTree.cpp \
     src/Kernel.cpp \
     src/KernelBox.cpp \
     src/KernelGabor.cpp \
@@ -394,12 +427,15 @@ SOURCES += \
     src/KnnGraphAdjacency.cpp \
     src/LocalMaxPathFunction.cpp \
     src/LSHGraphAdjacency.cpp \
+    src/MappedFile.cpp \
     src/MarchingCubes.cpp \
     src/MatrixDeterminant.cpp \
     src/MatrixIdentity.cpp \
     src/MatrixInverse.cpp \
+    src/MatrixMultiply.cpp \
     src/MatrixPolar.cpp \
     src/MatrixResize.cpp \
+    src/MatrixSolve.cpp \
     src/MatrixTranspose.cpp \
     src/MaxPathFunction.cpp \
     src/MaxSumPathFunction.cpp \
@@ -408,14 +444,18 @@ SOURCES += \
     src/MinPathFunction.cpp \
     src/MorphologyDilation.cpp \
     src/MorphologyErosion.cpp \
+    src/MorphologyLines.cpp \
     src/MultiImage.cpp \
     src/NiftiHeader.cpp \
+    src/NiftiMapping.cpp \
+    src/NNDescent.cpp \
     src/OPFClusterMatching.cpp \
     src/OPFHierarchicalClustering.cpp \
     src/OPFSpatialClustering.cpp \
     src/OPFSpectralClustering.cpp \
     src/OrientedExternPathFunction.cpp \
     src/OrientedInternPathFunction.cpp \
+    src/ParallelImageIFT.cpp \
     src/PathFunction.cpp \
     src/ParameterInterpreter.cpp \
     src/PixelInterpolation.cpp \
@@ -449,10 +489,12 @@ SOURCES += \
     src/SignalMedianFilter.cpp \
     src/SignalNormalize.cpp \
     src/SignalOtsuThreshold.cpp \
+    src/SlidingHistogram.cpp \
     src/SortingBinarySearch.cpp \
     src/SortingSort.cpp \
     src/SpatialFeature.cpp \
     src/SquareEuclideanDistanceFunction.cpp \
+    src/StaticImageIFT.cpp \
     src/StatisticsAverage.cpp \
     src/StatisticsBaddeley.cpp \
     src/StatisticsDice.cpp \
@@ -462,9 +504,12 @@ SOURCES += \
     src/StatisticsObsAgree.cpp \
     src/StatisticsPosNeg.cpp \
     src/StatisticsStdDev.cpp \
+    src/Storage.cpp \
+    src/StreamFilter.cpp \
     src/SumPathFunction.cpp \
     src/Superpixel.cpp \
     src/Table.cpp \
+    src/ThreadPool.cpp \
     src/TransformEuclDist.cpp \
     src/TransformEuclDistInv.cpp
 
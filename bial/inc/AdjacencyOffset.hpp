@@ -0,0 +1,186 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Adjacency relation converted to linear offsets for a given image shape.
+ * <br> Description: Pixels whose whole neighborhood lies inside the image domain (interior pixels) are visited by
+ * adding precomputed offsets to their index, with no coordinate decomposition nor bounds checking. Only pixels in the
+ * border band need checked access.
+ * <br> Usage:
+ * @code
+ *   AdjacencyOffset offsets( adj, img );
+ *   for( size_t pxl = 0; pxl < img.size( ); ) {
+ *     for( size_t run_end = offsets.InteriorEnd( pxl ); pxl < run_end; ++pxl ) {
+ *       for( size_t idx = 0; idx < offsets.size( ); ++idx ) {
+ *         size_t adj_pxl = offsets( pxl, idx ); // Always valid.
+ *       }
+ *     }
+ *     if( pxl < img.size( ) ) {
+ *       for( size_t idx = 0; idx < offsets.size( ); ++idx ) {
+ *         size_t adj_pxl = offsets.Checked( pxl, idx ); // img.size( ) if invalid.
+ *       }
+ *       ++pxl;
+ *     }
+ *   }
+ * @endcode
+ */
+
+#include "Adjacency.hpp"
+#include "Common.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALADJACENCYOFFSET_H
+#define BIALADJACENCYOFFSET_H
+
+/* Declarations -------------------------------------------------------------------------------------------------------- */
+
+namespace Bial {
+
+  template< class D >
+  class Image;
+  /**
+   * @brief Adjacency relation as a table of linear offsets, with interior/border split of the image domain.
+   */
+  class AdjacencyOffset {
+
+  private:
+    /** @brief Spatial dimensions of the image. */
+    Vector< size_t > dim_size;
+    /** @brief Linear displacement of each adjacent element. */
+    Vector< llint > offset;
+    /** @brief Displacement of each adjacent element in each dimension. Element-major order. */
+    Vector< float > displacement;
+    /** @brief First interior coordinate in each dimension. */
+    Vector< size_t > lower;
+    /** @brief One past the last interior coordinate in each dimension. */
+    Vector< size_t > upper;
+    /** @brief Size of the image. Returned by Checked for invalid adjacents. */
+    size_t data_limit;
+
+    /**
+     * @date 2026/Oct/17
+     * @param adj: An adjacency relation.
+     * @return none.
+     * @brief Computes offsets and interior limits from adj and dim_size.
+     * @warning none.
+     */
+    void Initialize( const Adjacency &adj );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param adj: An adjacency relation.
+     * @param dim: Spatial dimensions of the image or matrix.
+     * @return none.
+     * @brief Basic Constructor.
+     * @warning none.
+     */
+    AdjacencyOffset( const Adjacency &adj, const Vector< size_t > &dim );
+
+    /**
+     * @date 2026/Oct/17
+     * @param adj: An adjacency relation.
+     * @param img: An image.
+     * @return none.
+     * @brief Basic Constructor.
+     * @warning none.
+     */
+    template< class D >
+    AdjacencyOffset( const Adjacency &adj, const Image< D > &img );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of adjacent elements.
+     * @brief Returns the number of adjacent elements.
+     * @warning none.
+     */
+    size_t Size( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of adjacent elements.
+     * @brief Same as Size( ). Just for coherence with Adjacency.size( ).
+     * @warning none.
+     */
+    size_t size( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param adj_index: Index of the adjacent element.
+     * @return Linear displacement of the adjacent element.
+     * @brief Returns the linear displacement of the adjacent element.
+     * @warning none.
+     */
+    llint Offset( size_t adj_index ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param position: Index of an interior pixel.
+     * @param adj_index: Index of the adjacent element.
+     * @return Index of the adjacent pixel.
+     * @brief Returns the index of the adjacent pixel with no bounds checking.
+     * @warning position must be an interior pixel.
+     */
+    size_t operator()( size_t position, size_t adj_index ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param position: Index of any pixel.
+     * @param adj_index: Index of the adjacent element.
+     * @return Index of the adjacent pixel, or image size if it is out of the image domain.
+     * @brief Returns the index of the adjacent pixel with bounds checking. Same result as AdjacencyIterator.
+     * @warning none.
+     */
+    size_t Checked( size_t position, size_t adj_index ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param position: Index of a pixel.
+     * @return true if all adjacents of position are inside the image domain.
+     * @brief Verifies if position is an interior pixel.
+     * @warning none.
+     */
+    bool Interior( size_t position ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param position: Index of a pixel.
+     * @return One past the last interior pixel of the run of interior pixels starting at position along the first
+     * dimension, or position itself, if it is a border pixel.
+     * @brief Returns the end of the run of interior pixels starting at position.
+     * @warning none.
+     */
+    size_t InteriorEnd( size_t position ) const;
+
+  };
+
+  /* Inline member functions used in inner loops. ---------------------------------------------------------------------- */
+
+  inline size_t AdjacencyOffset::Size( ) const {
+    return( offset.size( ) );
+  }
+
+  inline size_t AdjacencyOffset::size( ) const {
+    return( offset.size( ) );
+  }
+
+  inline llint AdjacencyOffset::Offset( size_t adj_index ) const {
+    return( offset[ adj_index ] );
+  }
+
+  inline size_t AdjacencyOffset::operator()( size_t position, size_t adj_index ) const {
+    return( static_cast< size_t >( static_cast< llint >( position ) + offset[ adj_index ] ) );
+  }
+
+}
+
+/* Call to cpp file. --------------------------------------------------------------------------------------------------- */
+
+#include "AdjacencyOffset.cpp"
+
+#endif
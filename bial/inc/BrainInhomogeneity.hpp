@@ -41,13 +41,15 @@ namespace Bial {
      * @param cln_msk: Brain mask without outliers. 
      * @param radius: Radius for distance transform. (8.0 to 20.0) 
      * @param modality: Image modality. 
+     * @param smooth_std_dev: If positive, the bias field is smoothed by a recursive Gaussian of this standard
+     * deviation, normalized within the mask, instead of the mean of radius 1.1. 
      * @return Image with bias field surface. 
      * @brief Computes bias surface based on white matter pixels in the image. 
-     * @warning none. 
+     * @warning A positive smooth_std_dev must be at least 0.5. 
      */
     template< class D >
     Image< D > BiasSurfaceEstimation( const Image< D > &img, const Image< D > &msk, const Image< D > &cln_msk,
-                                      float radius, MRIModality modality );
+                                      float radius, MRIModality modality, float smooth_std_dev = 0.0f );
 
     /**
      * @date 2014/Jan/08 
@@ -70,13 +72,15 @@ namespace Bial {
      * @param radius: Radius for distance transform. For searching local WM pixel (7.0 to 28.0) 
      * @param compression: compression rate to compute bias field faster (1, 2, or 4). 
      * @param modality: Image modality. 
+     * @param smooth_std_dev: Passed to BiasSurfaceEstimation, in compressed pixels. 0 keeps the mean filter. 
      * @return Image with bias field surface. 
      * @brief Computes bias surface based on white matter pixels in the image. 
-     * @warning none. 
+     * @warning A positive smooth_std_dev must be at least 0.5. 
      */
     template< class D >
     Image< D > InhomogeneityCorrection( const Image< D > &img, const Image< D > &msk, float radius = 15.5,
-                                        size_t compression = 2, MRIModality modality = MRIModality::T1 );
+                                        size_t compression = 2, MRIModality modality = MRIModality::T1,
+                                        float smooth_std_dev = 0.0f );
 
   }
   
@@ -0,0 +1,321 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Chunked on-disk volumes, loaded lazily by region.
+ * <br> Description: A .bvol file splits the image in bricks of fixed size, each compressed independently with zlib.
+ * ChunkedImage maps the file and inflates only the chunks touched by a request, in parallel, keeping the most
+ * recently used ones in a cache of bounded size. Images much larger than the memory are then processed by regions.
+ * <br> File layout, in little endian: the header, with magic string "BIALCVOL", version, stored data type (as
+ * NiftiType), number of dimensions, compression level, image dimensions, chunk dimensions and pixel size; then the
+ * index, with offset and compressed size of each chunk; then the chunks. Chunks are stored with x varying fastest,
+ * and each one holds only the pixels inside the image, so that border chunks are smaller. A chunk whose compressed
+ * size equals its uncompressed size is stored raw.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALCHUNKEDIMAGE_H
+#define BIALCHUNKEDIMAGE_H
+
+#include "MappedFile.hpp"
+#include "NiftiHeader.hpp"
+#include "Vector.hpp"
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <zlib.h>
+
+namespace Bial {
+
+  template< class D >
+  class Image;
+
+  class IFile;
+  class NiftiMapping;
+
+  template< class D >
+  class ChunkedImage {
+
+  public:
+
+    /** @brief Default edge of a chunk, in pixels. */
+    static const size_t DEFAULT_CHUNK = 64;
+    /** @brief Default largest number of bytes of cached chunks. */
+    static const size_t DEFAULT_CACHE = 536870912;
+    /** @brief Number of bytes of the header, before the index. */
+    static const size_t HEADER = 88;
+
+  private:
+
+    /** @brief Pixels of a chunk, shared by the cache and the requests using it. */
+    typedef std::shared_ptr< const Vector< D > > ChunkData;
+
+    /** @brief Mapping of the file. */
+    MappedFile mapping;
+    /** @brief Stored data type. */
+    NiftiType type;
+    /** @brief Number of spatial dimensions. */
+    size_t dims;
+    /** @brief Image dimensions, chunk dimensions, and number of chunks in each dimension. Always three entries. */
+    Vector< size_t > dim;
+    Vector< size_t > chunk;
+    Vector< size_t > chunks;
+    /** @brief Pixel size. */
+    Vector< float > pixel_size;
+    /** @brief Offset into the file and compressed size of each chunk. */
+    std::vector< size_t > offset;
+    std::vector< size_t > bytes;
+    /** @brief Cached chunks, from the most to the least recently used, and their positions in the list. */
+    mutable std::list< size_t > lru;
+    mutable std::unordered_map< size_t, std::pair< ChunkData, std::list< size_t >::iterator > > cache;
+    /** @brief Number of bytes of the cached chunks, and its limit. */
+    mutable size_t cached_bytes;
+    size_t cache_limit;
+    /** @brief Protects the cache. */
+    mutable std::mutex mutex;
+
+    /**
+     * @date 2026/Oct/17
+     * @param index: Chunk index.
+     * @param spc_dim: Image dimensions.
+     * @param chunk_dim: Chunk dimensions.
+     * @param chunk_num: Number of chunks in each dimension.
+     * @param low: Returns the low coordinates of the chunk.
+     * @param box: Returns the dimensions of the chunk, clipped to the image.
+     * @return none.
+     * @brief Computes the box covered by a chunk.
+     * @warning none.
+     */
+    static void Box( size_t index, const Vector< size_t > &spc_dim, const Vector< size_t > &chunk_dim,
+                     const Vector< size_t > &chunk_num, Vector< size_t > &low, Vector< size_t > &box );
+
+    /**
+     * @date 2026/Oct/17
+     * @param index: Chunk index.
+     * @return Pixels of the chunk.
+     * @brief Inflates a chunk from the mapping and converts it to D. Does not use the cache.
+     * @warning Throws ios_base::failure if the chunk is corrupted.
+     */
+    ChunkData Load( size_t index ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param index: Chunk indexes.
+     * @return Pixels of each chunk.
+     * @brief Returns the chunks, taking cached ones from the cache, and inflating the others in parallel.
+     * @warning none.
+     */
+    std::vector< ChunkData > Fetch( const std::vector< size_t > &index ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param index: Chunk index.
+     * @param data: Pixels of the chunk.
+     * @return none.
+     * @brief Inserts a chunk in the cache, evicting the least recently used ones beyond the limit.
+     * @warning Must be called with mutex locked.
+     */
+    void Insert( size_t index, const ChunkData &data ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param slab: Returns the pixels of the given first plane and number of planes, with x varying fastest. The
+     * pointer must stay valid until the next call.
+     * @param spc_dim: Image dimensions.
+     * @param spc_pixel_size: Pixel size.
+     * @param filename: File to be written.
+     * @param chunk_dim: Chunk dimensions.
+     * @param level: Compression level.
+     * @return none.
+     * @brief Fetches the planes of one brick row at a time, compresses its chunks in parallel batches and writes
+     * them in order, then writes the header and index. Pixels are stored as S.
+     * @warning Throws ios_base::failure if writing fails.
+     */
+    template< class S >
+    static void WriteData( const std::function< const S*( size_t, size_t ) > &slab, const Vector< size_t > &spc_dim,
+                           const Vector< float > &spc_pixel_size, const std::string &filename,
+                           const Vector< size_t > &chunk_dim, int level );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Nifti data type code of S.
+     * @brief Returns the code of S, stored in the header.
+     * @warning Throws logic_error for types that cannot be stored.
+     */
+    template< class S >
+    static NiftiType StoredType( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param mapping: Mapped Nifti file.
+     * @param dst_filename: .bvol file name.
+     * @param chunk_dim: Chunk dimensions.
+     * @param level: Compression level.
+     * @return none.
+     * @brief Converts a mapped Nifti file brick row by brick row, storing its pixels as S.
+     * @warning none.
+     */
+    template< class S >
+    static void ConvertNifti( const NiftiMapping &mapping, const std::string &dst_filename,
+                              const Vector< size_t > &chunk_dim, int level );
+
+    /**
+     * @date 2026/Oct/17
+     * @param file: Scene file, positioned at the first pixel.
+     * @param spc_dim: Image dimensions.
+     * @param spc_pixel_size: Pixel size.
+     * @param dst_filename: .bvol file name.
+     * @param chunk_dim: Chunk dimensions.
+     * @param level: Compression level.
+     * @return none.
+     * @brief Converts the pixels of a Scene file brick row by brick row, reading and storing them as S.
+     * @warning none.
+     */
+    template< class S >
+    static void ConvertScene( IFile &file, const Vector< size_t > &spc_dim, const Vector< float > &spc_pixel_size,
+                              const std::string &dst_filename, const Vector< size_t > &chunk_dim, int level );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: .bvol file name.
+     * @param cache_limit: Largest number of bytes of cached chunks.
+     * @return none.
+     * @brief Basic Constructor. Maps the file and reads its header and index. No chunk is inflated.
+     * @warning Throws ios_base::failure if the file is not a valid chunked volume.
+     */
+    ChunkedImage( const std::string &filename, size_t cache_limit = DEFAULT_CACHE );
+
+    ChunkedImage( const ChunkedImage< D > & ) = delete;
+    ChunkedImage< D > &operator=( const ChunkedImage< D > & ) = delete;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of spatial dimensions, image dimensions, and pixel size, as given by Image.
+     * @brief Returns the image geometry.
+     * @warning none.
+     */
+    size_t Dims( ) const;
+    Vector< size_t > Dim( ) const;
+    Vector< float > PixelSize( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param dms: A dimension.
+     * @return Number of pixels in dms, or in the whole image.
+     * @brief Returns the image size.
+     * @warning none.
+     */
+    size_t size( size_t dms ) const;
+    size_t size( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Chunk dimensions.
+     * @brief Returns the dimensions of the chunks that are not at the image border.
+     * @warning none.
+     */
+    Vector< size_t > ChunkDim( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param p_0, p_1, p_2: Pixel coordinates.
+     * @return Pixel value.
+     * @brief Returns a pixel, loading its chunk if it is not cached.
+     * @warning Each call locks the cache. Use Region for many pixels.
+     */
+    D operator()( size_t p_0, size_t p_1, size_t p_2 = 0 ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param low_coord: Lower coordinates of the region.
+     * @param hgh_coord: Higher coordinates of the region, included.
+     * @return Image with the region.
+     * @brief Loads only the chunks that intersect the region, in parallel batches, and copies their pixels into the
+     * resultant image. As in ImageOp::Resize, 2D coordinates of a 3D image cover all slices.
+     * @warning Throws out_of_range if the region is empty or exceeds the image.
+     */
+    Image< D > Region( const Vector< size_t > &low_coord, const Vector< size_t > &hgh_coord ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param dimension: Dimension normal to the slice.
+     * @param index: Slice coordinate in dimension.
+     * @return 2D image of the slice.
+     * @brief Loads the slice, inflating only the chunks that contain it.
+     * @warning Throws out_of_range for invalid dimension or index.
+     */
+    Image< D > Slice( size_t dimension, size_t index ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return The whole image.
+     * @brief Loads the whole image.
+     * @warning none.
+     */
+    Image< D > Load( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of bytes of cached chunks, and its limit.
+     * @brief Returns the cache usage.
+     * @warning none.
+     */
+    size_t CachedBytes( ) const;
+    size_t CacheLimit( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param limit: Largest number of bytes of cached chunks. 0 disables the cache.
+     * @return none.
+     * @brief Sets the cache limit, evicting chunks beyond it.
+     * @warning none.
+     */
+    void CacheLimit( size_t limit );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Image to be written.
+     * @param filename: .bvol file name.
+     * @param chunk_dim: Chunk dimensions. Empty for DEFAULT_CHUNK in every dimension.
+     * @param level: Compression level, from 0 to 9, or Z_DEFAULT_COMPRESSION.
+     * @return none.
+     * @brief Writes img as a chunked volume, compressing the chunks in parallel.
+     * @warning Throws ios_base::failure if writing fails.
+     */
+    static void Write( const Image< D > &img, const std::string &filename,
+                       const Vector< size_t > &chunk_dim = Vector< size_t >( ), int level = Z_DEFAULT_COMPRESSION );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src_filename: Nifti, PNM, Scene, or any other image file given by Read.
+     * @param dst_filename: .bvol file name.
+     * @param chunk_dim: Chunk dimensions. Empty for DEFAULT_CHUNK in every dimension.
+     * @param level: Compression level, from 0 to 9, or Z_DEFAULT_COMPRESSION.
+     * @return none.
+     * @brief Converts an image file to a chunked volume. Uncompressed Nifti files and Scene files are read one brick
+     * row of planes at a time, and their pixels are stored in the source type, so that a 16 bit stack is not widened
+     * to D. Chunks are converted to D when loaded.
+     * @warning PNM and the other formats are read to memory first, and stored as D.
+     */
+    static void Convert( const std::string &src_filename, const std::string &dst_filename,
+                         const Vector< size_t > &chunk_dim = Vector< size_t >( ), int level = Z_DEFAULT_COMPRESSION );
+
+  };
+
+}
+
+#include "ChunkedImage.cpp"
+
+#endif
@@ -29,6 +29,8 @@ namespace Bial {
    * @param proportion: Proportion of the pixels in adj to be taken. In ]0.0,1.0]. 
    * @return A median feature vector of all colors. 
    * @brief Assings a median values from the neighborhoods of each pixel from image src to a feature vector. 
+   * Adjacents are ranked by the sum of their channel distances to the central pixel, and only the ranks taken as
+   * features are selected and sorted.
    * @warning none. 
    */
   template< class D >
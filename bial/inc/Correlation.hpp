@@ -16,6 +16,8 @@ namespace Bial {
 
   template< class D >
   class Image;
+  template< class D >
+  class Vector;
   class Kernel;
 
   /**
@@ -23,12 +25,72 @@ namespace Bial {
    * @param img: Input image. 
    * @param krn: A kernel. 
    * @return Image with correlation between img and krn. 
-   * @brief Returns an image with correlation between img and krn. 
+   * @brief Returns an image with correlation between img and krn. Large kernels are computed in the frequency
+   * domain. See UseFFTCorrelation.
    * @warning none. 
    */
   template< class D >
   Image< D > Correlation( const Image< D > &img, const Kernel &krn );
 
+  /**
+   * @date 2026/Oct/17
+   * @param img: Input image.
+   * @param krn: A kernel.
+   * @return Image with correlation between img and krn.
+   * @brief Computes the correlation in the spatial domain, whatever the kernel size. Each pixel depends only on its
+   * neighbors, with the same rounding, so that the result of a region equals the same region of the result.
+   * @warning none.
+   */
+  template< class D >
+  Image< D > SpatialCorrelation( const Image< D > &img, const Kernel &krn );
+
+  /**
+   * @date 2026/Oct/17
+   * @param img: Input image.
+   * @param bank: A filter bank.
+   * @return One image with correlation between img and each kernel of bank.
+   * @brief Returns the correlations between img and each kernel of bank. In the frequency domain, the spectrum of img
+   * is computed only once and reused by all kernels.
+   * @warning none.
+   */
+  template< class D >
+  Vector< Image< D > > Correlation( const Image< D > &img, const Vector< Kernel > &bank );
+
+  /**
+   * @date 2026/Oct/17
+   * @param img: Input image.
+   * @param bank: A filter bank.
+   * @return One image with correlation between img and each kernel of bank.
+   * @brief Computes the correlations in the frequency domain. The image is zero-padded, so that the result is the
+   * same of the spatial correlation, up to rounding errors.
+   * @warning Kernel displacements must be integers. Requires about 24 bytes per element of the padded image.
+   */
+  template< class D >
+  Vector< Image< D > > FFTCorrelation( const Image< D > &img, const Vector< Kernel > &bank );
+
+  /**
+   * @date 2026/Oct/17
+   * @param dim: Image dimensions.
+   * @param bank: A filter bank.
+   * @param min_dim: Resulting minimum padded dimensions, so that the circular correlation does not wrap around.
+   * @return true if all kernels have integer displacements, that is, if the correlation may be computed in the
+   * frequency domain.
+   * @brief Computes the padding required by FFTCorrelation.
+   * @warning none.
+   */
+  bool FFTCorrelationPadding( const Vector< size_t > &dim, const Vector< Kernel > &bank, Vector< size_t > &min_dim );
+
+  /**
+   * @date 2026/Oct/17
+   * @param dim: Image dimensions.
+   * @param bank: A filter bank.
+   * @return true if the frequency domain correlation is expected to be faster than the spatial one.
+   * @brief Compares the estimated costs of spatial and frequency domain correlations of an image of dimensions dim
+   * with the kernels of bank.
+   * @warning none.
+   */
+  bool UseFFTCorrelation( const Vector< size_t > &dim, const Vector< Kernel > &bank );
+
   /**
    * @date 2013/Nov/26 
    * @param img: Input image. 
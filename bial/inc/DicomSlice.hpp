@@ -0,0 +1,272 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Fast parsing of single-frame Dicom files.
+ * <br> Description: The file is mapped and its data elements are walked in place. Only the elements needed to place
+ * the slice in a volume and to decode its pixels are read. All others, including sequences of undefined length, are
+ * skipped by their length, so that no byte of them is copied. Gziped files are decompressed to memory instead. Pixels
+ * are decoded straight from the mapping into the destination, optionally applying the rescale slope and intercept.
+ * <br> Supported transfer syntaxes: implicit and explicit VR little endian, and files with no meta header.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALDICOMSLICE_H
+#define BIALDICOMSLICE_H
+
+#include "MappedFile.hpp"
+#include "Vector.hpp"
+
+namespace Bial {
+
+  template< class D >
+  class Image;
+
+  class DicomSlice {
+
+  private:
+
+    /** @brief Mapping of the file. */
+    MappedFile mapping;
+    /** @brief Number of rows and columns. */
+    size_t rows;
+    size_t columns;
+    /** @brief Number of samples per pixel, and of frames. */
+    size_t samples;
+    size_t frames;
+    /** @brief Number of bits allocated for each sample. */
+    size_t bits_allocated;
+    /** @brief Whether samples are two's complement signed integers. */
+    bool is_signed;
+    /** @brief Rescale slope and intercept, applied to the stored values. */
+    double slope;
+    double intercept;
+    /** @brief Distance between the centers of adjacent rows and of adjacent columns, in mm. */
+    double row_spacing;
+    double column_spacing;
+    /** @brief Slice thickness and spacing between slices, or 0 if absent. */
+    double thickness;
+    double spacing;
+    /** @brief Image position ( patient ), and image orientation ( patient ): row cosines, then column cosines. */
+    Vector< double > position;
+    Vector< double > orientation;
+    /** @brief Instance number, or 0 if absent. */
+    long instance;
+    /** @brief Series instance UID. */
+    std::string series;
+    /** @brief Byte offset and number of bytes of the pixel data in the mapping. */
+    size_t pixel_offset;
+    size_t pixel_bytes;
+
+    /** @brief Number of bytes of the preamble, before the "DICM" magic string. */
+    static const size_t PREAMBLE = 128;
+    /** @brief Length of sequences and items closed by delimiters. */
+    static const size_t UNDEFINED = 0xFFFFFFFF;
+    /** @brief Tags of items, delimiters and pixel data. */
+    static const uint ITEM = 0xFFFEE000;
+    static const uint ITEM_DELIMITER = 0xFFFEE00D;
+    static const uint SEQUENCE_DELIMITER = 0xFFFEE0DD;
+    static const uint PIXEL_DATA = 0x7FE00010;
+
+    /**
+     * @date 2026/Oct/17
+     * @param pos: Position of the first byte of the element.
+     * @param explicit_vr: Whether the element has an explicit value representation.
+     * @param tag: Returns group and element numbers, as group * 65536 + element.
+     * @param value: Returns the position of the value.
+     * @param length: Returns the length of the value. 0xFFFFFFFF for undefined length.
+     * @return none.
+     * @brief Reads the header of the data element at pos.
+     * @warning Throws ios_base::failure if the header goes beyond the end of the file.
+     */
+    void ElementHeader( size_t pos, bool explicit_vr, uint &tag, size_t &value, size_t &length ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param pos: Position of the first element after the start of the sequence or item.
+     * @param explicit_vr: Whether elements have explicit value representation.
+     * @param delimiter: Tag that closes the sequence or item.
+     * @return Position after the delimiter.
+     * @brief Skips the elements of a sequence or item of undefined length, including nested ones.
+     * @warning Throws ios_base::failure if the delimiter is not found.
+     */
+    size_t Skip( size_t pos, bool explicit_vr, uint delimiter ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param tag: Element tag.
+     * @param value: Position of the value.
+     * @param length: Length of the value.
+     * @return none.
+     * @brief Stores the value of the element if it is one of the used ones. Others are ignored.
+     * @warning none.
+     */
+    void Store( uint tag, size_t value, size_t length );
+
+    /**
+     * @date 2026/Oct/17
+     * @param value: Position of the value.
+     * @param length: Length of the value.
+     * @return Value as text, without trailing spaces and nulls.
+     * @brief Reads a text value.
+     * @warning none.
+     */
+    std::string Text( size_t value, size_t length ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param value: Position of the value.
+     * @param length: Length of the value.
+     * @return Numbers of a multi-valued decimal or integer string.
+     * @brief Reads the numbers of a DS or IS value, separated by backslashes.
+     * @warning none.
+     */
+    Vector< double > Numbers( size_t value, size_t length ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param value: Position of the value.
+     * @return Unsigned 16 or 32 bits integer at value, in little endian.
+     * @brief Reads a little endian integer from the mapping.
+     * @warning none.
+     */
+    ushort Load16( size_t value ) const;
+    uint Load32( size_t value ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: First byte of the stored samples, of type S.
+     * @param size: Number of samples.
+     * @param dst: Destination.
+     * @param rescale: Whether rescale slope and intercept are applied.
+     * @return none.
+     * @brief Converts the stored samples to D.
+     * @warning src does not need to be aligned to S.
+     */
+    template< class S, class D >
+    void Convert( const char *src, size_t size, D *dst, bool rescale ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Dicom file name.
+     * @return Mapping of filename, or its decompressed bytes if it is gziped.
+     * @brief Gives access to all bytes of the file.
+     * @warning none.
+     */
+    static MappedFile Map( const std::string &filename );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Dicom file name.
+     * @return none.
+     * @brief Basic Constructor. Maps or decompresses the file and parses its header up to the pixel data.
+     * @warning Throws logic_error for compressed, big endian, or multi-frame files, and for files with no pixel data.
+     */
+    DicomSlice( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Dicom file name.
+     * @return true if filename is not gziped.
+     * @brief Checks whether filename may be mapped. Gziped files are decompressed to memory instead.
+     * @warning none.
+     */
+    static bool IsMappable( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of columns and rows.
+     * @brief Returns the dimensions of the slice, with columns first, as in Image.
+     * @warning none.
+     */
+    Vector< size_t > Dim( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Distance between the centers of adjacent columns and of adjacent rows, in mm.
+     * @brief Returns the pixel size, with columns first, as in Image. 1.0 if the file has no pixel spacing.
+     * @warning none.
+     */
+    Vector< float > PixelSize( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if the file has image position and orientation.
+     * @brief Checks whether the slice may be placed in space by Location.
+     * @warning none.
+     */
+    bool HasPosition( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Position of the slice along its normal, in mm.
+     * @brief Returns the projection of the image position onto the normal of the slice, given by the cross product
+     * of its row and column cosines. Slices of a volume sorted by it are in spatial order.
+     * @warning Valid only if HasPosition( ).
+     */
+    double Location( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Spacing between slices, or slice thickness if absent, or 0 if both are absent.
+     * @brief Returns the distance to the next slice, as stated in the header.
+     * @warning none.
+     */
+    double SliceSpacing( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Instance number, or 0 if absent.
+     * @brief Returns the instance number.
+     * @warning none.
+     */
+    long InstanceNumber( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Series instance UID, or an empty string if absent.
+     * @brief Returns the UID of the series of this slice.
+     * @warning none.
+     */
+    const std::string &SeriesUID( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param dst: Destination with Dim( )( 0 ) * Dim( )( 1 ) elements.
+     * @param rescale: Whether rescale slope and intercept are applied, or stored values are kept.
+     * @return none.
+     * @brief Decodes the pixels straight from the mapping into dst.
+     * @warning Throws logic_error for images with more than one sample per pixel.
+     */
+    template< class D >
+    void Decode( D *dst, bool rescale ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param rescale: Whether rescale slope and intercept are applied, or stored values are kept.
+     * @return 2D image of the slice.
+     * @brief Decodes the slice into a new image with its pixel size.
+     * @warning Throws logic_error for images with more than one sample per pixel.
+     */
+    template< class D >
+    Image< D > Read( bool rescale ) const;
+
+  };
+
+}
+
+#include "DicomSlice.cpp"
+
+#endif
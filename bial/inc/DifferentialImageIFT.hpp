@@ -0,0 +1,219 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Differential IFT (DIFT) over images. Keeps the optimum-path forest between seed edits.
+ * <br> Description: The handicap (gradient) image, the cost, label, predecessor, and root maps, and the queue are
+ * kept alive for the whole interactive session. Each Run processes the seeds added and removed since the previous
+ * one. Trees rooted at removed seeds are reset and reconquered from their frontier. Added seeds become roots and
+ * conquer the pixels to which they offer better paths, together with their subtrees. Only the pixels of the
+ * affected trees are visited.
+ * <br> Seeds are always roots of their trees. The cost map is the same as the one of a sequential IFT from all
+ * current seeds, and the forest is an optimum-path forest: each predecessor offers its successor exactly the final
+ * cost. Ties are not broken as in the sequential IFT, though. A pixel keeps the first optimum path that reached it,
+ * across runs, while the sequential IFT from scratch takes the one whose predecessor leaves the queue first.
+ * Therefore, labels and predecessors may differ from the sequential IFT only at pixels with optimum paths from more
+ * than one seed, as in plateaus and on watershed lines, and in the subtrees rooted at them. With max-arc path
+ * functions and few seeds, these tie zones may be large.
+ * <br> Usage:
+ * @code
+ *   DifferentialImageIFT< int, MaxPathFunction< Image, int > > dift( gradient, adjacency );
+ *   dift.AddSeeds( obj_seeds, 1 );
+ *   dift.AddSeeds( bkg_seeds, 0 );
+ *   dift.Run( );
+ *   dift.RemoveSeeds( wrong_seeds );
+ *   dift.Run( );
+ *   const Image< int > &label = dift.Label( );
+ * @endcode
+ */
+
+#include "Adjacency.hpp"
+#include "AdjacencyOffset.hpp"
+#include "Common.hpp"
+#include "Image.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALDIFFERENTIALIMAGEIFT_H
+#define BIALDIFFERENTIALIMAGEIFT_H
+
+#include "BucketQueue.hpp"
+
+namespace Bial {
+
+  template< class D, class PF, class Q = BucketQueue >
+  class DifferentialImageIFT {
+
+  protected:
+
+    /** @brief Differential IFT attributes. */
+    Image< D > value;
+    Image< int > label;
+    Image< int > predecessor;
+    Image< int > root;
+    AdjacencyOffset offsets;
+    PF function;
+    Q queue;
+    /** @brief Whether each pixel is a seed. */
+    Vector< bool > seed;
+    /** @brief Seeds added since the last run, and their labels. */
+    Vector< size_t > added;
+    Vector< int > added_label;
+    /** @brief Seeds removed since the last run. */
+    Vector< size_t > removed;
+    /** @brief Pixels whose queue state changed in the current run. */
+    Vector< size_t > touched;
+    /** @brief Pixels visited in the last run. */
+    size_t visited;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Cost of pixels that are not conquered by any seed.
+     * @brief Worst cost in the order of the path function.
+     * @warning none.
+     */
+    D Infinity( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param lhs: A cost.
+     * @param rhs: Another cost.
+     * @return true if lhs is a better path cost than rhs.
+     * @brief Compares costs in the order of the path function.
+     * @warning none.
+     */
+    bool Better( D lhs, D rhs );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Pixel at the end of a path.
+     * @param tgt: Adjacent pixel.
+     * @param offer: Returns the cost of the path from src extended to tgt.
+     * @return false if the path function does not extend paths from src to tgt.
+     * @brief Computes the cost offered by src to tgt, regardless of the current cost of tgt.
+     * @warning none.
+     */
+    bool Offer( size_t src, size_t tgt, D &offer );
+
+    /**
+     * @date 2026/Oct/17
+     * @param pxl: Pixel to be inserted or moved in the queue.
+     * @param cur_wgt: Current weight of pxl.
+     * @param new_wgt: New weight of pxl.
+     * @return none.
+     * @brief Updates the queue, recording pxl to reset its state at the end of the run.
+     * @warning none.
+     */
+    void Enqueue( size_t pxl, D cur_wgt, D new_wgt );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Resets the trees rooted at removed seeds, and inserts their frontier in the queue.
+     * @warning none.
+     */
+    void RemoveTrees( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Turns added seeds into roots, and inserts them in the queue.
+     * @warning none.
+     */
+    void InsertSeeds( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Propagates paths from the queue. Pixels also follow their predecessors when these change.
+     * @warning none.
+     */
+    void Propagate( );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param handicap: Handicap (e.g. gradient) image used by the path function.
+     * @param adjacency: adjacency relation defining neighborhood.
+     * @param bucket_size: Size of a bucket in the bucket queue.
+     * @param fifo_tie: true for fifo tiebreak, and false for lifo tiebreak.
+     * @return none.
+     * @brief Constructor. Starts a session with no seeds. All pixels have infinite cost and label 0.
+     * @warning Handicap and adjacency must have compatible dimensions. PF must have a constructor taking the handicap
+     * image, and write only the value of the conquered pixel in Capable and Propagate (e.g. MaxPathFunction and
+     * SumPathFunction).
+     */
+    DifferentialImageIFT( const Image< D > &handicap, const Adjacency &adjacency, long double bucket_size = 1.0,
+                          bool fifo_tie = true );
+
+    /**
+     * @date 2026/Oct/17
+     * @param seeds: Pixels to become seeds.
+     * @param seed_label: Label of the new seeds.
+     * @return none.
+     * @brief Schedules seeds to be added in the next run. Existing seeds are relabeled.
+     * @warning none.
+     */
+    void AddSeeds( const Vector< size_t > &seeds, int seed_label );
+
+    /**
+     * @date 2026/Oct/17
+     * @param seeds: Pixels to stop being seeds.
+     * @return none.
+     * @brief Schedules seeds to be removed in the next run. Pixels that are not seeds are ignored.
+     * @warning none.
+     */
+    void RemoveSeeds( const Vector< size_t > &seeds );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Updates the forest with the seeds removed and added since the previous run.
+     * @warning none.
+     */
+    void Run( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Reference to cost, label, predecessor, and root maps, respectively.
+     * @brief Maps of the current forest. Unconquered pixels have label 0 and predecessor and root -1.
+     * @warning none.
+     */
+    const Image< D > &Value( ) const;
+    const Image< int > &Label( ) const;
+    const Image< int > &Predecessor( ) const;
+    const Image< int > &Root( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param pxl: A pixel.
+     * @return true if pxl is a seed.
+     * @brief Seed verification. Seeds scheduled for addition or removal only count after Run.
+     * @warning none.
+     */
+    bool Seed( size_t pxl ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of pixels removed from the queue in the last run.
+     * @brief Measures the work done by the last run.
+     * @warning none.
+     */
+    size_t Visited( ) const;
+
+  };
+
+}
+
+#include "DifferentialImageIFT.cpp"
+
+#endif
@@ -0,0 +1,180 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Batched distance computation between feature vectors, with the distance function chosen per object.
+ * <br> Description: Unlike DFIDE, whose distance function is process-global state, each DistanceKernel holds its
+ * own distance function, so that concurrent pipelines may use different ones. Distances are computed from one
+ * source vector to many target vectors stored contiguously, as the elements of Feature, resolving the distance
+ * function and the instruction set once per batch instead of once per pair.
+ * <br> Euclidean, square Euclidean, city-block and chessboard distances over float and double features use AVX-512
+ * or AVX2 kernels, selected at run time from the instructions supported by the processor, with scalar fallback.
+ * Other data types and the pre-computed Euclidean distance use the scalar distance functions.
+ */
+
+#include "Common.hpp"
+#include "DFIDE.hpp"
+
+#ifndef BIALDISTANCEKERNEL_H
+#define BIALDISTANCEKERNEL_H
+
+namespace Bial {
+
+  template< class D >
+  class Feature;
+  template< class D >
+  class Matrix;
+
+  class DistanceKernel {
+
+  public:
+
+    /** @brief Instruction sets used by the kernels. */
+    enum class InstructionSet : char {
+      Scalar,
+      AVX2,
+      AVX512
+    };
+
+  protected:
+
+    /** @brief Distance function of this kernel. */
+    DistanceFunctionType type;
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Source vector.
+     * @param tgt: First target vector.
+     * @param tgts: Number of target vectors.
+     * @param stride: Number of elements from a target vector to the next one.
+     * @param dms: Number of dimensions.
+     * @param res: Returns the distance from src to each target vector.
+     * @return none.
+     * @brief Batch kernels of distance function T, with scalar, AVX2 and AVX-512 instructions. Differences are
+     * accumulated in double precision.
+     * @warning AVX kernels are defined for float and double data only, and require processor support.
+     */
+    template< DistanceFunctionType T, class D >
+    static void BatchScalar( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms, double *res );
+    template< DistanceFunctionType T, class D >
+    static void BatchAVX2( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms, double *res );
+    template< DistanceFunctionType T, class D >
+    static void BatchAVX512( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms, double *res );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src, tgt, tgts, stride, dms, res: Same as Distances.
+     * @return none.
+     * @brief Calls the batch kernel of distance function T for the best instruction set supported by the
+     * processor.
+     * @warning Float and double data only.
+     */
+    template< DistanceFunctionType T, class D >
+    static void BatchVector( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms, double *res );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src, tgt, tgts, stride, dms, res: Same as Distances.
+     * @return none.
+     * @brief Batch of distance function T. Float and double overloads use the vector kernels, and other data types
+     * use the scalar kernel.
+     * @warning none.
+     */
+    template< DistanceFunctionType T, class D >
+    static void Batch( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms, double *res );
+    template< DistanceFunctionType T >
+    static void Batch( const float *src, const float *tgt, size_t tgts, size_t stride, size_t dms, double *res );
+    template< DistanceFunctionType T >
+    static void Batch( const double *src, const double *tgt, size_t tgts, size_t stride, size_t dms, double *res );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param type: Distance function.
+     * @return none.
+     * @brief Basic Constructor. The default is the current distance function of DFIDE.
+     * @warning The pre-computed Euclidean distance uses the table set by DFIDE::SetPreEuclideanDistanceFunction.
+     */
+    DistanceKernel( DistanceFunctionType type = DFIDE::distance_function_type );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Distance function of this kernel.
+     * @brief Returns the distance function of this kernel.
+     * @warning none.
+     */
+    DistanceFunctionType Type( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Instruction set used by the float and double kernels.
+     * @brief Returns the widest instruction set supported by the processor, detected once.
+     * @warning none.
+     */
+    static InstructionSet Instructions( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Source vector.
+     * @param tgt: Target vector.
+     * @param dms: Number of dimensions.
+     * @return Distance from src to tgt.
+     * @brief Returns the distance from src to tgt.
+     * @warning none.
+     */
+    template< class D >
+    double Distance( const D *src, const D *tgt, size_t dms ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Source vector.
+     * @param tgt: First target vector.
+     * @param tgts: Number of target vectors.
+     * @param stride: Number of elements from a target vector to the next one.
+     * @param dms: Number of dimensions.
+     * @param res: Returns the distance from src to each target vector. Must hold tgts elements.
+     * @return none.
+     * @brief One-to-many distances.
+     * @warning none.
+     */
+    template< class D >
+    void Distances( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms, double *res ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param feature: Feature vectors.
+     * @param src: Source element.
+     * @param first: First target element.
+     * @param last: One past the last target element.
+     * @param res: Returns the distance from src to each element in [ first, last ). Must hold last - first
+     * elements.
+     * @return none.
+     * @brief One-to-many distances among the elements of feature.
+     * @warning none.
+     */
+    template< class D >
+    void Distances( const Feature< D > &feature, size_t src, size_t first, size_t last, double *res ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Source feature vectors.
+     * @param tgt: Target feature vectors.
+     * @return Matrix with the distance from source element s to target element t at ( s, t ).
+     * @brief Many-to-many distances, with source elements processed by the thread pool.
+     * @warning src and tgt must have the same number of features.
+     */
+    template< class D >
+    Matrix< double > Distances( const Feature< D > &src, const Feature< D > &tgt ) const;
+
+  };
+
+}
+
+#include "DistanceKernel.cpp"
+
+#endif
@@ -0,0 +1,473 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Lazy element-wise arithmetic of images, vectors and matrices.
+ * <br> Description: The arithmetic operators of Image, Vector and Matrix create a temporary for each operation, so
+ * that ( a - b ) * 0.5 + c reads and writes the whole data three times. Expressions are opt-in: Lazy( x ) wraps a
+ * container in an expression node, and the operators of expression nodes build larger nodes, computing nothing.
+ * Assign( dst, expr ) and the compound assignments dst += expr, dst -= expr, etc. compute the whole expression in a
+ * single pass over the elements of dst, without temporaries. Large containers are split among the thread pool and
+ * each part is a single vectorizable loop.
+ * <br> Example: Assign( res, ( Lazy( a ) - Lazy( b ) ) * 0.5 + Lazy( c ) );
+ * <br> Intermediate values follow the C++ arithmetic conversions of the container types and of double scalars.
+ * Only the assignment converts them to the type of dst. Hence, integer expressions may give different results of
+ * the eager operators, which convert each intermediate result.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALEXPRESSION_H
+#define BIALEXPRESSION_H
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+
+namespace Bial {
+
+  template< class D >
+  class Image;
+  template< class D >
+  class Matrix;
+  template< class D >
+  class Vector;
+
+  /** @brief Smallest number of elements of an assignment computed by the thread pool. */
+  const size_t EXPRESSION_PARALLEL = 262144;
+  /** @brief Number of elements assigned to each thread pool task. */
+  const size_t EXPRESSION_GRAIN = 65536;
+
+  /**
+   * @brief Base of the expression nodes. E is the node class, which gives value_type, size( ) and operator[ ].
+   * Nodes keep their operands by value, and containers by pointer. Containers must outlive the expression.
+   */
+  template< class E >
+  class Expression {
+
+  public:
+
+    /** @brief Returns the node of derived class E. */
+    const E &Node( ) const {
+      return( static_cast< const E & >( *this ) );
+    }
+
+  };
+
+  /** @brief Leaf node reading the elements of a container. */
+  template< class D >
+  class ExpressionTerminal : public Expression< ExpressionTerminal< D > > {
+
+  protected:
+
+    const D *data;
+    size_t elements;
+
+  public:
+
+    typedef D value_type;
+
+    ExpressionTerminal( const D *data, size_t elements ) : data( data ), elements( elements ) {
+    }
+
+    size_t size( ) const {
+      return( elements );
+    }
+
+    D operator[]( size_t elm ) const {
+      return( data[ elm ] );
+    }
+
+  };
+
+  /** @brief Leaf node of a scalar, with the same value for all elements. Its size is 0, matching any size. */
+  class ExpressionConstant : public Expression< ExpressionConstant > {
+
+  protected:
+
+    double value;
+
+  public:
+
+    typedef double value_type;
+
+    ExpressionConstant( double value ) : value( value ) {
+    }
+
+    size_t size( ) const {
+      return( 0 );
+    }
+
+    double operator[]( size_t ) const {
+      return( value );
+    }
+
+  };
+
+  /** @brief Element-wise operations of the nodes. */
+  struct ExpressionAdd {
+    template< class A, class B >
+    static auto Apply( A a, B b ) -> decltype( a + b ) {
+      return( a + b );
+    }
+  };
+
+  struct ExpressionSubtract {
+    template< class A, class B >
+    static auto Apply( A a, B b ) -> decltype( a - b ) {
+      return( a - b );
+    }
+  };
+
+  struct ExpressionMultiply {
+    template< class A, class B >
+    static auto Apply( A a, B b ) -> decltype( a * b ) {
+      return( a * b );
+    }
+  };
+
+  struct ExpressionDivide {
+    template< class A, class B >
+    static auto Apply( A a, B b ) -> decltype( a / b ) {
+      return( a / b );
+    }
+  };
+
+  struct ExpressionNegate {
+    template< class A >
+    static auto Apply( A a ) -> decltype( -a ) {
+      return( -a );
+    }
+  };
+
+  struct ExpressionAbs {
+    template< class A >
+    static A Apply( A a ) {
+      return( std::abs( a ) );
+    }
+  };
+
+  /** @brief Node of a binary operation of two nodes. */
+  template< class L, class R, class OP >
+  class ExpressionBinary : public Expression< ExpressionBinary< L, R, OP > > {
+
+  protected:
+
+    L lhs;
+    R rhs;
+
+  public:
+
+    typedef decltype( OP::Apply( std::declval< typename L::value_type >( ),
+                                 std::declval< typename R::value_type >( ) ) ) value_type;
+
+    ExpressionBinary( const L &lhs, const R &rhs ) : lhs( lhs ), rhs( rhs ) {
+      if( ( lhs.size( ) != rhs.size( ) ) && ( lhs.size( ) != 0 ) && ( rhs.size( ) != 0 ) ) {
+        std::string msg( BIAL_ERROR( "Operands must have the same number of elements." ) );
+        throw( std::logic_error( msg ) );
+      }
+    }
+
+    size_t size( ) const {
+      return( std::max( lhs.size( ), rhs.size( ) ) );
+    }
+
+    value_type operator[]( size_t elm ) const {
+      return( OP::Apply( lhs[ elm ], rhs[ elm ] ) );
+    }
+
+  };
+
+  /** @brief Node of a unary operation of a node. */
+  template< class E, class OP >
+  class ExpressionUnary : public Expression< ExpressionUnary< E, OP > > {
+
+  protected:
+
+    E operand;
+
+  public:
+
+    typedef decltype( OP::Apply( std::declval< typename E::value_type >( ) ) ) value_type;
+
+    ExpressionUnary( const E &operand ) : operand( operand ) {
+    }
+
+    size_t size( ) const {
+      return( operand.size( ) );
+    }
+
+    value_type operator[]( size_t elm ) const {
+      return( OP::Apply( operand[ elm ] ) );
+    }
+
+  };
+
+  /** @brief Assignments of a value to an element of the destination. */
+  struct ExpressionAssign {
+    template< class D, class V >
+    static void Apply( D &dst, V val ) {
+      dst = static_cast< D >( val );
+    }
+  };
+
+  struct ExpressionAddAssign {
+    template< class D, class V >
+    static void Apply( D &dst, V val ) {
+      dst = static_cast< D >( dst + val );
+    }
+  };
+
+  struct ExpressionSubtractAssign {
+    template< class D, class V >
+    static void Apply( D &dst, V val ) {
+      dst = static_cast< D >( dst - val );
+    }
+  };
+
+  struct ExpressionMultiplyAssign {
+    template< class D, class V >
+    static void Apply( D &dst, V val ) {
+      dst = static_cast< D >( dst * val );
+    }
+  };
+
+  struct ExpressionDivideAssign {
+    template< class D, class V >
+    static void Apply( D &dst, V val ) {
+      dst = static_cast< D >( dst / val );
+    }
+  };
+
+  /**
+   * @date 2026/Oct/17
+   * @param dst: Destination elements.
+   * @param size: Number of destination elements.
+   * @param expr: Expression.
+   * @return none.
+   * @brief Assigns each element of expr to dst with assignment OP, in one pass. Large destinations are split among
+   * the thread pool.
+   * @warning expr must have size elements, or be a scalar. Each element of dst may appear in expr only at its own
+   * position.
+   */
+  template< class OP, class D, class E >
+  void ExpressionEvaluate( D *dst, size_t size, const Expression< E > &expr ) {
+    const E &node = expr.Node( );
+    if( ( node.size( ) != size ) && ( node.size( ) != 0 ) ) {
+      std::string msg( BIAL_ERROR( "Destination and expression must have the same number of elements." ) );
+      throw( std::logic_error( msg ) );
+    }
+    std::function< void( size_t, size_t ) > body = [ dst, &node ]( size_t first, size_t last ) {
+#pragma omp simd
+      for( size_t elm = first; elm < last; ++elm ) {
+        OP::Apply( dst[ elm ], node[ elm ] );
+      }
+    };
+    if( size >= EXPRESSION_PARALLEL ) {
+      size_t blocks = ( size + EXPRESSION_GRAIN - 1 ) / EXPRESSION_GRAIN;
+      ThreadPool::ParallelFor( 0, blocks, 1, [ &body, size ]( size_t first, size_t last ) {
+          body( first * EXPRESSION_GRAIN, std::min( last * EXPRESSION_GRAIN, size ) );
+        } );
+    }
+    else {
+      body( 0, size );
+    }
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param src: Image, vector or matrix.
+   * @return Leaf node of the elements of src.
+   * @brief Starts a lazy expression with the elements of src.
+   * @warning src must outlive the expression.
+   */
+  template< class D >
+  ExpressionTerminal< D > Lazy( const Image< D > &src ) {
+    return( ExpressionTerminal< D >( src.data( ), src.size( ) ) );
+  }
+  template< class D >
+  ExpressionTerminal< D > Lazy( const Vector< D > &src ) {
+    return( ExpressionTerminal< D >( src.data( ), src.size( ) ) );
+  }
+  template< class D >
+  ExpressionTerminal< D > Lazy( const Matrix< D > &src ) {
+    return( ExpressionTerminal< D >( src.data( ), src.size( ) ) );
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param lhs, rhs: Expressions, or an expression and a scalar.
+   * @return Node of the element-wise operation.
+   * @brief Element-wise arithmetic operators of expressions. Nothing is computed until the expression is assigned.
+   * @warning Products and quotients of matrices are element-wise.
+   */
+  template< class L, class R >
+  ExpressionBinary< L, R, ExpressionAdd > operator+( const Expression< L > &lhs, const Expression< R > &rhs ) {
+    return( ExpressionBinary< L, R, ExpressionAdd >( lhs.Node( ), rhs.Node( ) ) );
+  }
+  template< class E >
+  ExpressionBinary< E, ExpressionConstant, ExpressionAdd > operator+( const Expression< E > &lhs, double rhs ) {
+    return( ExpressionBinary< E, ExpressionConstant, ExpressionAdd >( lhs.Node( ), rhs ) );
+  }
+  template< class E >
+  ExpressionBinary< ExpressionConstant, E, ExpressionAdd > operator+( double lhs, const Expression< E > &rhs ) {
+    return( ExpressionBinary< ExpressionConstant, E, ExpressionAdd >( lhs, rhs.Node( ) ) );
+  }
+
+  template< class L, class R >
+  ExpressionBinary< L, R, ExpressionSubtract > operator-( const Expression< L > &lhs, const Expression< R > &rhs ) {
+    return( ExpressionBinary< L, R, ExpressionSubtract >( lhs.Node( ), rhs.Node( ) ) );
+  }
+  template< class E >
+  ExpressionBinary< E, ExpressionConstant, ExpressionSubtract > operator-( const Expression< E > &lhs, double rhs ) {
+    return( ExpressionBinary< E, ExpressionConstant, ExpressionSubtract >( lhs.Node( ), rhs ) );
+  }
+  template< class E >
+  ExpressionBinary< ExpressionConstant, E, ExpressionSubtract > operator-( double lhs, const Expression< E > &rhs ) {
+    return( ExpressionBinary< ExpressionConstant, E, ExpressionSubtract >( lhs, rhs.Node( ) ) );
+  }
+
+  template< class L, class R >
+  ExpressionBinary< L, R, ExpressionMultiply > operator*( const Expression< L > &lhs, const Expression< R > &rhs ) {
+    return( ExpressionBinary< L, R, ExpressionMultiply >( lhs.Node( ), rhs.Node( ) ) );
+  }
+  template< class E >
+  ExpressionBinary< E, ExpressionConstant, ExpressionMultiply > operator*( const Expression< E > &lhs, double rhs ) {
+    return( ExpressionBinary< E, ExpressionConstant, ExpressionMultiply >( lhs.Node( ), rhs ) );
+  }
+  template< class E >
+  ExpressionBinary< ExpressionConstant, E, ExpressionMultiply > operator*( double lhs, const Expression< E > &rhs ) {
+    return( ExpressionBinary< ExpressionConstant, E, ExpressionMultiply >( lhs, rhs.Node( ) ) );
+  }
+
+  template< class L, class R >
+  ExpressionBinary< L, R, ExpressionDivide > operator/( const Expression< L > &lhs, const Expression< R > &rhs ) {
+    return( ExpressionBinary< L, R, ExpressionDivide >( lhs.Node( ), rhs.Node( ) ) );
+  }
+  template< class E >
+  ExpressionBinary< E, ExpressionConstant, ExpressionDivide > operator/( const Expression< E > &lhs, double rhs ) {
+    return( ExpressionBinary< E, ExpressionConstant, ExpressionDivide >( lhs.Node( ), rhs ) );
+  }
+  template< class E >
+  ExpressionBinary< ExpressionConstant, E, ExpressionDivide > operator/( double lhs, const Expression< E > &rhs ) {
+    return( ExpressionBinary< ExpressionConstant, E, ExpressionDivide >( lhs, rhs.Node( ) ) );
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param expr: Expression.
+   * @return Node of the element-wise opposite or absolute value.
+   * @brief Element-wise unary operations of expressions.
+   * @warning none.
+   */
+  template< class E >
+  ExpressionUnary< E, ExpressionNegate > operator-( const Expression< E > &expr ) {
+    return( ExpressionUnary< E, ExpressionNegate >( expr.Node( ) ) );
+  }
+  template< class E >
+  ExpressionUnary< E, ExpressionAbs > Abs( const Expression< E > &expr ) {
+    return( ExpressionUnary< E, ExpressionAbs >( expr.Node( ) ) );
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param dst: Destination image, vector or matrix, with the size of expr.
+   * @param expr: Expression.
+   * @return Reference to dst.
+   * @brief Computes expr into dst, in a single pass.
+   * @warning dst is not resized.
+   */
+  template< class D, class E >
+  Image< D > &Assign( Image< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Vector< D > &Assign( Vector< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Matrix< D > &Assign( Matrix< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param dst: Destination image or vector, with the size of expr.
+   * @param expr: Expression.
+   * @return Reference to dst.
+   * @brief Element-wise compound assignments, computed in a single pass with expr.
+   * @warning none.
+   */
+  template< class D, class E >
+  Image< D > &operator+=( Image< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionAddAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Image< D > &operator-=( Image< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionSubtractAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Image< D > &operator*=( Image< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionMultiplyAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Image< D > &operator/=( Image< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionDivideAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+
+  template< class D, class E >
+  Vector< D > &operator+=( Vector< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionAddAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Vector< D > &operator-=( Vector< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionSubtractAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Vector< D > &operator*=( Vector< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionMultiplyAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Vector< D > &operator/=( Vector< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionDivideAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param dst: Destination matrix, with the size of expr.
+   * @param expr: Expression.
+   * @return Reference to dst.
+   * @brief Element-wise compound sum and difference, computed in a single pass with expr.
+   * @warning Matrix product and quotient are not element-wise. Use Assign( dst, Lazy( dst ) * expr ) for the
+   * element-wise ones.
+   */
+  template< class D, class E >
+  Matrix< D > &operator+=( Matrix< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionAddAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+  template< class D, class E >
+  Matrix< D > &operator-=( Matrix< D > &dst, const Expression< E > &expr ) {
+    ExpressionEvaluate< ExpressionSubtractAssign >( dst.data( ), dst.size( ), expr );
+    return( dst );
+  }
+
+}
+
+#endif
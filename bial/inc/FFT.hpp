@@ -0,0 +1,240 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief
+ * Content: Fast Fourier transform.
+ * <br> Description: Mixed-radix (4, 2, and generic odd radices) complex transform of any size, real transform of
+ * even size computed by a complex transform of half the size, and 3D real transform of zero-padded volumes used by
+ * the spectral correlation. Sizes with prime factors 2, 3, and 5 only are the fastest ones. See FFT::GoodSize.
+ */
+
+#ifndef BIALFFT_H
+#define BIALFFT_H
+
+#include "Common.hpp"
+#include "Vector.hpp"
+#include <complex>
+
+namespace Bial {
+
+  /** @brief One-dimensional complex fast Fourier transform plan. */
+  class FFT {
+
+  private:
+
+    /** @brief Transform size. */
+    size_t fft_size;
+    /** @brief Radix and remaining size of each stage. */
+    Vector< size_t > factor;
+    /** @brief exp( -2 pi i k / size ), for k in [ 0, size ). */
+    Vector< std::complex< double > > forward_twiddle;
+    /** @brief exp( 2 pi i k / size ), for k in [ 0, size ). */
+    Vector< std::complex< double > > inverse_twiddle;
+    /** @brief exp( -2 pi i k / ( 2 size ) ), for k in [ 0, size ]. Used by real transforms of size 2 * size. */
+    Vector< std::complex< double > > real_twiddle;
+
+    /**
+     * @date 2026/Oct/17
+     * @param out: Output sequence.
+     * @param in: Input sequence.
+     * @param fstride: Distance between used input elements, in elements of the current stage.
+     * @param stage: Index of the current stage in factor.
+     * @param twiddle: Twiddle factor table, forward or inverse.
+     * @return none.
+     * @brief Recursive decimation in time over the stages starting at stage.
+     * @warning none.
+     */
+    void Work( std::complex< double > *out, const std::complex< double > *in, size_t fstride, size_t stage,
+               const Vector< std::complex< double > > &twiddle ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param data: Sequence of radix * sub_size elements, composed by radix transforms of size sub_size.
+     * @param fstride: Twiddle index stride.
+     * @param sub_size: Size of sub-transforms.
+     * @param radix: Radix of the stage.
+     * @param twiddle: Twiddle factor table, forward or inverse.
+     * @return none.
+     * @brief Combines radix sub-transforms into one transform of size radix * sub_size.
+     * @warning none.
+     */
+    void Butterfly( std::complex< double > *data, size_t fstride, size_t sub_size, size_t radix,
+                    const Vector< std::complex< double > > &twiddle ) const;
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param size: Transform size.
+     * @return none.
+     * @brief Basic Constructor. Computes the stages and twiddle factors.
+     * @warning Size must be greater than zero.
+     */
+    FFT( size_t size = 1 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Transform size.
+     * @brief Returns the transform size.
+     * @warning none.
+     */
+    size_t size( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param min_size: Minimum size.
+     * @return Smallest size not smaller than min_size with prime factors 2, 3, and 5 only.
+     * @brief Returns a fast transform size for padded data.
+     * @warning none.
+     */
+    static size_t GoodSize( size_t min_size );
+
+    /**
+     * @date 2026/Oct/17
+     * @param in: Input sequence with size( ) elements.
+     * @param out: Output sequence with size( ) elements.
+     * @return none.
+     * @brief Computes the forward transform of in.
+     * @warning in and out must not overlap.
+     */
+    void Forward( const std::complex< double > *in, std::complex< double > *out ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param in: Input sequence with size( ) elements.
+     * @param out: Output sequence with size( ) elements.
+     * @return none.
+     * @brief Computes the inverse transform of in, not normalized. That is, Inverse( Forward( x ) ) = size( ) * x.
+     * @warning in and out must not overlap.
+     */
+    void Inverse( const std::complex< double > *in, std::complex< double > *out ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param in: Real input sequence with 2 * size( ) elements.
+     * @param out: First size( ) + 1 elements of the spectrum of in. The others are given by conjugate symmetry.
+     * @param scratch: Buffer with size( ) elements.
+     * @return none.
+     * @brief Computes the forward transform of a real sequence of size 2 * size( ).
+     * @warning none.
+     */
+    void RealForward( const double *in, std::complex< double > *out, std::complex< double > *scratch ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param in: First size( ) + 1 elements of a conjugate symmetric spectrum.
+     * @param out: Real output sequence with 2 * size( ) elements.
+     * @param scratch: Buffer with 2 * size( ) elements.
+     * @return none.
+     * @brief Computes the inverse transform of a conjugate symmetric spectrum, not normalized. That is,
+     * RealInverse( RealForward( x ) ) = size( ) * x.
+     * @warning none.
+     */
+    void RealInverse( const std::complex< double > *in, double *out, std::complex< double > *scratch ) const;
+
+  };
+
+  /** @brief Three-dimensional real transform of zero-padded volumes. */
+  class FFTVolume {
+
+  private:
+
+    /** @brief Padded volume dimensions. The first one is even. */
+    Vector< size_t > dim_size;
+    /** @brief Real transform along the first dimension. */
+    FFT fft_x;
+    /** @brief Complex transform along the second dimension. */
+    FFT fft_y;
+    /** @brief Complex transform along the third dimension. */
+    FFT fft_z;
+
+    /**
+     * @date 2026/Oct/17
+     * @param spectrum: Spectrum to be transformed in place.
+     * @param fft: Transform plan of the lines.
+     * @param lines: Number of lines.
+     * @param inner: Number of consecutive lines before a jump of outer_stride.
+     * @param outer_stride: Distance between first elements of lines l and l + inner.
+     * @param stride: Distance between consecutive elements of a line.
+     * @param inverse: Whether the inverse transform is computed.
+     * @return none.
+     * @brief Computes the transform of spectrum lines. Line l starts at ( l % inner ) + ( l / inner ) * outer_stride.
+     * @warning none.
+     */
+    void Lines( Vector< std::complex< double > > &spectrum, const FFT &fft, size_t lines, size_t inner,
+                size_t outer_stride, size_t stride, bool inverse ) const;
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param min_dim: Minimum padded dimensions.
+     * @return none.
+     * @brief Basic Constructor. Each padded dimension is the GoodSize of min_dim, and the first one is also even.
+     * @warning none.
+     */
+    FFTVolume( const Vector< size_t > &min_dim );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Padded volume dimensions.
+     * @brief Returns the padded volume dimensions.
+     * @warning none.
+     */
+    const Vector< size_t > &Dim( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of elements of the padded volume.
+     * @brief Returns the number of elements of the padded volume.
+     * @warning none.
+     */
+    size_t VolumeSize( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of elements of the spectrum: ( Dim( )( 0 ) / 2 + 1 ) * Dim( )( 1 ) * Dim( )( 2 ).
+     * @brief Returns the number of elements of the spectrum. Spectrum is stored with the first dimension varying
+     * faster.
+     * @warning none.
+     */
+    size_t SpectrumSize( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param volume: Padded volume with VolumeSize( ) elements.
+     * @param used: Dimensions of the volume corner which may be non-zero. Used to skip null lines.
+     * @param spectrum: Output spectrum with SpectrumSize( ) elements.
+     * @return none.
+     * @brief Computes the forward transform of volume, using the thread pool.
+     * @warning Elements of volume out of the used corner must be zero.
+     */
+    void Forward( const Vector< double > &volume, const Vector< size_t > &used,
+                  Vector< std::complex< double > > &spectrum ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param spectrum: Spectrum with SpectrumSize( ) elements. Overwritten.
+     * @param used: Dimensions of the volume corner to be computed.
+     * @param volume: Output padded volume with VolumeSize( ) elements. Only the used corner is set.
+     * @return none.
+     * @brief Computes the normalized inverse transform of spectrum, using the thread pool.
+     * @warning none.
+     */
+    void Inverse( Vector< std::complex< double > > &spectrum, const Vector< size_t > &used,
+                  Vector< double > &volume ) const;
+
+  };
+
+}
+
+#include "FFT.cpp"
+
+#endif
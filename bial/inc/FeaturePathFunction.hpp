@@ -79,7 +79,7 @@ namespace Bial {
      * function. This function makes IFT faster.
      * @warning none.
      */
-    bool Capable( int index, int adj_index, BucketState adj_state );
+    bool Capable( size_t index, size_t adj_index, BucketState adj_state );
 
     /**
      * @date 2013/Jun/28
@@ -89,7 +89,7 @@ namespace Bial {
      * @brief Updates adjacent pixel values and returns true if path_function is propagated.
      * @warning none.
      */
-    bool Propagate( int index, int adj_index );
+    bool Propagate( size_t index, size_t adj_index );
 
     /**
      * @date 2012/Sep/19
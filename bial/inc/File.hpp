@@ -5,7 +5,9 @@
 /**
  * @date 2013/Aug/08 
  * @brief File and Directory Handling. 
- * @warning random access from IFile does not work for gziped files, since gzstream does not support it.
+ * @warning seekg on gziped files is fast only for files written by OFile, whose blocks are indexed. Other gziped
+ * files are inflated up to the target position, from their start when seeking backwards. seekp does not work for
+ * gziped files.
  */
 
 #include "Common.hpp"
@@ -164,7 +166,7 @@ namespace Bial {
     IFile &operator>>( std::istream & ( *pf )( std::istream & ) );
     IFile &operator>>( std::ios & ( *pf )( std::ios & ) );
     IFile &operator>>( std::ios_base & ( *pf )( std::ios_base & ) );
-    std::streamsize gcount( ); /* Do not use this for gziped files. Random access does not work in gzstream. */
+    std::streamsize gcount( );
     int get( );
     IFile &get( char &c );
     IFile &get( char *s, std::streamsize n );
@@ -175,10 +177,9 @@ namespace Bial {
     IFile &getline( char *s, std::streamsize n, char delim );
     IFile &ignore( std::streamsize n = 1, int delim = EOF );
     IFile &read( char *s, std::streamsize n );
-    IFile &seekg( std::streampos pos ); /* Do not use this for gziped files. Random access does not work in gzstream. 
-					 * Do not use this for gziped files. Random access does not work in gzstream. 
-					 */
-    IFile &seekg( std::streamoff off, std::ios_base::seekdir way );
+    IFile &seekg( std::streampos pos ); /* Fast on gziped files written by OFile. Slow on other gziped files. */
+    IFile &seekg( std::streamoff off, std::ios_base::seekdir way ); /* Seeking from the end of gziped files works
+                                                                     * only for files written by OFile. */
     std::ios_base::iostate exceptions( ) const;
     void exceptions( std::ios_base::iostate except );
     /**
@@ -272,7 +273,7 @@ namespace Bial {
     OFile &operator<<( std::ios_base & ( *pf )( std::ios_base & ) );
     OFile &put( char c );
     OFile &write( const char *s, std::streamsize n );
-    std::streampos tellp( ); /* Do not use this for gziped files. Random access does not work in gzstream. */
+    std::streampos tellp( );
     OFile &seekp( std::streampos pos ); /* Do not use this for gziped files. Random access does not work in gzstream. 
 					 * Do not use this for gziped files. Random access does not work in gzstream. 
 					 */
@@ -22,25 +22,43 @@ namespace Bial {
    * @date 2013/Oct/28
    * @param filename: Source filename to be readed.
    * @return A reference to the created scene.
-   * @brief Open a Dicom file for reading and returns it.
-   * @warning none.
+   * @brief Open a Dicom file for reading and returns it. Gziped files are decompressed to memory. Pixels keep their
+   * stored values, without rescale slope and intercept.
+   * @warning Color images are gray, with stored values clamped to [ 0, 255 ].
    */
   template< class D >
   static Image< D > ReadDicom( const std::string &filename );
+
+  /**
+   * @date 2026/Oct/17
+   * @param dir_name: Directory with the slices of a Dicom series, one per file.
+   * @return 3D image with the slices in spatial order.
+   * @brief Parses all files of the directory in parallel, sorts the slices by their position along the slice normal,
+   * or by instance number if any slice has no position, and decodes them in parallel straight into the volume,
+   * applying the rescale slope and intercept of each slice. The distance between slices is taken from their
+   * positions, or from the header if they have none.
+   * @warning Files that are not Dicom slices are ignored. If the directory holds more than one series, the one with
+   * most slices is read.
+   */
+  template< class D >
+  static Image< D > ReadDicomSeries( const std::string &dir_name );
 }
 
 /* Implementation --------------------------------------------------------------------------------------------------- */
 
 #include "Color.hpp"
-#include "DicomHeader.hpp"
+#include "DicomSlice.hpp"
+#include "File.hpp"
+#include "ThreadPool.hpp"
+#include <map>
+#include <memory>
 
 namespace Bial {
 
   template< class D >
   Image< D > ReadDicom( const std::string &filename ) {
     try {
-      DicomHeader dhdr;
-      return( dhdr.readFile< D >( filename ) );
+      return( DicomSlice( filename ).Read< D >( false ) );
     }
     catch( std::ios_base::failure &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/reading/closing Dicom file." ) );
@@ -63,8 +81,15 @@ namespace Bial {
   template< >
   Image< Color > ReadDicom( const std::string &filename ) {
     try {
-      DicomHeader dhdr;
-      return( dhdr.readFile< Color >( filename ) );
+      Image< int > gray( DicomSlice( filename ).Read< int >( false ) );
+      Image< Color > res( gray.Dim( ), gray.PixelSize( ) );
+      COMMENT( "Clamping, as signed and 16 bits samples would wrap around.", 2 );
+      for( size_t pxl = 0; pxl < res.size( ); ++pxl ) {
+        res[ pxl ]( 1 ) = static_cast< uchar >( std::min( std::max( gray[ pxl ], 0 ), 255 ) );
+        res[ pxl ]( 2 ) = res[ pxl ]( 1 );
+        res[ pxl ]( 3 ) = res[ pxl ]( 1 );
+      }
+      return( res );
     }
     catch( std::ios_base::failure &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/reading/closing Dicom file." ) );
@@ -84,6 +109,118 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  Image< D > ReadDicomSeries( const std::string &dir_name ) {
+    try {
+      COMMENT( "Parsing the headers of all files in parallel. Files that are not Dicom slices are dropped.", 2 );
+      Vector< std::string > names( Directory::ListFiles( dir_name ) );
+      std::string prefix( dir_name );
+      if( ( !prefix.empty( ) ) && ( prefix[ prefix.size( ) - 1 ] != DIR_SEPARATOR ) ) {
+        prefix += DIR_SEPARATOR;
+      }
+      std::vector< std::unique_ptr< DicomSlice > > parsed( names.size( ) );
+      ThreadPool::ParallelFor( 0, names.size( ), 1, [ & ]( size_t first, size_t last ) {
+          for( size_t fls = first; fls < last; ++fls ) {
+            try {
+              parsed[ fls ].reset( new DicomSlice( prefix + names[ fls ] ) );
+            }
+            catch( std::ios_base::failure & ) {
+              COMMENT( "Not a readable Dicom file: " << names[ fls ], 2 );
+            }
+            catch( const std::logic_error & ) {
+              COMMENT( "Not a supported Dicom slice: " << names[ fls ], 2 );
+            }
+          }
+        } );
+      COMMENT( "Choosing the series with most slices.", 2 );
+      std::map< std::string, size_t > count;
+      for( size_t fls = 0; fls < parsed.size( ); ++fls ) {
+        if( parsed[ fls ] ) {
+          ++count[ parsed[ fls ]->SeriesUID( ) ];
+        }
+      }
+      if( count.empty( ) ) {
+        std::string msg( BIAL_ERROR( "No Dicom slice found in directory " + dir_name + "." ) );
+        throw( std::logic_error( msg ) );
+      }
+      auto largest = count.begin( );
+      for( auto srs = count.begin( ); srs != count.end( ); ++srs ) {
+        if( srs->second > largest->second ) {
+          largest = srs;
+        }
+      }
+      if( count.size( ) > 1 ) {
+        BIAL_WARNING( "Directory " << dir_name << " has " << count.size( ) << " Dicom series. Reading the one with " <<
+                      largest->second << " slices." );
+      }
+      std::vector< const DicomSlice* > slice;
+      for( size_t fls = 0; fls < parsed.size( ); ++fls ) {
+        if( ( parsed[ fls ] ) && ( parsed[ fls ]->SeriesUID( ) == largest->first ) ) {
+          slice.push_back( parsed[ fls ].get( ) );
+        }
+      }
+      Vector< size_t > dim( slice[ 0 ]->Dim( ) );
+      bool positioned = true;
+      for( size_t slc = 0; slc < slice.size( ); ++slc ) {
+        if( ( slice[ slc ]->Dim( )[ 0 ] != dim[ 0 ] ) || ( slice[ slc ]->Dim( )[ 1 ] != dim[ 1 ] ) ) {
+          std::string msg( BIAL_ERROR( "Slices of Dicom series in " + dir_name + " have different dimensions." ) );
+          throw( std::logic_error( msg ) );
+        }
+        positioned = positioned && slice[ slc ]->HasPosition( );
+      }
+      COMMENT( "Sorting slices in spatial order.", 2 );
+      if( positioned ) {
+        std::stable_sort( slice.begin( ), slice.end( ), [ ]( const DicomSlice *a, const DicomSlice *b ) {
+            return( a->Location( ) < b->Location( ) );
+          } );
+      }
+      else {
+        std::stable_sort( slice.begin( ), slice.end( ), [ ]( const DicomSlice *a, const DicomSlice *b ) {
+            return( a->InstanceNumber( ) < b->InstanceNumber( ) );
+          } );
+      }
+      COMMENT( "Slice distance from positions, as slice thickness may differ from it in overlapping series.", 2 );
+      double distance = slice[ 0 ]->SliceSpacing( );
+      if( ( positioned ) && ( slice.size( ) > 1 ) ) {
+        double span = slice.back( )->Location( ) - slice.front( )->Location( );
+        if( span > 0.0 ) {
+          distance = span / static_cast< double >( slice.size( ) - 1 );
+        }
+      }
+      if( distance <= 0.0 ) {
+        distance = 1.0;
+      }
+      COMMENT( "Decoding slices in parallel straight into the volume.", 2 );
+      Vector< float > pixel_size( slice[ 0 ]->PixelSize( ) );
+      Image< D > res( Vector< size_t >( { dim[ 0 ], dim[ 1 ], slice.size( ) } ), StorageInit::None );
+      res.PixelSize( Vector< float >( { pixel_size[ 0 ], pixel_size[ 1 ], static_cast< float >( distance ) } ) );
+      size_t slice_size = dim[ 0 ] * dim[ 1 ];
+      D *data = &res[ 0 ];
+      ThreadPool::ParallelFor( 0, slice.size( ), 1, [ & ]( size_t first, size_t last ) {
+          for( size_t slc = first; slc < last; ++slc ) {
+            slice[ slc ]->Decode( data + slc * slice_size, true );
+          }
+        } );
+      return( res );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading Dicom series." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
 }
 
 #endif
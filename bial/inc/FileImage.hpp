@@ -88,6 +88,7 @@ namespace Bial {
 
 /* Implementation --------------------------------------------------------------------------------------------------- */
 
+#include "ChunkedImage.hpp"
 #include "Color.hpp"
 #include "File.hpp"
 #include "FileBMP.hpp"
@@ -108,7 +109,8 @@ namespace Bial {
           ( extension.find( ".ppm" ) != std::string::npos ) || ( extension.find( ".pnm" ) != std::string::npos ) ||
           ( extension.find( ".scn" ) != std::string::npos ) || ( extension.find( ".nii" ) != std::string::npos ) ||
           ( extension.find( ".img" ) != std::string::npos ) || ( extension.find( ".hdr" ) != std::string::npos ) ||
-          ( extension.find( ".dcm" ) != std::string::npos ) || ( extension.find( ".bmat" ) != std::string::npos ) ) {
+          ( extension.find( ".dcm" ) != std::string::npos ) || ( extension.find( ".bmat" ) != std::string::npos ) ||
+          ( extension.find( ".bvol" ) != std::string::npos ) ) {
         return( true );
       }
       return( false );
@@ -198,11 +200,14 @@ namespace Bial {
       if( extension.rfind( ".bmat" ) != std::string::npos ) {
         return( ReadMatrixImage< D >( filename ) );
       }
+      if( extension.rfind( ".bvol" ) != std::string::npos ) {
+        return( ChunkedImage< D >( filename ).Load( ) );
+      }
       COMMENT( "Call here other image extensions.", 2 );
       std::string msg( BIAL_ERROR(
                          "Unsupported extension for file " + filename + ". Currently supported: .scn(.gz), " +
                          ".img(.gz), .hdr(.gz), .nii(.gz), .pnm(.gz), .ppm(.gz), .pgm(.gz), .pbm(.gz), " +
-                         ".dcm(.gz), .bmat(.gz)" ) );
+                         ".dcm(.gz), .bmat(.gz), .bvol" ) );
       throw( std::invalid_argument( msg ) );
     }
     catch( std::ios_base::failure &e ) {
@@ -330,10 +335,14 @@ namespace Bial {
         WriteMatrixImage( img, filename );
         return;
       }
+      if( extension.rfind( ".bvol" ) != std::string::npos ) {
+        ChunkedImage< D >::Write( img, filename );
+        return;
+      }
       COMMENT( "Call here other image extensions.", 2 );
       std::string msg( BIAL_ERROR(
                          "Unsupported extension. Currently supported: .scn(.gz), .bmp(.gz) .img(.gz), .hdr(.gz), "
-                         + ".nii(.gz), .pnm(.gz), .ppm(.gz), .pgm(.gz), .pbm(.gz), .bmat(.gz)." ) );
+                         + ".nii(.gz), .pnm(.gz), .ppm(.gz), .pgm(.gz), .pbm(.gz), .bmat(.gz), .bvol." ) );
       throw( std::invalid_argument( msg ) );
     }
     catch( std::ios_base::failure &e ) {
@@ -48,9 +48,30 @@ namespace Bial {
 #include "ColorRGB.hpp"
 #include "File.hpp"
 #include "NiftiHeader.hpp"
+#include "NiftiMapping.hpp"
 
 namespace Bial {
 
+  /**
+   * @date 2026/Oct/17
+   * @param type: Stored data type.
+   * @return true if type is the Nifti code of D.
+   * @brief Checks whether data stored as type may be read straight into an image of type D.
+   * @warning none.
+   */
+  template< class D >
+  static bool NiftiStoredAs( NiftiType type ) {
+    return( ( std::is_same< D, signed char >::value && ( type == NiftiType::INT8 ) ) ||
+            ( std::is_same< D, unsigned char >::value && ( type == NiftiType::UINT8 ) ) ||
+            ( std::is_same< D, short >::value && ( type == NiftiType::INT16 ) ) ||
+            ( std::is_same< D, unsigned short >::value && ( type == NiftiType::UINT16 ) ) ||
+            ( std::is_same< D, int >::value && ( type == NiftiType::INT32 ) ) ||
+            ( std::is_same< D, unsigned int >::value && ( type == NiftiType::UINT32 ) ) ||
+            ( std::is_same< D, llint >::value && ( type == NiftiType::INT64 ) ) ||
+            ( std::is_same< D, float >::value && ( type == NiftiType::FLOAT32 ) ) ||
+            ( std::is_same< D, double >::value && ( type == NiftiType::FLOAT64 ) ) );
+  }
+
   template< >
   Image< Color > ReadNifti( const std::string &filename ) {
     try {
@@ -101,7 +122,8 @@ namespace Bial {
       COMMENT( "Seeking to the appropriate read position.", 2 );
       size_t offset;
       if( extension.rfind( ".nii" ) != std::string::npos ) {
-        offset = NiftiHeader::NIFTI_HEADER_SIZE + 4u;
+        COMMENT( "Data of .nii files starts after the header and its extensions.", 2 );
+        offset = std::max( hdr.VoxOffset( ), static_cast< size_t >( NiftiHeader::NIFTI_HEADER_SIZE + 4 ) );
         file.ignore( offset );
       }
       COMMENT( "Reading data.", 2 );
@@ -117,7 +139,7 @@ namespace Bial {
       file.close( );
 
       COMMENT( "Byte swap array if needed.", 2 );
-      bool swap = NiftiHeader::IsSwapped( filename );
+      bool swap = hdr.Swapped( );
       if( ( swap == true ) && ( single_bytes > 1 ) ) {
         NiftiHeader::SwapNBytes( img_size, single_bytes, dataptr );
       }
@@ -261,6 +283,11 @@ namespace Bial {
         return( ColorSpace::ARGBtoGraybyBrightness< D >( color_img ) );
       }
 
+      if( NiftiMapping::IsMappable( filename ) ) {
+        COMMENT( "Uncompressed data. Converting directly from the mapped file.", 2 );
+        return( NiftiMapping( filename, hdr ).Read< D >( ) );
+      }
+
       Image< D > res( spc_dims, pixel_size );
       COMMENT( "Getting filename and opening it.", 2 );
       std::string imgname( NiftiHeader::ExistingDataFileName( filename ) );
@@ -275,9 +302,31 @@ namespace Bial {
       COMMENT( "Seeking to the appropriate read position.", 2 );
       size_t offset;
       if( extension.rfind( ".nii" ) != std::string::npos ) {
-        offset = NiftiHeader::NIFTI_HEADER_SIZE + 4u;
+        COMMENT( "Data of .nii files starts after the header and its extensions.", 2 );
+        offset = std::max( hdr.VoxOffset( ), static_cast< size_t >( NiftiHeader::NIFTI_HEADER_SIZE + 4 ) );
         file.ignore( offset );
       }
+      if( NiftiStoredAs< D >( hdr.DataType( ) ) ) {
+        COMMENT( "Stored type is D. Decompressing straight into the image.", 2 );
+        file.read( reinterpret_cast< char* >( &res[ 0 ] ), sizeof( D ) * res.size( ) );
+        if( ( !file.good( ) ) || file.eof( ) || file.fail( ) || file.bad( ) ) {
+          file.close( );
+          std::string msg( BIAL_ERROR( "Error opening/reading Nifti file." ) );
+          throw( std::ios_base::failure( msg ) );
+        }
+        file.close( );
+        if( hdr.Swapped( ) && ( sizeof( D ) > 1 ) ) {
+          NiftiHeader::SwapNBytes( res.size( ), sizeof( D ), &res[ 0 ] );
+        }
+        if( std::is_floating_point< D >::value ) {
+          for( size_t p = 0; p < res.size( ); ++p ) {
+            if( !std::isfinite( res( p ) ) ) {
+              res( p ) = 0;
+            }
+          }
+        }
+        return( res );
+      }
       COMMENT( "Reading data.", 2 );
       size_t single_bytes = hdr.BitPix( ) / 8;
       size_t total_bytes = single_bytes * res.size( );
@@ -290,7 +339,7 @@ namespace Bial {
       }
       file.close( );
 
-      bool swap = NiftiHeader::IsSwapped( filename );
+      bool swap = hdr.Swapped( );
       COMMENT( "Is swapped??????????? " << swap, 2 );
       if( ( swap == true ) && ( single_bytes > 1 ) ) {
         COMMENT( "Byte swap array if needed.", 2 );
@@ -8,6 +8,7 @@
  */
 
 #include "Common.hpp"
+#include <functional>
 
 #ifndef BIALFILTERINGGAUSSIAN_H
 #define BIALFILTERINGGAUSSIAN_H
@@ -16,6 +17,8 @@ namespace Bial {
 
   template< class D >
   class Image;
+  template< class D >
+  class Vector;
 
   namespace Filtering {
 
@@ -30,6 +33,82 @@ namespace Bial {
     template< class D >
     Image< D > Gaussian( const Image< D > &img, float radius = 2.0, float std_dev = 2.0 );
 
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param radius: radius of the kernel in each dimension.
+     * @param std_dev: standard deviation of the Gaussian.
+     * @return Gaussian filtered image.
+     * @brief Returns the Gaussian filtered image computed by one 1D correlation along each dimension. Same kernel
+     * values and border handling of Gaussian( ), with cost proportional to the radius instead of its power.
+     * @warning The kernel support is a box of side 2 * radius + 1 instead of a hypersphere. Hence, the result
+     * differs slightly from Gaussian( ) on the box corners.
+     */
+    template< class D >
+    Image< D > SeparableGaussian( const Image< D > &img, float radius = 2.0, float std_dev = 2.0 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param std_dev: standard deviation of the Gaussian. Must be at least 0.5.
+     * @return Gaussian filtered image.
+     * @brief Returns the Gaussian filtered image computed by the recursive filter of Young and van Vliet. The cost
+     * per pixel does not depend on the standard deviation.
+     * @warning Unit gain filter with replicated borders, while Gaussian( ) uses a truncated, non-normalized kernel.
+     */
+    template< class D >
+    Image< D > RecursiveGaussian( const Image< D > &img, float std_dev = 2.0 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param std_dev: standard deviation of the Gaussian. Must be at least 0.5.
+     * @param direction: dimension of the derivative.
+     * @return First derivative of the Gaussian filtered image along direction.
+     * @brief Returns the derivative of the recursive Gaussian filtered image along direction, computed by central
+     * differences over the smoothed image, as proposed by van Vliet, Young and Verbeek.
+     * @warning none.
+     */
+    template< class D >
+    Image< D > RecursiveGaussianDerivative( const Image< D > &img, float std_dev, size_t direction );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param std_dev: standard deviation of the Gaussian.
+     * @param passes: number of box mean passes.
+     * @return Gaussian filtered image.
+     * @brief Returns the Gaussian filtered image approximated by passes successive box means whose widths are chosen
+     * as in Kovesi, so that their combined variance best matches std_dev. Each pass is computed from the integral
+     * image, so that the cost per pixel does not depend on the standard deviation.
+     * @warning Only 2D and 3D images are supported. Box windows are clipped to the image domain.
+     */
+    template< class D >
+    Image< D > BoxGaussian( const Image< D > &img, float std_dev = 2.0, size_t passes = 3 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Image to be filtered in place.
+     * @param direction: dimension of the lines.
+     * @param filter: function applied to each line, given as a contiguous copy.
+     * @return none.
+     * @brief Applies filter in place to all image lines along direction, using the thread pool.
+     * @warning none.
+     */
+    void FilterLines( Image< double > &img, size_t direction,
+                      const std::function< void( Vector< double > & ) > &filter );
+
+    /**
+     * @date 2026/Oct/17
+     * @param line: Line to be filtered in place.
+     * @param std_dev: standard deviation of the Gaussian. Must be at least 0.5.
+     * @return none.
+     * @brief Applies the causal and anti-causal passes of the recursive Gaussian filter of Young and van Vliet to
+     * line.
+     * @warning none.
+     */
+    void RecursiveGaussian( Vector< double > &line, float std_dev );
+
   }
 
 }
@@ -16,6 +16,8 @@ namespace Bial {
 
   template< class D >
   class Image;
+  template< class D >
+  class Vector;
 
   namespace Filtering {
 
@@ -24,7 +26,8 @@ namespace Bial {
      * @param img: Input image. 
      * @param neighborhood_radius: radius of the neighborhood. 
      * @return Mean filtered image with the given radius. 
-     * @brief Returns the mean filtered image with the given radius. 
+     * @brief Returns the mean filtered image with the given radius. Adjacents out of the image domain are ignored.
+     * Pixels are processed by the thread pool.
      * @warning none. 
      */
     template< class D >
@@ -37,11 +40,38 @@ namespace Bial {
      * @param neighborhood_radius: radius of the neighborhood. 
      * @return Mean filtered image with the given radius restricted to non-zero mask pixels. 
      * @brief Returns the mean filtered image with the given radius restricted to non-zero mask pixels. 
+     * Pixels are processed by the thread pool.
      * @warning none. 
      */
     template< class D >
     Image< D > Mean( const Image< D > &img, const Image< D > &msk, float radius );
 
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param radius: Window radius in pixels in each dimension.
+     * @return Mean filtered image with a box window of side 2 * radius + 1.
+     * @brief Returns the mean of the box window centered at each pixel, clipped to the image domain. Computed from
+     * the integral image, so that the cost per pixel does not depend on the radius.
+     * @warning Only 2D and 3D images are supported.
+     */
+    template< class D >
+    Image< D > BoxMean( const Image< D > &img, const Vector< size_t > &radius );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param msk: Restrictive mask.
+     * @param radius: Window radius in pixels in each dimension.
+     * @return Mean filtered image with a box window of side 2 * radius + 1 restricted to non-zero mask pixels.
+     * @brief Returns the mean of the non-zero mask pixels of the box window centered at each non-zero mask pixel.
+     * Other pixels keep their values. Computed from the integral images of the masked input and of the mask count,
+     * so that the cost per pixel does not depend on the radius.
+     * @warning Only 2D and 3D images are supported.
+     */
+    template< class D >
+    Image< D > BoxMean( const Image< D > &img, const Image< D > &msk, const Vector< size_t > &radius );
+
   }
 
 }
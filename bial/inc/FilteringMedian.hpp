@@ -16,6 +16,8 @@ namespace Bial {
 
   template< class D >
   class Image;
+  template< class D >
+  class Vector;
   class Adjacency;
 
   namespace Filtering {
@@ -25,7 +27,10 @@ namespace Bial {
      * @param img: Input image. 
      * @param neighborhood_radius: radius of the neighborhood. 
      * @return Median filtered image with the given radius. 
-     * @brief Returns the median filtered image with the given radius. 
+     * @brief Returns the median filtered image with the given radius. Adjacents out of the image domain are ignored.
+     * Computed with a histogram of the window sliding along image lines, so that each pixel only updates the
+     * adjacents entering and leaving the window. The lower median is taken for windows with an even number of
+     * pixels.
      * @warning none. 
      */
     template< class D >
@@ -35,6 +40,8 @@ namespace Bial {
      * @date 2013/Aug/08 
      * @param img: Input image. 
      * @param adj: Adjacency relation. 
+     * @param bin: Histogram bin of each pixel, as returned by SlidingHistogram::Quantize.
+     * @param value: Value of each histogram bin, as returned by SlidingHistogram::Quantize.
      * @param res: Resulting image. 
      * @param thread: number of the thread. 
      * @param total_threads: total number of threads. 
@@ -43,8 +50,8 @@ namespace Bial {
      * @warning none. 
      */
     template< class D >
-    void MedianThreads( const Image< D > &img, const Adjacency &adj, Image< D > &res, size_t thread,
-                        size_t total_threads );
+    void MedianThreads( const Image< D > &img, const Adjacency &adj, const Vector< int > &bin,
+                        const Vector< D > &value, Image< D > &res, size_t thread, size_t total_threads );
     
   }
 
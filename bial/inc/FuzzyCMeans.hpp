@@ -11,6 +11,11 @@
  * Content: FuzzyCMeans class 
  * <br> Description: Implementation of Fuzzy C-Means clustering algorithm
  * for 3D images. 
+ * <br> Memberships are computed from the distance powers of each element to each centroid, taking O( C * N * F ) per
+ * iteration. Elements are processed by the thread pool in fixed blocks, and centroid sums are reduced in block order,
+ * so that results do not depend on the number of threads. Scalar features with repeated values are clustered by
+ * their distinct values, weighted by their counts. RunMiniBatch updates the centroids from random batches of
+ * elements, for very large feature sets.
  */
 
 #include "Common.hpp"
@@ -34,9 +39,14 @@ namespace Bial {
     float m;
     double epsilon;
     size_t max_iterations;
+    /** @brief true to cluster the distinct values of scalar features, weighted by their counts. */
+    bool compression;
 
   public:
 
+    /** @brief Number of elements of each block processed by a thread. */
+    static const size_t BLOCK_SIZE = 4096;
+
     /**
      * @date 2012/Jun/25 
      * @param feats: 3D image feature vector.
@@ -53,23 +63,64 @@ namespace Bial {
 
   private:
 
+    /**
+     * @date 2026/Oct/17
+     * @param vct: A feature vector.
+     * @param res: Returns the fuzzy degree of membership of vct to each centroid.
+     * @return none.
+     * @brief Computes the memberships of vct from the distance power of vct to each centroid. Centroids at null
+     * distance get membership 1, and the other ones get 0.
+     * @warning none.
+     */
+    void ElementMembership( const D *vct, double *res ) const;
+
     /* membership: matrix of fuzzy degree of membership. 
      * @date 2012/Jun/25 
-     * @param none.
+     * @param points: Clustered feature vectors.
+     * @param mbs: Membership matrix of points, updated.
      * @return Maximum membership difference considering each centroid/feature pair between consecutive iterations. 
      * @brief Update the membership matriz. 
      * @warning Both membership matriz and centroid positions must be already inicialized. 
      */
-    double MembershipUpdate( );
+    double MembershipUpdate( const Feature< D > &points, Matrix< double > &mbs );
+
+    /**
+     * @date 2026/Oct/17
+     * @param points: Clustered feature vectors.
+     * @param mbs: Membership matrix of points.
+     * @param weight: Weight of each point, or an empty vector for unit weights.
+     * @param sum: Sums of the weighted feature vectors of each centroid, incremented. Features( ) elements per
+     * centroid.
+     * @param total: Sum of the weights of each centroid, incremented.
+     * @return none.
+     * @brief Accumulates the membership powers of points, with elements reduced in blocks.
+     * @warning none.
+     */
+    void Accumulate( const Feature< D > &points, const Matrix< double > &mbs, const Vector< double > &weight,
+                     Vector< double > &sum, Vector< double > &total ) const;
 
     /* membership: matrix of fuzzy degree of membership. 
      * @date 2012/Jun/25 
-     * @param none.
+     * @param points: Clustered feature vectors.
+     * @param mbs: Membership matrix of points.
+     * @param weight: Weight of each point, or an empty vector for unit weights.
      * @return none. 
      * @brief Update the centroid positions. 
      * @warning Both membership matriz and centroid positions must be already inicialized. 
      */
-    void CentroidUpdate( );
+    void CentroidUpdate( const Feature< D > &points, const Matrix< double > &mbs, const Vector< double > &weight );
+
+    /**
+     * @date 2026/Oct/17
+     * @param points: Clustered feature vectors.
+     * @param mbs: Membership matrix of points.
+     * @param weight: Weight of each point, or an empty vector for unit weights.
+     * @param verbose: verbose mode.
+     * @return none.
+     * @brief Alternates centroid and membership updates until convergence.
+     * @warning none.
+     */
+    void Iterate( const Feature< D > &points, Matrix< double > &mbs, const Vector< double > &weight, bool verbose );
 
   public:
 
@@ -83,6 +134,29 @@ namespace Bial {
      */
     Matrix< double > Run( bool verbose = false );
 
+    /**
+     * @date 2026/Oct/17
+     * @param batch_size: Number of random elements of each batch.
+     * @param verbose: verbose mode.
+     * @return The fuzzy degree of membership.
+     * @brief Computes fuzzy c-means updating the centroids from random batches of elements. Each centroid is the
+     * weighted mean of all batch elements seen so far. Iterations stop when the largest membership change of the
+     * batch elements due to the centroid update is below epsilon. Memberships of all elements are computed at the
+     * end.
+     * @warning Feature sets not larger than batch_size are clustered by Run.
+     */
+    Matrix< double > RunMiniBatch( size_t batch_size, bool verbose = false );
+
+    /**
+     * @date 2026/Oct/17
+     * @param enable: true to cluster the distinct values of scalar features. Default: true.
+     * @return none.
+     * @brief Sets whether Run clusters the distinct values of scalar features, weighted by their counts, when there
+     * are at most half as many distinct values as elements. Results are the same, up to rounding.
+     * @warning none.
+     */
+    void Compression( bool enable );
+
     /**
      * @date 2012/Jun/26 
      * @param none.
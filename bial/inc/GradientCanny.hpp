@@ -38,12 +38,28 @@ namespace Bial {
      * @param lower_threshold: Lower hysteresis threshold. 
      * @param higher_threshold: Higher hysteresis threshold. 
      * @param sigma: Standard deviation of Gaussian filter. 
+     * @param recursive: If true, computes the gradient as RecursiveCanny does.
      * @return Canny edge detection image. 
      * @brief Returns Canny edge detection image. Lower and higher threshold as frequencies from 0.0 to 1.0. 
-     * @warning none. 
+     * @warning With recursive set, sigma must be at least 0.5. 
+     */
+    template< class D >
+    Image< D > Canny( const Image< D > &img, float lower_threshold, float higher_threshold, float sigma,
+                      bool recursive = false );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param lower_threshold: Lower hysteresis threshold.
+     * @param higher_threshold: Higher hysteresis threshold.
+     * @param sigma: Standard deviation of Gaussian derivative filters. Must be at least 0.5.
+     * @return Canny edge detection image.
+     * @brief Returns Canny edge detection image using recursive Gaussian derivatives instead of Gaussian smoothing
+     * followed by Sobel. Lower and higher threshold as frequencies from 0.0 to 1.0.
+     * @warning none.
      */
     template< class D >
-    Image< D > Canny( const Image< D > &img, float lower_threshold, float higher_threshold, float sigma );
+    Image< D > RecursiveCanny( const Image< D > &img, float lower_threshold, float higher_threshold, float sigma );
 
     /**
      * @date 2013/Aug/08 
@@ -55,6 +71,19 @@ namespace Bial {
     template< class D >
     Image< D > NonMaxSobelSuppression( const Image< D > &img );
 
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @param sigma: Standard deviation of the Gaussian derivative filters. Must be at least 0.5.
+     * @return Gradient magnitude image with non-maximum intensities suppressed.
+     * @brief Returns the gradient magnitude image with non-maximum intensities suppressed. The gradient is computed
+     * by recursive Gaussian derivative filters, which smooth and differentiate in a single pass whose cost does not
+     * depend on sigma.
+     * @warning none.
+     */
+    template< class D >
+    Image< D > NonMaxGaussianSuppression( const Image< D > &img, float sigma );
+
     /**
      * @date 2013/Aug/08 
      * @param magnitude: Sobel magnitude image. 
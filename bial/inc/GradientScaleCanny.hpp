@@ -28,13 +28,16 @@ namespace Bial {
      * @param window_scale: Scale by which image is divided to generate the window. 
      * @param lower_threshold: Lower hysteresis threshold. 
      * @param higher_threshold: Higher hysteresis threshold. 
+     * @param sigma: If positive, the gradient is computed by recursive Gaussian derivatives of this standard
+     * deviation, instead of Sobel.
      * @return Scaled Canny edge detection image. 
      * @brief Returns a scaled Canny edge detection image. Lower and higher threshold as frequencies from 0.0 to
      *1.0. 
-     * @warning none. 
+     * @warning A positive sigma must be at least 0.5. 
      */
     template< class D >
-    Image< D > ScaleCanny( const Image< D > &img, size_t window_scale, float lower_threshold, float higher_threshold );
+    Image< D > ScaleCanny( const Image< D > &img, size_t window_scale, float lower_threshold, float higher_threshold,
+                           float sigma = 0.0f );
 
     /**
      * @date 2015/Jan/27 
@@ -42,13 +45,15 @@ namespace Bial {
      * @param base_grad: Gradient from higher levels with greater windows. 
      * @param window_scale: Scale by which image is divided to generate the window. 
      * @param lower_threshold: Lower hysteresis threshold. 
+     * @param sigma: If positive, the gradient is computed by recursive Gaussian derivatives of this standard
+     * deviation, instead of Sobel.
      * @return Sub scaled Canny edge detection image. 
      * @brief Returns a sub scaled Canny edge detection image. Lower threshold as a frequency from 0.0 to 1.0. 
-     * @warning none. 
+     * @warning A positive sigma must be at least 0.5. 
      */
     template< class D >
     Image< D > SubScaleCanny( const Image< D > &img, const Image< D > &base_grad, size_t window_scale, 
-                              float lower_threshold );
+                              float lower_threshold, float sigma = 0.0f );
 
     /**
      * @date 2015/Jan/26 
@@ -57,14 +62,15 @@ namespace Bial {
      * @param higher_threshold: Higher hysteresis threshold. 
      * @param sigma: Standard deviation of Gaussian filter. 
      * @param scales: Number of scales to run Canny. 
+     * @param recursive: If true, Gaussian smoothing followed by Sobel is replaced by recursive Gaussian derivatives.
      * @return Multi scale Canny edge detection image. 
      * @brief Returns multi scale Canny edge detection image. Lower and higher threshold as frequencies from 0.0
      * to 1.0. 
-     * @warning none. 
+     * @warning With recursive set, sigma must be at least 0.5. 
      */
     template< class D >
     Image< D > MultiScaleCanny( const Image< D > &img, float lower_threshold, float higher_threshold, float sigma, 
-                                size_t scales );
+                                size_t scales, bool recursive = false );
 
     /**
      * @date 2015/Jan/27 
@@ -73,14 +79,15 @@ namespace Bial {
      * @param higher_threshold: Higher hysteresis threshold. 
      * @param sigma: Standard deviation of Gaussian filter. 
      * @param scales: Number of scales to run Canny. 
+     * @param recursive: If true, Gaussian smoothing followed by Sobel is replaced by recursive Gaussian derivatives.
      * @return Multi scale Canny edge detection image. 
      * @brief Returns multi scale Canny edge detection image. Lower and higher threshold as frequencies from 0.0
      * to 1.0. 
-     * @warning none. 
+     * @warning With recursive set, sigma must be at least 0.5. 
      */
     template< class D >
     Image< D > MultiSubScaleCanny( const Image< D > &img, float lower_threshold, float higher_threshold, float sigma,
-                                   size_t scales );
+                                   size_t scales, bool recursive = false );
 
     /**
      * @date 2015/Jun/02 
@@ -90,14 +97,16 @@ namespace Bial {
      * @param sigma: Standard deviation of Gaussian filter. 
      * @param scales: Number of scales to run Canny. 
      * @param fraction: Fraction of the maximum size edge that specifies the minimum edge size. (0.0, 1.0) 
+     * @param recursive: If true, Gaussian smoothing followed by Sobel is replaced by recursive Gaussian derivatives.
      * @return Multi scale Canny edge detection image. 
      * @brief Returns multi scale Canny edge detection image. Lower and higher threshold as frequencies from 0.0
      * to 1.0. 
-     * @warning none. 
+     * @warning With recursive set, sigma must be at least 0.5. 
      */
     template< class D >
     Image< D > MultiScaleSizeCanny( const Image< D > &img, float lower_threshold, float higher_threshold, 
-                                    float sigma, size_t scales, float fraction );
+                                    float sigma, size_t scales, float fraction,
+                                    bool recursive = false );
 
   }
 
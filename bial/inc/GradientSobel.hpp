@@ -15,6 +15,8 @@ namespace Bial {
 
   template< class D >
   class Image;
+  template< class D >
+  class Vector;
   /**
    * @brief Computes image gradients.
    */
@@ -47,6 +49,20 @@ namespace Bial {
     template< class D >
     void Sobel( const Image< D > &img, Image< D > *magnitude = nullptr, Image< int > *direction = nullptr );
 
+    /**
+     * @date 2026/Oct/17
+     * @param partial: Partial derivative images, one for each image dimension.
+     * @param magnitude: Output gradient magnitude image.
+     * @param direction: Output gradient direction image, with the same codes of Sobel.
+     * @return none.
+     * @brief Computes gradient magnitude and coded direction from the partial derivatives of an image, so that
+     * gradients computed by other filters can be given to NonMaxSobelSuppression.
+     * @warning none.
+     */
+    template< class D >
+    void MagnitudeAndDirection( const Vector< Image< D > > &partial, Image< D > *magnitude = nullptr,
+                                Image< int > *direction = nullptr );
+
   };
 
 }
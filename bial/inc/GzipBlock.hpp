@@ -0,0 +1,218 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Block-parallel gzip compression and indexed random access to the compressed files.
+ * <br> Description: GzipBlockWriter splits the data in blocks of BLOCK bytes and compresses each one as an
+ * independent gzip member, in parallel, as pigz does. Concatenated members form a valid gzip file, read by any gzip
+ * tool. Each member has an extra header field ("BI") with its compressed size, so that GzipBlockReader builds an index
+ * of the members by reading only their headers and trailers. Seeking then inflates only the member that contains the
+ * target position, and long reads inflate whole members in parallel, straight into the destination.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALGZIPBLOCK_H
+#define BIALGZIPBLOCK_H
+
+#include "MappedFile.hpp"
+#include <cstdio>
+#include <vector>
+#include <zlib.h>
+
+namespace Bial {
+
+  class GzipBlockWriter {
+
+  private:
+
+    /** @brief Compressed file. */
+    std::FILE *file;
+    /** @brief Compression level, from 0 to 9. */
+    int level;
+    /** @brief Data waiting to be compressed. Holds a batch of blocks, compressed in parallel. */
+    std::vector< char > input;
+    /** @brief Number of bytes in input. */
+    size_t filled;
+    /** @brief Number of uncompressed bytes written to file. */
+    size_t written;
+    /** @brief Number of members written to file. */
+    size_t members;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Compresses input, one member per block, in parallel, and writes the members in order.
+     * @warning Throws ios_base::failure if writing fails.
+     */
+    void Flush( );
+
+  public:
+
+    /** @brief Number of uncompressed bytes of each member. */
+    static const size_t BLOCK = 1048576;
+    /** @brief Number of bytes of the member header written by CompressMember. */
+    static const size_t HEADER = 20;
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Compressed file to be written.
+     * @param level: Compression level, from 0 to 9, or Z_DEFAULT_COMPRESSION.
+     * @return none.
+     * @brief Basic Constructor. Creates the file.
+     * @warning Throws ios_base::failure if the file cannot be created.
+     */
+    GzipBlockWriter( const std::string &filename, int level = Z_DEFAULT_COMPRESSION );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Destructor. Closes the file, if still open. Errors are ignored. Call Close to check them.
+     * @warning none.
+     */
+    ~GzipBlockWriter( );
+
+    GzipBlockWriter( const GzipBlockWriter & ) = delete;
+    GzipBlockWriter &operator=( const GzipBlockWriter & ) = delete;
+
+    /**
+     * @date 2026/Oct/17
+     * @param data: Data to be compressed.
+     * @param bytes: Number of bytes of data.
+     * @return none.
+     * @brief Appends data to the file. Data is compressed whenever a batch of blocks is complete.
+     * @warning Throws ios_base::failure if writing fails.
+     */
+    void Write( const char *data, size_t bytes );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of uncompressed bytes given to Write.
+     * @brief Returns the uncompressed position of the file.
+     * @warning none.
+     */
+    size_t Tell( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Compresses the remaining data and closes the file. Files with no data get one empty member, so that
+     * they are valid gzip files.
+     * @warning Throws ios_base::failure if writing fails.
+     */
+    void Close( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Data to be compressed.
+     * @param bytes: Number of bytes of src.
+     * @param level: Compression level.
+     * @param dst: Returns the gzip member, with its header, compressed data and trailer.
+     * @return none.
+     * @brief Compresses src into an independent gzip member with the "BI" extra field.
+     * @warning none.
+     */
+    static void CompressMember( const char *src, size_t bytes, int level, std::vector< unsigned char > &dst );
+
+  };
+
+  class GzipBlockReader {
+
+  private:
+
+    /** @brief Mapping of the compressed file. */
+    MappedFile mapping;
+    /** @brief Compressed offset of each member, and the file size at the end. */
+    std::vector< size_t > member_offset;
+    /** @brief Uncompressed offset of each member, and the uncompressed size at the end. */
+    std::vector< size_t > data_offset;
+    /** @brief Last member inflated for a partial read. */
+    std::vector< char > cache;
+    /** @brief Index of the member in cache, or member_offset.size( ) if none. */
+    size_t cached;
+    /** @brief Uncompressed position of the next read. */
+    size_t position;
+
+    /**
+     * @date 2026/Oct/17
+     * @param member: Index of the member.
+     * @param dst: Destination, with room for the whole uncompressed member.
+     * @return none.
+     * @brief Inflates one member and checks its CRC.
+     * @warning Throws ios_base::failure if the member is corrupted.
+     */
+    void Inflate( size_t member, char *dst ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param hdr: First bytes of a gzip member.
+     * @param available: Number of bytes of hdr.
+     * @param header_size: Returns the size of the member header.
+     * @return Compressed size of the member, given by its "BI" extra field, or 0 if it has none.
+     * @brief Parses the header of a member written by GzipBlockWriter.
+     * @warning none.
+     */
+    static size_t MemberSize( const unsigned char *hdr, size_t available, size_t &header_size );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Compressed file written by GzipBlockWriter.
+     * @return none.
+     * @brief Basic Constructor. Maps the file and builds the index of its members.
+     * @warning Throws ios_base::failure if the file cannot be mapped or if any member has no "BI" extra field.
+     */
+    GzipBlockReader( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Compressed file.
+     * @return true if the first member of filename has the "BI" extra field.
+     * @brief Checks whether filename was written by GzipBlockWriter, by reading its first bytes.
+     * @warning none.
+     */
+    static bool IsIndexed( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param dst: Destination.
+     * @param bytes: Number of bytes to be read.
+     * @return Number of bytes read. Less than bytes at the end of the data.
+     * @brief Reads from the current position. Whole members are inflated in parallel, straight into dst.
+     * @warning Throws ios_base::failure if a member is corrupted.
+     */
+    size_t Read( char *dst, size_t bytes );
+
+    /**
+     * @date 2026/Oct/17
+     * @param pos: Uncompressed position.
+     * @return none.
+     * @brief Sets the position of the next read. Nothing is inflated until then.
+     * @warning Positions beyond the end make the next read return 0.
+     */
+    void Seek( size_t pos );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Uncompressed position of the next read, and total uncompressed size.
+     * @brief Returns the position and size of the uncompressed data.
+     * @warning none.
+     */
+    size_t Tell( ) const;
+    size_t Size( ) const;
+
+  };
+
+}
+
+#include "GzipBlock.cpp"
+
+#endif
@@ -84,11 +84,13 @@ namespace Bial {
     /**
      * @date 2013/Jun/21
      * @param spc_dim: Vector with image dimensions.
+     * @param init: Initialization of the elements. StorageInit::None skips zeroing, for images that are overwritten
+     * right away.
      * @return none.
      * @brief Basic Constructor. Two to three dimensions.
-     * @warning Zero is assigned to all elements. Pixel dimensions are set to 1.0.
+     * @warning Zero is assigned to all elements, unless init is StorageInit::None. Pixel dimensions are set to 1.0.
      */
-    Image( const Vector< size_t > &spc_dim );
+    Image( const Vector< size_t > &spc_dim, StorageInit init = StorageInit::Zero );
 
     /**
      * @date 2015/Set/10
@@ -347,7 +349,7 @@ namespace Bial {
      * @brief Returns iterator begin() of data.
      * @warning none.
      */
-    typename std::vector< D >::iterator begin( ) noexcept;
+    typename Vector< D >::iterator begin( ) noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -356,7 +358,7 @@ namespace Bial {
      * @brief Returns const_iterator begin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator begin( ) const noexcept;
+    typename Vector< D >::const_iterator begin( ) const noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -365,7 +367,7 @@ namespace Bial {
      * @brief Returns iterator end() of data.
      * @warning none.
      */
-    typename std::vector< D >::iterator end( ) noexcept;
+    typename Vector< D >::iterator end( ) noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -374,7 +376,7 @@ namespace Bial {
      * @brief Returns const_iterator end() of data.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator end( ) const noexcept;
+    typename Vector< D >::const_iterator end( ) const noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -383,7 +385,7 @@ namespace Bial {
      * @brief Returns the iterator rbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::reverse_iterator rbegin( ) noexcept;
+    typename Vector< D >::reverse_iterator rbegin( ) noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -392,7 +394,7 @@ namespace Bial {
      * @brief Returns const_iterator rbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator rbegin( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator rbegin( ) const noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -401,7 +403,7 @@ namespace Bial {
      * @brief Returns iterator rend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::reverse_iterator rend( ) noexcept;
+    typename Vector< D >::reverse_iterator rend( ) noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -410,7 +412,7 @@ namespace Bial {
      * @brief Returns const_iterator rend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator rend( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator rend( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -419,7 +421,7 @@ namespace Bial {
      * @brief Returns the iterator cbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator cbegin( ) const noexcept;
+    typename Vector< D >::const_iterator cbegin( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -428,7 +430,7 @@ namespace Bial {
      * @brief Returns the iterator cend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator cend( ) const noexcept;
+    typename Vector< D >::const_iterator cend( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -437,7 +439,7 @@ namespace Bial {
      * @brief Returns the iterator crbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator crbegin( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator crbegin( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -446,7 +448,7 @@ namespace Bial {
      * @brief Returns the iterator crend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator crend( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator crend( ) const noexcept;
 
     /**
      * @date 2014/Apr/10
@@ -16,6 +16,7 @@
 namespace Bial {
 
   template< class D > class Image;
+  template< class D > class ChunkedImage;
 
   namespace ImageOp {
 
@@ -43,6 +44,19 @@ namespace Bial {
     template< class D >
     Image< D > RemoveFrame( const Image< D > &img, size_t width );
 
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input chunked volume.
+     * @param low_coord: Lower coordinates of the frame.
+     * @param hgh_coord: Higher coordinates of the frame.
+     * @return Image without the frame.
+     * @brief Loads only the chunks inside the frame and returns the image without it.
+     * @warning Throws out_of_range if the coordinates exceed the image, instead of clipping them.
+     */
+    template< class D >
+    Image< D > RemoveFrame( const ChunkedImage< D > &img, const Vector< size_t > &low_coord,
+                            const Vector< size_t > &hgh_coord );
+
     /**
      * @date 2014/Jan/07
      * @param img: Input image.
@@ -16,6 +16,7 @@
 namespace Bial {
 
   template< class D > class Image;
+  template< class D > class ChunkedImage;
 
   namespace ImageOp {
 
@@ -30,6 +31,17 @@ namespace Bial {
     template< class D >
     std::tuple< Vector< size_t >, Vector< size_t > > ROI( const Image< D > &img );
 
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input chunked volume.
+     * @return Lower and higher coordinates of the region of interest (ROI).
+     * @brief Computes the ROI of a chunked volume, loading one row of chunks at a time, so that memory is bounded
+     * by the row and the chunk cache.
+     * @warning none.
+     */
+    template< class D >
+    std::tuple< Vector< size_t >, Vector< size_t > > ROI( const ChunkedImage< D > &img );
+
   }
 
 }
@@ -16,6 +16,7 @@
 namespace Bial {
 
   template< class D > class Image;
+  template< class D > class ChunkedImage;
 
   namespace ImageOp {
 
@@ -30,6 +31,17 @@ namespace Bial {
     template< class D >
     Vector< Image< D > > Split( const Image< D > &img, size_t dimension );
 
+    /**
+     * @date 2026/Oct/17
+     * @param img: A 3D input chunked volume.
+     * @param dimension: Dimension of the image to be split in vectors.
+     * @return An image vector with split images.
+     * @brief Loads each slice from the chunks that contain it. Consecutive slices reuse the cached chunks.
+     * @warning All slices are kept in memory. Use ChunkedImage::Slice to process them one at a time.
+     */
+    template< class D >
+    Vector< Image< D > > Split( const ChunkedImage< D > &img, size_t dimension );
+
   }
 
 }
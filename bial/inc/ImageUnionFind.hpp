@@ -0,0 +1,122 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Connected component labeling of images with union-find, with the image domain split in blocks processed by
+ * the thread pool.
+ * <br> Description: Every non-zero pixel belongs to the object. Each block of consecutive pixels joins the object
+ * pixels adjacent to each other inside it, concurrently, in its own disjoint-set forest. Then, the arcs crossing
+ * block seams join the forests of neighboring blocks. A final raster scan compresses the paths to the roots, assigns
+ * sequential labels from 1 in the order of the first pixel of each component, and counts the component sizes.
+ * <br> Adjacency arcs are taken as undirected edges. Background pixels have label 0.
+ */
+
+#include "Adjacency.hpp"
+#include "Common.hpp"
+#include "Image.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALIMAGEUNIONFIND_H
+#define BIALIMAGEUNIONFIND_H
+
+namespace Bial {
+
+  class AdjacencyOffset;
+
+  template< class D >
+  class ImageUnionFind {
+
+  protected:
+
+    /** @brief Union-find attributes. */
+    const Image< D > &input;
+    const Adjacency &adjacency;
+    /** @brief Parent of each pixel in the disjoint-set forest. Roots are the first pixel of their set. */
+    Vector< size_t > parent;
+    /** @brief First pixel of each block, and the image size as the last element. */
+    Vector< size_t > bound;
+    /** @brief Resulting label map. */
+    Image< int > label;
+    /** @brief Number of pixels of each label, including the background at label 0. */
+    Vector< size_t > size;
+
+    /**
+     * @date 2026/Oct/17
+     * @param pxl: A pixel.
+     * @return Root of the set of pxl.
+     * @brief Finds the root of the set of pxl, halving the path along the way.
+     * @warning Only the parents of pixels in the path are written.
+     */
+    size_t Find( size_t pxl );
+
+    /**
+     * @date 2026/Oct/17
+     * @param pxl: A pixel.
+     * @param adj_pxl: Another pixel.
+     * @return none.
+     * @brief Joins the sets of pxl and adj_pxl. The root with the smallest index becomes the root of both.
+     * @warning none.
+     */
+    void Union( size_t pxl, size_t adj_pxl );
+
+    /**
+     * @date 2026/Oct/17
+     * @param offsets: Adjacency offsets over the image.
+     * @param blk: Block of the range.
+     * @param first: First pixel of the range.
+     * @param last: One past the last pixel of the range.
+     * @param seam: true to join only with adjacent pixels out of blk, and false to join only with pixels in blk.
+     * @return none.
+     * @brief Joins each object pixel in [ first, last ) with its adjacent object pixels.
+     * @warning none.
+     */
+    void Join( const AdjacencyOffset &offsets, size_t blk, size_t first, size_t last, bool seam );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param input: Input image. Non-zero pixels belong to the object.
+     * @param adjacency: adjacency relation defining connectedness.
+     * @return none.
+     * @brief Basic Constructor.
+     * @warning input and adjacency are referenced, not copied. They must have compatible dimensions.
+     */
+    ImageUnionFind( const Image< D > &input, const Adjacency &adjacency );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Labels the connected components and counts their sizes.
+     * @warning none.
+     */
+    void Run( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Reference to the label map.
+     * @brief Label map computed by Run. Components are labeled from 1. Background pixels have label 0.
+     * @warning none.
+     */
+    const Image< int > &Label( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Reference to the number of pixels of each label.
+     * @brief Component sizes computed by Run. Element 0 holds the number of background pixels.
+     * @warning none.
+     */
+    const Vector< size_t > &Size( ) const;
+
+  };
+
+}
+
+#include "ImageUnionFind.cpp"
+
+#endif
@@ -0,0 +1,252 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief
+ * Content: Bucket-sort queue with 64-bit element identifiers and integer weights.
+ * <br> Description: Same interface and ordering as BucketQueue, for integral path costs and data sets with more than
+ * 2^31 elements. Element links are 64-bit integers, element states are kept in a separate 1-byte array, and the
+ * number of buckets is a power of two, so that the bucket of a weight is computed with integer division and a
+ * bit mask. No member function is virtual. It is meant to be the queue argument of StaticImageIFT.
+ * <br> Usage:
+ * @code
+ *   StaticImageIFT< llint, MaxPathFunction< Image, llint >, IntegerBucketQueue, llint >
+ *     ift( value, adj, &pf, &seeds, &label );
+ * @endcode
+ */
+
+#ifndef BIALINTEGERBUCKETQUEUE_H
+#define BIALINTEGERBUCKETQUEUE_H
+
+#include "BucketQueueElements.hpp"
+#include "Common.hpp"
+#include "Vector.hpp"
+
+namespace Bial {
+
+  /** @brief Bucket queue of integer weights with 64-bit element identifiers. */
+  class IntegerBucketQueue {
+
+  protected:
+    Vector< llint > next; /** @brief Next element in the bucket of each element, or -1. */
+    Vector< llint > prev; /** @brief Previous element in the bucket of each element, or -1. */
+    Vector< BucketState > state; /** @brief State of each element. */
+    Vector< llint > first; /** @brief First element of each bucket, or -1. */
+    Vector< llint > last; /** @brief Last element of each bucket, or -1. */
+    size_t mask; /** @brief Number of buckets minus one. Number of buckets is a power of two. */
+    llint minimum; /** @brief Lowest bucket number that may be non-empty. */
+    llint maximum; /** @brief Highest bucket number that may be non-empty. */
+    llint delta; /** @brief step between two consecutive buckets. */
+    size_t elements; /** @brief Number of elements currently in the queue. */
+    bool increasing; /** @brief Whether this queue removes elements increasingly or decreasingly. */
+    bool fifo; /** @brief Whether this queue implements FIFO or LIFO tie-break policy. */
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param size: Total number of elements to be inserted in the queue.
+     * @param bucket_size: the size of the bucket. Rounded to the nearest integer, at least 1.
+     * @param increasing_order: increasing or decreasing order of bucket queue output.
+     * @param fifo_tie: fifo or lifo tiebreak.
+     * @return none.
+     * @brief Basic Constructor. Same arguments as BucketQueue.
+     * @warning none.
+     */
+    IntegerBucketQueue( size_t size, ldbl bucket_size = 1.0, bool increasing_order = true, bool fifo_tie = true );
+
+  protected:
+
+    /**
+     * @date 2026/Oct/17
+     * @param wgt: weight.
+     * @return The bucket number of wgt, i.e. floor( wgt / delta ).
+     * @brief Computes the bucket number of a weight.
+     * @warning none.
+     */
+    llint Bucket( llint wgt ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param bucket: bucket number.
+     * @return The position of the bucket in the circular bucket arrays.
+     * @brief Computes the position of the bucket in the circular bucket arrays.
+     * @warning none.
+     */
+    size_t Index( llint bucket ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param new_size: new number of buckets. A power of two.
+     * @return none.
+     * @brief Changes the number of buckets, keeping the current elements.
+     * @warning none.
+     */
+    void Grow( size_t new_size );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param idt: element identifier.
+     * @param wgt: weight.
+     * @return none.
+     * @brief Inserts element idt with weight wgt.
+     * @warning Element must not be in the queue.
+     */
+    void Insert( size_t idt, llint wgt );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Identifier of the removed element.
+     * @brief Removes the element with minimum (maximum if decreasing) weight, according to the tie-break policy.
+     * @warning Queue must not be empty.
+     */
+    size_t Remove( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param idt: element identifier.
+     * @param wgt: current weight of idt.
+     * @return none.
+     * @brief Removes element idt from the queue.
+     * @warning Element must be in the queue with weight wgt.
+     */
+    void Remove( size_t idt, llint wgt );
+
+    /**
+     * @date 2026/Oct/17
+     * @param idt: element identifier.
+     * @param cur_wgt: current weight of idt, if it is in the queue.
+     * @param new_wgt: new weight of idt.
+     * @return none.
+     * @brief Moves idt to the bucket of new_wgt, inserting it if it is not in the queue. State becomes UPDATED.
+     * @warning none.
+     */
+    void Update( size_t idt, llint cur_wgt, llint new_wgt );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if the queue is empty.
+     * @brief Verifies if the queue is empty.
+     * @warning none.
+     */
+    bool Empty( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of elements in the queue.
+     * @brief Returns the number of elements in the queue.
+     * @warning none.
+     */
+    size_t Elements( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if elements are removed in increasing order.
+     * @brief Returns the removal order.
+     * @warning none.
+     */
+    bool Increasing( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param idt: element identifier.
+     * @return State of idt.
+     * @brief Returns the state of an element.
+     * @warning none.
+     */
+    BucketState State( size_t idt ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param idt: element identifier.
+     * @param new_state: new state.
+     * @return none.
+     * @brief Sets the state of an element.
+     * @warning none.
+     */
+    void State( size_t idt, BucketState new_state );
+
+    /**
+     * @date 2026/Oct/17
+     * @param idt: element identifier.
+     * @return none.
+     * @brief Sets the state of an element to REMOVED.
+     * @warning none.
+     */
+    void Finished( size_t idt );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return The current number of buckets.
+     * @brief Returns the current number of buckets.
+     * @warning none.
+     */
+    size_t Buckets( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Sets all element states to NOT_VISITED.
+     * @warning none.
+     */
+    void ResetState( );
+
+  };
+
+  /* Inline member functions used in inner loops. ---------------------------------------------------------------------- */
+
+  inline llint IntegerBucketQueue::Bucket( llint wgt ) const {
+    if( delta == 1 ) {
+      return( wgt );
+    }
+    llint bucket = wgt / delta;
+    return( ( ( wgt % delta ) < 0 ) ? bucket - 1 : bucket );
+  }
+
+  inline size_t IntegerBucketQueue::Index( llint bucket ) const {
+    return( static_cast< size_t >( bucket ) & mask );
+  }
+
+  inline bool IntegerBucketQueue::Empty( ) const {
+    return( elements == 0 );
+  }
+
+  inline size_t IntegerBucketQueue::Elements( ) const {
+    return( elements );
+  }
+
+  inline bool IntegerBucketQueue::Increasing( ) const {
+    return( increasing );
+  }
+
+  inline BucketState IntegerBucketQueue::State( size_t idt ) const {
+    return( state[ idt ] );
+  }
+
+  inline void IntegerBucketQueue::State( size_t idt, BucketState new_state ) {
+    state[ idt ] = new_state;
+  }
+
+  inline void IntegerBucketQueue::Finished( size_t idt ) {
+    state[ idt ] = BucketState::REMOVED;
+  }
+
+  inline size_t IntegerBucketQueue::Buckets( ) const {
+    return( mask + 1 );
+  }
+
+}
+
+#include "IntegerBucketQueue.cpp"
+
+#endif
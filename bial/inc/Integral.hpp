@@ -27,12 +27,24 @@ namespace Bial {
      * @date 2013/Aug/27 
      * @param img: An image. 
      * @return Integral image based on img. 
-     * @brief Returns the integral image based on img. 
+     * @brief Returns the integral image based on img. Computed by cumulative sums along each dimension, with the
+     * lines of each dimension processed by the thread pool.
      * @warning none. 
      */
     template< class D >
     static Image< double > IntegralImage( const Image< D > &img );
 
+    /**
+     * @date 2026/Oct/17
+     * @param integral: An integral image.
+     * @param radius: Window radius in pixels in each dimension.
+     * @return Sum of the window of side 2 * radius + 1 centered at each pixel.
+     * @brief Returns the sum of the window centered at each pixel, clipped to the image domain. Each sum takes a
+     * fixed number of integral image accesses, regardless of the radius. Slices are processed by the thread pool.
+     * @warning Only 2D and 3D images are supported.
+     */
+    static Image< double > WindowSums( const Image< double > &integral, const Vector< size_t > &radius );
+
     /**
      * @date 2013/Aug/29 
      * @param integral: An integral image. 
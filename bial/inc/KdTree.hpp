@@ -0,0 +1,116 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Kd-tree for exact k-nearest neighbor search among feature vectors.
+ * <br> Description: Nodes split the elements at the median of the feature with the largest spread, down to leaves
+ * of at most leaf_size elements. Each node keeps the bounding box of its elements. The leaves keep a copy of their
+ * feature vectors, stored contiguously, so that the distances to a leaf are computed in one DistanceKernel batch.
+ * A search visits the nearest child first and skips the nodes whose bounding box is farther than the current k-th
+ * neighbor.
+ * <br> Neighbors are ordered by distance and then by element index, so that the result is the same of the exhaustive
+ * search with the same kernel.
+ */
+
+#include "Common.hpp"
+#include "DistanceKernel.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALKDTREE_H
+#define BIALKDTREE_H
+
+namespace Bial {
+
+  template< class D >
+  class Feature;
+
+  template< class D >
+  class KdTree {
+
+  protected:
+
+    /** @brief Distance kernel. */
+    DistanceKernel kernel;
+    /** @brief Number of features. */
+    size_t features;
+    /** @brief Maximum number of elements in a leaf. */
+    size_t leaf_size;
+    /** @brief Element indexes, ordered so that each node holds a contiguous range. */
+    Vector< size_t > order;
+    /** @brief Feature vectors in the same order of order. */
+    Vector< D > point;
+    /** @brief Position in order of each element. */
+    Vector< size_t > position;
+    /** @brief Range of order of each node, and its children. Leaves have no children, given as 0. */
+    Vector< size_t > node_first;
+    Vector< size_t > node_last;
+    Vector< size_t > node_left;
+    Vector< size_t > node_right;
+    /** @brief Bounding box of each node, with features elements per node. */
+    Vector< double > node_lower;
+    Vector< double > node_upper;
+
+    /**
+     * @date 2026/Oct/17
+     * @param data: Feature vectors, in the order of the elements.
+     * @param first: First position of the range.
+     * @param last: One past the last position of the range.
+     * @return Index of the new node.
+     * @brief Creates the node of range [ first, last ) of order, and its descendants.
+     * @warning none.
+     */
+    size_t Build( const D *data, size_t first, size_t last );
+
+    /**
+     * @date 2026/Oct/17
+     * @param query: Query feature vector.
+     * @param node: A node.
+     * @return Lower bound of the distance from query to the elements of node.
+     * @brief Returns the distance from query to the bounding box of node.
+     * @warning none.
+     */
+    double Bound( const D *query, size_t node ) const;
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param feature: Feature vectors.
+     * @param kernel: Distance kernel.
+     * @param leaf_size: Maximum number of elements in a leaf.
+     * @return none.
+     * @brief Basic Constructor. Builds the tree.
+     * @warning The distance function of the kernel must be supported. See Supports.
+     */
+    KdTree( const Feature< D > &feature, const DistanceKernel &kernel = DistanceKernel( ), size_t leaf_size = 16 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param type: Distance function.
+     * @return true if the distance to a bounding box is a lower bound of type.
+     * @brief Returns true for Euclidean, square Euclidean, city-block and chessboard distances.
+     * @warning none.
+     */
+    static bool Supports( DistanceFunctionType type );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Query element.
+     * @param k: Number of neighbors.
+     * @param index: Returns the neighbor indexes. Must hold k elements.
+     * @param distance: Returns the neighbor distances. Must hold k elements.
+     * @return Number of neighbors found, that is, the minimum of k and the number of elements but src.
+     * @brief Finds the k nearest elements to src, except itself, in increasing order of distance and index.
+     * @warning none.
+     */
+    size_t Neighbors( size_t src, size_t k, size_t *index, double *distance ) const;
+
+  };
+
+}
+
+#include "KdTree.cpp"
+
+#endif
@@ -13,6 +13,7 @@
 #ifndef BIALKNNGRAPHADJACENCY_H
 #define BIALKNNGRAPHADJACENCY_H
 
+#include "DistanceKernel.hpp"
 #include "Matrix.hpp"
 #include "GraphAdjacency.hpp"
 
@@ -22,6 +23,19 @@ namespace Bial {
   class Feature;
   class Sample;
 
+  /**
+   * @brief Search of the nearest neighbors of each sample. Exhaustive computes the distances to all samples. KdTree
+   * gives the same arcs, searching a kd-tree, for Euclidean, square Euclidean, city-block and chessboard distances.
+   * NNDescent is approximate, for high-dimensional features. Automatic uses the kd-tree for low-dimensional features
+   * with enough samples, and the exhaustive search otherwise.
+   */
+  enum class KnnSearchType : char {
+    Automatic,
+    Exhaustive,
+    KdTree,
+    NNDescent
+  };
+
   class KnnGraphAdjacency : public GraphAdjacency< KnnGraphAdjacency > {
 
   private:
@@ -37,18 +51,27 @@ namespace Bial {
   public:
 
     static const size_t MAX_SAMPLES;
+    /** @brief Largest number of features and smallest number of samples of the automatic kd-tree search. */
+    static const size_t KDTREE_MAX_FEATURES;
+    static const size_t KDTREE_MIN_SAMPLES;
 
     /**
      * @date 2012/Oct/09 
      * @param feature: feature vector containing only the subsamples. 
      * @param sample: sample vector. 
      * @param scl_min, scl_max: minimum and maximum scale fractions utilized for clustering. (0.0 - 1.0) 
+     * @param kernel: Distance kernel. The default uses the current distance function of DFIDE.
+     * @param search: Search of the nearest neighbors.
      * @return none. 
-     * @brief Initializes the object. 
-     * @warning none. 
+     * @brief Initializes the object. Samples are processed by the thread pool. The exhaustive search computes the
+     * distances from each sample to all samples in one batch.
+     * @warning Only the exhaustive search supports the pre-computed Euclidean distance. Other searches fall back to
+     * it. 
      */
     template< class D >
-    void Initialize( const Feature< D > &feature, const Sample &sample, float scl_min, float scl_max );
+    void Initialize( const Feature< D > &feature, const Sample &sample, float scl_min, float scl_max,
+                     const DistanceKernel &kernel = DistanceKernel( ),
+                     KnnSearchType search = KnnSearchType::Automatic );
 
     /**
      * @date 2014/Nov/14 
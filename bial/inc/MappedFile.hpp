@@ -0,0 +1,119 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Read-only memory mapping of a whole file.
+ * <br> Description: The file is mapped privately, so that its pages are loaded on first access and shared with the
+ * page cache. Writes to the mapping, such as in-place byte swapping, create private copies of the pages written, and
+ * never reach the file. Systems without mmap read the whole file to memory instead.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALMAPPEDFILE_H
+#define BIALMAPPEDFILE_H
+
+#include <vector>
+
+namespace Bial {
+
+  class MappedFile {
+
+  private:
+
+    /** @brief First byte of the mapping. */
+    char *data;
+    /** @brief Number of bytes of the file. */
+    size_t bytes;
+    /** @brief Whether data was read to memory instead of mapped. */
+    bool copied;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Unmaps the file and resets the object to the empty state.
+     * @warning none.
+     */
+    void Close( ) noexcept;
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: File to be mapped.
+     * @return none.
+     * @brief Basic Constructor. Maps the whole file.
+     * @warning Throws ios_base::failure if the file cannot be opened or mapped. Compressed files are mapped as they
+     * are, without decompression.
+     */
+    MappedFile( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param buffer: Bytes already read to memory, such as those of a decompressed file.
+     * @return none.
+     * @brief Holds a copy of buffer, for files that cannot be mapped.
+     * @warning none.
+     */
+    explicit MappedFile( const std::vector< char > &buffer );
+
+    /**
+     * @date 2026/Oct/17
+     * @param other: Mapping to be moved. It is left empty.
+     * @return none.
+     * @brief Move constructor and assignment. Mappings are not copyable.
+     * @warning none.
+     */
+    MappedFile( MappedFile &&other ) noexcept;
+    MappedFile &operator=( MappedFile &&other ) noexcept;
+    MappedFile( const MappedFile & ) = delete;
+    MappedFile &operator=( const MappedFile & ) = delete;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Destructor. Unmaps the file. Pointers to the mapping become invalid.
+     * @warning none.
+     */
+    ~MappedFile( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Pointer to the first byte of the file.
+     * @brief Returns the mapped bytes. Writes are private to this mapping.
+     * @warning none.
+     */
+    char *Data( );
+    const char *Data( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of bytes of the file.
+     * @brief Returns the number of mapped bytes.
+     * @warning none.
+     */
+    size_t Size( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param offset: First byte of the range.
+     * @param length: Number of bytes of the range.
+     * @return none.
+     * @brief Advises the system that the range will be read sequentially soon, so that it is read ahead.
+     * @warning Only a hint. Does nothing on systems without madvise.
+     */
+    void WillNeed( size_t offset, size_t length ) const;
+
+  };
+
+}
+
+#include "MappedFile.cpp"
+
+#endif
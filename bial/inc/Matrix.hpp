@@ -55,6 +55,18 @@ namespace Bial {
     /** @brief  accumulated size of matrix dimensions. */
     Vector< size_t > acc_dim_size;
 
+    /**
+     * @date 2026/Oct/17
+     * @param other: right matrix.
+     * @param res: Zeroed product of 'this' and other.
+     * @return none.
+     * @brief Accumulates the product of 'this' and other into res. Matrices of different data types use the plain
+     * triple loop. Matrices of the same data type use the tiled kernels of MatrixMultiply.
+     * @warning Dimensions must have been checked by operator*.
+     */
+    template< class D2 >
+    void Product( const Matrix< D2 > &other, Matrix< D > &res ) const;
+    void Product( const Matrix< D > &other, Matrix< D > &res ) const;
 
   public:
 
@@ -70,11 +82,12 @@ namespace Bial {
     /**
      * @date 2012/Jun/21
      * @param size: Vector with matrix dimensions.
+     * @param init: Initialization of the elements. StorageInit::None skips zeroing.
      * @return none.
      * @brief Basic Constructor.
-     * @warning Uninitialized element values.
+     * @warning With StorageInit::None, element values are undefined.
      */
-    Matrix( const Vector< size_t > &size );
+    Matrix( const Vector< size_t > &size, StorageInit init = StorageInit::Zero );
 
     /**
      * @date 2015/Set/10
@@ -266,7 +279,8 @@ namespace Bial {
      * @date 2012/Jun/21
      * @param other: second other.
      * @return Product of matrices 'this' and other.
-     * @brief Computes the product of the matrices 'this' and other and returns the resultant matrix.
+     * @brief Computes the product of the matrices 'this' and other and returns the resultant matrix. Matrices of the
+     * same data type use the tiled kernels of MatrixMultiply.
      * @warning 'this' matrix must have the same dimensions of other matrix.
      */
     template< class D2 >
@@ -569,7 +583,7 @@ namespace Bial {
      * @brief Returns iterator begin() of data.
      * @warning none.
      */
-    typename std::vector< D >::iterator begin( ) noexcept;
+    typename Vector< D >::iterator begin( ) noexcept;
 
     /**
      * @date 2012/Jun/29
@@ -578,7 +592,7 @@ namespace Bial {
      * @brief Returns const_iterator begin() of data.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator begin( ) const noexcept;
+    typename Vector< D >::const_iterator begin( ) const noexcept;
 
     /**
      * @date 2012/Jun/29
@@ -587,7 +601,7 @@ namespace Bial {
      * @brief Returns iterator end() of data.
      * @warning none.
      */
-    typename std::vector< D >::iterator end( ) noexcept;
+    typename Vector< D >::iterator end( ) noexcept;
 
     /**
      * @date 2012/Jun/29
@@ -596,7 +610,7 @@ namespace Bial {
      * @brief Returns const_iterator end() of data.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator end( ) const noexcept;
+    typename Vector< D >::const_iterator end( ) const noexcept;
 
     /**
      * @date 2013/Aug/09
@@ -605,7 +619,7 @@ namespace Bial {
      * @brief Returns the reverse_iterator rbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::reverse_iterator rbegin( ) noexcept;
+    typename Vector< D >::reverse_iterator rbegin( ) noexcept;
 
     /**
      * @date 2013/Aug/09
@@ -614,7 +628,7 @@ namespace Bial {
      * @brief Returns const_reverse_iterator rbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator rbegin( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator rbegin( ) const noexcept;
 
     /**
      * @date 2013/Aug/09
@@ -623,7 +637,7 @@ namespace Bial {
      * @brief Returns reverse_iterator rend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::reverse_iterator rend( ) noexcept;
+    typename Vector< D >::reverse_iterator rend( ) noexcept;
 
     /**
      * @date 2013/Aug/09
@@ -632,7 +646,7 @@ namespace Bial {
      * @brief Returns const_reverse_iterator rend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator rend( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator rend( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -641,7 +655,7 @@ namespace Bial {
      * @brief Returns the iterator cbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator cbegin( ) const noexcept;
+    typename Vector< D >::const_iterator cbegin( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -650,7 +664,7 @@ namespace Bial {
      * @brief Returns the iterator cend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_iterator cend( ) const noexcept;
+    typename Vector< D >::const_iterator cend( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -659,7 +673,7 @@ namespace Bial {
      * @brief Returns the iterator crbegin() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator crbegin( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator crbegin( ) const noexcept;
 
     /**
      * @date 2015/Apr/06
@@ -668,7 +682,7 @@ namespace Bial {
      * @brief Returns the iterator crend() of data Vector.
      * @warning none.
      */
-    typename std::vector< D >::const_reverse_iterator crend( ) const noexcept;
+    typename Vector< D >::const_reverse_iterator crend( ) const noexcept;
 
     /**
      * @date 2012/Sep/11
@@ -1139,6 +1153,7 @@ namespace Bial {
 /* Implementation  ------------------------------------------------------------------------------------------------------ */
 #include "Adjacency.hpp"
 #include "File.hpp"
+#include "MatrixMultiply.hpp"
 
 namespace Bial {
 
@@ -1146,7 +1161,7 @@ namespace Bial {
                                                acc_dim_size( ) {
   }
   
-  template< class D > Matrix< D >::Matrix( const Vector< size_t > &dim_size ) try
+  template< class D > Matrix< D >::Matrix( const Vector< size_t > &dim_size, StorageInit init ) try
     : _data( ), qk_data( nullptr ), _size( dim_size[ 0 ] ), dims( dim_size.size( ) ), dim_size( dim_size ),
         acc_dim_size( dim_size ) {
 
@@ -1161,7 +1176,7 @@ namespace Bial {
       throw( std::logic_error( msg ) );
     }
     COMMENT( "Initializing data.", 2 );
-    _data = Vector< D >( _size );
+    _data = Vector< D >( _size, init );
     COMMENT( "Assigning quick access pointers.", 2 );
     qk_data = _data.data( );
   }
@@ -1183,8 +1198,10 @@ namespace Bial {
   }
 
   template< class D > Matrix< D >::Matrix( D *new_data, const Vector< size_t > &new_dim ) try
-    : _data( new_data, std::accumulate( new_dim.begin( ), new_dim.end( ), 0 ) ), qk_data( new_data ),
-        _size( std::accumulate( new_dim.begin( ), new_dim.end( ), 0 ) ), dims( new_dim.size( ) ),
+    : _data( new_data, std::accumulate( new_dim.begin( ), new_dim.end( ), static_cast< size_t >( 1 ),
+                                        std::multiplies< size_t >( ) ) ), qk_data( new_data ),
+        _size( std::accumulate( new_dim.begin( ), new_dim.end( ), static_cast< size_t >( 1 ),
+                                std::multiplies< size_t >( ) ) ), dims( new_dim.size( ) ),
         dim_size( new_dim ), acc_dim_size( new_dim ) {
 
       COMMENT( "Computing dimension accumulated size.", 4 );
@@ -1306,8 +1323,8 @@ namespace Bial {
 
   template< class D >
   template< class D2 > Matrix< D >::Matrix( const Matrix< D2 > &mtx ) try
-    : _data( mtx._size ), qk_data( nullptr ), _size( mtx._size ), dims( mtx.dims ), dim_size( mtx.dim_size ),
-        acc_dim_size( mtx.acc_dim_size ) {
+    : _data( mtx._size, StorageInit::None ), qk_data( nullptr ), _size( mtx._size ), dims( mtx.dims ),
+        dim_size( mtx.dim_size ), acc_dim_size( mtx.acc_dim_size ) {
 
       COMMENT( "Assigning quick access pointers.", 2 );
       qk_data = _data.data( );
@@ -1636,6 +1653,25 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  template< class D2 >
+  void Matrix< D >::Product( const Matrix< D2 > &other, Matrix< D > &res ) const {
+    for( size_t j = 0; j < res.dim_size( 1 ); ++j ) {
+      for( size_t k = 0; k < dim_size( 0 ); ++k ) {
+        for( size_t i = 0; i < res.dim_size( 0 ); ++i ) {
+          res.QK_DATA( j * res.dim_size( 0 ) + i ) += QK_DATA( j * dim_size( 0 ) + k ) *
+            other.QK_DATA( k * res.dim_size( 0 ) + i );
+        }
+      }
+    }
+  }
+
+  template< class D >
+  void Matrix< D >::Product( const Matrix< D > &other, Matrix< D > &res ) const {
+    COMMENT( "Same data types: tiled product, or matrix-vector product for a single column.", 2 );
+    MatrixMultiply::Multiply( data( ), other.data( ), dim_size( 1 ), dim_size( 0 ), other.dim_size( 0 ), res.data( ) );
+  }
+
   template< class D >
   template< class D2 >
   Matrix< D > Matrix< D >::operator*( const Matrix< D2 > &other ) const {
@@ -1650,15 +1686,7 @@ namespace Bial {
         throw( std::logic_error( msg ) );
       }
       Matrix< D > res( other.dim_size( 0 ), dim_size( 1 ) );
-      for( size_t j = 0; j < res.dim_size( 1 ); ++j ) {
-        for( size_t i = 0; i < res.dim_size( 0 ); ++i ) {
-          res.QK_DATA( j * res.dim_size( 0 ) + i ) = 0.0;
-          for( size_t k = 0; k < dim_size( 0 ); ++k ) {
-            res.QK_DATA( j * res.dim_size( 0 ) + i ) += QK_DATA( j * dim_size( 0 ) + k ) *
-        other.QK_DATA( k * res.dim_size( 0 ) + i );
-          }
-        }
-      }
+      Product( other, res );
       return( res );
     }
     catch( std::bad_alloc &e ) {
@@ -2143,66 +2171,66 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Matrix< D >::begin( ) noexcept {
+  typename Vector< D >::iterator Matrix< D >::begin( ) noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.begin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Matrix< D >::begin( ) const noexcept {
+  typename Vector< D >::const_iterator Matrix< D >::begin( ) const noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.begin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::iterator Matrix< D >::end( ) noexcept {
+  typename Vector< D >::iterator Matrix< D >::end( ) noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.end( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Matrix< D >::end( ) const noexcept {
+  typename Vector< D >::const_iterator Matrix< D >::end( ) const noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.end( ) );
   }
 
   template< class D >
-  typename std::vector< D >::reverse_iterator Matrix< D >::rbegin( ) noexcept {
+  typename Vector< D >::reverse_iterator Matrix< D >::rbegin( ) noexcept {
     return( _data.rbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Matrix< D >::rbegin( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Matrix< D >::rbegin( ) const noexcept {
     return( _data.rbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::reverse_iterator Matrix< D >::rend( ) noexcept {
+  typename Vector< D >::reverse_iterator Matrix< D >::rend( ) noexcept {
     return( _data.rend( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Matrix< D >::rend( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Matrix< D >::rend( ) const noexcept {
     return( _data.rend( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Matrix< D >::cbegin( ) const noexcept {
+  typename Vector< D >::const_iterator Matrix< D >::cbegin( ) const noexcept {
     return( _data.cbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Matrix< D >::cend( ) const noexcept {
+  typename Vector< D >::const_iterator Matrix< D >::cend( ) const noexcept {
     return( _data.cend( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Matrix< D >::crbegin( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Matrix< D >::crbegin( ) const noexcept {
     return( _data.crbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Matrix< D >::crend( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Matrix< D >::crend( ) const noexcept {
     return( _data.crend( ) );
   }
 
@@ -22,7 +22,7 @@ namespace Bial {
      * @date 2012/Oct/23
      * @param mat: Input matrix.
      * @return Determinant of this matrix.
-     * @brief Compute and return the determinant of this matrix.
+     * @brief Compute and return the determinant of this matrix. Matrices larger than 3x3 use the LU decomposition.
      * @warning 'this' matrix must be square and 2D.
      */
     template< class D >
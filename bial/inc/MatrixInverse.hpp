@@ -32,8 +32,9 @@ namespace Bial {
      * @date 2012/Jun/21
      * @param mat: input matrix.
      * @return none.
-     * @brief Computes LU decomposition based inverse of 'this' matrix, overwriting data Vector.
-     * @warning 'this' matrix must be square and 2D.
+     * @brief Computes LU decomposition based inverse of 'this' matrix, overwriting data Vector. The decomposition
+     * uses partial pivoting. See MatrixOp::Solve to solve linear systems without the inverse.
+     * @warning 'this' matrix must be square and 2D. Throws logic_error if it is singular.
      */
     template< class D >
     void Inverse( Matrix< D > &mat );
@@ -43,7 +44,7 @@ namespace Bial {
      * @param mat: input matrix.
      * @return The inverse of this matrix.
      * @brief Compute and return LU decomposition based inverse of 'this' matrix.
-     * @warning 'this' matrix must be square and 2D.
+     * @warning 'this' matrix must be square and 2D. Throws logic_error if it is singular.
      */
     template< class D >
     Matrix< D > Inverse( const Matrix< D > &mat );
@@ -0,0 +1,166 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Matrix multiplication kernels for row-major data.
+ * <br> Description: Products of large matrices are computed by tiles, as in GotoBLAS and BLIS. Panels of kc rows of
+ * the right matrix and blocks of mc rows and kc columns of the left matrix are packed in contiguous slivers, so that
+ * a micro-kernel computes each tile of mr rows and nr columns of the result with all operands read in sequence.
+ * Blocks of rows are processed by the thread pool. Float and double micro-kernels use AVX-512 or AVX2 with FMA,
+ * selected at run time as in DistanceKernel, with a scalar fallback. Integer matrices use the scalar kernel.
+ * <br> Products by a single column or a single row, and small products, skip the packing.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALMATRIXMULTIPLY_H
+#define BIALMATRIXMULTIPLY_H
+
+namespace Bial {
+
+  class MatrixMultiply {
+
+  protected:
+
+    /** @brief Rows of the micro-kernel tile. */
+    static const size_t MR = 6;
+    /** @brief Largest number of columns of the micro-kernel tile, for AVX-512 float kernels. */
+    static const size_t MAX_NR = 32;
+    /** @brief Rows of the packed blocks of the left matrix. Multiple of MR. */
+    static const size_t MC = 96;
+    /** @brief Inner dimension of the packed panels. */
+    static const size_t KC = 256;
+    /** @brief Columns of the packed panels of the right matrix. Multiple of MAX_NR. */
+    static const size_t NC = 2048;
+    /** @brief Smallest number of multiply-adds computed with packed tiles or by the thread pool. */
+    static const size_t MIN_TILED = 32768;
+    static const size_t MIN_PARALLEL = 1048576;
+
+    /**
+     * @date 2026/Oct/17
+     * @param kc: Inner dimension.
+     * @param pa: Packed sliver of MR rows of the left matrix, with MR elements per inner index.
+     * @param pb: Packed sliver of nr columns of the right matrix, with nr elements per inner index.
+     * @param tile: Returns the product tile, with MR rows of nr elements.
+     * @return none.
+     * @brief Micro-kernels with scalar, AVX2 and AVX-512 instructions. nr is the template argument of the scalar
+     * kernel, and two vector registers for the AVX kernels.
+     * @warning AVX kernels are defined for float and double data only, and require processor support.
+     */
+    template< class D, size_t NR >
+    static void KernelScalar( size_t kc, const D *pa, const D *pb, D *tile );
+    static void KernelAVX2( size_t kc, const float *pa, const float *pb, float *tile );
+    static void KernelAVX2( size_t kc, const double *pa, const double *pb, double *tile );
+    static void KernelAVX512( size_t kc, const float *pa, const float *pb, float *tile );
+    static void KernelAVX512( size_t kc, const double *pa, const double *pb, double *tile );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Source matrix.
+     * @param lds: Number of columns of src.
+     * @param row: First row.
+     * @param rows: Number of rows. Rows beyond the matrix are taken as zero.
+     * @param col: First column.
+     * @param cols: Number of columns. Columns beyond the matrix are taken as zero.
+     * @param src_rows, src_cols: Dimensions of src.
+     * @param width: Number of rows or columns of each sliver.
+     * @param dst: Returns the packed slivers.
+     * @return none.
+     * @brief PackRows packs slivers of width rows, with width elements per column. PackColumns packs slivers of
+     * width columns, with width elements per row.
+     * @warning none.
+     */
+    template< class D >
+    static void PackRows( const D *src, size_t lds, size_t src_rows, size_t row, size_t rows, size_t col,
+                          size_t cols, size_t width, D *dst );
+    template< class D >
+    static void PackColumns( const D *src, size_t lds, size_t src_cols, size_t row, size_t rows, size_t col,
+                             size_t cols, size_t width, D *dst );
+
+    /**
+     * @date 2026/Oct/17
+     * @param lhs, rhs, rows, inner, cols, res: Same as Multiply.
+     * @return none.
+     * @brief Tiled product with packed panels.
+     * @warning none.
+     */
+    template< class D >
+    static void Tiled( const D *lhs, const D *rhs, size_t rows, size_t inner, size_t cols, D *res );
+
+    /**
+     * @date 2026/Oct/17
+     * @param lhs: First vector.
+     * @param rhs: Second vector.
+     * @param size: Number of elements.
+     * @return Dot product.
+     * @brief Dot products with scalar, AVX2 and AVX-512 instructions, used by the matrix-vector product.
+     * @warning AVX versions are defined for float and double data only, and require processor support.
+     */
+    template< class D >
+    static D DotScalar( const D *lhs, const D *rhs, size_t size );
+    static float DotAVX2( const float *lhs, const float *rhs, size_t size );
+    static double DotAVX2( const double *lhs, const double *rhs, size_t size );
+    static float DotAVX512( const float *lhs, const float *rhs, size_t size );
+    static double DotAVX512( const double *lhs, const double *rhs, size_t size );
+
+    /**
+     * @date 2026/Oct/17
+     * @param nr: Number of columns of the micro-kernel tile. Initially, the one of the scalar kernel.
+     * @param kernel: Micro-kernel. Initially, the scalar one.
+     * @param dot: Dot product. Initially, the scalar one.
+     * @return none.
+     * @brief Selects the micro-kernel and the dot product of the widest instruction set supported by the processor.
+     * Float and double overloads call SelectVector. Other data types keep the scalar versions.
+     * @warning SelectVector is defined for float and double data only.
+     */
+    template< class D >
+    static void Select( size_t &nr, void ( *&kernel )( size_t, const D*, const D*, D* ),
+                        D ( *&dot )( const D*, const D*, size_t ) );
+    static void Select( size_t &nr, void ( *&kernel )( size_t, const float*, const float*, float* ),
+                        float ( *&dot )( const float*, const float*, size_t ) );
+    static void Select( size_t &nr, void ( *&kernel )( size_t, const double*, const double*, double* ),
+                        double ( *&dot )( const double*, const double*, size_t ) );
+    template< class D >
+    static void SelectVector( size_t &nr, void ( *&kernel )( size_t, const D*, const D*, D* ),
+                              D ( *&dot )( const D*, const D*, size_t ) );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param lhs: Left matrix, with rows rows of inner elements.
+     * @param rhs: Right matrix, with inner rows of cols elements.
+     * @param rows: Number of rows of lhs.
+     * @param inner: Number of columns of lhs and of rows of rhs.
+     * @param cols: Number of columns of rhs.
+     * @param res: Returns the product, with rows rows of cols elements.
+     * @return none.
+     * @brief Computes the product of row-major matrices.
+     * @warning res must not overlap lhs or rhs.
+     */
+    template< class D >
+    static void Multiply( const D *lhs, const D *rhs, size_t rows, size_t inner, size_t cols, D *res );
+
+    /**
+     * @date 2026/Oct/17
+     * @param mat: Matrix, with rows rows of cols elements.
+     * @param vct: Vector with cols elements.
+     * @param rows: Number of rows of mat.
+     * @param cols: Number of columns of mat.
+     * @param res: Returns the product, with rows elements.
+     * @return none.
+     * @brief Computes the product of a row-major matrix by a column vector, as one dot product per row.
+     * @warning res must not overlap mat or vct.
+     */
+    template< class D >
+    static void MultiplyVector( const D *mat, const D *vct, size_t rows, size_t cols, D *res );
+
+  };
+
+}
+
+#include "MatrixMultiply.cpp"
+
+#endif
@@ -0,0 +1,113 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief LU and Cholesky decompositions and solution of linear systems.
+ * <br> Description: Both decompositions are blocked. A panel of columns is factorized first, and the rest of the
+ * matrix is updated with the product of the panel blocks, computed by MatrixMultiply. Decompositions are computed in
+ * double precision, for any input type. Systems are solved by forward and backward substitution, without computing
+ * the inverse.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALMATRIXSOLVE_H
+#define BIALMATRIXSOLVE_H
+
+#include "Vector.hpp"
+
+namespace Bial {
+
+  template< class D >
+  class Matrix;
+
+  namespace MatrixOp {
+
+    /**
+     * @date 2026/Oct/17
+     * @param mat: Input matrix.
+     * @param lu: Returns the factors. U is in the upper triangle and diagonal, and L, with unit diagonal, below it.
+     * @param pivot: Returns the row exchanged with row i in step i of the decomposition.
+     * @return Sign of the row permutation, or 0 if mat is singular.
+     * @brief Computes the LU decomposition with partial pivoting of mat, that is, P mat = L U.
+     * @warning mat must be square and 2D. Singular matrices give a zero diagonal element in U.
+     */
+    template< class D >
+    int LU( const Matrix< D > &mat, Matrix< double > &lu, Vector< size_t > &pivot );
+
+    /**
+     * @date 2026/Oct/17
+     * @param mat: Input matrix. Only the lower triangle is read.
+     * @param chol: Returns the lower triangular factor L, with zeros above the diagonal.
+     * @return true if mat is positive definite.
+     * @brief Computes the Cholesky decomposition of symmetric matrix mat, that is, mat = L L^T.
+     * @warning mat must be square and 2D. chol is incomplete when false is returned.
+     */
+    template< class D >
+    bool Cholesky( const Matrix< D > &mat, Matrix< double > &chol );
+
+    /**
+     * @date 2026/Oct/17
+     * @param tri: Matrix whose lower triangle is L.
+     * @param unit: true if the diagonal of L is one, instead of the diagonal of tri.
+     * @param rhs: Right-hand side, with one row per row of tri. Returns the solution.
+     * @return none.
+     * @brief Solves L x = rhs for each column of rhs, by blocks of rows. The product of each block of L at the left
+     * of the diagonal by the rows already solved is computed by MatrixMultiply.
+     * @warning none.
+     */
+    void LowerSolve( const Matrix< double > &tri, bool unit, Matrix< double > &rhs );
+
+    /**
+     * @date 2026/Oct/17
+     * @param tri: Matrix whose upper triangle is U.
+     * @param transposed: true if U is the transpose of the lower triangle of tri.
+     * @param rhs: Right-hand side, with one row per row of tri. Returns the solution.
+     * @return none.
+     * @brief Solves U x = rhs for each column of rhs, by blocks of rows, as LowerSolve.
+     * @warning none.
+     */
+    void UpperSolve( const Matrix< double > &tri, bool transposed, Matrix< double > &rhs );
+
+    /**
+     * @date 2026/Oct/17
+     * @param lu: Factors given by LU.
+     * @param pivot: Pivots given by LU.
+     * @param rhs: Right-hand side, with one row per row of lu. Returns the solution.
+     * @return none.
+     * @brief Solves the system of the decomposed matrix for each column of rhs.
+     * @warning lu must not be singular.
+     */
+    void LUSolve( const Matrix< double > &lu, const Vector< size_t > &pivot, Matrix< double > &rhs );
+
+    /**
+     * @date 2026/Oct/17
+     * @param chol: Factor given by Cholesky.
+     * @param rhs: Right-hand side, with one row per row of chol. Returns the solution.
+     * @return none.
+     * @brief Solves the system of the decomposed matrix for each column of rhs.
+     * @warning none.
+     */
+    void CholeskySolve( const Matrix< double > &chol, Matrix< double > &rhs );
+
+    /**
+     * @date 2026/Oct/17
+     * @param mat: Input matrix.
+     * @param rhs: Right-hand side, a vector or a matrix with one row per row of mat.
+     * @return Solution x of mat x = rhs, with the dimensions of rhs.
+     * @brief Solves the linear system. Symmetric positive definite matrices use the Cholesky decomposition, and
+     * other matrices the LU decomposition.
+     * @warning mat must be square and 2D. Throws logic_error if mat is singular.
+     */
+    template< class D >
+    Matrix< D > Solve( const Matrix< D > &mat, const Matrix< D > &rhs );
+
+  }
+
+}
+
+#include "MatrixSolve.cpp"
+
+#endif
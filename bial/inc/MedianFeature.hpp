@@ -22,6 +22,8 @@ namespace Bial {
   class Image;
   template< class D >
   class Matrix;
+  template< class D >
+  class Vector;
 
   /**
    * @date 2012/Jun/29 
@@ -30,6 +32,8 @@ namespace Bial {
    * @param proportion: Proportion of the pixels in adj to be taken. In ]0.0,1.0]. 
    * @return A median feature vector. 
    * @brief Assings a median values from the neighborhoods of each pixel from matrix src to a feature vector. 
+   * Adjacents out of the domain count as the central pixel value. The features are the ranks around the median of
+   * the neighborhood, taken from a histogram of the window sliding along the lines.
    * @warning none. 
    */
   template< class D >
@@ -54,16 +58,18 @@ namespace Bial {
    * @date 2013/Nov/28 
    * @param src: Input source matrix to extract features. 
    * @param adj_rel: Adjacency relation of each pixel. 
+   * @param bin: Histogram bin of each element, as returned by SlidingHistogram::Quantize.
+   * @param value: Value of each histogram bin, as returned by SlidingHistogram::Quantize.
    * @param res: Resulting feature vector. 
    * @param thread: Thread number. 
    * @param total_threads: Number of threads. 
    * @return none. 
-   * @brief Multi-thread implementation of MedianFeature. 
+   * @brief Multi-thread implementation of MedianFeature, with a histogram of the window sliding along the lines.
    * @warning none. 
    */
   template< class D >
-  void MedianFeatureThread( const Matrix< D > &src, const Adjacency &adj_rel, Feature< D > &res,
-                            size_t thread, size_t total_threads );
+  void MedianFeatureThread( const Matrix< D > &src, const Adjacency &adj_rel, const Vector< int > &bin,
+                            const Vector< D > &value, Feature< D > &res, size_t thread, size_t total_threads );
 
   /**
    * @date 2014/Apr/16 
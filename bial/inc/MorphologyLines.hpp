@@ -0,0 +1,211 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Morphological dilation and erosion decomposed in 1D line operations.
+ * <br> Description: The structuring element given by an adjacency relation is decomposed in runs of consecutive
+ * displacements along image lines. Each run is evaluated by the running maximum or minimum of van Herk and
+ * Gil-Werman, with three comparisons per pixel regardless of the run length. Boxes are evaluated separably, one
+ * run per dimension. Crosses take the extremum of one run per dimension through the origin. Other elements, as
+ * hyperspheres, take the extremum of their runs along dimension 0, shifted over the other dimensions, computing the
+ * running extremum once for each distinct run length. All decompositions are exact.
+ * <br> Binary dilation and erosion by hyperspheres with many adjacents are computed by thresholding the exact
+ * Euclidean distance transform.
+ * <br> As Morphology::Dilate and Morphology::Erode, the origin is always part of the element, and adjacents out of
+ * the image domain are ignored.
+ */
+
+#include "Common.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALMORPHOLOGYLINES_H
+#define BIALMORPHOLOGYLINES_H
+
+namespace Bial {
+
+  template< class D >
+  class Image;
+  class Adjacency;
+
+  class MorphologyLines {
+
+  protected:
+
+    /** @brief Number of dimensions of the adjacency relation. */
+    size_t dims;
+    /** @brief Number of distinct adjacents, including the origin. */
+    size_t adjs;
+    /** @brief false if some displacement is not integer. The decomposition is not used then. */
+    bool integral;
+    /** @brief true if the element is a box, given by lower and upper. */
+    bool box;
+    /** @brief true if the element is a cross, given by lower and upper. */
+    bool cross;
+    /** @brief true if the element holds all displacements with squared norm up to squared_radius. */
+    bool sphere;
+    /** @brief Largest squared norm of the displacements. */
+    llint squared_radius;
+    /** @brief Lower and upper displacements in each dimension. */
+    Vector< llint > lower;
+    Vector< llint > upper;
+    /** @brief Lower and upper displacements of each run along dimension 0. */
+    Vector< llint > run_lower;
+    Vector< llint > run_upper;
+    /** @brief Displacement of each run in the other dimensions, with dims elements per run. */
+    Vector< llint > run_shift;
+    /** @brief Distinct run lengths. */
+    Vector< size_t > run_lengths;
+
+    /**
+     * @date 2026/Oct/17
+     * @param line: Input line, padded with neutral elements of extremum.
+     * @param length: Window length.
+     * @param extremum: Function returning the maximum or the minimum of two values.
+     * @param prefix: Buffer with line.size( ) elements.
+     * @param suffix: Buffer with line.size( ) elements.
+     * @param res: Returns the extremum of the window [ x, x + length - 1 ] of line at index x, for x in
+     * [ 0, line.size( ) - length ].
+     * @return none.
+     * @brief Running extremum of van Herk and Gil-Werman. The line is split in blocks of length elements. Each
+     * window joins the suffix of a block with the prefix of the next one.
+     * @warning none.
+     */
+    template< class D, class C >
+    static void RunningExtremum( const Vector< D > &line, size_t length, C extremum, Vector< D > &prefix,
+                                 Vector< D > &suffix, Vector< D > &res );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Input image.
+     * @param dms: Dimension of the lines.
+     * @param low: Lower displacement of the run.
+     * @param high: Upper displacement of the run. Must not be smaller than low.
+     * @param neutral: Neutral element of extremum.
+     * @param extremum: Function returning the maximum or the minimum of two values.
+     * @param dst: Output image. May be src.
+     * @param combine: true to combine the run extremum with dst, and false to overwrite dst.
+     * @return none.
+     * @brief Computes the extremum of the run [ low, high ] along dimension dms for all pixels, using the thread
+     * pool.
+     * @warning low must not be larger than 0, and high must not be smaller than 0.
+     */
+    template< class D, class C >
+    static void LineExtremum( const Image< D > &src, size_t dms, llint low, llint high, D neutral, C extremum,
+                              Image< D > &dst, bool combine );
+
+    /**
+     * @date 2026/Oct/17
+     * @param image: Input image.
+     * @param neutral: Neutral element of extremum.
+     * @param extremum: Function returning the maximum or the minimum of two values.
+     * @return Extremum of the adjacents of each pixel.
+     * @brief Evaluates the decomposition of the structuring element over image.
+     * @warning none.
+     */
+    template< class D, class C >
+    Image< D > Extremum( const Image< D > &image, D neutral, C extremum ) const;
+
+  public:
+
+    /** @brief Decomposition cost per dimension above which binary hypersphere operations use the distance
+     * transform. */
+    static const size_t distance_cost = 8;
+
+    /**
+     * @date 2026/Oct/17
+     * @param adjacency: Adjacency relation defining the structuring element.
+     * @return none.
+     * @brief Basic Constructor. Decomposes the structuring element.
+     * @warning none.
+     */
+    MorphologyLines( const Adjacency &adjacency );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of comparisons per pixel of the decomposition.
+     * @brief Returns the number of comparisons per pixel of the decomposition. Direct evaluation takes one per
+     * adjacent.
+     * @warning none.
+     */
+    size_t Cost( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if the decomposition is cheaper than direct evaluation.
+     * @brief Returns true if the decomposition is supported and takes fewer comparisons than direct evaluation.
+     * @warning none.
+     */
+    bool Efficient( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if the element is a hypersphere.
+     * @brief Returns true if the element holds all displacements with squared norm up to the largest one.
+     * @warning none.
+     */
+    bool Sphere( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if binary operations threshold the distance transform.
+     * @brief Returns true if the element is a hypersphere whose decomposition costs more than distance_cost
+     * comparisons per pixel and dimension.
+     * @warning none.
+     */
+    bool Distance( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param image: Input image.
+     * @return Dilation of input image.
+     * @brief Computes the dilation of input image by the decomposed structuring element.
+     * @warning Image and adjacency relation dimensions must match.
+     */
+    template< class D >
+    Image< D > Dilate( const Image< D > &image ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param image: Input image.
+     * @return Erosion of input image.
+     * @brief Computes the erosion of input image by the decomposed structuring element.
+     * @warning Image and adjacency relation dimensions must match.
+     */
+    template< class D >
+    Image< D > Erode( const Image< D > &image ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param image: Input binary image. All non-zero pixels must have the same value.
+     * @return Dilation of input binary image.
+     * @brief Computes the binary dilation of input image. Large hyperspheres threshold the squared Euclidean
+     * distance to the object.
+     * @warning Image and adjacency relation dimensions must match.
+     */
+    template< class D >
+    Image< D > DilateBin( const Image< D > &image ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param image: Input image.
+     * @return Erosion of input binary image.
+     * @brief Computes the binary erosion of input image: non-zero pixels with some zero adjacent are set to zero.
+     * Large hyperspheres threshold the squared Euclidean distance to the background.
+     * @warning Image and adjacency relation dimensions must match.
+     */
+    template< class D >
+    Image< D > ErodeBin( const Image< D > &image ) const;
+
+  };
+
+}
+
+#include "MorphologyLines.cpp"
+
+#endif
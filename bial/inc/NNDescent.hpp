@@ -0,0 +1,104 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Approximate k-nearest neighbor graph by NN-Descent, for high-dimensional feature vectors.
+ * <br> Description: Dong, Charikar and Li. Efficient k-nearest neighbor graph construction for generic similarity
+ * measures. Each element starts with k random neighbors. At each iteration, the neighbors of a neighbor are taken
+ * as candidates: for each element, its new and old neighbors and reverse neighbors are joined pairwise, and each
+ * pair updates the neighbor lists of both elements. Only pairs with some new element are joined. Iterations stop
+ * when fewer than delta * k * elements lists are updated. Only a sample of the new neighbors and of the reverse
+ * neighbors of each element is joined at each iteration.
+ * <br> Joins of distinct elements are processed by the thread pool, with one lock per neighbor list. As the order
+ * of the updates depends on the thread schedule, results may differ slightly from one run to another.
+ */
+
+#include "Common.hpp"
+#include "DistanceKernel.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALNNDESCENT_H
+#define BIALNNDESCENT_H
+
+namespace Bial {
+
+  template< class D >
+  class Feature;
+
+  template< class D >
+  class NNDescent {
+
+  protected:
+
+    /** @brief Feature vectors. */
+    const Feature< D > &feature;
+    /** @brief Distance kernel. */
+    DistanceKernel kernel;
+    /** @brief Number of neighbors of each element. */
+    size_t k;
+    /** @brief Neighbor lists, with k entries per element, in increasing order of distance and index. */
+    Vector< size_t > neighbor;
+    Vector< double > neighbor_distance;
+    /** @brief Non-zero for neighbors not yet joined. */
+    Vector< char > neighbor_new;
+    /** @brief Number of entries of each neighbor list. */
+    Vector< size_t > neighbor_size;
+
+    /**
+     * @date 2026/Oct/17
+     * @param elm: An element.
+     * @param nbr: Candidate neighbor of elm.
+     * @param dist: Distance from elm to nbr.
+     * @return 1 if nbr was inserted, and 0 if it was already a neighbor or is farther than all neighbors.
+     * @brief Inserts nbr in the neighbor list of elm, as a new neighbor.
+     * @warning Not thread safe for the same elm.
+     */
+    size_t Insert( size_t elm, size_t nbr, double dist );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param feature: Feature vectors.
+     * @param k: Number of neighbors of each element.
+     * @param kernel: Distance kernel.
+     * @return none.
+     * @brief Basic Constructor.
+     * @warning feature is referenced, not copied. k is limited to the number of elements minus one.
+     */
+    NNDescent( const Feature< D > &feature, size_t k, const DistanceKernel &kernel = DistanceKernel( ) );
+
+    /**
+     * @date 2026/Oct/17
+     * @param max_iterations: Maximum number of iterations.
+     * @param delta: Fraction of updated neighbors below which the iterations stop.
+     * @param sample_rate: Fraction of k of the new neighbors and of the reverse neighbors joined at each iteration.
+     * @return Number of iterations.
+     * @brief Initializes random neighbors and refines them by NN-Descent. Each join computes about
+     * ( 2 * sample_rate * k )^2 distances per element, so that it pays off for k much smaller than the number of
+     * elements.
+     * @warning none.
+     */
+    size_t Run( size_t max_iterations = 20, double delta = 0.001, double sample_rate = 0.5 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: An element.
+     * @param index: Returns the neighbor indexes. Must hold k elements.
+     * @param distance: Returns the neighbor distances. Must hold k elements.
+     * @return Number of neighbors of src.
+     * @brief Returns the approximate nearest neighbors of src, except itself, in increasing order of distance and
+     * index.
+     * @warning Run must be called first.
+     */
+    size_t Neighbors( size_t src, size_t *index, double *distance ) const;
+
+  };
+
+}
+
+#include "NNDescent.cpp"
+
+#endif
@@ -29,6 +29,8 @@ namespace Bial {
   class OFile;
   template< class D >
   class Image;
+  template< class D >
+  class StreamFilter;
   union Color;
   class RealColor;
 
@@ -248,6 +250,9 @@ namespace Bial {
   class NiftiHeader {
     template< class D >
     friend class Image;
+    friend class NiftiMapping;
+    template< class D >
+    friend class StreamFilter;
   public:
     static const short NIFTI_HEADER_SIZE = 348;
     static const short ANALYZE_EXTENT = 16384;
@@ -340,6 +345,8 @@ namespace Bial {
     Matrix< float > stm;
     /** @brief  NIFTI1: 'name' or meaning of data. intent_name[ 16 ]                    */
     std::string intent_name;
+    /** @brief  Whether the file was written with the opposite byte order. Not part of the header. */
+    bool swapped;
 
     /**
      * @date 2012/jul/31
@@ -505,6 +512,25 @@ namespace Bial {
      */
     NiftiType DataType( ) const;
 
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if the header was read from a file with the opposite byte order of this system.
+     * @brief Returns whether the header and the data of the file must be byte swapped.
+     * @warning none.
+     */
+    bool Swapped( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Offset of the data.
+     * @brief Returns the byte offset of the data into .nii files. Data of .hdr/.img pairs starts at the beginning of
+     * the .img file.
+     * @warning none.
+     */
+    size_t VoxOffset( ) const;
+
     /**
      * @date 2013/Aug/20
      * @param filename: A nifti extension file name.
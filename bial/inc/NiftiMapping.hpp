@@ -0,0 +1,186 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Zero-copy reading of uncompressed Nifti files through memory mapping.
+ * <br> Description: The header is parsed once and the data file is mapped. When the stored type matches the
+ * requested image type, View returns an image over the mapped data, with no copy. Otherwise, and always for Read,
+ * the data is converted in parallel chunks directly from the mapping into the resultant image, swapping bytes on the
+ * fly, so that no intermediate buffer of the whole file is allocated.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALNIFTIMAPPING_H
+#define BIALNIFTIMAPPING_H
+
+#include "MappedFile.hpp"
+#include "NiftiHeader.hpp"
+
+namespace Bial {
+
+  template< class D >
+  class Image;
+
+  class NiftiMapping {
+
+  private:
+
+    /** @brief Header of the file. */
+    NiftiHeader hdr;
+    /** @brief Mapping of the data file. */
+    MappedFile mapping;
+    /** @brief Byte offset of the data into the mapping. */
+    size_t offset;
+    /** @brief Number of pixels. */
+    size_t elements;
+    /** @brief Image dimensions. */
+    Vector< size_t > spc_dims;
+    /** @brief Pixel dimensions. */
+    Vector< float > pixel_size;
+    /** @brief Whether the mapped data is in the byte order of this system. */
+    bool native;
+
+    /** @brief Pixels converted at once by a thread. */
+    static const size_t GRAIN = 262144;
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Nifti file name.
+     * @return Name of the data file.
+     * @brief Returns the existing data file of filename.
+     * @warning Throws logic_error if the data file is compressed.
+     */
+    static std::string MappableFileName( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param val: Value read from a file in the opposite byte order.
+     * @return val with its bytes reversed.
+     * @brief Swaps the bytes of a single value.
+     * @warning none.
+     */
+    template< class S >
+    static S SwapBytes( S val );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: First byte of the stored data, of type S.
+     * @param swap: Whether the bytes of each value must be swapped.
+     * @param dst: Resultant data.
+     * @param size: Number of values.
+     * @return none.
+     * @brief Converts the stored data to D in parallel chunks. Non-finite floating point values are set to zero.
+     * @warning src does not need to be aligned to S.
+     */
+    template< class S, class D >
+    static void Convert( const char *src, bool swap, D *dst, size_t size );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: .nii, .hdr or .img file name. Data must not be compressed.
+     * @return none.
+     * @brief Basic Constructor. Reads the header and maps the data file.
+     * @warning Throws logic_error for compressed, multi-channel or time series files.
+     */
+    NiftiMapping( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: .nii, .hdr or .img file name. Data must not be compressed.
+     * @param header: Header already read from filename.
+     * @return none.
+     * @brief Basic Constructor. Maps the data file, without reading the header again.
+     * @warning Throws logic_error for compressed, multi-channel or time series files.
+     */
+    NiftiMapping( const std::string &filename, const NiftiHeader &header );
+
+    /**
+     * @date 2026/Oct/17
+     * @param filename: Nifti file name.
+     * @return true if the data of filename may be mapped.
+     * @brief Returns whether the data file of filename is not compressed.
+     * @warning none.
+     */
+    static bool IsMappable( const std::string &filename );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return The header of the file.
+     * @brief Returns the header read in the constructor.
+     * @warning none.
+     */
+    const NiftiHeader &Header( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return true if View< D > returns the mapped data with no copy.
+     * @brief Checks whether the stored type is D and its data is aligned to D.
+     * @warning none.
+     */
+    template< class D >
+    bool IsZeroCopy( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Image over the mapped data if IsZeroCopy< D >( ), or a converted image otherwise.
+     * @brief Returns the image with no copy whenever possible. Data of files in the opposite byte order is swapped in
+     * place at the first view, in private pages of the mapping. The file itself is never modified.
+     * @warning The returned image is valid only while this object exists. Copies of it own their data. Non-finite
+     * values of zero-copy views are kept as stored.
+     */
+    template< class D >
+    Image< D > View( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Image with its own data.
+     * @brief Converts the mapped data into a new image, in parallel.
+     * @warning none.
+     */
+    template< class D >
+    Image< D > Read( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param first: Index of the first pixel.
+     * @param size: Number of pixels.
+     * @param dst: Destination with size elements.
+     * @return none.
+     * @brief Converts a range of the mapped pixels into dst, so that a volume may be read by slabs. Only the pages of
+     * the range are touched.
+     * @warning Throws out_of_range if the range exceeds the image.
+     */
+    template< class D >
+    void Read( size_t first, size_t size, D *dst ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param type: Stored data type.
+     * @param src: First byte of the stored data.
+     * @param swap: Whether the bytes of each value must be swapped.
+     * @param dst: Resultant data.
+     * @param size: Number of values.
+     * @return none.
+     * @brief Converts stored data of any supported type to D in parallel chunks. Non-finite floating point values
+     * are set to zero.
+     * @warning Throws logic_error for unsupported types. src does not need to be aligned.
+     */
+    template< class D >
+    static void ConvertData( NiftiType type, const char *src, bool swap, D *dst, size_t size );
+
+  };
+
+}
+
+#include "NiftiMapping.cpp"
+
+#endif
@@ -8,6 +8,7 @@
  */
 
 #include "Common.hpp"
+#include "DistanceKernel.hpp"
 
 #ifndef BIALOPFSPATIALCLUSTERING_H
 #define BIALOPFSPATIALCLUSTERING_H
@@ -28,13 +29,14 @@ namespace Bial {
      * @param label: label map. 
      * @param adjacency: adjacency relation for spacial constraints. 
      * @param intensity_fraction: fraction from 0.0 to 1.0 of the maximum intensity set for adjacent pixels. 
+     * @param kernel: Distance kernel. The default uses the current distance function of DFIDE.
      * @return Number of clusters. 
      * @brief Computes OPF clustering based on the feature and image space, using complete graph. 
      * @warning Feature and init label must have compatible dimensions. 
      */
     template< class D >
     size_t SpacialClustering( const Feature< D > &feature, Image< int > &label, const Adjacency &adjacency,
-                              float intensity_fraction );
+                              float intensity_fraction, const DistanceKernel &kernel = DistanceKernel( ) );
 
     /**
      * @date 2012/Nov/26 
@@ -42,13 +44,14 @@ namespace Bial {
      * @param label: label map. May be a std random access container, Bial::Image, or Bial::Matrix class. 
      * @param adjacency: adjacency relation for spacial constraints. 
      * @param intensity_fraction: fraction from 0.0 to 1.0 of the maximum intensity set for adjacent pixels. 
+     * @param kernel: Distance kernel. The default uses the current distance function of DFIDE.
      * @return The bucket size for the IFT queue and PathFunction. 
      * @brief Computes PDF for 'neighbors' neighbours. 
      * @warning none. 
      */
     template< class D >
     float MaxWeight( const Feature< D > &feature, Image< int > &label, const Adjacency &adjacency,
-                     float intensity_fraction );
+                     float intensity_fraction, const DistanceKernel &kernel = DistanceKernel( ) );
 
     /**
      * @date 2013/Dec/10 
@@ -58,13 +61,15 @@ namespace Bial {
      * @param max_distance: Maximum distance among pixels. 
      * @param thread: Thread number. 
      * @param total_threads: Number of threads. 
+     * @param kernel: Distance kernel. The default uses the current distance function of DFIDE.
      * @return The bucket size for the IFT queue and PathFunction. 
      * @brief Computes PDF for 'neighbors' neighbours. 
      * @warning none. 
      */
     template< class D >
     void MaxWeightThread( const Feature< D > &feature, Image< int > &label, const Adjacency &adjacency,
-                          float &max_distance, size_t thread, size_t total_threads );
+                          float &max_distance, size_t thread, size_t total_threads,
+                          const DistanceKernel &kernel = DistanceKernel( ) );
 
     /**
      * @date 2012/Nov/26 
@@ -72,13 +77,14 @@ namespace Bial {
      * @param adjacency: adjacency relation for spacial constraints. 
      * @param density: Samples density. Used as value map in IFT. 
      * @param max_weight: maximum arc weight in feature space. 
+     * @param kernel: Distance kernel. The default uses the current distance function of DFIDE.
      * @return The bucket size for the IFT queue and PathFunction. 
      * @brief Computes PDF in spatial and spectral domains. 
      * @warning none. 
      */
     template< class D >
     float PDF( const Feature< D > &feature, const Adjacency &adjacency, Image< float > &density,
-               float max_weight );
+               float max_weight, const DistanceKernel &kernel = DistanceKernel( ) );
 
     /**
      * @date 2013/Dec/10 
@@ -89,13 +95,15 @@ namespace Bial {
      * @param max_dens_diff: Maximum density difference found among samples. 
      * @param thread: Thread number. 
      * @param total_threads: Number of threads. 
+     * @param kernel: Distance kernel. The default uses the current distance function of DFIDE.
      * @return The bucket size for the IFT queue and PathFunction. 
      * @brief Computes PDF in spatial and spectral domains. 
      * @warning none. 
      */
     template< class D >
     float PDFThread( const Feature< D > &feature, const Adjacency &adjacency, Image< float > &density,
-                     float sigma, float &max_dens_diff, size_t thread, size_t total_threads );
+                     float sigma, float &max_dens_diff, size_t thread, size_t total_threads,
+                     const DistanceKernel &kernel = DistanceKernel( ) );
 
   }
 
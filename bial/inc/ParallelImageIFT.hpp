@@ -0,0 +1,148 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief IFT algorithm running on Images, with the image domain split in blocks processed by the thread pool.
+ * <br> Description: The image is split in slabs of planes along its last dimension, one per thread. Each slab runs
+ * the sequential IFT over the arcs inside it, concurrently, reading and writing only its own pixels. Then, the arcs
+ * crossing slab boundaries are verified serially: a boundary is kept only if no path through it could change the
+ * sequential result, that is, if it offers no pixel a cost in the same or in a better bucket than the one it was
+ * removed from, and offers seeds no better cost than their initial one. Otherwise, the slabs on both sides are merged
+ * and the merged range runs the sequential IFT again. This is repeated until all remaining boundaries are kept.
+ * <br> The queue of a range removes its pixels in the same relative order as the sequential queue, since their
+ * bucket positions are only set by arcs inside the range. Therefore, costs, labels, and predecessors are the same as
+ * the ones of StaticImageIFT, ties included. The speedup depends on how many optimum paths cross slab boundaries. In
+ * the worst case, all slabs are merged, and the sequential IFT runs after the local ones.
+ * <br> Path functions must only write the value of the conquered pixel in RemoveSimple, Capable and Propagate, and
+ * must not read the label map. With one thread, or for images with too few planes, StaticImageIFT is run instead.
+ */
+
+#include "Adjacency.hpp"
+#include "Common.hpp"
+#include "Image.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALPARALLELIMAGEIFT_H
+#define BIALPARALLELIMAGEIFT_H
+
+#include "BucketQueue.hpp"
+#include "PathFunction.hpp"
+
+namespace Bial {
+
+  class AdjacencyOffset;
+
+  template< class D, class PF, class Q = BucketQueue, class L = int >
+  class ParallelImageIFT {
+
+  protected:
+
+    /** @brief Parallel IFT attributes. */
+    Image< D > &value;
+    const Adjacency &adjacency;
+    PF *function;
+    const Vector< bool > *seed;
+    Image< L > *label;
+    Image< L > *predecessor;
+    bool sequential_label;
+    long double bucket_size;
+    bool fifo_tie;
+    /** @brief First pixel of each block, and the image size as the last element. */
+    Vector< size_t > bound;
+    /** @brief Block of each plane along the last dimension. */
+    Vector< size_t > plane_block;
+    /** @brief Number of pixels of a plane along the last dimension. */
+    size_t plane_size;
+    /** @brief First block of the range containing each block. Blocks of a range are processed together. */
+    Vector< size_t > range;
+    /** @brief Initial values of the pixels. Ranges restart from them, and seeds are compared to them. */
+    Vector< D > seed_value;
+    /** @brief Internal predecessor map. -1 for roots and pixels not conquered. */
+    Vector< llint > pred;
+    /** @brief Whether each pixel is a root of the forest. */
+    Vector< char > root;
+
+    /**
+     * @date 2026/Oct/17
+     * @param first_blk: First block of the range.
+     * @param last_blk: Block after the last one of the range.
+     * @param offsets: Adjacency offsets for the image.
+     * @return none.
+     * @brief Restores the initial values of the range and runs the sequential IFT over the arcs inside it.
+     * @warning Only reads and writes the pixels of the range.
+     */
+    void LocalRun( size_t first_blk, size_t last_blk, const AdjacencyOffset &offsets );
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: A pixel removed by its range.
+     * @param tgt: A pixel of another range.
+     * @return true if the arc from src to tgt could change the result of the range of tgt.
+     * @brief Seeds and pixels not conquered change if src offers them a better cost than their initial one. Other
+     * pixels change their position in the queue if src offers them a cost in the same or in a better bucket.
+     * @warning none.
+     */
+    bool Crossing( size_t src, size_t tgt );
+
+    /**
+     * @date 2026/Oct/17
+     * @param offsets: Adjacency offsets for the image.
+     * @param reach: Largest displacement along the last dimension.
+     * @param merge: Set to true for each block that must be merged to the previous one.
+     * @return true if any boundary must be removed.
+     * @brief Verifies the arcs crossing the boundaries between ranges.
+     * @warning none.
+     */
+    bool Exchange( const AdjacencyOffset &offsets, size_t reach, Vector< char > &merge );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Sets the label and predecessor maps from the internal forest.
+     * @warning none.
+     */
+    void SetMaps( );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param value: Value map used in path propagation. It contains the input and output values.
+     * @param adjacency: adjacency relation defining neighborhood. Assumes central element being at position 0.
+     * @param function: Function used to initialize and propagate values.
+     * @param seed: A boolean Vector indicating the seeds.
+     * @param label: label map.
+     * @param predecessor: predecessor map.
+     * @param sequential_label: true for labeling each root with a new label.
+     * @param bucket_size: Size of a bucket in the bucket queue.
+     * @param fifo_tie: true for fifo tiebreak, and false for lifo tiebreak.
+     * @return none.
+     * @brief Constructor of parallel IFT object to run over images. Same arguments as StaticImageIFT.
+     * @warning Input image and adjacency must have compatible dimensions. Label, and predecessor maps are
+     * optional. PF must be the dynamic type of function. Q must have 64-bit identifiers (IntegerBucketQueue) for
+     * ranges with more than 2^31 pixels.
+     */
+    ParallelImageIFT( Image< D > &value, const Adjacency &adjacency, PF *function,
+                      const Vector< bool > *seed = nullptr, Image< L > *label = nullptr,
+                      Image< L > *predecessor = nullptr, bool sequential_label = false,
+                      long double bucket_size = 1.0, bool fifo_tie = true );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Runs IFT algorithm over image.
+     * @warning none.
+     */
+    void Run( );
+
+  };
+
+}
+
+#include "ParallelImageIFT.cpp"
+
+#endif
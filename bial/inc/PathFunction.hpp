@@ -137,7 +137,7 @@ namespace Bial {
      * function. This function makes IFT faster.
      * @warning none.
      */
-    virtual bool Capable( int index, int adj_index, BucketState adj_state ) = 0;
+    virtual bool Capable( size_t index, size_t adj_index, BucketState adj_state ) = 0;
 
     /**
      * @date 2013/Jun/28
@@ -147,7 +147,7 @@ namespace Bial {
      * @brief Updates adjacent pixel values and returns true if path_function is propagated.
      * @warning none.
      */
-    virtual bool Propagate( int index, int adj_index ) = 0;
+    virtual bool Propagate( size_t index, size_t adj_index ) = 0;
 
     /**
      * @date 2012/Sep/19
@@ -166,7 +166,7 @@ namespace Bial {
      *        this kind of map.
      * @warning none.
      */
-    virtual D BestValue( int index );
+    virtual D BestValue( size_t index );
 
     /**
      * @date 2013/Jun/28
@@ -17,6 +17,8 @@ namespace Bial {
   class Adjacency;
   template< class D >
   class Image;
+  template< class D >
+  class Vector;
 
   namespace Segmentation {
     
@@ -27,12 +29,26 @@ namespace Bial {
      * @return Image with each connected component labeled with a distinct label.
      * @brief Returns an image with each connected component labeled with a distinct label. Connectness is defined *
      * according to given adjacency relation. Every non-zero intensity pixel is considered belonging to the object. Only *
-     * zere intensity pixels belong to the background.
+     * zere intensity pixels belong to the background. Components are labeled from 1, in the order of their first
+     * pixel, and the background has label 0. Computed with union-find over blocks processed by the thread pool.
      * @warning none. 
      */
     template< class D >
     Image< int > ConnectedComponents( const Image< D > &input, const Adjacency &adj );
 
+    /**
+     * @date 2026/Oct/17
+     * @param input: Input image.
+     * @param adj: An adjacency relation.
+     * @param size: Returns the number of pixels of each label. Element 0 holds the number of background pixels.
+     * @return Image with each connected component labeled with a distinct label.
+     * @brief Same as ConnectedComponents( input, adj ), also returning the component sizes computed in the same
+     * pass.
+     * @warning none.
+     */
+    template< class D >
+    Image< int > ConnectedComponents( const Image< D > &input, const Adjacency &adj, Vector< size_t > &size );
+
     /**
      * @date 2016/Jun/27 
      * @param input: Input labeled component image.
@@ -44,6 +60,18 @@ namespace Bial {
      */
     Image< int > RemoveSmallComponents( const Image< int > &label, float fraction );
 
+    /**
+     * @date 2026/Oct/17
+     * @param label: Input labeled component image.
+     * @param size: Number of pixels of each label, as returned by ConnectedComponents.
+     * @param fraction: The fraction of components that should be removed.
+     * @return Labeled component image containing only the largest compoenents, according to the given fraction.
+     * @brief Same as RemoveSmallComponents( label, fraction ), using the given component sizes instead of counting
+     * them.
+     * @warning size must have an element for each label.
+     */
+    Image< int > RemoveSmallComponents( const Image< int > &label, const Vector< size_t > &size, float fraction );
+
   }
 
 }
@@ -24,36 +24,39 @@ namespace Bial {
      * @date 2013/Oct/08 
      * @param gradient: Gradient input image. 
      * @param radius: Radius for local minima detection.
+     * @param parallel: true for running the IFT over blocks of the image in the thread pool (ParallelImageIFT).
      * @return Label image from FSum segmentation algorithm. 
      * @brief Returns the label image from FSum segmentation algorithm using local minima as the leaking
      * points. 
      * @warning Gradient image is changed. It returns the cost map. 
      */
     template< class D >
-    Image< int > FSum( Image< D > &gradient, float radius = 1.1f );
+    Image< int > FSum( Image< D > &gradient, float radius = 1.1f, bool parallel = false );
 
     /**
      * @date 2013/Oct/08 
      * @param gradient: Gradient input image. 
      * @param seeds: Seed vector. 
+     * @param parallel: true for running the IFT over blocks of the image in the thread pool (ParallelImageIFT).
      * @return Label image from FSum segmentation algorithm. 
      * @brief Returns the label image from FSum segmentation algorithm using seeds as the leaking points. 
      * @warning Gradient image is changed. It returns the cost map. 
      */
     template< class D >
-    Image< int > FSum( Image< D > &gradient, const Vector< bool > &seeds );
+    Image< int > FSum( Image< D > &gradient, const Vector< bool > &seeds, bool parallel = false );
 
     /**
      * @date 2013/Oct/08 
      * @param gradient: Gradient input image. 
      * @param obj_seeds, bkg_seeds: Seed vectors for object and back ground respectively. 
+     * @param parallel: true for running the IFT over blocks of the image in the thread pool (ParallelImageIFT).
      * @return Label image from FSum segmentation algorithm. 
      * @brief Returns the label image from FSum segmentation algorithm using seeds as the leaking points. 
      * @warning Gradient image is changed. It returns the cost map. 
      */
     template< class D >
     Image< int > FSum( Image< D > &gradient, const Vector< size_t > &obj_seeds,
-                            const Vector< size_t > &bkg_seeds );
+                            const Vector< size_t > &bkg_seeds, bool parallel = false );
 
   }
 
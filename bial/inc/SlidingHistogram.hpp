@@ -0,0 +1,187 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Histogram of the pixels of an adjacency window sliding along image lines, for rank filters.
+ * <br> Description: Image values are first quantized to bins. Integer data with up to 65536 distinct values keep one
+ * bin per value. Other data, as float and llint, are ranked, with one bin per distinct value. The window is built
+ * once at the start of each line. Moving it to the next pixel only removes the pixels of the leaving adjacents and
+ * inserts the ones of the entering adjacents, as in Huang's algorithm, for any adjacency relation.
+ * <br> Integer bins are counted in a histogram split in coarse and fine bins, as in Perreault and Hebert, so that
+ * selecting a rank scans about the square root of the number of bins. Ranked data may have as many bins as pixels,
+ * so their window is kept as a sorted list of the bins of its elements instead. Its size follows the window, not the
+ * number of bins, insertion and removal move the elements after the bin, and selection is direct.
+ */
+
+#include "Common.hpp"
+#include "Vector.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#ifndef BIALSLIDINGHISTOGRAM_H
+#define BIALSLIDINGHISTOGRAM_H
+
+namespace Bial {
+
+  class Adjacency;
+
+  class SlidingHistogram {
+
+  protected:
+
+    /** @brief Number of elements of each bin. */
+    Vector< size_t > count;
+    /** @brief Number of elements of each group of coarse_size consecutive bins. */
+    Vector< size_t > coarse;
+    /** @brief Bins of the elements in increasing order, for sorted histograms. */
+    std::vector< uint > window;
+    /** @brief Number of bins in a coarse bin. */
+    size_t coarse_size;
+    /** @brief Number of elements in the histogram. */
+    size_t total;
+    /** @brief true if the histogram keeps the sorted window instead of counts. */
+    bool sorted;
+
+  public:
+
+    /** @brief Largest number of bins kept as coarse and fine bins. */
+    static const size_t max_direct_bins = 65536;
+
+    /**
+     * @date 2026/Oct/17
+     * @param bins: Number of bins.
+     * @param sorted: true to keep the sorted window, with memory proportional to the number of elements, instead of
+     * the counts of all bins.
+     * @return none.
+     * @brief Basic Constructor. Creates an empty histogram.
+     * @warning none.
+     */
+    SlidingHistogram( size_t bins, bool sorted );
+
+    /**
+     * @date 2026/Oct/17
+     * @param bins: Number of bins returned by Quantize for data of type D.
+     * @return true for non-integer data, or for more than max_direct_bins bins.
+     * @brief Chooses the histogram representation for the bins of Quantize. Histograms of such data keep the sorted
+     * window, as their number of bins may be up to the number of pixels.
+     * @warning none.
+     */
+    template< class D >
+    static bool Sorted( size_t bins );
+
+    /**
+     * @date 2026/Oct/17
+     * @param bin: A bin.
+     * @param elements: Number of elements to be inserted in bin.
+     * @return none.
+     * @brief Inserts elements in bin.
+     * @warning none.
+     */
+    void Insert( size_t bin, size_t elements = 1 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param bin: A bin.
+     * @param elements: Number of elements to be removed from bin.
+     * @return none.
+     * @brief Removes elements from bin.
+     * @warning bin must hold at least elements elements.
+     */
+    void Remove( size_t bin, size_t elements = 1 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param rank: Rank of an element, from 0.
+     * @return Bin of the element of the given rank in increasing order.
+     * @brief Selects the bin of the rank-th smallest element.
+     * @warning rank must be smaller than Size( ).
+     */
+    size_t Select( size_t rank ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of elements in the histogram.
+     * @brief Returns the number of elements in the histogram.
+     * @warning none.
+     */
+    size_t Size( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param data: Input data.
+     * @param size: Number of elements of data.
+     * @param bin: Returns the bin of each element of data.
+     * @param value: Returns the value of each bin.
+     * @return Number of bins.
+     * @brief Quantizes data to bins in the same order as their values, so that ranks of bins are ranks of values.
+     * Integer data spanning up to max_direct_bins values get one bin per value in their range. Other data get one
+     * bin per distinct value.
+     * @warning none.
+     */
+    template< class D >
+    static size_t Quantize( const D *data, size_t size, Vector< int > &bin, Vector< D > &value );
+
+    /**
+     * @date 2026/Oct/17
+     * @param dim: Dimensions of the image.
+     * @param bin: Bin of each pixel, as returned by Quantize.
+     * @param bins: Number of bins.
+     * @param sorted: Histogram representation, as returned by Sorted.
+     * @param adj: Adjacency relation defining the window.
+     * @param mask: Pixels that may enter the window, or nullptr for all pixels.
+     * @param first: First pixel of the range.
+     * @param last: One past the last pixel of the range.
+     * @param body: Function called as body( pxl, histogram ) for each pixel of [ first, last ), with the histogram
+     * of the adjacents of pxl inside the image domain and the mask.
+     * @return none.
+     * @brief Slides the adjacency window along the image lines of [ first, last ), calling body at each pixel.
+     * @warning body may insert elements in the histogram, but must remove them before returning.
+     */
+    static void Slide( const Vector< size_t > &dim, const Vector< int > &bin, size_t bins, bool sorted,
+                       const Adjacency &adj, const Vector< bool > *mask, size_t first, size_t last,
+                       const std::function< void( size_t, SlidingHistogram & ) > &body );
+
+  };
+
+  /* Inline member functions used in inner loops. ------------------------------------------------------------------- */
+
+  inline void SlidingHistogram::Insert( size_t bin, size_t elements ) {
+    total += elements;
+    if( sorted ) {
+      window.insert( std::upper_bound( window.begin( ), window.end( ), bin ), elements, static_cast< uint >( bin ) );
+      return;
+    }
+    count[ bin ] += elements;
+    coarse[ bin / coarse_size ] += elements;
+  }
+
+  inline void SlidingHistogram::Remove( size_t bin, size_t elements ) {
+    total -= elements;
+    if( sorted ) {
+      auto pos = std::lower_bound( window.begin( ), window.end( ), bin );
+      window.erase( pos, pos + elements );
+      return;
+    }
+    count[ bin ] -= elements;
+    coarse[ bin / coarse_size ] -= elements;
+  }
+
+  inline size_t SlidingHistogram::Size( ) const {
+    return( total );
+  }
+
+  template< class D >
+  inline bool SlidingHistogram::Sorted( size_t bins ) {
+    return( ( !std::numeric_limits< D >::is_integer ) || ( bins > max_direct_bins ) );
+  }
+
+}
+
+#include "SlidingHistogram.cpp"
+
+#endif
@@ -0,0 +1,154 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief IFT algorithm running on Images, statically dispatched on the path function and queue types.
+ * <br> Description: Same algorithm and constructor arguments as ImageIFT, but the path function and the queue are
+ * template arguments. Their member functions are called with qualified names, so that no virtual call nor member
+ * function pointer is left in the propagation loop, and the compiler is free to inline it. Label, predecessor, and
+ * sequential labeling choices are resolved once per Run, instead of once per visited arc.
+ * <br> Label and predecessor maps may be Image< llint > (L = llint) for images with more than 2^31 pixels. Combined
+ * with IntegerBucketQueue, no 32-bit element identifier is left. In that case, the path function does not receive
+ * the maps, and root labels are assigned by the engine.
+ * <br> Usage:
+ * @code
+ *   MaxPathFunction< Image, float > pf( gradient );
+ *   StaticImageIFT< float, MaxPathFunction< Image, float > > ift( value, adj, &pf, &seeds, &label );
+ *   ift.Run( );
+ * @endcode
+ * <br> Note: Inlining requires the path function and queue definitions to be visible. That is always the case with
+ * BIAL_IMPLICIT_BIN. With BIAL_EXPLICIT_LIB, virtual dispatch is avoided anyway.
+ */
+
+#include "Adjacency.hpp"
+#include "Common.hpp"
+#include "Image.hpp"
+#include "Vector.hpp"
+
+#ifndef BIALSTATICIMAGEIFT_H
+#define BIALSTATICIMAGEIFT_H
+
+#include "BucketQueue.hpp"
+#include "PathFunction.hpp"
+
+namespace Bial {
+
+  template< class D, class PF, class Q = BucketQueue, class L = int >
+  class StaticImageIFT {
+
+  protected:
+
+    /** @brief Static IFT attributes. */
+    Q *queue;
+    Image< D > &value;
+    const Adjacency &adjacency;
+    PF *function;
+    const Vector< bool > *seed;
+    Image< L > *label;
+    Image< L > *predecessor;
+    bool sequential_label;
+    llint next_label;
+    long double bucket_size;
+    bool fifo_tie;
+    bool dift_enb;
+    size_t dift_elm;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Creates the queue, initializes the path function and the maps, and inserts the seeds.
+     * @warning none.
+     */
+    void Initialize( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param map: Label or predecessor map.
+     * @return map, if it has int elements, or nullptr otherwise.
+     * @brief Returns the map handed to the path function. Path functions only deal with int maps.
+     * @warning none.
+     */
+    static Image< int > *PathFunctionMap( Image< int > *map );
+    static Image< int > *PathFunctionMap( Image< llint > *map );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Propagation loop specialized to the given labeling and predecessor choices.
+     * @warning none.
+     */
+    template< bool LABEL, bool PREDECESSOR, bool SEQUENTIAL >
+    void Propagate( );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param value: Value map used in path propagation. It contains the input and output values.
+     * @param adjacency: adjacency relation defining neighborhood. Assumes central element being at position 0.
+     * @param function: Function used to initialize and propagate values.
+     * @param seed: A boolean Vector indicating the seeds.
+     * @param label: label map.
+     * @param predecessor: predecessor map.
+     * @param sequential_label: true for labeling each root with a new label.
+     * @param bucket_size: Size of a bucket in the bucket queue.
+     * @param fifo_tie: true for fifo tiebreak, and false for lifo tiebreak.
+     * @return none.
+     * @brief Constructor of IFT object to run over images. Same arguments as ImageIFT.
+     * @warning Input image and adjacency must have compatible dimensions. Label, and predecessor maps are
+     * optional. PF must be the dynamic type of function. Otherwise, derived overrides are not called. With
+     * L = llint, path functions whose propagation reads the label map (e.g. oriented path functions) are not
+     * supported, and Q must have 64-bit identifiers (IntegerBucketQueue) for more than 2^31 pixels.
+     */
+    StaticImageIFT( Image< D > &value, const Adjacency &adjacency, PF *function,
+                    const Vector< bool > *seed = nullptr, Image< L > *label = nullptr,
+                    Image< L > *predecessor = nullptr, bool sequential_label = false,
+                    long double bucket_size = 1.0, bool fifo_tie = true );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Destructor.
+     * @warning none.
+     */
+    ~StaticImageIFT( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Runs IFT algorithm over image.
+     * @warning none.
+     */
+    void Run( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param elm: Target element.
+     * @return none.
+     * @brief Enables differential IFT. Runs until target element is reached.
+     * @warning none.
+     */
+    void EnableDifferentialIFT( size_t elm );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Disables differential IFT. Runs until all elements leave the queue.
+     * @warning none.
+     */
+    void DisableDifferentialIFT( );
+
+  };
+
+}
+
+#include "StaticImageIFT.cpp"
+
+#endif
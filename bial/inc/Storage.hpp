@@ -0,0 +1,223 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Aligned and pooled storage of the data of Vector, Matrix and Image.
+ * <br> Description: Buffers are aligned to 64 bytes, the size of a cache line and of an AVX-512 register. Buffers
+ * of at least 2 MiB are aligned to 2 MiB and, on Linux, advised to use transparent huge pages. Buffers of at least
+ * 64 KiB are rounded up to size classes, four per power of two, and released buffers are kept in a pool, up to a
+ * limit, so that intermediate images of the same shape reuse the same memory instead of returning it to the system.
+ * Smaller buffers go directly to the system allocator.
+ * <br> StorageAllocator constructs elements without arguments by default-initialization, so that buffers of
+ * arithmetic types that are overwritten right away are not zeroed. Vector zeroes its elements explicitly, unless
+ * constructed with StorageInit::None.
+ * <br> Compile with BIAL_STD_ALLOCATOR to use std::allocator instead.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALSTORAGE_H
+#define BIALSTORAGE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Bial {
+
+  /** @brief Initialization of the elements of a new buffer. None leaves elements of arithmetic types undefined. */
+  enum class StorageInit : char {
+    Zero,
+    None
+  };
+
+  class Storage {
+
+  public:
+
+    /** @brief Alignment of all buffers. */
+    static const size_t ALIGNMENT = 64;
+    /** @brief Smallest buffer aligned to and advised to use huge pages. */
+    static const size_t HUGE_PAGE = 2097152;
+    /** @brief Smallest buffer rounded to a size class and kept in the pool when released. */
+    static const size_t MIN_POOLED = 65536;
+    /** @brief Default largest number of bytes kept in the pool. */
+    static const size_t DEFAULT_POOL_LIMIT = 1073741824;
+
+  protected:
+
+    /** @brief Released buffers by size class, and counters. */
+    struct Pool {
+      std::mutex mutex;
+      std::unordered_map< size_t, std::vector< void* > > blocks;
+      std::atomic< size_t > in_use;
+      std::atomic< size_t > peak;
+      std::atomic< size_t > pooled;
+      std::atomic< size_t > limit;
+      Pool( ) : in_use( 0 ), peak( 0 ), pooled( 0 ), limit( DEFAULT_POOL_LIMIT ) {
+      }
+    };
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return The pool.
+     * @brief Returns the pool, created on first use and never destroyed, so that buffers released by static
+     * objects at exit are still valid.
+     * @warning none.
+     */
+    static Pool &Instance( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param bytes: Requested number of bytes.
+     * @return Number of bytes of the buffer.
+     * @brief Rounds small buffers up to the alignment, and pooled buffers up to their size class.
+     * @warning none.
+     */
+    static size_t SizeClass( size_t bytes );
+
+    /**
+     * @date 2026/Oct/17
+     * @param bytes: Size of the buffer, given by SizeClass.
+     * @return Pointer to the buffer.
+     * @brief Allocates an aligned buffer from the system.
+     * @warning Throws bad_alloc on failure.
+     */
+    static void *SystemAllocate( size_t bytes );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param bytes: Number of bytes.
+     * @return Pointer to a buffer with at least bytes bytes, aligned to ALIGNMENT.
+     * @brief Allocates a buffer, reusing a pooled one of the same size class if available.
+     * @warning Throws bad_alloc on failure.
+     */
+    static void *Allocate( size_t bytes );
+
+    /**
+     * @date 2026/Oct/17
+     * @param ptr: Buffer given by Allocate.
+     * @param bytes: Number of bytes given to Allocate.
+     * @return none.
+     * @brief Releases the buffer to the pool, or to the system if it is small or the pool is full.
+     * @warning none.
+     */
+    static void Release( void *ptr, size_t bytes ) noexcept;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of bytes.
+     * @brief Bytes of the buffers in use, highest bytes in use since the start or the last ResetPeak, and bytes of
+     * the buffers kept in the pool.
+     * @warning none.
+     */
+    static size_t BytesInUse( );
+    static size_t PeakBytes( );
+    static size_t PooledBytes( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Sets the peak to the bytes in use.
+     * @warning none.
+     */
+    static void ResetPeak( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param bytes: Largest number of bytes kept in the pool. 0 disables the pool.
+     * @return none.
+     * @brief Sets the largest number of bytes kept in the pool, releasing buffers beyond it.
+     * @warning none.
+     */
+    static void PoolLimit( size_t bytes );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Returns all pooled buffers to the system.
+     * @warning none.
+     */
+    static void Trim( );
+
+  };
+
+  /** @brief Allocator of Storage buffers. Elements constructed without arguments are default-initialized. */
+  template< class D >
+  class StorageAllocator {
+
+  public:
+
+    typedef D value_type;
+
+    template< class U >
+    struct rebind {
+      typedef StorageAllocator< U > other;
+    };
+
+    StorageAllocator( ) noexcept {
+    }
+
+    template< class U >
+    StorageAllocator( const StorageAllocator< U > & ) noexcept {
+    }
+
+    D *allocate( size_t n ) {
+      if( n > static_cast< size_t >( -1 ) / sizeof( D ) ) {
+        throw( std::bad_alloc( ) );
+      }
+      return( static_cast< D* >( Storage::Allocate( n * sizeof( D ) ) ) );
+    }
+
+    void deallocate( D *ptr, size_t n ) noexcept {
+      Storage::Release( ptr, n * sizeof( D ) );
+    }
+
+    template< class U >
+    void construct( U *ptr ) {
+      ::new( static_cast< void* >( ptr ) ) U;
+    }
+
+    template< class U, class ... Args >
+    void construct( U *ptr, Args && ... args ) {
+      ::new( static_cast< void* >( ptr ) ) U( std::forward< Args >( args ) ... );
+    }
+
+  };
+
+  template< class D, class U >
+  bool operator==( const StorageAllocator< D > &, const StorageAllocator< U > & ) noexcept {
+    return( true );
+  }
+
+  template< class D, class U >
+  bool operator!=( const StorageAllocator< D > &, const StorageAllocator< U > & ) noexcept {
+    return( false );
+  }
+
+  /** @brief Allocator of the data of Vector. */
+#ifdef BIAL_STD_ALLOCATOR
+  template< class D >
+  using BufferAllocator = std::allocator< D >;
+#else
+  template< class D >
+  using BufferAllocator = StorageAllocator< D >;
+#endif
+
+}
+
+#include "Storage.cpp"
+
+#endif
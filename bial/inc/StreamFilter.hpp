@@ -0,0 +1,203 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Out-of-core execution of chains of local filters.
+ * <br> Description: Local filters, as Gaussian, mean and median filters, dilation, erosion and Sobel gradient, only
+ * need the pixels within a bounded distance, the halo, of each pixel. StreamFilter reads the input volume in slabs of
+ * slices, along its last dimension, each one extended by the halo of the whole chain. The chain is applied to the
+ * slab and its central slices are written to the output file. The halo slices shared by consecutive slabs are
+ * copied, not read again, so that compressed files are read only once, in order. While a slab is filtered, the next
+ * one is read and the previous result is written by separate threads. Memory is bounded by a few slabs, whatever the
+ * volume size, and the result equals that of the filters applied to the whole volume.
+ */
+
+#include "Common.hpp"
+
+#ifndef BIALSTREAMFILTER_H
+#define BIALSTREAMFILTER_H
+
+#include "Vector.hpp"
+#include <functional>
+
+namespace Bial {
+
+  class Adjacency;
+  template< class D >
+  class Image;
+
+  template< class D >
+  class StreamFilter {
+
+  public:
+
+    /** @brief Local operator. Must return an image of the same dimensions of its argument. */
+    typedef std::function< Image< D >( const Image< D > & ) > Operator;
+    /** @brief Receives the first slice and the number of slices to be read, and the destination. */
+    typedef std::function< void( size_t, size_t, D* ) > SliceReader;
+    /** @brief Receives the filtered slab to be written. */
+    typedef std::function< void( const Image< D > & ) > SlabWriter;
+
+    /** @brief Default number of output slices of each slab. */
+    static const size_t DEFAULT_SLAB = 32;
+
+  private:
+
+    /** @brief Operators of the chain, in order, and their halos. */
+    std::vector< Operator > operation;
+    std::vector< size_t > halo;
+    /** @brief Number of output slices of each slab. */
+    size_t slab;
+
+    /**
+     * @date 2026/Oct/17
+     * @param src: Slab extended by the halo.
+     * @param first: First output slice in src.
+     * @param slices: Number of output slices.
+     * @return Output slices of the slab.
+     * @brief Applies the chain to src and crops the output slices.
+     * @warning Throws logic_error if an operator changes the image dimensions.
+     */
+    Image< D > Apply( const Image< D > &src, size_t first, size_t slices ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param spc_dim: Dimensions of the whole image.
+     * @param pixel_size: Pixel size of the whole image.
+     * @param read: Reads slices of the input. Slices are requested once each, in increasing order.
+     * @param write: Writes filtered slabs. Slabs are given in increasing order.
+     * @return none.
+     * @brief Runs the pipeline: while a slab is filtered, the next one is read and the previous one is written.
+     * Parallel loops inside read and write, as Nifti conversion or gzip inflation, run serially in their threads, so
+     * that the thread pool is left to the operators.
+     * @warning Exceptions of read and write are rethrown in the calling thread.
+     */
+    void Execute( const Vector< size_t > &spc_dim, const Vector< float > &pixel_size, const SliceReader &read,
+                  const SlabWriter &write ) const;
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param slab_size: Number of output slices of each slab.
+     * @return none.
+     * @brief Basic Constructor. Creates an empty chain.
+     * @warning Throws logic_error if slab_size is 0.
+     */
+    StreamFilter( size_t slab_size = DEFAULT_SLAB );
+
+    /**
+     * @date 2026/Oct/17
+     * @param op: Local operator.
+     * @param op_halo: Largest distance, in slices, from a pixel to the pixels it depends on.
+     * @return Reference to this object, to chain further operators.
+     * @brief Appends op to the chain.
+     * @warning Results are wrong if op_halo is smaller than the true halo of op.
+     */
+    StreamFilter< D > &Add( const Operator &op, size_t op_halo );
+
+    /**
+     * @date 2026/Oct/17
+     * @param radius, std_dev: As in Filtering::Gaussian.
+     * @return Reference to this object.
+     * @brief Appends Filtering::Gaussian, with the halo of its kernel.
+     * @warning The correlation is always spatial. Filtering::Gaussian may switch to the frequency domain for large
+     * images, which rounds differently.
+     */
+    StreamFilter< D > &Gaussian( float radius = 2.0, float std_dev = 2.0 );
+
+    /**
+     * @date 2026/Oct/17
+     * @param radius: As in Filtering::Mean and Filtering::Median.
+     * @return Reference to this object.
+     * @brief Appends Filtering::Mean or Filtering::Median, with the halo of their adjacency.
+     * @warning none.
+     */
+    StreamFilter< D > &Mean( float radius );
+    StreamFilter< D > &Median( float radius );
+
+    /**
+     * @date 2026/Oct/17
+     * @param adjacency: Structuring element.
+     * @return Reference to this object.
+     * @brief Appends Morphology::Dilate or Morphology::Erode, with the halo of adjacency.
+     * @warning none.
+     */
+    StreamFilter< D > &Dilate( const Adjacency &adjacency );
+    StreamFilter< D > &Erode( const Adjacency &adjacency );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Reference to this object.
+     * @brief Appends the magnitude of Gradient::Sobel, with halo 1.
+     * @warning The correlations are always spatial, as in Gaussian.
+     */
+    StreamFilter< D > &Sobel( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of operators, and halo of the whole chain.
+     * @brief The halo of the chain is the sum of the halos of its operators.
+     * @warning none.
+     */
+    size_t size( ) const;
+    size_t Halo( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param adj: An adjacency or kernel.
+     * @return Largest displacement of adj in any dimension, rounded up.
+     * @brief Returns the halo of an operator based on adj.
+     * @warning none.
+     */
+    static size_t Halo( const Adjacency &adj );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Number of output slices of each slab.
+     * @brief Returns the slab size.
+     * @warning none.
+     */
+    size_t SlabSize( ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param slab_size: Number of output slices of each slab.
+     * @return none.
+     * @brief Sets the slab size. Memory grows with it, and the halo overhead shrinks.
+     * @warning Throws logic_error if slab_size is 0.
+     */
+    void SlabSize( size_t slab_size );
+
+    /**
+     * @date 2026/Oct/17
+     * @param img: Input image.
+     * @return Filtered image.
+     * @brief Applies the chain to img slab by slab, so that the memory used by the operators is bounded.
+     * @warning none.
+     */
+    Image< D > Run( const Image< D > &img ) const;
+
+    /**
+     * @date 2026/Oct/17
+     * @param src_filename: Nifti file, compressed or not, or chunked volume (.bvol).
+     * @param dst_filename: Nifti file, compressed or not, with data type D.
+     * @return none.
+     * @brief Filters src_filename into dst_filename slab by slab. Uncompressed Nifti files are read through a
+     * mapping, and chunked volumes by regions. Compressed Nifti files are read sequentially.
+     * @warning Throws logic_error for other formats, and runtime_error for multi-channel or time series files.
+     */
+    void Run( const std::string &src_filename, const std::string &dst_filename ) const;
+
+  };
+
+}
+
+#include "StreamFilter.cpp"
+
+#endif
@@ -0,0 +1,208 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief
+ * Content: Library-wide persistent thread pool.
+ * <br> Description: Workers are created once and reused by every multi-thread entry point of the library. Parallel
+ * loops split their index range among the workers, and idle workers steal half of the remaining range of a busy one,
+ * so that unbalanced loads are redistributed. The number of workers may be changed at runtime, or through the
+ * BIAL_THREADS environment variable.
+ */
+
+#ifndef BIALTHREADPOOL_H
+#define BIALTHREADPOOL_H
+
+#include "Common.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+
+namespace Bial {
+
+  /** @brief Persistent work-stealing thread pool shared by all multi-thread functions of the library. */
+  class ThreadPool {
+
+  private:
+
+    /** @brief Index range still to be processed by one worker. Thieves take elements from its end. */
+    struct WorkRange {
+      std::mutex lock;
+      size_t first;
+      size_t last;
+    };
+
+    std::vector< std::thread > worker; /** @brief Persistent worker threads. The calling thread acts as slot 0. */
+    std::vector< std::unique_ptr< WorkRange > > range; /** @brief Remaining range of each slot. */
+    std::atomic< size_t > slots; /** @brief Number of slots. Read without locking, so that jobs may query it. */
+    std::mutex job_mutex; /** @brief Serializes jobs from different calling threads and pool resizing. */
+    std::mutex state_mutex; /** @brief Protects generation, active, stop, and error. */
+    std::condition_variable wake; /** @brief Signals workers that a new job is available. */
+    std::condition_variable done; /** @brief Signals the calling thread that all workers finished. */
+    const std::function< void( size_t, size_t ) > *body; /** @brief Loop body of current job. */
+    size_t grain; /** @brief Number of elements taken by a worker at once. */
+    size_t generation; /** @brief Job counter. Workers wake up when it changes. */
+    size_t active; /** @brief Number of workers still running the current job. */
+    bool stop; /** @brief Whether workers must exit. */
+    std::exception_ptr error; /** @brief First exception thrown by the current job. */
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Basic Constructor. Creates the number of workers given by BIAL_THREADS environment variable, or the
+     * number of hardware threads.
+     * @warning none.
+     */
+    ThreadPool( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return none.
+     * @brief Destructor. Stops and joins all workers.
+     * @warning none.
+     */
+    ~ThreadPool( );
+
+    ThreadPool( const ThreadPool & ) = delete;
+    ThreadPool &operator=( const ThreadPool & ) = delete;
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return Reference to the library thread pool.
+     * @brief Returns the library thread pool, creating it in the first call.
+     * @warning none.
+     */
+    static ThreadPool &Instance( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param total_threads: number of slots, including the calling thread.
+     * @return none.
+     * @brief Stops current workers and creates total_threads - 1 new ones. If a worker cannot be created, the pool
+     * runs with the ones already created.
+     * @warning Must be called with job_mutex locked.
+     */
+    void Resize( size_t total_threads );
+
+    /**
+     * @date 2026/Oct/17
+     * @param slot: slot of the worker.
+     * @param seen: generation of the last job before the worker was created.
+     * @return none.
+     * @brief Main loop of a persistent worker.
+     * @warning none.
+     */
+    void WorkerLoop( size_t slot, size_t seen );
+
+    /**
+     * @date 2026/Oct/17
+     * @param slot: slot of the running thread.
+     * @return none.
+     * @brief Runs the current job body over the slot range, then steals from other slots until all ranges are
+     * empty.
+     * @warning none.
+     */
+    void Execute( size_t slot );
+
+    /**
+     * @date 2026/Oct/17
+     * @param slot: slot of the running thread.
+     * @param first: first element of the resulting chunk.
+     * @param last: one past the last element of the resulting chunk.
+     * @return true if a chunk was taken from the slot range.
+     * @brief Takes up to grain elements from the beginning of the slot range.
+     * @warning none.
+     */
+    bool Pop( size_t slot, size_t &first, size_t &last );
+
+    /**
+     * @date 2026/Oct/17
+     * @param slot: slot of the running thread.
+     * @param first: first element of the resulting chunk.
+     * @param last: one past the last element of the resulting chunk.
+     * @return true if any work was stolen.
+     * @brief Steals the second half of the range of another slot, keeps it as the slot range, and returns its
+     * first chunk.
+     * @warning none.
+     */
+    bool Steal( size_t slot, size_t &first, size_t &last );
+
+  public:
+
+    /**
+     * @date 2026/Oct/17
+     * @param none.
+     * @return The number of threads used by parallel loops, including the calling thread.
+     * @brief Returns the number of threads used by parallel loops.
+     * @warning none.
+     */
+    static size_t Threads( );
+
+    /**
+     * @date 2026/Oct/17
+     * @param total_threads: number of threads used by parallel loops. 0 sets the number of hardware threads.
+     * @return none.
+     * @brief Sets the number of threads used by parallel loops.
+     * @warning Waits for running jobs to finish.
+     */
+    static void Threads( size_t total_threads );
+
+    /**
+     * @date 2026/Oct/17
+     * @param elements: number of elements to be processed.
+     * @return A suitable number of tasks to split elements among threads.
+     * @brief Returns a number of tasks larger than the number of threads, so that work stealing can balance
+     * unequal tasks, and never larger than the number of elements.
+     * @warning none.
+     */
+    static size_t Tasks( size_t elements );
+
+    /**
+     * @date 2026/Oct/17
+     * @param first: first index of the loop.
+     * @param last: one past the last index of the loop.
+     * @param grain: minimum number of consecutive indexes processed by a single call to body.
+     * @param body: function called with subranges [ begin, end ) of [ first, last ).
+     * @return none.
+     * @brief Runs body over disjoint subranges that cover [ first, last ) using all pool threads. Returns after all
+     * subranges are processed. If body throws, the first exception is rethrown to the caller.
+     * @warning Nested calls from inside body run serially in the calling thread.
+     */
+    static void ParallelFor( size_t first, size_t last, size_t grain,
+                             const std::function< void( size_t, size_t ) > &body );
+
+    /**
+     * @date 2026/Oct/17
+     * @param total_tasks: number of tasks.
+     * @param task: function called as task( thread, total_tasks ) for every thread in [ 0, total_tasks ).
+     * @return none.
+     * @brief Runs total_tasks tasks using all pool threads. This is the interface for functions with the
+     * ( thread, total_threads ) partitioning, such as CorrelationThreads.
+     * @warning none.
+     */
+    static void Run( size_t total_tasks, const std::function< void( size_t, size_t ) > &task );
+
+    /**
+     * @date 2026/Oct/17
+     * @param body: function to be run.
+     * @return none.
+     * @brief Runs body in the calling thread, with every parallel loop inside it run serially, as a nested loop.
+     * Threads that run alongside a parallel computation, as prefetchers, use it so that they neither wait for nor
+     * delay the jobs of the pool.
+     * @warning none.
+     */
+    static void Serial( const std::function< void( ) > &body );
+
+  };
+
+}
+
+#include "ThreadPool.cpp"
+
+#endif
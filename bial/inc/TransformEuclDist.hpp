@@ -5,6 +5,9 @@
 /**
  * @date 2014/Jan/07
  * @brief Euclidean Distance Transform
+ * <br> Description: Exact Euclidean distance transform computed by separable passes of squared distances along each
+ * dimension, using the lower envelope of parabolas of Felzenszwalb and Huttenlocher. Each pass is linear in the
+ * number of pixels, and its lines are processed by the thread pool.
  */
 
 #ifndef BIALTRANSFORMEUCLDIST_H
@@ -16,6 +19,8 @@ namespace Bial {
 
   template< class D >
   class Image;
+  template< class D >
+  class Vector;
 
   namespace Transform {
 
@@ -23,19 +28,43 @@ namespace Bial {
      * @date 2015/May/21
      * @param border: Border of binary image.
      * @return Distance map from the Euclidean distance transform.
-     * @brief Computes the Euclidean distance transform, starting from border pixels.
-     * @warning This function should use pixel dimensions but is not using yet.
+     * @brief Computes the exact Euclidean distance transform, starting from border pixels. Distances are measured in
+     * pixel size units.
+     * @warning Pixels are at the maximum value of D if there are no border pixels.
      */
     template< class D >
     Image< D > EDT( const Image< D > &border );
 
+    /**
+     * @date 2026/Oct/17
+     * @param border: Border of binary image.
+     * @return Squared distance map from the Euclidean distance transform.
+     * @brief Computes the exact squared Euclidean distance transform, starting from border pixels. Distances are
+     * measured in pixel size units.
+     * @warning Pixels are at infinity if there are no border pixels.
+     */
+    template< class D >
+    Image< double > SquaredEDT( const Image< D > &border );
+
+    /**
+     * @date 2026/Oct/17
+     * @param line: Line of squared distances, to be transformed in place. Infinity for pixels with no distance yet.
+     * @param spacing: Distance between consecutive pixels of line.
+     * @return none.
+     * @brief Computes the lower envelope of the parabolas rooted at each pixel of line, so that each pixel gets the
+     * minimum of its squared distance to pixel q plus line[ q ], for all q.
+     * @warning none.
+     */
+    void SquaredDistanceLine( Vector< double > &line, double spacing );
+
     /**
      * @date 2014/Jan/07
      * @param border: Border of binary image.
      * @param mask: Binary image.
      * @return Distance map from the Euclidean distance transform.
-     * @brief Computes the Euclidean distance transform, starting from border pixels inside the mask region.
-     * @warning This function should use pixel dimensions but is not using yet.
+     * @brief Computes the exact Euclidean distance transform, starting from border pixels inside the mask region.
+     * Distances are measured in pixel size units. Pixels out of the mask have distance 0.
+     * @warning Distances are Euclidean, not geodesic: the paths may cross pixels out of the mask.
      */
     template< class D >
     Image< D > EDT( const Image< D > &border, const Image< D > &mask );
@@ -48,7 +77,8 @@ namespace Bial {
      * @return The root map of the inverse paths to a pixel that is at root_dist distance from the border.
      * @brief Computes the distance transform and then follows the paths backwards to a pixel that is at root_dist
      * distance from the border.
-     * @warning This function should use pixel dimensions but is not using yet.
+     * @warning The distance map follows the pixel size, but local maxima and backward paths are taken over a 1.8
+     * radius adjacency in pixel units, ignoring pixel size.
      */
     template< class D >
     Image< D > InverseEDT( const Image< D > &border, const Image< D > &mask, int root_dist );
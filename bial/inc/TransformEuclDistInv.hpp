@@ -27,7 +27,7 @@ namespace Bial {
      * @return The root map of the inverse paths to a pixel that is at root_dist distance from the border.
      * @brief Computes the distance transform and then follows the paths backwards to a pixel that is at root_dist
      * distance from the border.
-     * @warning This function should use pixel dimensions but is not using yet.
+     * @warning none.
      */
     template< class D >
     Image< D > InverseEDT( const Image< D > &border, const Image< D > &mask, int root_dist );
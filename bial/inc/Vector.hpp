@@ -17,6 +17,8 @@
 #ifndef BIALVECTOR_H
 #define BIALVECTOR_H
 
+#include "Storage.hpp"
+
 namespace Bial {
 
   template< class D >
@@ -25,12 +27,20 @@ namespace Bial {
     template< class D2 >
     friend class Vector;
 
+  public:
+
+    /** @brief Iterators of the elements. */
+    typedef typename std::vector< D, BufferAllocator< D > >::iterator iterator;
+    typedef typename std::vector< D, BufferAllocator< D > >::const_iterator const_iterator;
+    typedef typename std::vector< D, BufferAllocator< D > >::reverse_iterator reverse_iterator;
+    typedef typename std::vector< D, BufferAllocator< D > >::const_reverse_iterator const_reverse_iterator;
+
   protected:
 
     /**
-     * @brief  data vector
+     * @brief  data vector, aligned and pooled by Storage.
      */
-    std::vector< D, std::allocator< D > > _data;
+    std::vector< D, BufferAllocator< D > > _data;
 
     /**
      * @brief  Quick access reference for data.
@@ -63,6 +73,16 @@ namespace Bial {
     template< class D2 > Vector( const Vector< D2 > &src );
     template< class D2 > Vector( const std::vector< D2 > &src );
 
+    /**
+     * @date 2026/Oct/17
+     * @param n: Number of elements.
+     * @param init: Initialization of the elements.
+     * @return none.
+     * @brief Constructor of n elements. StorageInit::None skips zeroing, for buffers that are overwritten right away.
+     * @warning With StorageInit::None, elements of arithmetic types are undefined.
+     */
+    Vector( size_t n, StorageInit init );
+
     /**
      * @date 2015/Set/10
      * @param new_data: Pointer to data allocated elsewhere.
@@ -146,18 +166,18 @@ namespace Bial {
      * @brief Iterators.
      * @warning none.
      */
-    typename std::vector< D >::iterator begin( );
-    typename std::vector< D >::const_iterator begin( ) const;
-    typename std::vector< D >::iterator end( );
-    typename std::vector< D >::const_iterator end( ) const;
-    typename std::vector< D >::reverse_iterator rbegin( );
-    typename std::vector< D >::const_reverse_iterator rbegin( ) const;
-    typename std::vector< D >::reverse_iterator rend( );
-    typename std::vector< D >::const_reverse_iterator rend( ) const;
-    typename std::vector< D >::const_iterator cbegin( ) const;
-    typename std::vector< D >::const_iterator cend( ) const;
-    typename std::vector< D >::const_reverse_iterator crbegin( ) const;
-    typename std::vector< D >::const_reverse_iterator crend( ) const;
+    typename Vector< D >::iterator begin( );
+    typename Vector< D >::const_iterator begin( ) const;
+    typename Vector< D >::iterator end( );
+    typename Vector< D >::const_iterator end( ) const;
+    typename Vector< D >::reverse_iterator rbegin( );
+    typename Vector< D >::const_reverse_iterator rbegin( ) const;
+    typename Vector< D >::reverse_iterator rend( );
+    typename Vector< D >::const_reverse_iterator rend( ) const;
+    typename Vector< D >::const_iterator cbegin( ) const;
+    typename Vector< D >::const_iterator cend( ) const;
+    typename Vector< D >::const_reverse_iterator crbegin( ) const;
+    typename Vector< D >::const_reverse_iterator crend( ) const;
 
     /**
      * @date 2015/Apr/01
@@ -393,14 +413,14 @@ namespace Bial {
      * @brief Inserts elements into the vector.
      * @warning none.
      */
-    typename std::vector< D >::iterator insert( typename std::vector< D >::iterator position, const D &val );
-    typename std::vector< D >::iterator insert( typename std::vector< D >::iterator position, size_t n,
+    typename Vector< D >::iterator insert( typename Vector< D >::iterator position, const D &val );
+    typename Vector< D >::iterator insert( typename Vector< D >::iterator position, size_t n,
                                                 const D &val );
     template< class InputIterator >
-    typename std::vector< D >::iterator insert( typename std::vector< D >::iterator position, InputIterator first,
+    typename Vector< D >::iterator insert( typename Vector< D >::iterator position, InputIterator first,
                                                 InputIterator last );
-    typename std::vector< D >::iterator insert( typename std::vector< D >::iterator position, D && val );
-    typename std::vector< D >::iterator insert( typename std::vector< D >::iterator position, 
+    typename Vector< D >::iterator insert( typename Vector< D >::iterator position, D && val );
+    typename Vector< D >::iterator insert( typename Vector< D >::iterator position, 
                                                 std::initializer_list< D > il );
 
     /**
@@ -410,9 +430,9 @@ namespace Bial {
      * @brief Removes elements from the vector.
      * @warning none.
      */
-    typename std::vector< D >::iterator erase( typename std::vector< D >::iterator position );
-    typename std::vector< D >::iterator erase( typename std::vector< D >::iterator first, 
-                                               typename std::vector< D >::iterator last );
+    typename Vector< D >::iterator erase( typename Vector< D >::iterator position );
+    typename Vector< D >::iterator erase( typename Vector< D >::iterator first, 
+                                               typename Vector< D >::iterator last );
 
     /**
      * @date 2015/Apr/01
@@ -440,7 +460,7 @@ namespace Bial {
      * @warning none.
      */
     template< class ... Args >
-    typename std::vector< D >::iterator emplace( typename std::vector< D >::const_iterator position, Args && ... args );
+    typename Vector< D >::iterator emplace( typename Vector< D >::const_iterator position, Args && ... args );
 
     /**
      * @date 2015/Apr/01
@@ -898,6 +918,31 @@ namespace Bial {
 
   template< class D > Vector< D >::Vector( size_t n ) try : _data( n ), qk_data( nullptr ), _size( n ) {
     qk_data = &_data[ 0 ];
+    std::fill( _data.begin( ), _data.end( ), D( ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D > Vector< D >::Vector( size_t n, StorageInit init ) try
+    : _data( n ), qk_data( nullptr ), _size( n ) {
+    qk_data = &_data[ 0 ];
+    if( init == StorageInit::Zero ) {
+      std::fill( _data.begin( ), _data.end( ), D( ) );
+    }
   }
   catch( std::bad_alloc &e ) {
     std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -1004,7 +1049,7 @@ namespace Bial {
   }
 
   template< class D > Vector< D >::Vector( const std::vector< D > &x ) try 
-    : _data( x ), qk_data( nullptr ), _size( x.size( ) ) {
+    : _data( x.begin( ), x.end( ) ), qk_data( nullptr ), _size( x.size( ) ) {
       qk_data = &_data[ 0 ];
     }
   catch( std::bad_alloc &e ) {
@@ -1025,7 +1070,8 @@ namespace Bial {
   }
 
   template< class D > Vector< D >::Vector( std::vector< D > &&x ) try 
-    : _data( std::move( x ) ), qk_data( nullptr ), _size( 0 ) {
+    : _data( std::make_move_iterator( x.begin( ) ), std::make_move_iterator( x.end( ) ) ), qk_data( nullptr ),
+      _size( 0 ) {
       qk_data = &_data[ 0 ];
       _size = _data.size( );
     }
@@ -1144,7 +1190,7 @@ namespace Bial {
   template< class D >
   Vector< D > &Vector< D >::operator=( const Vector< D > &x ) {
     try {
-      _data = std::vector< D >( x._size );
+      _data = std::vector< D, BufferAllocator< D > >( x._size );
       qk_data = &_data[ 0 ];
       _size = x._size;
 
@@ -1690,7 +1736,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::begin( ) {
+  typename Vector< D >::iterator Vector< D >::begin( ) {
     COMMENT( "Checking if this is a true Vector or just used as a Wrapper.", 4 );
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
@@ -1700,7 +1746,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Vector< D >::begin( ) const {
+  typename Vector< D >::const_iterator Vector< D >::begin( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1709,7 +1755,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::end( ) {
+  typename Vector< D >::iterator Vector< D >::end( ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1718,7 +1764,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Vector< D >::end( ) const {
+  typename Vector< D >::const_iterator Vector< D >::end( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1727,7 +1773,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::reverse_iterator Vector< D >::rbegin( ) {
+  typename Vector< D >::reverse_iterator Vector< D >::rbegin( ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1736,7 +1782,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Vector< D >::rbegin( ) const {
+  typename Vector< D >::const_reverse_iterator Vector< D >::rbegin( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1745,7 +1791,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::reverse_iterator Vector< D >::rend( ) {
+  typename Vector< D >::reverse_iterator Vector< D >::rend( ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1754,7 +1800,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Vector< D >::rend( ) const {
+  typename Vector< D >::const_reverse_iterator Vector< D >::rend( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1763,7 +1809,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Vector< D >::cbegin( ) const {
+  typename Vector< D >::const_iterator Vector< D >::cbegin( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1772,7 +1818,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Vector< D >::cend( ) const {
+  typename Vector< D >::const_iterator Vector< D >::cend( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1781,7 +1827,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Vector< D >::crbegin( ) const {
+  typename Vector< D >::const_reverse_iterator Vector< D >::crbegin( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1790,7 +1836,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Vector< D >::crend( ) const {
+  typename Vector< D >::const_reverse_iterator Vector< D >::crend( ) const {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -1824,7 +1870,11 @@ namespace Bial {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
     }
+    size_t old_size = _data.size( );
     _data.resize( n );
+    if( n > old_size ) {
+      std::fill( _data.begin( ) + old_size, _data.end( ), D( ) );
+    }
     qk_data = &_data[ 0 ];
     _size = n;
   }
@@ -2532,14 +2582,14 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::insert( typename std::vector< D >::iterator position,
+  typename Vector< D >::iterator Vector< D >::insert( typename Vector< D >::iterator position,
                                                            const D &val ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
     }
     try {
-      typename std::vector< D >::iterator res = _data.insert( position, val );
+      typename Vector< D >::iterator res = _data.insert( position, val );
       qk_data = &_data[ 0 ];
       _size = _data.size( );
       return( res );
@@ -2563,7 +2613,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::insert( typename std::vector< D >::iterator position,
+  typename Vector< D >::iterator Vector< D >::insert( typename Vector< D >::iterator position,
                                                            size_t n, const D &val ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
@@ -2595,7 +2645,7 @@ namespace Bial {
 
   template< class D >
   template< class InputIterator >
-  typename std::vector< D >::iterator Vector< D >::insert( typename std::vector< D >::iterator position,
+  typename Vector< D >::iterator Vector< D >::insert( typename Vector< D >::iterator position,
                                                            InputIterator first, InputIterator last ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
@@ -2626,7 +2676,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::insert( typename std::vector< D >::iterator position, D && val ) {
+  typename Vector< D >::iterator Vector< D >::insert( typename Vector< D >::iterator position, D && val ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -2656,7 +2706,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::insert( typename std::vector< D >::iterator position,
+  typename Vector< D >::iterator Vector< D >::insert( typename Vector< D >::iterator position,
                                                            std::initializer_list< D > il ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
@@ -2687,7 +2737,7 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::erase( typename std::vector< D >::iterator position ) {
+  typename Vector< D >::iterator Vector< D >::erase( typename Vector< D >::iterator position ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -2721,8 +2771,8 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Vector< D >::erase( typename std::vector< D >::iterator first,
-                                                          typename std::vector< D >::iterator last ) {
+  typename Vector< D >::iterator Vector< D >::erase( typename Vector< D >::iterator first,
+                                                          typename Vector< D >::iterator last ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
@@ -2789,14 +2839,14 @@ namespace Bial {
 
   template< class D >
   template< class ... Args >
-  typename std::vector< D >::iterator 
-  Vector< D >::emplace( typename std::vector< D >::const_iterator position, Args && ... args ) {
+  typename Vector< D >::iterator 
+  Vector< D >::emplace( typename Vector< D >::const_iterator position, Args && ... args ) {
     if( _data.size( ) != _size ) {
       std::string msg( BIAL_ERROR( "Vector wrapper cannot use this function." ) );
       throw( std::runtime_error( msg ) );
     }
     try {
-      typename std::vector< D >::iterator res = _data.emplace( position, std::forward< Args >( args ) ... );
+      typename Vector< D >::iterator res = _data.emplace( position, std::forward< Args >( args ) ... );
       qk_data = &_data[ 0 ];
       _size = _data.size( );
       return( res );
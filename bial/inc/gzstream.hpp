@@ -32,27 +32,32 @@
 #define GZSTREAM_H
 
 #include "Common.hpp"
+#include "GzipBlock.hpp"
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <vector>
 #include <zlib.h>
 
 namespace Bial {
 
   class gzstreambuf : public std::streambuf {
 private:
-    static const int bufferSize = 47 + 256; /* size of data buff */
-    /* totals 512 bytes under g++ for igzstream at the end. */
-    gzFile file; /* file handle for compressed file */
-    char buffer[ bufferSize ]; /* data buffer */
+    static const int bufferSize = 262144; /* size of data buff. Reads and writes of this size or more bypass it. */
+    gzFile file; /* file handle for compressed files not written by GzipBlockWriter */
+    std::vector< char > buffer; /* data buffer */
+    std::unique_ptr< GzipBlockReader > reader; /* random access reader for files written by GzipBlockWriter */
+    std::unique_ptr< GzipBlockWriter > writer; /* block-parallel compressor used for output */
     char opened; /* open/close state of stream */
     int mode; /* I/O mode */
     int flush_buffer( );
+    int read_buffer( char *s, int n ); /* reads decompressed data from reader or file */
 public:
-    gzstreambuf( ) try : opened( 0 ) {
-      setp( buffer, buffer + ( bufferSize - 1 ) );
-      setg( buffer + 4, /* beginning of putback area */
-            buffer + 4, /* read position */
-            buffer + 4 ); /* end position */
+    gzstreambuf( ) try : file( 0 ), buffer( bufferSize ), opened( 0 ) {
+      setp( buffer.data( ), buffer.data( ) + ( bufferSize - 1 ) );
+      setg( buffer.data( ) + 4, /* beginning of putback area */
+            buffer.data( ) + 4, /* read position */
+            buffer.data( ) + 4 ); /* end position */
       /* ASSERT: both input & output capabilities will not be used together */
     }
     catch( std::ios_base::failure &e ) {
@@ -89,6 +94,12 @@ public:
     virtual int overflow( int c = EOF );
     virtual int underflow( );
     virtual int sync( );
+    virtual std::streamsize xsgetn( char *s, std::streamsize n );
+    virtual std::streamsize xsputn( const char *s, std::streamsize n );
+    virtual std::streampos seekoff( std::streamoff off, std::ios_base::seekdir way,
+                                    std::ios_base::openmode which = std::ios_base::in | std::ios_base::out );
+    virtual std::streampos seekpos( std::streampos pos,
+                                    std::ios_base::openmode which = std::ios_base::in | std::ios_base::out );
   };
 
   class gzstreambase : virtual public std::ios {
@@ -428,7 +439,7 @@ public:
 /* Implementation ----------------------------------------------------------------------------------- */
 
 #include <iostream>
-#include <string.h> /* for memcpy */
+#include <string.h> /* for memcpy and memmove */
 
 namespace Bial {
 
@@ -445,20 +456,36 @@ namespace Bial {
           ( ( mode & std::ios::in ) && ( mode & std::ios::out ) ) ) {
         return( ( gzstreambuf* ) 0 );
       }
-      char fmode[ 10 ];
-      char *fmodeptr = fmode;
-      if( mode & std::ios::in ) {
-        *fmodeptr++ = 'r';
-      }
-      else if( mode & std::ios::out ) {
-        *fmodeptr++ = 'w';
+      if( mode & std::ios::out ) {
+        /* block-parallel compression, readable by any gzip tool */
+        try {
+          writer.reset( new GzipBlockWriter( name ) );
+        }
+        catch( std::ios_base::failure & ) {
+          return( ( gzstreambuf* ) 0 );
+        }
       }
-      *fmodeptr++ = 'b';
-      *fmodeptr = '\0';
-      file = gzopen( name, fmode );
-      if( file == 0 ) {
-        return( ( gzstreambuf* ) 0 );
+      else {
+        if( GzipBlockReader::IsIndexed( name ) ) {
+          /* file written by GzipBlockWriter: random access through its member index. The index is checked for
+           * every member. Files with later members lacking it, as the concatenation with another gzip file, are
+           * read by zlib. */
+          try {
+            reader.reset( new GzipBlockReader( name ) );
+          }
+          catch( std::ios_base::failure & ) {
+            reader.reset( );
+          }
+        }
+        if( !reader ) {
+          file = gzopen( name, "rb" );
+          if( file == 0 ) {
+            return( ( gzstreambuf* ) 0 );
+          }
+          gzbuffer( file, bufferSize );
+        }
       }
+      setg( buffer.data( ) + 4, buffer.data( ) + 4, buffer.data( ) + 4 );
       opened = 1;
       return( this );
     }
@@ -489,7 +516,23 @@ namespace Bial {
       if( is_open( ) ) {
         sync( );
         opened = 0;
-        if( gzclose( file ) == Z_OK ) {
+        if( writer ) {
+          std::unique_ptr< GzipBlockWriter > closing( std::move( writer ) );
+          try {
+            closing->Close( );
+          }
+          catch( std::ios_base::failure & ) {
+            return( ( gzstreambuf* ) 0 );
+          }
+          return( this );
+        }
+        if( reader ) {
+          reader.reset( );
+          return( this );
+        }
+        gzFile closing = file;
+        file = 0;
+        if( gzclose( closing ) == Z_OK ) {
           return( this );
         }
       }
@@ -530,16 +573,16 @@ namespace Bial {
       if( n_putback > 4 ) {
         n_putback = 4;
       }
-      memcpy( buffer + ( 4 - n_putback ), gptr( ) - n_putback, n_putback );
+      memmove( buffer.data( ) + ( 4 - n_putback ), gptr( ) - n_putback, n_putback );
 
-      int num = gzread( file, buffer + 4, bufferSize - 4 );
+      int num = read_buffer( buffer.data( ) + 4, bufferSize - 4 );
       if( num <= 0 ) { /* ERROR or EOF */
         return( EOF );
       }
       /* reset buffer pointers */
-      setg( buffer + ( 4 - n_putback ), /* beginning of putback area */
-            buffer + 4, /* read position */
-            buffer + 4 + num ); /* end of buffer */
+      setg( buffer.data( ) + ( 4 - n_putback ), /* beginning of putback area */
+            buffer.data( ) + 4, /* read position */
+            buffer.data( ) + 4 + num ); /* end of buffer */
 
       /* return next character */
       return( *reinterpret_cast< unsigned char* >( gptr( ) ) );
@@ -573,7 +616,10 @@ namespace Bial {
        * sync( ) operation.
        */
       int w = std::streambuf::pptr( ) - std::streambuf::pbase( );
-      if( gzwrite( file, std::streambuf::pbase( ), w ) != w ) {
+      try {
+        writer->Write( std::streambuf::pbase( ), w );
+      }
+      catch( std::ios_base::failure & ) {
         return( EOF );
       }
       pbump( -w );
@@ -668,6 +714,210 @@ namespace Bial {
     }
   }
 
+  inline int gzstreambuf::read_buffer( char *s, int n ) {
+    try {
+      if( reader ) {
+        return( static_cast< int >( reader->Read( s, static_cast< size_t >( n ) ) ) );
+      }
+      return( gzread( file, s, static_cast< unsigned >( n ) ) );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "I/O error while reading file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  inline std::streamsize gzstreambuf::xsgetn( char *s, std::streamsize n ) {
+    try {
+      std::streamsize done = std::min( n, static_cast< std::streamsize >( egptr( ) - gptr( ) ) );
+      if( done > 0 ) {
+        memcpy( s, gptr( ), done );
+        gbump( static_cast< int >( done ) );
+      }
+      if( ( n - done < bufferSize ) || !( mode & std::ios::in ) || !opened ) {
+        return( done + std::streambuf::xsgetn( s + done, n - done ) );
+      }
+      /* large reads are decompressed straight into the destination */
+      const std::streamsize chunk = 1 << 30;
+      while( done < n ) {
+        int num = read_buffer( s + done, static_cast< int >( std::min( n - done, chunk ) ) );
+        if( num <= 0 ) { /* ERROR or EOF */
+          break;
+        }
+        done += num;
+      }
+      setg( buffer.data( ) + 4, buffer.data( ) + 4, buffer.data( ) + 4 );
+      return( done );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "I/O error while reading file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  inline std::streamsize gzstreambuf::xsputn( const char *s, std::streamsize n ) {
+    try {
+      if( ( n < bufferSize ) || !( mode & std::ios::out ) || !opened ) {
+        return( std::streambuf::xsputn( s, n ) );
+      }
+      /* large writes go straight to the compressor */
+      if( flush_buffer( ) == EOF ) {
+        return( 0 );
+      }
+      try {
+        writer->Write( s, static_cast< size_t >( n ) );
+      }
+      catch( std::ios_base::failure & ) {
+        return( 0 );
+      }
+      return( n );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "I/O error while reading file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  inline std::streampos gzstreambuf::seekoff( std::streamoff off, std::ios_base::seekdir way,
+                                              std::ios_base::openmode ) {
+    try {
+      const std::streampos failure( std::streamoff( -1 ) );
+      if( !opened ) {
+        return( failure );
+      }
+      if( mode & std::ios::out ) {
+        /* only the current position, for tellp */
+        if( ( off != 0 ) || ( way != std::ios_base::cur ) ) {
+          return( failure );
+        }
+        return( std::streampos( static_cast< std::streamoff >( writer->Tell( ) ) + ( pptr( ) - pbase( ) ) ) );
+      }
+      std::streamoff current = ( reader ? static_cast< std::streamoff >( reader->Tell( ) ) : gztell( file ) ) -
+        ( egptr( ) - gptr( ) );
+      if( ( off == 0 ) && ( way == std::ios_base::cur ) ) {
+        return( std::streampos( current ) );
+      }
+      std::streamoff target = off;
+      if( way == std::ios_base::cur ) {
+        target = current + off;
+      }
+      else if( way == std::ios_base::end ) {
+        /* the uncompressed size is known only for indexed files */
+        if( !reader ) {
+          return( failure );
+        }
+        target = static_cast< std::streamoff >( reader->Size( ) ) + off;
+      }
+      if( target < 0 ) {
+        return( failure );
+      }
+      if( reader ) {
+        /* indexed files inflate only the member that contains target */
+        reader->Seek( static_cast< size_t >( target ) );
+      }
+      else if( gzseek( file, static_cast< z_off_t >( target ), SEEK_SET ) < 0 ) {
+        /* other files are inflated up to target, from their start if seeking backwards */
+        return( failure );
+      }
+      setg( buffer.data( ) + 4, buffer.data( ) + 4, buffer.data( ) + 4 );
+      return( std::streampos( target ) );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "I/O error while reading file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  inline std::streampos gzstreambuf::seekpos( std::streampos pos, std::ios_base::openmode which ) {
+    try {
+      return( seekoff( std::streamoff( pos ), std::ios_base::beg, which ) );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "I/O error while reading file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
   /* gzstreambase ------------------------------------------------------------------------------------ */
 
   inline gzstreambase::gzstreambase( const char *name, int mode ) {
@@ -0,0 +1,190 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Adjacency relation converted to linear offsets for a given image shape.
+ */
+
+#ifndef BIALADJACENCYOFFSET_C
+#define BIALADJACENCYOFFSET_C
+
+#include "AdjacencyOffset.hpp"
+#include "Image.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_AdjacencyOffset )
+#define BIAL_EXPLICIT_AdjacencyOffset
+#endif
+
+#if defined ( BIAL_EXPLICIT_AdjacencyOffset ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Color.hpp"
+
+namespace Bial {
+
+  AdjacencyOffset::AdjacencyOffset( const Adjacency &adj, const Vector< size_t > &dim ) try : dim_size( dim ) {
+    if( dim.size( ) == 0 ) {
+      std::string msg( BIAL_ERROR( "Dimension vector must not be empty." ) );
+      throw( std::logic_error( msg ) );
+    }
+    Initialize( adj );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D >
+  AdjacencyOffset::AdjacencyOffset( const Adjacency &adj, const Image< D > &img ) try : dim_size( img.Dim( ) ) {
+    COMMENT( "Keeping only the spatial dimensions used by the adjacency relation.", 4 );
+    if( img.Dims( ) == 2 ) {
+      dim_size.pop_back( );
+    }
+    Initialize( adj );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  void AdjacencyOffset::Initialize( const Adjacency &adj ) {
+    try {
+      size_t dims = dim_size.size( );
+      size_t adjs = adj.size( );
+      if( adj.Dims( ) < dims ) {
+        std::string msg( BIAL_ERROR( "Adjacency relation has less dimensions than the image. Adjacency dimensions: " +
+                                     std::to_string( adj.Dims( ) ) + ", image dimensions: " +
+                                     std::to_string( dims ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Computing accumulated dimension sizes.", 4 );
+      Vector< llint > acc_dim( dims, 1 );
+      for( size_t dms = 1; dms < dims; ++dms ) {
+        acc_dim[ dms ] = acc_dim[ dms - 1 ] * dim_size[ dms - 1 ];
+      }
+      data_limit = acc_dim[ dims - 1 ] * dim_size[ dims - 1 ];
+      COMMENT( "Computing linear offsets and displacement extent.", 4 );
+      offset = Vector< llint >( adjs, 0 );
+      displacement = Vector< float >( adjs * dims, 0.0f );
+      Vector< float > min_dsp( dims, 0.0f );
+      Vector< float > max_dsp( dims, 0.0f );
+      bool integral = true;
+      for( size_t idx = 0; idx < adjs; ++idx ) {
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          float dsp = adj.Displacement( dms, idx );
+          displacement[ idx * dims + dms ] = dsp;
+          offset[ idx ] += static_cast< llint >( dsp ) * acc_dim[ dms ];
+          min_dsp[ dms ] = std::min( min_dsp[ dms ], dsp );
+          max_dsp[ dms ] = std::max( max_dsp[ dms ], dsp );
+          if( dsp != std::floor( dsp ) ) {
+            integral = false;
+          }
+        }
+      }
+      COMMENT( "Computing interior limits. Non-integer displacements have no interior.", 4 );
+      lower = Vector< size_t >( dims, 0 );
+      upper = Vector< size_t >( dims, 0 );
+      if( integral ) {
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          size_t low = static_cast< size_t >( -min_dsp[ dms ] );
+          size_t high = static_cast< size_t >( max_dsp[ dms ] );
+          if( low + high < dim_size[ dms ] ) {
+            lower[ dms ] = low;
+            upper[ dms ] = dim_size[ dms ] - high;
+          }
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  size_t AdjacencyOffset::Checked( size_t position, size_t adj_index ) const {
+    size_t dims = dim_size.size( );
+    const float *dsp = &displacement[ adj_index * dims ];
+    size_t result = 0;
+    size_t factor = 1;
+    for( size_t dms = 0; dms < dims; ++dms ) {
+      llint coord = static_cast< llint >( ( position % dim_size[ dms ] ) + dsp[ dms ] );
+      if( ( coord < 0 ) || ( coord >= static_cast< llint >( dim_size[ dms ] ) ) ) {
+        return( data_limit );
+      }
+      result += coord * factor;
+      factor *= dim_size[ dms ];
+      position /= dim_size[ dms ];
+    }
+    return( result );
+  }
+
+  bool AdjacencyOffset::Interior( size_t position ) const {
+    for( size_t dms = 0; dms < dim_size.size( ); ++dms ) {
+      size_t coord = position % dim_size[ dms ];
+      if( ( coord < lower[ dms ] ) || ( coord >= upper[ dms ] ) ) {
+        return( false );
+      }
+      position /= dim_size[ dms ];
+    }
+    return( true );
+  }
+
+  size_t AdjacencyOffset::InteriorEnd( size_t position ) const {
+    if( !Interior( position ) ) {
+      return( position );
+    }
+    return( position + upper[ 0 ] - position % dim_size[ 0 ] );
+  }
+
+#ifdef BIAL_EXPLICIT_AdjacencyOffset
+
+  template AdjacencyOffset::AdjacencyOffset( const Adjacency &adj, const Image< int > &img );
+  template AdjacencyOffset::AdjacencyOffset( const Adjacency &adj, const Image< llint > &img );
+  template AdjacencyOffset::AdjacencyOffset( const Adjacency &adj, const Image< float > &img );
+  template AdjacencyOffset::AdjacencyOffset( const Adjacency &adj, const Image< double > &img );
+  template AdjacencyOffset::AdjacencyOffset( const Adjacency &adj, const Image< Color > &img );
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "AdjacencyRound.hpp"
 #include "AdjacencyIterator.hpp"
+#include "FilteringGaussian.hpp"
 #include "FilteringMean.hpp"
 #include "GeometricsScale.hpp"
 #include "Histogram.hpp"
@@ -93,7 +94,7 @@ namespace Bial {
 
     template< class D >
     Image< D > BiasSurfaceEstimation( const Image< D > &img, const Image< D > &msk, const Image< D > &cln_msk,
-                                      float radius, MRIModality modality ) {
+                                      float radius, MRIModality modality, float smooth_std_dev ) {
       try {
         COMMENT( "Preparing images for inhomogeity surface computing.", 0 );
         Adjacency small_adj = AdjacencyType::HyperSpheric( 1.0, img.Dims( ) );
@@ -144,6 +145,20 @@ namespace Bial {
             }
           }
         }
+        if( smooth_std_dev > 0.0f ) {
+          COMMENT( "Smoothing the bias field by masked recursive Gaussian: filtered field over filtered mask.", 0 );
+          Image< double > field( res );
+          Image< double > weight( msk );
+          for( size_t pxl = 0; pxl < msk.size( ); ++pxl )
+            weight[ pxl ] = ( msk[ pxl ] != 0 ) ? 1.0 : 0.0;
+          field = Filtering::RecursiveGaussian( field, smooth_std_dev );
+          weight = Filtering::RecursiveGaussian( weight, smooth_std_dev );
+          for( size_t pxl = 0; pxl < msk.size( ); ++pxl ) {
+            if( ( msk[ pxl ] != 0 ) && ( weight[ pxl ] > 0.0 ) )
+              res[ pxl ] = static_cast< D >( field[ pxl ] / weight[ pxl ] );
+          }
+          return( res );
+        }
         COMMENT( "Computing the mean to smooth the bias field.", 0 );
         res = Filtering::Mean( res, msk, 1.1 );
         return( res );
@@ -213,7 +228,7 @@ namespace Bial {
 
     template< class D >
     Image< D > InhomogeneityCorrection( const Image< D > &img, const Image< D > &msk, float radius,
-                                        size_t compression, MRIModality modality ) {
+                                        size_t compression, MRIModality modality, float smooth_std_dev ) {
       try {
         if( ( radius < 7.0 ) || ( radius > 28.0 ) ) {
           std::string msg( BIAL_ERROR( "Radius length must be between 7.0 and 28.0. Given: " +
@@ -243,7 +258,8 @@ namespace Bial {
         Image< D > cln_msk = RemoveIntensityOutliers( sub_img, sub_msk, compression, modality );
         sub_msk = Morphology::DilateBin( sub_msk, AdjacencyType::HyperSpheric( 1.9, img.Dims( ) ) );
         COMMENT( "Computing bias surface.", 0 );
-        Image< D > bias = BiasSurfaceEstimation( sub_img, sub_msk, cln_msk, radius / compression, modality );
+        Image< D > bias = BiasSurfaceEstimation( sub_img, sub_msk, cln_msk, radius / compression, modality,
+                                                 smooth_std_dev );
         COMMENT( "Converting bias image to the input format.", 0 );
         Vector< size_t > unframed_size( hgh_coord );
         for( size_t dms = 0; dms < unframed_size.size( ); ++dms )
@@ -282,39 +298,47 @@ namespace Bial {
     template Image< int > RemoveIntensityOutliers( const Image< int > &img, const Image< int > &msk, float compression,
                                                    MRIModality modality );
     template Image< int > BiasSurfaceEstimation( const Image< int > &img, const Image< int > &msk, 
-                                                 const Image< int > &cln_msk, float radius,  MRIModality modality );
+                                                 const Image< int > &cln_msk, float radius,  MRIModality modality,
+                                                 float smooth_std_dev );
     template Image< int > BiasSurfaceRemoval( const Image< int > &img, const Image< int > &msk, 
                                               const Image< int > &bias, MRIModality modality );
     template Image< int > InhomogeneityCorrection( const Image< int > &img, const Image< int > &msk, 
-                                                   float radius, size_t compression, MRIModality modality );
+                                                   float radius, size_t compression, MRIModality modality,
+                                                   float smooth_std_dev );
 
     template Image< llint > RemoveIntensityOutliers( const Image< llint > &img, const Image< llint > &msk,
                                                      float compression, MRIModality modality );
     template Image< llint > BiasSurfaceEstimation( const Image< llint > &img, const Image< llint > &msk, 
-                                                   const Image< llint > &cln_msk, float radius, MRIModality modality );
+                                                   const Image< llint > &cln_msk, float radius, MRIModality modality,
+                                                   float smooth_std_dev );
     template Image< llint > BiasSurfaceRemoval( const Image< llint > &img, const Image< llint > &msk, 
                                                 const Image< llint > &bias, MRIModality modality );
     template Image< llint > InhomogeneityCorrection( const Image< llint > &img, const Image< llint > &msk, 
-                                                     float radius, size_t compression, MRIModality modality );
+                                                     float radius, size_t compression, MRIModality modality,
+                                                     float smooth_std_dev );
 
     template Image< float > RemoveIntensityOutliers( const Image< float > &img, const Image< float > &msk, 
                                                      float compression, MRIModality modality );
     template Image< float > BiasSurfaceEstimation( const Image< float > &img, const Image< float > &msk, 
-                                                   const Image< float > &cln_msk, float radius, MRIModality modality );
+                                                   const Image< float > &cln_msk, float radius, MRIModality modality,
+                                                   float smooth_std_dev );
     template Image< float > BiasSurfaceRemoval( const Image< float > &img, const Image< float > &msk, 
                                                 const Image< float > &bias, MRIModality modality );
     template Image< float > InhomogeneityCorrection( const Image< float > &img, const Image< float > &msk, 
-                                                     float radius, size_t compression, MRIModality modality );
+                                                     float radius, size_t compression, MRIModality modality,
+                                                     float smooth_std_dev );
 
     template Image< double > RemoveIntensityOutliers( const Image< double > &img, const Image< double > &msk,
                                                       float compression, MRIModality modality );  
     template Image< double > BiasSurfaceEstimation( const Image< double > &img, const Image< double > &msk, 
                                                     const Image< double > &cln_msk, float radius, 
-                                                    MRIModality modality );
+                                                    MRIModality modality,
+                                                    float smooth_std_dev );
     template Image< double > BiasSurfaceRemoval( const Image< double > &img, const Image< double > &msk, 
                                                  const Image< double > &bias, MRIModality modality );
     template Image< double > InhomogeneityCorrection( const Image< double > &img, const Image< double > &msk, 
-                                                      float radius, size_t compression, MRIModality modality );
+                                                      float radius, size_t compression, MRIModality modality,
+                                                      float smooth_std_dev );
 
 #endif
 
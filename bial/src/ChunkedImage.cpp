@@ -0,0 +1,1030 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Chunked on-disk volumes, loaded lazily by region.
+ */
+
+#ifndef BIALCHUNKEDIMAGE_C
+#define BIALCHUNKEDIMAGE_C
+
+#include "ChunkedImage.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_ChunkedImage )
+#define BIAL_EXPLICIT_ChunkedImage
+#endif
+
+#if defined ( BIAL_EXPLICIT_ChunkedImage ) || ( BIAL_IMPLICIT_BIN )
+
+#include "File.hpp"
+#include "FileImage.hpp"
+#include "Image.hpp"
+#include "NiftiMapping.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace Bial {
+
+  template< class D >
+  const size_t ChunkedImage< D >::DEFAULT_CHUNK;
+  template< class D >
+  const size_t ChunkedImage< D >::DEFAULT_CACHE;
+  template< class D >
+  const size_t ChunkedImage< D >::HEADER;
+
+  /**
+   * @date 2026/Oct/17
+   * @param dst: Destination.
+   * @param val: Value to be stored.
+   * @param size: Number of bytes of the stored value.
+   * @return none.
+   * @brief Stores val in little endian.
+   * @warning none.
+   */
+  static void ChunkedStore( unsigned char *dst, size_t val, size_t size ) {
+    for( size_t byte = 0; byte < size; ++byte ) {
+      dst[ byte ] = static_cast< unsigned char >( ( val >> ( 8 * byte ) ) & 0xFF );
+    }
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param src: Source.
+   * @param size: Number of bytes of the stored value.
+   * @return Value stored in little endian.
+   * @brief Loads a little endian value.
+   * @warning none.
+   */
+  static size_t ChunkedLoad( const unsigned char *src, size_t size ) {
+    size_t val = 0;
+    for( size_t byte = 0; byte < size; ++byte ) {
+      val |= static_cast< size_t >( src[ byte ] ) << ( 8 * byte );
+    }
+    return( val );
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param type: Stored data type.
+   * @return Number of bytes of a pixel of the given type, or 0 for unsupported types.
+   * @brief Returns the size of a stored pixel.
+   * @warning none.
+   */
+  static size_t ChunkedTypeBytes( NiftiType type ) {
+    switch( type ) {
+    case NiftiType::INT8:
+    case NiftiType::UINT8:
+      return( 1 );
+    case NiftiType::INT16:
+    case NiftiType::UINT16:
+      return( 2 );
+    case NiftiType::INT32:
+    case NiftiType::UINT32:
+    case NiftiType::FLOAT32:
+      return( 4 );
+    case NiftiType::INT64:
+    case NiftiType::FLOAT64:
+      return( 8 );
+    default:
+      return( 0 );
+    }
+  }
+
+  /**
+   * @date 2026/Oct/17
+   * @param src: Stored pixels, of type S.
+   * @param size: Number of pixels.
+   * @param dst: Destination.
+   * @return none.
+   * @brief Converts stored pixels to D.
+   * @warning src does not need to be aligned to S.
+   */
+  template< class S, class D >
+  static void ChunkedConvert( const char *src, size_t size, D *dst ) {
+    for( size_t pxl = 0; pxl < size; ++pxl ) {
+      S val;
+      std::memcpy( &val, src + pxl * sizeof( S ), sizeof( S ) );
+      dst[ pxl ] = static_cast< D >( val );
+    }
+  }
+
+  template< class D >
+  ChunkedImage< D >::ChunkedImage( const std::string &filename, size_t cache_limit ) try
+    : mapping( filename ), type( NiftiType::FLOAT32 ), dims( 0 ), dim( 3, 1 ), chunk( 3, 1 ), chunks( 3, 1 ),
+      pixel_size( 3, 1.0f ), offset( ), bytes( ), lru( ), cache( ), cached_bytes( 0 ), cache_limit( cache_limit ),
+      mutex( ) {
+    const unsigned char *data = reinterpret_cast< const unsigned char* >( mapping.Data( ) );
+    COMMENT( "Reading header.", 2 );
+    if( ( mapping.Size( ) < HEADER ) || ( std::memcmp( data, "BIALCVOL", 8 ) != 0 ) ) {
+      std::string msg( BIAL_ERROR( filename + " is not a chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    if( ChunkedLoad( data + 8, 4 ) != 1 ) {
+      std::string msg( BIAL_ERROR( "Unsupported version of chunked volume " + filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    type = static_cast< NiftiType >( ChunkedLoad( data + 12, 4 ) );
+    dims = ChunkedLoad( data + 16, 4 );
+    if( ( ChunkedTypeBytes( type ) == 0 ) || ( dims < 2 ) || ( dims > 3 ) ) {
+      std::string msg( BIAL_ERROR( "Invalid data type or dimensions in chunked volume " + filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    size_t total = 1;
+    for( size_t dms = 0; dms < 3; ++dms ) {
+      dim[ dms ] = ChunkedLoad( data + 24 + 8 * dms, 8 );
+      chunk[ dms ] = ChunkedLoad( data + 48 + 8 * dms, 8 );
+      std::memcpy( &pixel_size[ dms ], data + 72 + 4 * dms, 4 );
+      if( ( dim[ dms ] == 0 ) || ( chunk[ dms ] == 0 ) ) {
+        std::string msg( BIAL_ERROR( "Invalid dimensions in chunked volume " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      chunks[ dms ] = ( dim[ dms ] + chunk[ dms ] - 1 ) / chunk[ dms ];
+      total *= chunks[ dms ];
+    }
+    COMMENT( "Reading index.", 2 );
+    if( HEADER + 16 * total > mapping.Size( ) ) {
+      std::string msg( BIAL_ERROR( "Truncated index in chunked volume " + filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    offset.resize( total );
+    bytes.resize( total );
+    for( size_t idx = 0; idx < total; ++idx ) {
+      offset[ idx ] = ChunkedLoad( data + HEADER + 16 * idx, 8 );
+      bytes[ idx ] = ChunkedLoad( data + HEADER + 16 * idx + 8, 8 );
+      if( ( offset[ idx ] > mapping.Size( ) ) || ( bytes[ idx ] > mapping.Size( ) - offset[ idx ] ) ) {
+        std::string msg( BIAL_ERROR( "Truncated chunk in chunked volume " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+    }
+  }
+  catch( std::ios_base::failure &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/reading chunked volume." ) );
+    throw( std::ios_base::failure( msg ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D >
+  void ChunkedImage< D >::Box( size_t index, const Vector< size_t > &spc_dim, const Vector< size_t > &chunk_dim,
+                               const Vector< size_t > &chunk_num, Vector< size_t > &low, Vector< size_t > &box ) {
+    size_t rest = index;
+    for( size_t dms = 0; dms < 3; ++dms ) {
+      low[ dms ] = ( rest % chunk_num[ dms ] ) * chunk_dim[ dms ];
+      box[ dms ] = std::min( chunk_dim[ dms ], spc_dim[ dms ] - low[ dms ] );
+      rest /= chunk_num[ dms ];
+    }
+  }
+
+  template< class D >
+  template< class S >
+  NiftiType ChunkedImage< D >::StoredType( ) {
+    if( std::is_same< S, signed char >::value ) {
+      return( NiftiType::INT8 );
+    }
+    if( std::is_same< S, uchar >::value ) {
+      return( NiftiType::UINT8 );
+    }
+    if( std::is_same< S, short >::value ) {
+      return( NiftiType::INT16 );
+    }
+    if( std::is_same< S, ushort >::value ) {
+      return( NiftiType::UINT16 );
+    }
+    if( std::is_same< S, int >::value ) {
+      return( NiftiType::INT32 );
+    }
+    if( std::is_same< S, uint >::value ) {
+      return( NiftiType::UINT32 );
+    }
+    if( std::is_same< S, llint >::value ) {
+      return( NiftiType::INT64 );
+    }
+    if( std::is_same< S, float >::value ) {
+      return( NiftiType::FLOAT32 );
+    }
+    if( std::is_same< S, double >::value ) {
+      return( NiftiType::FLOAT64 );
+    }
+    std::string msg( BIAL_ERROR( "Chunked volumes store only 8, 16, 32 and 64 bit integer, float and double " +
+                                 "pixels." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D >
+  typename ChunkedImage< D >::ChunkData ChunkedImage< D >::Load( size_t index ) const {
+    try {
+      Vector< size_t > low( 3 );
+      Vector< size_t > box( 3 );
+      Box( index, dim, chunk, chunks, low, box );
+      size_t size = box[ 0 ] * box[ 1 ] * box[ 2 ];
+      size_t raw = size * ChunkedTypeBytes( type );
+      std::shared_ptr< Vector< D > > res( new Vector< D >( size, StorageInit::None ) );
+      COMMENT( "Inflating straight into the chunk if it is stored as D.", 4 );
+      std::vector< char > converted;
+      char *dst = reinterpret_cast< char* >( res->data( ) );
+      if( type != StoredType< D >( ) ) {
+        converted.resize( raw );
+        dst = converted.data( );
+      }
+      const char *src = mapping.Data( ) + offset[ index ];
+      if( bytes[ index ] == raw ) {
+        std::memcpy( dst, src, raw );
+      }
+      else {
+        uLongf inflated = static_cast< uLongf >( raw );
+        if( ( uncompress( reinterpret_cast< Bytef* >( dst ), &inflated, reinterpret_cast< const Bytef* >( src ),
+                          static_cast< uLong >( bytes[ index ] ) ) != Z_OK ) || ( inflated != raw ) ) {
+          std::string msg( BIAL_ERROR( "Corrupted chunk " + std::to_string( index ) + "." ) );
+          throw( std::ios_base::failure( msg ) );
+        }
+      }
+      if( type != StoredType< D >( ) ) {
+        D *pxl = res->data( );
+        switch( type ) {
+        case NiftiType::INT8:
+          ChunkedConvert< signed char >( dst, size, pxl );
+          break;
+        case NiftiType::UINT8:
+          ChunkedConvert< uchar >( dst, size, pxl );
+          break;
+        case NiftiType::INT16:
+          ChunkedConvert< short >( dst, size, pxl );
+          break;
+        case NiftiType::UINT16:
+          ChunkedConvert< ushort >( dst, size, pxl );
+          break;
+        case NiftiType::INT32:
+          ChunkedConvert< int >( dst, size, pxl );
+          break;
+        case NiftiType::UINT32:
+          ChunkedConvert< uint >( dst, size, pxl );
+          break;
+        case NiftiType::INT64:
+          ChunkedConvert< llint >( dst, size, pxl );
+          break;
+        case NiftiType::FLOAT32:
+          ChunkedConvert< float >( dst, size, pxl );
+          break;
+        default:
+          ChunkedConvert< double >( dst, size, pxl );
+          break;
+        }
+      }
+      return( res );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void ChunkedImage< D >::Insert( size_t index, const ChunkData &data ) const {
+    auto found = cache.find( index );
+    if( found != cache.end( ) ) {
+      lru.splice( lru.begin( ), lru, found->second.second );
+      return;
+    }
+    size_t chunk_bytes = data->size( ) * sizeof( D );
+    if( chunk_bytes > cache_limit ) {
+      return;
+    }
+    while( ( cached_bytes + chunk_bytes > cache_limit ) && ( !lru.empty( ) ) ) {
+      auto evicted = cache.find( lru.back( ) );
+      cached_bytes -= evicted->second.first->size( ) * sizeof( D );
+      cache.erase( evicted );
+      lru.pop_back( );
+    }
+    lru.push_front( index );
+    cache[ index ] = std::make_pair( data, lru.begin( ) );
+    cached_bytes += chunk_bytes;
+  }
+
+  template< class D >
+  std::vector< typename ChunkedImage< D >::ChunkData >
+  ChunkedImage< D >::Fetch( const std::vector< size_t > &index ) const {
+    try {
+      std::vector< ChunkData > res( index.size( ) );
+      std::vector< size_t > missing;
+      {
+        std::lock_guard< std::mutex > lock( mutex );
+        for( size_t idx = 0; idx < index.size( ); ++idx ) {
+          auto found = cache.find( index[ idx ] );
+          if( found != cache.end( ) ) {
+            lru.splice( lru.begin( ), lru, found->second.second );
+            res[ idx ] = found->second.first;
+          }
+          else {
+            missing.push_back( idx );
+          }
+        }
+      }
+      COMMENT( "Inflating missing chunks in parallel, without holding the lock.", 4 );
+      ThreadPool::ParallelFor( 0, missing.size( ), 1, [ & ]( size_t first, size_t last ) {
+          for( size_t msn = first; msn < last; ++msn ) {
+            res[ missing[ msn ] ] = Load( index[ missing[ msn ] ] );
+          }
+        } );
+      std::lock_guard< std::mutex > lock( mutex );
+      for( size_t msn = 0; msn < missing.size( ); ++msn ) {
+        Insert( index[ missing[ msn ] ], res[ missing[ msn ] ] );
+      }
+      return( res );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  size_t ChunkedImage< D >::Dims( ) const {
+    return( dims );
+  }
+
+  template< class D >
+  Vector< size_t > ChunkedImage< D >::Dim( ) const {
+    return( dim );
+  }
+
+  template< class D >
+  Vector< float > ChunkedImage< D >::PixelSize( ) const {
+    return( pixel_size );
+  }
+
+  template< class D >
+  size_t ChunkedImage< D >::size( size_t dms ) const {
+    return( dim( dms ) );
+  }
+
+  template< class D >
+  size_t ChunkedImage< D >::size( ) const {
+    return( dim[ 0 ] * dim[ 1 ] * dim[ 2 ] );
+  }
+
+  template< class D >
+  Vector< size_t > ChunkedImage< D >::ChunkDim( ) const {
+    return( chunk );
+  }
+
+  template< class D >
+  D ChunkedImage< D >::operator()( size_t p_0, size_t p_1, size_t p_2 ) const {
+    try {
+      if( ( p_0 >= dim[ 0 ] ) || ( p_1 >= dim[ 1 ] ) || ( p_2 >= dim[ 2 ] ) ) {
+        std::string msg( BIAL_ERROR( "Pixel out of chunked volume." ) );
+        throw( std::out_of_range( msg ) );
+      }
+      size_t index = p_0 / chunk[ 0 ] + chunks[ 0 ] * ( p_1 / chunk[ 1 ] + chunks[ 1 ] * ( p_2 / chunk[ 2 ] ) );
+      ChunkData data;
+      {
+        std::lock_guard< std::mutex > lock( mutex );
+        auto found = cache.find( index );
+        if( found != cache.end( ) ) {
+          lru.splice( lru.begin( ), lru, found->second.second );
+          data = found->second.first;
+        }
+      }
+      if( !data ) {
+        data = Load( index );
+        std::lock_guard< std::mutex > lock( mutex );
+        Insert( index, data );
+      }
+      Vector< size_t > low( 3 );
+      Vector< size_t > box( 3 );
+      Box( index, dim, chunk, chunks, low, box );
+      return( ( *data )[ ( p_0 - low[ 0 ] ) + box[ 0 ] * ( ( p_1 - low[ 1 ] ) + box[ 1 ] * ( p_2 - low[ 2 ] ) ) ] );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > ChunkedImage< D >::Region( const Vector< size_t > &low_coord, const Vector< size_t > &hgh_coord ) const {
+    try {
+      COMMENT( "Checking region.", 2 );
+      Vector< size_t > low( low_coord );
+      Vector< size_t > hgh( hgh_coord );
+      if( ( low.size( ) != hgh.size( ) ) || ( low.size( ) < 2 ) || ( low.size( ) > 3 ) ) {
+        std::string msg( BIAL_ERROR( "Region coordinates must have 2 or 3 matching dimensions." ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( low.size( ) == 2 ) {
+        low.push_back( 0 );
+        hgh.push_back( dim[ 2 ] - 1 );
+      }
+      Vector< size_t > res_dim( 3 );
+      for( size_t dms = 0; dms < 3; ++dms ) {
+        if( ( low[ dms ] > hgh[ dms ] ) || ( hgh[ dms ] >= dim[ dms ] ) ) {
+          std::string msg( BIAL_ERROR( "Region out of chunked volume in dimension " + std::to_string( dms ) + "." ) );
+          throw( std::out_of_range( msg ) );
+        }
+        res_dim[ dms ] = hgh[ dms ] - low[ dms ] + 1;
+      }
+      Image< D > res( res_dim, StorageInit::None );
+      res.PixelSize( pixel_size );
+      D *res_data = &res[ 0 ];
+      COMMENT( "Listing the chunks that intersect the region.", 2 );
+      std::vector< size_t > index;
+      for( size_t z = low[ 2 ] / chunk[ 2 ]; z <= hgh[ 2 ] / chunk[ 2 ]; ++z ) {
+        for( size_t y = low[ 1 ] / chunk[ 1 ]; y <= hgh[ 1 ] / chunk[ 1 ]; ++y ) {
+          for( size_t x = low[ 0 ] / chunk[ 0 ]; x <= hgh[ 0 ] / chunk[ 0 ]; ++x ) {
+            index.push_back( x + chunks[ 0 ] * ( y + chunks[ 1 ] * z ) );
+          }
+        }
+      }
+      COMMENT( "Loading chunks in batches, so that only a batch is held besides the cache.", 2 );
+      size_t batch = 4 * ThreadPool::Threads( );
+      for( size_t first = 0; first < index.size( ); first += batch ) {
+        std::vector< size_t > batch_index( index.begin( ) + first,
+                                           index.begin( ) + std::min( first + batch, index.size( ) ) );
+        std::vector< ChunkData > data( Fetch( batch_index ) );
+        ThreadPool::ParallelFor( 0, batch_index.size( ), 1, [ & ]( size_t first_chk, size_t last_chk ) {
+            Vector< size_t > chk_low( 3 );
+            Vector< size_t > box( 3 );
+            for( size_t chk = first_chk; chk < last_chk; ++chk ) {
+              Box( batch_index[ chk ], dim, chunk, chunks, chk_low, box );
+              size_t x_0 = std::max( low[ 0 ], chk_low[ 0 ] );
+              size_t x_1 = std::min( hgh[ 0 ], chk_low[ 0 ] + box[ 0 ] - 1 );
+              size_t y_0 = std::max( low[ 1 ], chk_low[ 1 ] );
+              size_t y_1 = std::min( hgh[ 1 ], chk_low[ 1 ] + box[ 1 ] - 1 );
+              size_t z_0 = std::max( low[ 2 ], chk_low[ 2 ] );
+              size_t z_1 = std::min( hgh[ 2 ], chk_low[ 2 ] + box[ 2 ] - 1 );
+              const D *chk_data = data[ chk ]->data( );
+              for( size_t z = z_0; z <= z_1; ++z ) {
+                for( size_t y = y_0; y <= y_1; ++y ) {
+                  const D *src = chk_data + ( x_0 - chk_low[ 0 ] ) +
+                    box[ 0 ] * ( ( y - chk_low[ 1 ] ) + box[ 1 ] * ( z - chk_low[ 2 ] ) );
+                  D *dst = res_data + ( x_0 - low[ 0 ] ) + res_dim[ 0 ] * ( ( y - low[ 1 ] ) + res_dim[ 1 ] *
+                                                                            ( z - low[ 2 ] ) );
+                  std::copy( src, src + ( x_1 - x_0 + 1 ), dst );
+                }
+              }
+            }
+          } );
+      }
+      return( res );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > ChunkedImage< D >::Slice( size_t dimension, size_t index ) const {
+    try {
+      if( ( dimension >= dims ) || ( index >= dim[ dimension ] ) ) {
+        std::string msg( BIAL_ERROR( "Invalid slice " + std::to_string( index ) + " of dimension " +
+                                     std::to_string( dimension ) + "." ) );
+        throw( std::out_of_range( msg ) );
+      }
+      Vector< size_t > low( 3, 0 );
+      Vector< size_t > hgh( dim );
+      for( size_t dms = 0; dms < 3; ++dms ) {
+        --hgh[ dms ];
+      }
+      low[ dimension ] = index;
+      hgh[ dimension ] = index;
+      Image< D > box( Region( low, hgh ) );
+      if( dimension == 2 ) {
+        return( box );
+      }
+      COMMENT( "The slice keeps the data order of the region. Only its dimensions change.", 2 );
+      Vector< size_t > spc_dim( box.Dim( ) );
+      Vector< float > spc_pixel_size( pixel_size );
+      spc_dim.erase( spc_dim.begin( ) + dimension );
+      spc_pixel_size.erase( spc_pixel_size.begin( ) + dimension );
+      Image< D > res( spc_dim, spc_pixel_size );
+      std::copy( &box[ 0 ], &box[ 0 ] + box.size( ), &res[ 0 ] );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > ChunkedImage< D >::Load( ) const {
+    try {
+      Vector< size_t > low( 3, 0 );
+      Vector< size_t > hgh( dim );
+      for( size_t dms = 0; dms < 3; ++dms ) {
+        --hgh[ dms ];
+      }
+      return( Region( low, hgh ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  size_t ChunkedImage< D >::CachedBytes( ) const {
+    std::lock_guard< std::mutex > lock( mutex );
+    return( cached_bytes );
+  }
+
+  template< class D >
+  size_t ChunkedImage< D >::CacheLimit( ) const {
+    return( cache_limit );
+  }
+
+  template< class D >
+  void ChunkedImage< D >::CacheLimit( size_t limit ) {
+    std::lock_guard< std::mutex > lock( mutex );
+    cache_limit = limit;
+    while( ( cached_bytes > cache_limit ) && ( !lru.empty( ) ) ) {
+      auto evicted = cache.find( lru.back( ) );
+      cached_bytes -= evicted->second.first->size( ) * sizeof( D );
+      cache.erase( evicted );
+      lru.pop_back( );
+    }
+  }
+
+  template< class D >
+  template< class S >
+  void ChunkedImage< D >::WriteData( const std::function< const S*( size_t, size_t ) > &slab,
+                                     const Vector< size_t > &spc_dim, const Vector< float > &spc_pixel_size,
+                                     const std::string &filename, const Vector< size_t > &chunk_dim, int level ) {
+    std::FILE *file = nullptr;
+    try {
+      COMMENT( "Setting chunk dimensions.", 2 );
+      Vector< size_t > chk( 3, DEFAULT_CHUNK );
+      for( size_t dms = 0; dms < std::min( chunk_dim.size( ), static_cast< size_t >( 3 ) ); ++dms ) {
+        chk[ dms ] = std::max( chunk_dim[ dms ], static_cast< size_t >( 1 ) );
+      }
+      Vector< size_t > chk_num( 3 );
+      size_t total = 1;
+      for( size_t dms = 0; dms < 3; ++dms ) {
+        chk[ dms ] = std::min( chk[ dms ], spc_dim[ dms ] );
+        chk_num[ dms ] = ( spc_dim[ dms ] + chk[ dms ] - 1 ) / chk[ dms ];
+        total *= chk_num[ dms ];
+      }
+      file = std::fopen( filename.c_str( ), "wb" );
+      if( file == nullptr ) {
+        std::string msg( BIAL_ERROR( "Could not create file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      COMMENT( "Reserving header and index. They are written after the chunks, when their offsets are known.", 2 );
+      std::vector< unsigned char > head( HEADER + 16 * total, 0 );
+      if( std::fwrite( head.data( ), 1, head.size( ), file ) != head.size( ) ) {
+        std::string msg( BIAL_ERROR( "Could not write file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      size_t position = head.size( );
+      size_t batch = 4 * ThreadPool::Threads( );
+      size_t row_chunks = chk_num[ 0 ] * chk_num[ 1 ];
+      std::vector< std::vector< unsigned char > > packed( batch );
+      for( size_t row_first = 0; row_first < total; row_first += row_chunks ) {
+        COMMENT( "Chunks are stored with z varying slowest, so that a brick row only needs its own planes.", 3 );
+        size_t first_plane = ( row_first / row_chunks ) * chk[ 2 ];
+        const S *src = slab( first_plane, std::min( chk[ 2 ], spc_dim[ 2 ] - first_plane ) );
+        for( size_t first = row_first; first < row_first + row_chunks; first += batch ) {
+          size_t count = std::min( batch, row_first + row_chunks - first );
+          ThreadPool::ParallelFor( 0, count, 1, [ & ]( size_t first_chk, size_t last_chk ) {
+              Vector< size_t > low( 3 );
+              Vector< size_t > box( 3 );
+              for( size_t chk_idx = first_chk; chk_idx < last_chk; ++chk_idx ) {
+                Box( first + chk_idx, spc_dim, chk, chk_num, low, box );
+                size_t raw = box[ 0 ] * box[ 1 ] * box[ 2 ] * sizeof( S );
+                std::vector< S > pixels( box[ 0 ] * box[ 1 ] * box[ 2 ] );
+                S *dst = pixels.data( );
+                for( size_t z = 0; z < box[ 2 ]; ++z ) {
+                  for( size_t y = 0; y < box[ 1 ]; ++y ) {
+                    const S *row = src + low[ 0 ] + spc_dim[ 0 ] * ( ( low[ 1 ] + y ) +
+                                                                     spc_dim[ 1 ] * ( low[ 2 ] - first_plane + z ) );
+                    dst = std::copy( row, row + box[ 0 ], dst );
+                  }
+                }
+                std::vector< unsigned char > &out = packed[ chk_idx ];
+                const Bytef *pixel_bytes = reinterpret_cast< const Bytef* >( pixels.data( ) );
+                if( level != 0 ) {
+                  uLongf compressed = compressBound( static_cast< uLong >( raw ) );
+                  out.resize( compressed );
+                  int status = compress2( out.data( ), &compressed, pixel_bytes, static_cast< uLong >( raw ), level );
+                  if( ( status == Z_OK ) && ( compressed < raw ) ) {
+                    out.resize( compressed );
+                    continue;
+                  }
+                }
+                COMMENT( "Incompressible chunks are stored raw.", 4 );
+                out.assign( pixel_bytes, pixel_bytes + raw );
+              }
+            } );
+          for( size_t chk_idx = 0; chk_idx < count; ++chk_idx ) {
+            const std::vector< unsigned char > &out = packed[ chk_idx ];
+            if( std::fwrite( out.data( ), 1, out.size( ), file ) != out.size( ) ) {
+              std::string msg( BIAL_ERROR( "Could not write file " + filename + "." ) );
+              throw( std::ios_base::failure( msg ) );
+            }
+            ChunkedStore( &head[ HEADER + 16 * ( first + chk_idx ) ], position, 8 );
+            ChunkedStore( &head[ HEADER + 16 * ( first + chk_idx ) + 8 ], out.size( ), 8 );
+            position += out.size( );
+          }
+        }
+      }
+      COMMENT( "Writing header and index.", 2 );
+      std::memcpy( head.data( ), "BIALCVOL", 8 );
+      ChunkedStore( &head[ 8 ], 1, 4 );
+      ChunkedStore( &head[ 12 ], static_cast< size_t >( StoredType< S >( ) ), 4 );
+      ChunkedStore( &head[ 16 ], spc_dim[ 2 ] == 1 ? 2 : 3, 4 );
+      ChunkedStore( &head[ 20 ], static_cast< size_t >( static_cast< uint >( level ) ), 4 );
+      for( size_t dms = 0; dms < 3; ++dms ) {
+        ChunkedStore( &head[ 24 + 8 * dms ], spc_dim[ dms ], 8 );
+        ChunkedStore( &head[ 48 + 8 * dms ], chk[ dms ], 8 );
+        float size = dms < spc_pixel_size.size( ) ? spc_pixel_size[ dms ] : 1.0f;
+        std::memcpy( &head[ 72 + 4 * dms ], &size, 4 );
+      }
+      if( ( std::fseek( file, 0, SEEK_SET ) != 0 ) ||
+          ( std::fwrite( head.data( ), 1, head.size( ), file ) != head.size( ) ) ) {
+        std::string msg( BIAL_ERROR( "Could not write file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      std::FILE *closing = file;
+      file = nullptr;
+      if( std::fclose( closing ) != 0 ) {
+        std::string msg( BIAL_ERROR( "Could not close file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+    }
+    catch( std::ios_base::failure &e ) {
+      if( file != nullptr ) {
+        std::fclose( file );
+      }
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error writing chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      if( file != nullptr ) {
+        std::fclose( file );
+      }
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      if( file != nullptr ) {
+        std::fclose( file );
+      }
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      if( file != nullptr ) {
+        std::fclose( file );
+      }
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      if( file != nullptr ) {
+        std::fclose( file );
+      }
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void ChunkedImage< D >::Write( const Image< D > &img, const std::string &filename,
+                                 const Vector< size_t > &chunk_dim, int level ) {
+    try {
+      const D *data = &img[ 0 ];
+      size_t plane = img.size( 0 ) * img.size( 1 );
+      WriteData< D >( [ data, plane ]( size_t first_plane, size_t ) {
+          return( data + first_plane * plane );
+        }, img.Dim( ), img.PixelSize( ), filename, chunk_dim, level );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error writing chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  template< class S >
+  void ChunkedImage< D >::ConvertNifti( const NiftiMapping &mapping, const std::string &dst_filename,
+                                        const Vector< size_t > &chunk_dim, int level ) {
+    try {
+      const Vector< size_t > &hdr_dim = mapping.Header( ).Dim( );
+      const Vector< float > &hdr_pixel_size = mapping.Header( ).PixelSize( );
+      Vector< size_t > spc_dim( 3, 1 );
+      Vector< float > spc_pixel_size( 3, 1.0f );
+      for( size_t dms = 0; dms < std::min( hdr_dim.size( ), static_cast< size_t >( 3 ) ); ++dms ) {
+        spc_dim[ dms ] = hdr_dim[ dms ];
+        spc_pixel_size[ dms ] = hdr_pixel_size[ dms ];
+      }
+      size_t plane = spc_dim[ 0 ] * spc_dim[ 1 ];
+      std::vector< S > buffer;
+      WriteData< S >( [ &mapping, &buffer, plane ]( size_t first_plane, size_t planes ) {
+          buffer.resize( planes * plane );
+          mapping.Read( first_plane * plane, planes * plane, buffer.data( ) );
+          return( static_cast< const S* >( buffer.data( ) ) );
+        }, spc_dim, spc_pixel_size, dst_filename, chunk_dim, level );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error converting to chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  template< class S >
+  void ChunkedImage< D >::ConvertScene( IFile &file, const Vector< size_t > &spc_dim,
+                                        const Vector< float > &spc_pixel_size, const std::string &dst_filename,
+                                        const Vector< size_t > &chunk_dim, int level ) {
+    try {
+      size_t plane = spc_dim[ 0 ] * spc_dim[ 1 ];
+      std::vector< S > buffer;
+      WriteData< S >( [ &file, &buffer, plane ]( size_t, size_t planes ) {
+          COMMENT( "Brick rows are requested in order, so that the file is read sequentially.", 4 );
+          buffer.resize( planes * plane );
+          file.read( reinterpret_cast< char* >( buffer.data( ) ), static_cast< std::streamsize >( buffer.size( ) *
+                                                                                                 sizeof( S ) ) );
+          return( static_cast< const S* >( buffer.data( ) ) );
+        }, spc_dim, spc_pixel_size, dst_filename, chunk_dim, level );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error converting to chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void ChunkedImage< D >::Convert( const std::string &src_filename, const std::string &dst_filename,
+                                   const Vector< size_t > &chunk_dim, int level ) {
+    try {
+      size_t pos = src_filename.size( ) - std::min( src_filename.size( ), static_cast< size_t >( 4 ) );
+      std::string extension( File::ToLowerExtension( src_filename, pos ) );
+      bool nifti = ( extension.compare( ".nii" ) == 0 ) || ( extension.compare( ".hdr" ) == 0 ) ||
+                   ( extension.compare( ".img" ) == 0 );
+      if( ( nifti ) && ( NiftiMapping::IsMappable( src_filename ) ) ) {
+        NiftiMapping mapping( src_filename );
+        COMMENT( "Keeping the stored type. Loaded chunks are converted to D.", 2 );
+        switch( mapping.Header( ).DataType( ) ) {
+        case NiftiType::INT8:
+          ConvertNifti< signed char >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::UINT8:
+          ConvertNifti< uchar >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::INT16:
+          ConvertNifti< short >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::UINT16:
+          ConvertNifti< ushort >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::INT32:
+          ConvertNifti< int >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::UINT32:
+          ConvertNifti< uint >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::INT64:
+          ConvertNifti< llint >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::FLOAT32:
+          ConvertNifti< float >( mapping, dst_filename, chunk_dim, level );
+          break;
+        case NiftiType::FLOAT64:
+          ConvertNifti< double >( mapping, dst_filename, chunk_dim, level );
+          break;
+        default:
+          ConvertNifti< D >( mapping, dst_filename, chunk_dim, level );
+          break;
+        }
+        return;
+      }
+      std::string scene_extension( File::ToLowerExtension( src_filename, src_filename.size( ) -
+                                                           std::min( src_filename.size( ),
+                                                                     static_cast< size_t >( 8 ) ) ) );
+      if( scene_extension.rfind( ".scn" ) != std::string::npos ) {
+        COMMENT( "Reading the Scene header as in ReadScene.", 2 );
+        IFile file;
+        file.exceptions( std::fstream::failbit | std::fstream::badbit );
+        file.open( src_filename );
+        std::string scn_type;
+        getline( file, scn_type );
+        if( scn_type.compare( "SCN" ) != 0 ) {
+          std::string msg( BIAL_ERROR( "Scene file " + src_filename + " is unsupported or corrupted." ) );
+          throw( std::logic_error( msg ) );
+        }
+        Vector< size_t > spc_dim( 3 );
+        file >> spc_dim[ 0 ] >> spc_dim[ 1 ] >> spc_dim[ 2 ];
+        Vector< float > spc_pixel_size( 3 );
+        file >> spc_pixel_size[ 0 ] >> spc_pixel_size[ 1 ] >> spc_pixel_size[ 2 ];
+        unsigned int scn_bits;
+        file >> scn_bits;
+        file.ignore( 1 );
+        if( scn_bits == 8 ) {
+          ConvertScene< uchar >( file, spc_dim, spc_pixel_size, dst_filename, chunk_dim, level );
+        }
+        else if( scn_bits == 16 ) {
+          ConvertScene< ushort >( file, spc_dim, spc_pixel_size, dst_filename, chunk_dim, level );
+        }
+        else if( scn_bits == 32 ) {
+          ConvertScene< int >( file, spc_dim, spc_pixel_size, dst_filename, chunk_dim, level );
+        }
+        else {
+          ConvertScene< float >( file, spc_dim, spc_pixel_size, dst_filename, chunk_dim, level );
+        }
+        file.close( );
+        return;
+      }
+      COMMENT( "PNM images are 2D, and the other formats have no partial reader. They are read whole.", 2 );
+      Write( Read< D >( src_filename ), dst_filename, chunk_dim, level );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error converting to chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_ChunkedImage
+
+  template class ChunkedImage< int >;
+  template class ChunkedImage< llint >;
+  template class ChunkedImage< float >;
+  template class ChunkedImage< double >;
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -23,6 +23,7 @@
 #include "Color.hpp"
 #include "Feature.hpp"
 #include "Image.hpp"
+#include "ThreadPool.hpp"
 
 namespace Bial {
 
@@ -41,21 +42,9 @@ namespace Bial {
       size_t elements = src.size( );
       Feature< D > res( elements, features );
       COMMENT( "Computing median features.", 0 );
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads.push_back( std::thread( &ColorFeatureThread< D >, std::ref( src ), std::ref( adj_rel ),
-                                          std::ref( res ), thd, total_threads ) );
-        }
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads( thd ).join( );
-        }
-      }
-      catch( std::exception &e ) {
-        std::cout << "Warning: Failed to run in multi-thread. Exception: " << e.what( ) << std::endl;
-        ColorFeatureThread( src, adj_rel, res, 0, 1 );
-      }
+      ThreadPool::Run( ThreadPool::Tasks( src.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          ColorFeatureThread( src, adj_rel, res, thd, total_threads );
+        } );
       return( res );
     }
     catch( std::bad_alloc &e ) {
@@ -23,7 +23,10 @@
 #include "Color.hpp"
 #include "Feature.hpp"
 #include "Image.hpp"
-#include "SortingSort.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace Bial {
 
@@ -46,21 +49,9 @@ namespace Bial {
       size_t elements = src.size( );
       Feature< D > res( elements, features );
       COMMENT( "Computing median features.", 0 );
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads.push_back( std::thread( &ColorMedianFeatureThread< D >, std::ref( src ), std::ref( adj_rel ),
-                                          std::ref( res ), thd, total_threads ) );
-        }
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads( thd ).join( );
-        }
-      }
-      catch( std::exception &e ) {
-        std::cout << "Warning: Failed to run in multi-thread. Exception: " << e.what( ) << std::endl;
-        ColorMedianFeatureThread( src, adj_rel, res, 0, 1 );
-      }
+      ThreadPool::Run( ThreadPool::Tasks( src.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          ColorMedianFeatureThread( src, adj_rel, res, thd, total_threads );
+        } );
       return( res );
     }
     catch( std::bad_alloc &e ) {
@@ -110,37 +101,37 @@ namespace Bial {
       //Bial::Elements( msk, static_cast< D >( 1 ), msk.Maximum( ) );
       Feature< D > res( elements, features );
       COMMENT( "Computing median pixels.", 0 );
-      Vector< double > median( adj_rel.size( ) );
-      Vector< size_t > index( adj_rel.size( ) );
+      std::vector< std::pair< double, size_t > > median( adj_rel.size( ) );
       size_t adj_base = ( adj_rel.size( ) / 2 ) - ( features / ( 2 * 3 ) );
       size_t tgt_elm = 0;
       for( size_t src_elm = 0; src_elm < src.size( ); ++src_elm ) {
         if( msk[ src_elm ] != 0 ) {
-          COMMENT( "Computing the sum of the distances of all channels from adjacent to source pixels.", 4 );
+          COMMENT( "Computing the sum of the distances of all channels from adjacent to source pixels. Adjacents " <<
+                   "out of the domain or the mask count as the source pixel.", 4 );
           for( size_t adj = 0; adj < adj_rel.size( ); ++adj ) {
             size_t elm_adj = adj_rel( src, src_elm, adj );
-            index( adj ) = elm_adj;
-            if( ( elm_adj < src.size( ) ) && ( msk[ elm_adj ] != 0 ) ) {
-              for( size_t chn = 1; chn < 4; ++chn ) {
-                D adj_value = src( elm_adj )( chn );
-                D src_value = src( src_elm )( chn );
-                median( adj ) += ( adj_value > src_value ) ? adj_value - src_value : src_value - adj_value;
-              }
+            if( ( elm_adj >= src.size( ) ) || ( msk[ elm_adj ] == 0 ) ) {
+              elm_adj = src_elm;
             }
-            else {
-              median( adj ) = 0;
+            double distance = 0.0;
+            for( size_t chn = 1; chn < 4; ++chn ) {
+              D adj_value = src( elm_adj )( chn );
+              D src_value = src( src_elm )( chn );
+              distance += ( adj_value > src_value ) ? adj_value - src_value : src_value - adj_value;
             }
+            median[ adj ] = std::make_pair( distance, elm_adj );
           }
-          COMMENT( "Sorting the distances.", 4 );
-          Sorting::Sort( index, Sorting::Sort( median ) );
+          COMMENT( "Selecting and sorting only the distances taken as features.", 4 );
+          std::nth_element( median.begin( ), median.begin( ) + adj_base, median.end( ) );
+          std::partial_sort( median.begin( ) + adj_base, median.begin( ) + adj_base + features / 3, median.end( ) );
           COMMENT( "Getting the features from the median distances.", 4 );
           for( size_t ftr = 0; ftr < features / 3; ++ftr ) {
             for( size_t chn = 1; chn < 4; ++chn ) {
-              res( tgt_elm, ftr * 3 + ( chn - 1 ) ) = src( index( adj_base + ftr ) )( chn );
+              res( tgt_elm, ftr * 3 + ( chn - 1 ) ) = src( median[ adj_base + ftr ].second )( chn );
             }
-            res.Index( tgt_elm ) = src_elm;
-            ++tgt_elm;
           }
+          res.Index( tgt_elm ) = src_elm;
+          ++tgt_elm;
         }
       }
       return( res );
@@ -172,40 +163,33 @@ namespace Bial {
       size_t min_index = thread * src.size( ) / total_threads;
       size_t max_index = ( thread + 1 ) * src.size( ) / total_threads;
       COMMENT( "Computing median features.", 2 );
-      Vector< double > median( adj_rel.size( ) );
-      Vector< size_t > index( adj_rel.size( ) );
+      std::vector< std::pair< double, size_t > > median( adj_rel.size( ) );
       size_t adj_base = ( adj_rel.size( ) / 2 ) - ( features / ( 2 * 3 ) );
       for( size_t src_elm = min_index; src_elm < max_index; ++src_elm ) {
         COMMENT( "Setting index.", 4 );
         res.Index( src_elm ) = src_elm;
-        COMMENT( "Computing the sum of the distances of all channels from adjacent to source pixels.", 4 );
+        COMMENT( "Computing the sum of the distances of all channels from adjacent to source pixels. Adjacents " <<
+                 "out of the domain count as the source pixel.", 4 );
         for( size_t adj = 0; adj < adj_rel.size( ); ++adj ) {
-          COMMENT( "Computing index of elements.", 4 );
           size_t elm_adj = adj_rel( src, src_elm, adj );
-          if( elm_adj < src.size( ) ) {
-            index( adj ) = elm_adj;
+          if( elm_adj >= src.size( ) ) {
+            elm_adj = src_elm;
           }
-          else {
-            index( adj ) = src_elm;
-          }
-          COMMENT( "Computing the median vector fo the distances from the source element to target elements.", 4 );
-          if( elm_adj < src.size( ) ) {
-            for( size_t chn = 1; chn < 4; ++chn ) {
-              D adj_value = src( elm_adj )( chn );
-              D src_value = src( src_elm )( chn );
-              median( adj ) += ( adj_value > src_value ) ? adj_value - src_value : src_value - adj_value;
-            }
-          }
-          else {
-            median( adj ) = 0;
+          double distance = 0.0;
+          for( size_t chn = 1; chn < 4; ++chn ) {
+            D adj_value = src( elm_adj )( chn );
+            D src_value = src( src_elm )( chn );
+            distance += ( adj_value > src_value ) ? adj_value - src_value : src_value - adj_value;
           }
+          median[ adj ] = std::make_pair( distance, elm_adj );
         }
-        COMMENT( "Sorting the distances.", 4 );
-        Sorting::Sort( index, Sorting::Sort( median ) );
+        COMMENT( "Selecting and sorting only the distances taken as features.", 4 );
+        std::nth_element( median.begin( ), median.begin( ) + adj_base, median.end( ) );
+        std::partial_sort( median.begin( ) + adj_base, median.begin( ) + adj_base + features / 3, median.end( ) );
         COMMENT( "Getting the features from the median distances.", 4 );
         for( size_t ftr = 0; ftr < features / 3; ++ftr ) {
           for( size_t chn = 1; chn < 4; ++chn ) {
-            res( src_elm, ftr * 3 + ( chn - 1 ) ) = src( index( adj_base + ftr ) )( chn );
+            res( src_elm, ftr * 3 + ( chn - 1 ) ) = src( median[ adj_base + ftr ].second )( chn );
           }
         }
       }
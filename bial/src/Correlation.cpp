@@ -20,8 +20,11 @@
 #ifdef BIAL_DEBUG
 #include "FileImage.hpp"
 #endif
+#include "FFT.hpp"
 #include "Image.hpp"
 #include "KernelIterator.hpp"
+#include "ThreadPool.hpp"
+#include <type_traits>
 
 namespace Bial {
 
@@ -32,25 +35,48 @@ namespace Bial {
         std::string msg( BIAL_ERROR( "Image and kernel dimensions do not match." ) );
         throw( std::logic_error( msg ) );
       }
-      COMMENT( "Creating resulting image.", 1 );
-      Image< D > result( img );
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        COMMENT( "Starting threads.", 1 );
-        for( size_t thd = 0; thd < total_threads; ++thd )
-          threads.push_back( std::thread( &CorrelationThreads< D >, std::ref( img ), std::ref( krn ),
-                                          std::ref( result ), thd, total_threads ) );
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          COMMENT( "Merging.", 1 );
-          threads( thd ).join( );
-        }
-        COMMENT( "Finished threads.", 1 );
+      Vector< Kernel > bank( 1, krn );
+      if( UseFFTCorrelation( img.Dim( ), bank ) ) {
+        COMMENT( "Large kernel. Running correlation in the frequency domain.", 1 );
+        return( FFTCorrelation( img, bank )( 0 ) );
       }
-      catch( std::exception &e ) {
-        BIAL_WARNING( "Failed to run in multi-thread. Exception: " << e.what( ) );
-        CorrelationThreads( img, krn, result, 0, 1 );
+      return( SpatialCorrelation( img, krn ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+    catch( const std::exception &e ) {
+      BIAL_WARNING( "Thread execution exception." );
+      throw( std::exception( e ) );
+    }
+  }
+
+  template< class D >
+  Image< D > SpatialCorrelation( const Image< D > &img, const Kernel &krn ) {
+    try {
+      if( img.Dims( ) != krn.Dims( ) ) {
+        std::string msg( BIAL_ERROR( "Image and kernel dimensions do not match." ) );
+        throw( std::logic_error( msg ) );
       }
+      COMMENT( "Creating resulting image.", 1 );
+      Image< D > result( img );
+      COMMENT( "Running threads.", 1 );
+      ThreadPool::Run( ThreadPool::Tasks( img.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          CorrelationThreads( img, krn, result, thd, total_threads );
+        } );
       return( result );
     }
     catch( std::bad_alloc &e ) {
@@ -116,21 +142,250 @@ namespace Bial {
     }
   }
   
+  template< class D >
+  Vector< Image< D > > Correlation( const Image< D > &img, const Vector< Kernel > &bank ) {
+    try {
+      if( UseFFTCorrelation( img.Dim( ), bank ) ) {
+        COMMENT( "Running filter bank in the frequency domain.", 1 );
+        return( FFTCorrelation( img, bank ) );
+      }
+      COMMENT( "Running filter bank in the spatial domain.", 1 );
+      Vector< Image< D > > result;
+      for( size_t krn = 0; krn < bank.size( ); ++krn ) {
+        result.push_back( Correlation( img, bank( krn ) ) );
+      }
+      return( result );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Vector< Image< D > > FFTCorrelation( const Image< D > &img, const Vector< Kernel > &bank ) {
+    try {
+      for( size_t krn = 0; krn < bank.size( ); ++krn ) {
+        if( img.Dims( ) != bank( krn ).Dims( ) ) {
+          std::string msg( BIAL_ERROR( "Image and kernel dimensions do not match." ) );
+          throw( std::logic_error( msg ) );
+        }
+      }
+      Vector< Image< D > > result;
+      if( bank.size( ) == 0 ) {
+        return( result );
+      }
+      Vector< size_t > dim( img.Dim( ) );
+      Vector< size_t > min_dim;
+      if( !FFTCorrelationPadding( dim, bank, min_dim ) ) {
+        std::string msg( BIAL_ERROR( "Frequency domain correlation requires kernels with integer displacements." ) );
+        throw( std::logic_error( msg ) );
+      }
+      FFTVolume volume( min_dim );
+      const Vector< size_t > &pad = volume.Dim( );
+      COMMENT( "Computing image spectrum.", 1 );
+      Vector< double > data( volume.VolumeSize( ), 0.0 );
+      double max_abs = 0.0;
+      for( size_t z = 0, pxl = 0; z < dim( 2 ); ++z ) {
+        for( size_t y = 0; y < dim( 1 ); ++y ) {
+          double *row = &data[ ( y + z * pad( 1 ) ) * pad( 0 ) ];
+          for( size_t x = 0; x < dim( 0 ); ++x, ++pxl ) {
+            row[ x ] = static_cast< double >( img[ pxl ] );
+            max_abs = std::max( max_abs, std::abs( row[ x ] ) );
+          }
+        }
+      }
+      Vector< std::complex< double > > img_spectrum;
+      volume.Forward( data, dim, img_spectrum );
+      Vector< std::complex< double > > krn_spectrum;
+      for( size_t krn = 0; krn < bank.size( ); ++krn ) {
+        COMMENT( "Placing kernel coefficients at circularly wrapped displacements.", 1 );
+        const Kernel &kernel = bank( krn );
+        std::fill( data.begin( ), data.end( ), 0.0 );
+        double abs_sum = 0.0;
+        for( size_t elm = 0; elm < kernel.size( ); ++elm ) {
+          size_t position = 0;
+          for( size_t dms = kernel.Dims( ); dms > 0; --dms ) {
+            llint dsp = static_cast< llint >( kernel.Displacement( dms - 1, elm ) );
+            llint size = static_cast< llint >( pad( dms - 1 ) );
+            position = position * pad( dms - 1 ) + static_cast< size_t >( ( dsp % size + size ) % size );
+          }
+          data[ position ] += kernel.Value( elm );
+          abs_sum += std::abs( kernel.Value( elm ) );
+        }
+        volume.Forward( data, pad, krn_spectrum );
+        COMMENT( "Correlation is the product by the conjugate of the kernel spectrum.", 1 );
+        ThreadPool::ParallelFor( 0, krn_spectrum.size( ), 4096, [ & ]( size_t first, size_t last ) {
+            for( size_t elm = first; elm < last; ++elm ) {
+              krn_spectrum[ elm ] = img_spectrum[ elm ] * std::conj( krn_spectrum[ elm ] );
+            }
+          } );
+        volume.Inverse( krn_spectrum, dim, data );
+        COMMENT( "Copying result. Integer types are snapped to integers within rounding error, so that truncation " <<
+                 "matches the spatial correlation.", 1 );
+        double tolerance = 1.0e-9 * std::max( 1.0, max_abs * abs_sum );
+        Image< D > res( img );
+        for( size_t z = 0, pxl = 0; z < dim( 2 ); ++z ) {
+          for( size_t y = 0; y < dim( 1 ); ++y ) {
+            const double *row = &data[ ( y + z * pad( 1 ) ) * pad( 0 ) ];
+            for( size_t x = 0; x < dim( 0 ); ++x, ++pxl ) {
+              double value = row[ x ];
+              if( std::is_integral< D >::value ) {
+                double rounded = std::round( value );
+                if( std::abs( value - rounded ) < tolerance ) {
+                  value = rounded;
+                }
+              }
+              res[ pxl ] = static_cast< D >( value );
+            }
+          }
+        }
+        result.push_back( res );
+      }
+      return( result );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  bool FFTCorrelationPadding( const Vector< size_t > &dim, const Vector< Kernel > &bank, Vector< size_t > &min_dim ) {
+    try {
+      COMMENT( "Padding must hold the largest displacement in each direction, so that wrapped adjacents fall on " <<
+               "zeros.", 2 );
+      min_dim = dim;
+      Vector< float > extent( dim.size( ), 0.0f );
+      for( size_t krn = 0; krn < bank.size( ); ++krn ) {
+        const Kernel &kernel = bank( krn );
+        if( kernel.Dims( ) > dim.size( ) ) {
+          return( false );
+        }
+        for( size_t elm = 0; elm < kernel.size( ); ++elm ) {
+          for( size_t dms = 0; dms < kernel.Dims( ); ++dms ) {
+            float dsp = kernel.Displacement( dms, elm );
+            if( dsp != std::floor( dsp ) ) {
+              return( false );
+            }
+            extent( dms ) = std::max( extent( dms ), std::abs( dsp ) );
+          }
+        }
+      }
+      for( size_t dms = 0; dms < dim.size( ); ++dms ) {
+        min_dim( dms ) += static_cast< size_t >( extent( dms ) );
+      }
+      return( true );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  bool UseFFTCorrelation( const Vector< size_t > &dim, const Vector< Kernel > &bank ) {
+    try {
+      COMMENT( "Relative costs per kernel element of spatial correlation and per element and level of FFT.", 2 );
+      const double SPATIAL_COST = 1.0;
+      const double FFT_COST = 0.3;
+      Vector< size_t > min_dim;
+      if( ( bank.size( ) == 0 ) || ( !FFTCorrelationPadding( dim, bank, min_dim ) ) ) {
+        return( false );
+      }
+      double elements = 1.0;
+      double padded = 1.0;
+      for( size_t dms = 0; dms < dim.size( ); ++dms ) {
+        elements *= dim( dms );
+        padded *= FFT::GoodSize( min_dim( dms ) );
+      }
+      double taps = 0.0;
+      for( size_t krn = 0; krn < bank.size( ); ++krn ) {
+        taps += bank( krn ).size( );
+      }
+      double spatial = SPATIAL_COST * elements * taps;
+      double spectral = FFT_COST * padded * std::log2( padded ) * ( 1.0 + 2.0 * bank.size( ) );
+      return( spectral < spatial );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
 #ifdef BIAL_EXPLICIT_Correlation
 
   template Image< int > Correlation( const Image< int > &img, const Kernel &krn );
+  template Image< int > SpatialCorrelation( const Image< int > &img, const Kernel &krn );
+  template Vector< Image< int > > Correlation( const Image< int > &img, const Vector< Kernel > &bank );
+  template Vector< Image< int > > FFTCorrelation( const Image< int > &img, const Vector< Kernel > &bank );
   template void CorrelationThreads( const Image< int > &img, const Kernel &krn, Image< int > &res, size_t thread, 
                                     size_t total_threads );
 
   template Image< llint > Correlation( const Image< llint > &img, const Kernel &krn );
+  template Image< llint > SpatialCorrelation( const Image< llint > &img, const Kernel &krn );
+  template Vector< Image< llint > > Correlation( const Image< llint > &img, const Vector< Kernel > &bank );
+  template Vector< Image< llint > > FFTCorrelation( const Image< llint > &img, const Vector< Kernel > &bank );
   template void CorrelationThreads( const Image< llint > &img, const Kernel &krn, Image< llint > &res, size_t thread,
                                     size_t total_threads );
 
   template Image< float > Correlation( const Image< float > &img, const Kernel &krn );
+  template Image< float > SpatialCorrelation( const Image< float > &img, const Kernel &krn );
+  template Vector< Image< float > > Correlation( const Image< float > &img, const Vector< Kernel > &bank );
+  template Vector< Image< float > > FFTCorrelation( const Image< float > &img, const Vector< Kernel > &bank );
   template void CorrelationThreads( const Image< float > &img, const Kernel &krn, Image< float > &res, size_t thread,
                                     size_t total_threads );
 
   template Image< double > Correlation( const Image< double > &img, const Kernel &krn );
+  template Image< double > SpatialCorrelation( const Image< double > &img, const Kernel &krn );
+  template Vector< Image< double > > Correlation( const Image< double > &img, const Vector< Kernel > &bank );
+  template Vector< Image< double > > FFTCorrelation( const Image< double > &img, const Vector< Kernel > &bank );
   template void CorrelationThreads( const Image< double > &img, const Kernel &krn, Image< double > &res, size_t thread,
                                     size_t total_threads );
 
@@ -0,0 +1,520 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Fast parsing of single-frame Dicom files.
+ */
+
+#ifndef BIALDICOMSLICE_C
+#define BIALDICOMSLICE_C
+
+#include "DicomSlice.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_DicomSlice )
+#define BIAL_EXPLICIT_DicomSlice
+#endif
+
+#if defined ( BIAL_EXPLICIT_DicomSlice ) || ( BIAL_IMPLICIT_BIN )
+
+#include "File.hpp"
+#include "Image.hpp"
+#include <cctype>
+#include <cstring>
+#include <vector>
+
+namespace Bial {
+
+  DicomSlice::DicomSlice( const std::string &filename ) try
+    : mapping( Map( filename ) ), rows( 0 ), columns( 0 ), samples( 1 ), frames( 1 ), bits_allocated( 16 ),
+      is_signed( false ), slope( 1.0 ), intercept( 0.0 ), row_spacing( 0.0 ), column_spacing( 0.0 ),
+      thickness( 0.0 ), spacing( 0.0 ), position( ), orientation( ), instance( 0 ), series( ), pixel_offset( 0 ),
+      pixel_bytes( 0 ) {
+    const char *data = mapping.Data( );
+    size_t pos = 0;
+    bool explicit_vr = false;
+    if( ( mapping.Size( ) >= PREAMBLE + 4 ) && ( std::memcmp( data + PREAMBLE, "DICM", 4 ) == 0 ) ) {
+      COMMENT( "Meta header elements are always explicit VR little endian.", 2 );
+      pos = PREAMBLE + 4;
+      std::string syntax( "1.2.840.10008.1.2" );
+      while( ( pos + 8 <= mapping.Size( ) ) && ( Load16( pos ) == 0x0002 ) ) {
+        uint tag;
+        size_t value;
+        size_t length;
+        ElementHeader( pos, true, tag, value, length );
+        if( length == UNDEFINED ) {
+          pos = Skip( value, true, SEQUENCE_DELIMITER );
+        }
+        else {
+          if( tag == 0x00020010 ) {
+            syntax = Text( value, length );
+          }
+          pos = value + length;
+        }
+      }
+      if( syntax.compare( "1.2.840.10008.1.2.1" ) == 0 ) {
+        explicit_vr = true;
+      }
+      else if( syntax.compare( "1.2.840.10008.1.2" ) != 0 ) {
+        std::string msg( BIAL_ERROR( "Unsupported Dicom transfer syntax " + syntax + " in " + filename +
+                                     ". Only uncompressed little endian files are supported." ) );
+        throw( std::logic_error( msg ) );
+      }
+    }
+    else if( mapping.Size( ) >= 8 ) {
+      COMMENT( "No meta header. Explicit VR files have letters where implicit VR files have a small length.", 2 );
+      explicit_vr = ( std::isupper( static_cast< uchar >( data[ 4 ] ) ) != 0 ) &&
+                    ( std::isupper( static_cast< uchar >( data[ 5 ] ) ) != 0 );
+    }
+    COMMENT( "Walking the data set up to the pixel data.", 2 );
+    while( pos + 8 <= mapping.Size( ) ) {
+      uint tag;
+      size_t value;
+      size_t length;
+      ElementHeader( pos, explicit_vr, tag, value, length );
+      if( tag == PIXEL_DATA ) {
+        if( length == UNDEFINED ) {
+          std::string msg( BIAL_ERROR( "Compressed Dicom pixel data in " + filename + " is not supported." ) );
+          throw( std::logic_error( msg ) );
+        }
+        pixel_offset = value;
+        pixel_bytes = length;
+        break;
+      }
+      if( length == UNDEFINED ) {
+        COMMENT( "UN elements of undefined length hold implicit VR data.", 4 );
+        bool nested_vr = explicit_vr && ( ( data[ pos + 4 ] != 'U' ) || ( data[ pos + 5 ] != 'N' ) );
+        pos = Skip( value, nested_vr, SEQUENCE_DELIMITER );
+      }
+      else {
+        if( value + length > mapping.Size( ) ) {
+          std::string msg( BIAL_ERROR( "Truncated Dicom file " + filename + "." ) );
+          throw( std::ios_base::failure( msg ) );
+        }
+        Store( tag, value, length );
+        pos = value + length;
+      }
+    }
+    COMMENT( "Checking the image description.", 2 );
+    if( pixel_bytes == 0 ) {
+      std::string msg( BIAL_ERROR( "Dicom file " + filename + " has no pixel data." ) );
+      throw( std::logic_error( msg ) );
+    }
+    if( ( rows == 0 ) || ( columns == 0 ) || ( samples == 0 ) ) {
+      std::string msg( BIAL_ERROR( "Dicom file " + filename + " has no image dimensions." ) );
+      throw( std::logic_error( msg ) );
+    }
+    if( frames > 1 ) {
+      std::string msg( BIAL_ERROR( "Multi-frame Dicom file " + filename + " is not supported." ) );
+      throw( std::logic_error( msg ) );
+    }
+    if( ( bits_allocated != 8 ) && ( bits_allocated != 16 ) && ( bits_allocated != 32 ) ) {
+      std::string msg( BIAL_ERROR( "Unsupported number of bits allocated in Dicom file " + filename + "." ) );
+      throw( std::logic_error( msg ) );
+    }
+    size_t bytes = rows * columns * samples * ( bits_allocated / 8 );
+    if( ( pixel_bytes < bytes ) || ( pixel_offset + bytes > mapping.Size( ) ) ) {
+      std::string msg( BIAL_ERROR( "Dicom pixel data of " + filename + " is shorter than its dimensions." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+  }
+  catch( std::ios_base::failure &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/reading/mapping Dicom file." ) );
+    throw( std::ios_base::failure( msg ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  bool DicomSlice::IsMappable( const std::string &filename ) {
+    try {
+      size_t pos = filename.size( ) - std::min( filename.size( ), static_cast< size_t >( 3 ) );
+      std::string extension( File::ToLowerExtension( filename, pos ) );
+      return( extension.compare( ".gz" ) != 0 );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  MappedFile DicomSlice::Map( const std::string &filename ) {
+    try {
+      if( IsMappable( filename ) ) {
+        return( MappedFile( filename ) );
+      }
+      IFile file( filename );
+      if( !file.is_open( ) ) {
+        std::string msg( BIAL_ERROR( "Could not open file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      COMMENT( "The decompressed size is not known in advance. Reading by blocks.", 2 );
+      const size_t block = 1 << 20;
+      std::vector< char > buffer;
+      size_t bytes = 0;
+      do {
+        buffer.resize( bytes + block );
+        file.read( buffer.data( ) + bytes, block );
+        bytes += static_cast< size_t >( file.gcount( ) );
+      } while( file.good( ) );
+      if( file.bad( ) ) {
+        std::string msg( BIAL_ERROR( "Could not decompress file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      buffer.resize( bytes );
+      return( MappedFile( buffer ) );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading Dicom file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  ushort DicomSlice::Load16( size_t value ) const {
+    const uchar *byte = reinterpret_cast< const uchar* >( mapping.Data( ) + value );
+    return( static_cast< ushort >( byte[ 0 ] | ( byte[ 1 ] << 8 ) ) );
+  }
+
+  uint DicomSlice::Load32( size_t value ) const {
+    return( static_cast< uint >( Load16( value ) ) | ( static_cast< uint >( Load16( value + 2 ) ) << 16 ) );
+  }
+
+  void DicomSlice::ElementHeader( size_t pos, bool explicit_vr, uint &tag, size_t &value, size_t &length ) const {
+    static const char long_vr[ ][ 3 ] = {
+      "OB", "OD", "OF", "OL", "OV", "OW", "SQ", "SV", "UC", "UN", "UR", "UT", "UV"
+    };
+    if( pos + 8 > mapping.Size( ) ) {
+      std::string msg( BIAL_ERROR( "Truncated Dicom file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    tag = ( static_cast< uint >( Load16( pos ) ) << 16 ) | Load16( pos + 2 );
+    value = pos + 8;
+    if( ( ( tag >> 16 ) == 0xFFFF ) || ( ( tag >> 16 ) == 0xFFFE ) || ( !explicit_vr ) ) {
+      COMMENT( "Items, delimiters, and implicit VR elements: 4 bytes tag and 4 bytes length.", 4 );
+      length = Load32( pos + 4 );
+      return;
+    }
+    const char *vr = mapping.Data( ) + pos + 4;
+    for( size_t lvr = 0; lvr < sizeof( long_vr ) / sizeof( long_vr[ 0 ] ); ++lvr ) {
+      if( ( vr[ 0 ] == long_vr[ lvr ][ 0 ] ) && ( vr[ 1 ] == long_vr[ lvr ][ 1 ] ) ) {
+        if( pos + 12 > mapping.Size( ) ) {
+          std::string msg( BIAL_ERROR( "Truncated Dicom file." ) );
+          throw( std::ios_base::failure( msg ) );
+        }
+        length = Load32( pos + 8 );
+        value = pos + 12;
+        return;
+      }
+    }
+    length = Load16( pos + 6 );
+  }
+
+  size_t DicomSlice::Skip( size_t pos, bool explicit_vr, uint delimiter ) const {
+    while( true ) {
+      uint tag;
+      size_t value;
+      size_t length;
+      ElementHeader( pos, explicit_vr, tag, value, length );
+      if( tag == delimiter ) {
+        return( value );
+      }
+      if( length == UNDEFINED ) {
+        bool nested_vr = explicit_vr &&
+                         ( ( mapping.Data( )[ pos + 4 ] != 'U' ) || ( mapping.Data( )[ pos + 5 ] != 'N' ) );
+        pos = Skip( value, nested_vr, tag == ITEM ? ITEM_DELIMITER : SEQUENCE_DELIMITER );
+      }
+      else {
+        pos = value + length;
+      }
+    }
+  }
+
+  std::string DicomSlice::Text( size_t value, size_t length ) const {
+    const char *text = mapping.Data( ) + value;
+    size_t first = 0;
+    while( ( first < length ) && ( text[ first ] == ' ' ) ) {
+      ++first;
+    }
+    while( ( length > first ) && ( ( text[ length - 1 ] == ' ' ) || ( text[ length - 1 ] == '\0' ) ) ) {
+      --length;
+    }
+    return( std::string( text + first, length - first ) );
+  }
+
+  Vector< double > DicomSlice::Numbers( size_t value, size_t length ) const {
+    std::string text( Text( value, length ) );
+    Vector< double > res;
+    size_t first = 0;
+    while( first <= text.size( ) ) {
+      size_t last = std::min( text.find( '\\', first ), text.size( ) );
+      std::string number( text.substr( first, last - first ) );
+      char *end = nullptr;
+      double val = std::strtod( number.c_str( ), &end );
+      if( end != number.c_str( ) ) {
+        res.push_back( val );
+      }
+      first = last + 1;
+    }
+    return( res );
+  }
+
+  void DicomSlice::Store( uint tag, size_t value, size_t length ) {
+    Vector< double > num;
+    switch( tag ) {
+    case 0x00280002:
+      samples = length >= 2 ? Load16( value ) : samples;
+      break;
+    case 0x00280008:
+      num = Numbers( value, length );
+      frames = num.empty( ) ? frames : static_cast< size_t >( std::max( num[ 0 ], 1.0 ) );
+      break;
+    case 0x00280010:
+      rows = length >= 2 ? Load16( value ) : rows;
+      break;
+    case 0x00280011:
+      columns = length >= 2 ? Load16( value ) : columns;
+      break;
+    case 0x00280100:
+      bits_allocated = length >= 2 ? Load16( value ) : bits_allocated;
+      break;
+    case 0x00280103:
+      is_signed = ( length >= 2 ) && ( Load16( value ) == 1 );
+      break;
+    case 0x00280030:
+      num = Numbers( value, length );
+      if( num.size( ) >= 2 ) {
+        row_spacing = num[ 0 ];
+        column_spacing = num[ 1 ];
+      }
+      break;
+    case 0x00281052:
+      num = Numbers( value, length );
+      intercept = num.empty( ) ? intercept : num[ 0 ];
+      break;
+    case 0x00281053:
+      num = Numbers( value, length );
+      slope = num.empty( ) ? slope : num[ 0 ];
+      break;
+    case 0x00180050:
+      num = Numbers( value, length );
+      thickness = num.empty( ) ? thickness : std::abs( num[ 0 ] );
+      break;
+    case 0x00180088:
+      num = Numbers( value, length );
+      spacing = num.empty( ) ? spacing : std::abs( num[ 0 ] );
+      break;
+    case 0x00200032:
+      num = Numbers( value, length );
+      position = num.size( ) == 3 ? num : position;
+      break;
+    case 0x00200037:
+      num = Numbers( value, length );
+      orientation = num.size( ) == 6 ? num : orientation;
+      break;
+    case 0x00200013:
+      num = Numbers( value, length );
+      instance = num.empty( ) ? instance : static_cast< long >( num[ 0 ] );
+      break;
+    case 0x0020000E:
+      series = Text( value, length );
+      break;
+    default:
+      break;
+    }
+  }
+
+  Vector< size_t > DicomSlice::Dim( ) const {
+    return( Vector< size_t >( { columns, rows } ) );
+  }
+
+  Vector< float > DicomSlice::PixelSize( ) const {
+    if( ( row_spacing <= 0.0 ) || ( column_spacing <= 0.0 ) ) {
+      return( Vector< float >( { 1.0f, 1.0f } ) );
+    }
+    COMMENT( "Pixel spacing is given as the distance between rows, then between columns.", 4 );
+    return( Vector< float >( { static_cast< float >( column_spacing ), static_cast< float >( row_spacing ) } ) );
+  }
+
+  bool DicomSlice::HasPosition( ) const {
+    return( ( position.size( ) == 3 ) && ( orientation.size( ) == 6 ) );
+  }
+
+  double DicomSlice::Location( ) const {
+    double normal_x = orientation[ 1 ] * orientation[ 5 ] - orientation[ 2 ] * orientation[ 4 ];
+    double normal_y = orientation[ 2 ] * orientation[ 3 ] - orientation[ 0 ] * orientation[ 5 ];
+    double normal_z = orientation[ 0 ] * orientation[ 4 ] - orientation[ 1 ] * orientation[ 3 ];
+    return( position[ 0 ] * normal_x + position[ 1 ] * normal_y + position[ 2 ] * normal_z );
+  }
+
+  double DicomSlice::SliceSpacing( ) const {
+    return( spacing > 0.0 ? spacing : thickness );
+  }
+
+  long DicomSlice::InstanceNumber( ) const {
+    return( instance );
+  }
+
+  const std::string &DicomSlice::SeriesUID( ) const {
+    return( series );
+  }
+
+  template< class S, class D >
+  void DicomSlice::Convert( const char *src, size_t size, D *dst, bool rescale ) const {
+    COMMENT( "Samples are little endian, as the byte order of supported systems.", 4 );
+    if( ( !rescale ) || ( ( slope == 1.0 ) && ( intercept == 0.0 ) ) ) {
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        S val;
+        std::memcpy( &val, src + pxl * sizeof( S ), sizeof( S ) );
+        dst[ pxl ] = static_cast< D >( val );
+      }
+    }
+    else {
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        S val;
+        std::memcpy( &val, src + pxl * sizeof( S ), sizeof( S ) );
+        dst[ pxl ] = static_cast< D >( val * slope + intercept );
+      }
+    }
+  }
+
+  template< class D >
+  void DicomSlice::Decode( D *dst, bool rescale ) const {
+    try {
+      if( samples != 1 ) {
+        std::string msg( BIAL_ERROR( "Cannot decode Dicom images with more than one sample per pixel." ) );
+        throw( std::logic_error( msg ) );
+      }
+      const char *src = mapping.Data( ) + pixel_offset;
+      size_t size = rows * columns;
+      if( bits_allocated == 8 ) {
+        if( is_signed ) {
+          Convert< signed char >( src, size, dst, rescale );
+        }
+        else {
+          Convert< uchar >( src, size, dst, rescale );
+        }
+      }
+      else if( bits_allocated == 16 ) {
+        if( is_signed ) {
+          Convert< short >( src, size, dst, rescale );
+        }
+        else {
+          Convert< ushort >( src, size, dst, rescale );
+        }
+      }
+      else {
+        if( is_signed ) {
+          Convert< int >( src, size, dst, rescale );
+        }
+        else {
+          Convert< uint >( src, size, dst, rescale );
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > DicomSlice::Read( bool rescale ) const {
+    try {
+      Image< D > res( Dim( ), StorageInit::None );
+      res.PixelSize( PixelSize( ) );
+      Decode( &res[ 0 ], rescale );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_DicomSlice
+
+  template void DicomSlice::Decode( int *dst, bool rescale ) const;
+  template Image< int > DicomSlice::Read( bool rescale ) const;
+
+  template void DicomSlice::Decode( llint *dst, bool rescale ) const;
+  template Image< llint > DicomSlice::Read( bool rescale ) const;
+
+  template void DicomSlice::Decode( float *dst, bool rescale ) const;
+  template Image< float > DicomSlice::Read( bool rescale ) const;
+
+  template void DicomSlice::Decode( double *dst, bool rescale ) const;
+  template Image< double > DicomSlice::Read( bool rescale ) const;
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -178,7 +178,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  inline bool DiffPathFunction< C, D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  inline bool DiffPathFunction< C, D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) &&
               ( this->value->operator()( index ) > this->value->operator()( adj_index ) ) );
@@ -202,7 +202,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  bool DiffPathFunction< C, D >::Propagate( int index, int adj_index ) {
+  bool DiffPathFunction< C, D >::Propagate( size_t index, size_t adj_index ) {
     try {
       D src_value = this->value->operator()( adj_index );
       D prp_value = this->value->operator()( index ) - handicap( adj_index );
@@ -0,0 +1,351 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Differential IFT (DIFT) over images. Keeps the optimum-path forest between seed edits.
+ */
+
+#ifndef BIALDIFFERENTIALIMAGEIFT_C
+#define BIALDIFFERENTIALIMAGEIFT_C
+
+#include "DifferentialImageIFT.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_DifferentialImageIFT )
+#define BIAL_EXPLICIT_DifferentialImageIFT
+#endif
+
+#if defined ( BIAL_EXPLICIT_DifferentialImageIFT ) || ( BIAL_IMPLICIT_BIN )
+
+#include "BucketQueueElements.hpp"
+#include "MaxPathFunction.hpp"
+#include "SumPathFunction.hpp"
+#include <limits>
+
+namespace Bial {
+
+  template< class D, class PF, class Q >
+  DifferentialImageIFT< D, PF, Q >::DifferentialImageIFT( const Image< D > &handicap, const Adjacency &adjacency,
+                                                          long double bucket_size, bool fifo_tie ) try :
+    value( handicap ), label( handicap.Dim( ) ), predecessor( handicap.Dim( ) ), root( handicap.Dim( ) ),
+      offsets( adjacency, handicap ), function( handicap ),
+      queue( handicap.size( ), bucket_size, function.PF::Increasing( ), fifo_tie ), seed( handicap.size( ), false ),
+      visited( 0 ) {
+      if( handicap.Dims( ) != adjacency.Dims( ) ) {
+        std::string msg( BIAL_ERROR( "Image and adjacency relation dimensions do not match. Image dimensions: " +
+                                     std::to_string( handicap.Dims( ) ) + ", adjacency dimensions: " +
+                                     std::to_string( adjacency.Dims( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Initializing the maps with no seeds.", 1 );
+      D infinity = Infinity( );
+      for( size_t pxl = 0; pxl < value.size( ); ++pxl ) {
+        value[ pxl ] = infinity;
+      }
+      label.Set( 0 );
+      predecessor.Set( -1 );
+      root.Set( -1 );
+      function.PF::Initialize( value, &label, &predecessor, false );
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D, class PF, class Q >
+  D DifferentialImageIFT< D, PF, Q >::Infinity( ) {
+    return( function.PF::Increasing( ) ? std::numeric_limits< D >::max( ) : std::numeric_limits< D >::lowest( ) );
+  }
+
+  template< class D, class PF, class Q >
+  bool DifferentialImageIFT< D, PF, Q >::Better( D lhs, D rhs ) {
+    return( function.PF::Increasing( ) ? ( lhs < rhs ) : ( lhs > rhs ) );
+  }
+
+  template< class D, class PF, class Q >
+  bool DifferentialImageIFT< D, PF, Q >::Offer( size_t src, size_t tgt, D &offer ) {
+    D tgt_value = value[ tgt ];
+    value[ tgt ] = Infinity( );
+    bool extended = ( ( function.PF::Capable( src, tgt, BucketState::NOT_VISITED ) ) &&
+                      ( function.PF::Propagate( src, tgt ) ) );
+    offer = value[ tgt ];
+    value[ tgt ] = tgt_value;
+    return( extended );
+  }
+
+  template< class D, class PF, class Q >
+  void DifferentialImageIFT< D, PF, Q >::Enqueue( size_t pxl, D cur_wgt, D new_wgt ) {
+    if( queue.Q::State( pxl ) == BucketState::NOT_VISITED ) {
+      touched.push_back( pxl );
+    }
+    queue.Q::Update( pxl, cur_wgt, new_wgt );
+  }
+
+  template< class D, class PF, class Q >
+  void DifferentialImageIFT< D, PF, Q >::RemoveTrees( ) {
+    size_t size = value.size( );
+    size_t adjs = offsets.size( );
+    D infinity = Infinity( );
+    Vector< size_t > tree;
+    Vector< size_t > frontier;
+    for( size_t elm = 0; elm < removed.size( ); ++elm ) {
+      size_t src = removed[ elm ];
+      if( !seed[ src ] ) {
+        continue;
+      }
+      COMMENT( "Resetting the tree of seed " << src << ".", 2 );
+      seed[ src ] = false;
+      value[ src ] = infinity;
+      label[ src ] = 0;
+      predecessor[ src ] = -1;
+      root[ src ] = -1;
+      tree.push_back( src );
+      while( !tree.empty( ) ) {
+        size_t pxl = tree.back( );
+        tree.pop_back( );
+        bool interior = offsets.Interior( pxl );
+        for( size_t adj = 0; adj < adjs; ++adj ) {
+          size_t adj_pxl = interior ? offsets( pxl, adj ) : offsets.Checked( pxl, adj );
+          if( adj_pxl >= size ) {
+            continue;
+          }
+          if( predecessor[ adj_pxl ] == static_cast< int >( pxl ) ) {
+            value[ adj_pxl ] = infinity;
+            label[ adj_pxl ] = 0;
+            predecessor[ adj_pxl ] = -1;
+            root[ adj_pxl ] = -1;
+            tree.push_back( adj_pxl );
+          }
+          else if( root[ adj_pxl ] != -1 ) {
+            frontier.push_back( adj_pxl );
+          }
+        }
+      }
+    }
+    COMMENT( "Inserting the frontier of the removed trees.", 2 );
+    for( size_t elm = 0; elm < frontier.size( ); ++elm ) {
+      size_t pxl = frontier[ elm ];
+      if( ( root[ pxl ] != -1 ) && ( queue.Q::State( pxl ) == BucketState::NOT_VISITED ) ) {
+        Enqueue( pxl, value[ pxl ], value[ pxl ] );
+      }
+    }
+  }
+
+  template< class D, class PF, class Q >
+  void DifferentialImageIFT< D, PF, Q >::InsertSeeds( ) {
+    for( size_t elm = 0; elm < added.size( ); ++elm ) {
+      size_t src = added[ elm ];
+      D previous_value = value[ src ];
+      seed[ src ] = true;
+      COMMENT( "Trivial path cost, as for a root in the IFT.", 4 );
+      function.PF::RemoveSimple( src, BucketState::INSERTED );
+      label[ src ] = added_label[ elm ];
+      predecessor[ src ] = -1;
+      root[ src ] = static_cast< int >( src );
+      Enqueue( src, previous_value, value[ src ] );
+    }
+  }
+
+  template< class D, class PF, class Q >
+  void DifferentialImageIFT< D, PF, Q >::Propagate( ) {
+    size_t size = value.size( );
+    size_t adjs = offsets.size( );
+    D *val = value.data( );
+    int *lbl = label.data( );
+    int *prd = predecessor.data( );
+    int *rot = root.data( );
+    while( !queue.Q::Empty( ) ) {
+      size_t pxl = queue.Q::Remove( );
+      queue.Q::Finished( pxl );
+      ++visited;
+      bool interior = offsets.Interior( pxl );
+      for( size_t adj = 0; adj < adjs; ++adj ) {
+        size_t adj_pxl = interior ? offsets( pxl, adj ) : offsets.Checked( pxl, adj );
+        if( ( adj_pxl >= size ) || ( seed[ adj_pxl ] ) ) {
+          continue;
+        }
+        bool child = ( prd[ adj_pxl ] == static_cast< int >( pxl ) );
+        if( ( !child ) && ( !Better( val[ pxl ], val[ adj_pxl ] ) ) ) {
+          continue;
+        }
+        D offer;
+        if( !Offer( pxl, adj_pxl, offer ) ) {
+          continue;
+        }
+        if( child ) {
+          if( ( offer == val[ adj_pxl ] ) && ( lbl[ adj_pxl ] == lbl[ pxl ] ) && ( rot[ adj_pxl ] == rot[ pxl ] ) ) {
+            COMMENT( "Predecessor did not change. Subtree is kept.", 4 );
+            continue;
+          }
+        }
+        else if( !Better( offer, val[ adj_pxl ] ) ) {
+          continue;
+        }
+        D previous_value = val[ adj_pxl ];
+        val[ adj_pxl ] = offer;
+        lbl[ adj_pxl ] = lbl[ pxl ];
+        rot[ adj_pxl ] = rot[ pxl ];
+        prd[ adj_pxl ] = static_cast< int >( pxl );
+        Enqueue( adj_pxl, previous_value, offer );
+      }
+    }
+  }
+
+  template< class D, class PF, class Q >
+  void DifferentialImageIFT< D, PF, Q >::AddSeeds( const Vector< size_t > &seeds, int seed_label ) {
+    try {
+      for( size_t elm = 0; elm < seeds.size( ); ++elm ) {
+        if( seeds[ elm ] >= value.size( ) ) {
+          std::string msg( BIAL_ERROR( "Seed out of image domain: " + std::to_string( seeds[ elm ] ) + "." ) );
+          throw( std::out_of_range( msg ) );
+        }
+        added.push_back( seeds[ elm ] );
+        added_label.push_back( seed_label );
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D, class PF, class Q >
+  void DifferentialImageIFT< D, PF, Q >::RemoveSeeds( const Vector< size_t > &seeds ) {
+    try {
+      for( size_t elm = 0; elm < seeds.size( ); ++elm ) {
+        if( seeds[ elm ] >= value.size( ) ) {
+          std::string msg( BIAL_ERROR( "Seed out of image domain: " + std::to_string( seeds[ elm ] ) + "." ) );
+          throw( std::out_of_range( msg ) );
+        }
+        removed.push_back( seeds[ elm ] );
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D, class PF, class Q >
+  void DifferentialImageIFT< D, PF, Q >::Run( ) {
+    try {
+      visited = 0;
+      COMMENT( "Removing " << removed.size( ) << " seeds.", 1 );
+      RemoveTrees( );
+      COMMENT( "Adding " << added.size( ) << " seeds.", 1 );
+      InsertSeeds( );
+      COMMENT( "Propagating.", 1 );
+      Propagate( );
+      COMMENT( "Visited " << visited << " pixels. Resetting queue states.", 1 );
+      for( size_t elm = 0; elm < touched.size( ); ++elm ) {
+        queue.Q::State( touched[ elm ], BucketState::NOT_VISITED );
+      }
+      touched.clear( );
+      added.clear( );
+      added_label.clear( );
+      removed.clear( );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D, class PF, class Q >
+  const Image< D > &DifferentialImageIFT< D, PF, Q >::Value( ) const {
+    return( value );
+  }
+
+  template< class D, class PF, class Q >
+  const Image< int > &DifferentialImageIFT< D, PF, Q >::Label( ) const {
+    return( label );
+  }
+
+  template< class D, class PF, class Q >
+  const Image< int > &DifferentialImageIFT< D, PF, Q >::Predecessor( ) const {
+    return( predecessor );
+  }
+
+  template< class D, class PF, class Q >
+  const Image< int > &DifferentialImageIFT< D, PF, Q >::Root( ) const {
+    return( root );
+  }
+
+  template< class D, class PF, class Q >
+  bool DifferentialImageIFT< D, PF, Q >::Seed( size_t pxl ) const {
+    return( seed[ pxl ] );
+  }
+
+  template< class D, class PF, class Q >
+  size_t DifferentialImageIFT< D, PF, Q >::Visited( ) const {
+    return( visited );
+  }
+
+#ifdef BIAL_EXPLICIT_DifferentialImageIFT
+
+  template class DifferentialImageIFT< int, MaxPathFunction< Image, int > >;
+  template class DifferentialImageIFT< llint, MaxPathFunction< Image, llint > >;
+  template class DifferentialImageIFT< float, MaxPathFunction< Image, float > >;
+  template class DifferentialImageIFT< double, MaxPathFunction< Image, double > >;
+
+  template class DifferentialImageIFT< int, SumPathFunction< Image, int > >;
+  template class DifferentialImageIFT< llint, SumPathFunction< Image, llint > >;
+  template class DifferentialImageIFT< float, SumPathFunction< Image, float > >;
+  template class DifferentialImageIFT< double, SumPathFunction< Image, double > >;
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,361 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Batched distance computation between feature vectors, with the distance function chosen per object.
+ */
+
+#ifndef BIALDISTANCEKERNEL_C
+#define BIALDISTANCEKERNEL_C
+
+#include "DistanceKernel.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_DistanceKernel )
+#define BIAL_EXPLICIT_DistanceKernel
+#endif
+
+#if defined ( BIAL_EXPLICIT_DistanceKernel ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Feature.hpp"
+#include "Matrix.hpp"
+#include "PreEuclideanDistanceFunction.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if ( defined ( __GNUC__ ) || defined ( __clang__ ) ) && ( defined ( __x86_64__ ) || defined ( __i386__ ) )
+#define BIAL_DISTANCE_KERNEL_AVX
+#include <immintrin.h>
+#endif
+
+namespace Bial {
+
+  DistanceKernel::DistanceKernel( DistanceFunctionType type ) : type( type ) {
+  }
+
+  DistanceFunctionType DistanceKernel::Type( ) const {
+    return( type );
+  }
+
+  DistanceKernel::InstructionSet DistanceKernel::Instructions( ) {
+#ifdef BIAL_DISTANCE_KERNEL_AVX
+    static const InstructionSet instructions = __builtin_cpu_supports( "avx512f" ) ? InstructionSet::AVX512 :
+      ( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) ) ? InstructionSet::AVX2 :
+      InstructionSet::Scalar;
+    return( instructions );
+#else
+    return( InstructionSet::Scalar );
+#endif
+  }
+
+  template< DistanceFunctionType T, class D >
+  void DistanceKernel::BatchScalar( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms,
+                                    double *res ) {
+    for( size_t elm = 0; elm < tgts; ++elm, tgt += stride ) {
+      double dist = 0.0;
+      for( size_t ftr = 0; ftr < dms; ++ftr ) {
+        double diff = static_cast< double >( src[ ftr ] ) - static_cast< double >( tgt[ ftr ] );
+        if( ( T == DistanceFunctionType::Euclidean ) || ( T == DistanceFunctionType::SquareEuclidean ) ) {
+          dist += diff * diff;
+        }
+        else if( T == DistanceFunctionType::CityBlock ) {
+          dist += std::abs( diff );
+        }
+        else {
+          dist = std::max( dist, std::abs( diff ) );
+        }
+      }
+      res[ elm ] = ( T == DistanceFunctionType::Euclidean ) ? std::sqrt( dist ) : dist;
+    }
+  }
+
+#ifdef BIAL_DISTANCE_KERNEL_AVX
+
+  /* Loads of 4 and 8 elements converted to double precision. */
+  __attribute__( ( target( "avx2,fma" ) ) )
+  static inline __m256d DistanceKernelLoad4( const float *src ) {
+    return( _mm256_cvtps_pd( _mm_loadu_ps( src ) ) );
+  }
+
+  __attribute__( ( target( "avx2,fma" ) ) )
+  static inline __m256d DistanceKernelLoad4( const double *src ) {
+    return( _mm256_loadu_pd( src ) );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) )
+  static inline __m512d DistanceKernelLoad8( const float *src ) {
+    return( _mm512_maskz_cvtps_pd( static_cast< __mmask8 >( 0xFF ), _mm256_loadu_ps( src ) ) );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) )
+  static inline __m512d DistanceKernelLoad8( const double *src ) {
+    return( _mm512_loadu_pd( src ) );
+  }
+
+  template< DistanceFunctionType T, class D >
+  __attribute__( ( target( "avx2,fma" ) ) )
+  void DistanceKernel::BatchAVX2( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms,
+                                  double *res ) {
+    const __m256d sign = _mm256_set1_pd( -0.0 );
+    size_t vec_end = dms - dms % 4;
+    for( size_t elm = 0; elm < tgts; ++elm, tgt += stride ) {
+      __m256d acc = _mm256_setzero_pd( );
+      for( size_t ftr = 0; ftr < vec_end; ftr += 4 ) {
+        __m256d diff = _mm256_sub_pd( DistanceKernelLoad4( src + ftr ), DistanceKernelLoad4( tgt + ftr ) );
+        if( ( T == DistanceFunctionType::Euclidean ) || ( T == DistanceFunctionType::SquareEuclidean ) ) {
+          acc = _mm256_fmadd_pd( diff, diff, acc );
+        }
+        else if( T == DistanceFunctionType::CityBlock ) {
+          acc = _mm256_add_pd( acc, _mm256_andnot_pd( sign, diff ) );
+        }
+        else {
+          acc = _mm256_max_pd( acc, _mm256_andnot_pd( sign, diff ) );
+        }
+      }
+      double lane[ 4 ];
+      _mm256_storeu_pd( lane, acc );
+      double dist;
+      if( T == DistanceFunctionType::ChessBoard ) {
+        dist = std::max( std::max( lane[ 0 ], lane[ 1 ] ), std::max( lane[ 2 ], lane[ 3 ] ) );
+      }
+      else {
+        dist = ( lane[ 0 ] + lane[ 1 ] ) + ( lane[ 2 ] + lane[ 3 ] );
+      }
+      COMMENT( "Remaining dimensions.", 4 );
+      double tail = 0.0;
+      BatchScalar< T == DistanceFunctionType::Euclidean ? DistanceFunctionType::SquareEuclidean : T >(
+        src + vec_end, tgt + vec_end, 1, 0, dms - vec_end, &tail );
+      dist = ( T == DistanceFunctionType::ChessBoard ) ? std::max( dist, tail ) : dist + tail;
+      res[ elm ] = ( T == DistanceFunctionType::Euclidean ) ? std::sqrt( dist ) : dist;
+    }
+  }
+
+  template< DistanceFunctionType T, class D >
+  __attribute__( ( target( "avx512f" ) ) )
+  void DistanceKernel::BatchAVX512( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms,
+                                    double *res ) {
+    const __m512i magnitude = _mm512_set1_epi64( 0x7FFFFFFFFFFFFFFFLL );
+    size_t vec_end = dms - dms % 8;
+    for( size_t elm = 0; elm < tgts; ++elm, tgt += stride ) {
+      __m512d acc = _mm512_setzero_pd( );
+      for( size_t ftr = 0; ftr < vec_end; ftr += 8 ) {
+        __m512d diff = _mm512_sub_pd( DistanceKernelLoad8( src + ftr ), DistanceKernelLoad8( tgt + ftr ) );
+        if( ( T == DistanceFunctionType::Euclidean ) || ( T == DistanceFunctionType::SquareEuclidean ) ) {
+          acc = _mm512_fmadd_pd( diff, diff, acc );
+        }
+        else {
+          __m512d abs = _mm512_castsi512_pd( _mm512_and_si512( _mm512_castpd_si512( diff ), magnitude ) );
+          if( T == DistanceFunctionType::CityBlock ) {
+            acc = _mm512_add_pd( acc, abs );
+          }
+          else {
+            acc = _mm512_mask_max_pd( acc, static_cast< __mmask8 >( 0xFF ), acc, abs );
+          }
+        }
+      }
+      COMMENT( "Intrinsics that pass an undefined register through, as the reductions, _mm512_max_pd and " <<
+               "_mm512_cvtps_pd, make GCC warn of uninitialized use. Masked forms and a lane array are used.", 4 );
+      double lane[ 8 ];
+      _mm512_storeu_pd( lane, acc );
+      double dist;
+      if( T == DistanceFunctionType::ChessBoard ) {
+        dist = std::max( std::max( std::max( lane[ 0 ], lane[ 1 ] ), std::max( lane[ 2 ], lane[ 3 ] ) ),
+                         std::max( std::max( lane[ 4 ], lane[ 5 ] ), std::max( lane[ 6 ], lane[ 7 ] ) ) );
+      }
+      else {
+        dist = ( ( lane[ 0 ] + lane[ 1 ] ) + ( lane[ 2 ] + lane[ 3 ] ) ) +
+          ( ( lane[ 4 ] + lane[ 5 ] ) + ( lane[ 6 ] + lane[ 7 ] ) );
+      }
+      COMMENT( "Remaining dimensions.", 4 );
+      double tail = 0.0;
+      BatchScalar< T == DistanceFunctionType::Euclidean ? DistanceFunctionType::SquareEuclidean : T >(
+        src + vec_end, tgt + vec_end, 1, 0, dms - vec_end, &tail );
+      dist = ( T == DistanceFunctionType::ChessBoard ) ? std::max( dist, tail ) : dist + tail;
+      res[ elm ] = ( T == DistanceFunctionType::Euclidean ) ? std::sqrt( dist ) : dist;
+    }
+  }
+
+#endif
+
+  template< DistanceFunctionType T, class D >
+  void DistanceKernel::BatchVector( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms,
+                                    double *res ) {
+#ifdef BIAL_DISTANCE_KERNEL_AVX
+    InstructionSet instructions = Instructions( );
+    if( instructions == InstructionSet::AVX512 ) {
+      BatchAVX512< T >( src, tgt, tgts, stride, dms, res );
+      return;
+    }
+    if( instructions == InstructionSet::AVX2 ) {
+      BatchAVX2< T >( src, tgt, tgts, stride, dms, res );
+      return;
+    }
+#endif
+    BatchScalar< T >( src, tgt, tgts, stride, dms, res );
+  }
+
+  template< DistanceFunctionType T, class D >
+  void DistanceKernel::Batch( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms, double *res ) {
+    BatchScalar< T >( src, tgt, tgts, stride, dms, res );
+  }
+
+  template< DistanceFunctionType T >
+  void DistanceKernel::Batch( const float *src, const float *tgt, size_t tgts, size_t stride, size_t dms,
+                              double *res ) {
+    BatchVector< T >( src, tgt, tgts, stride, dms, res );
+  }
+
+  template< DistanceFunctionType T >
+  void DistanceKernel::Batch( const double *src, const double *tgt, size_t tgts, size_t stride, size_t dms,
+                              double *res ) {
+    BatchVector< T >( src, tgt, tgts, stride, dms, res );
+  }
+
+  template< class D >
+  double DistanceKernel::Distance( const D *src, const D *tgt, size_t dms ) const {
+    double res = 0.0;
+    Distances( src, tgt, 1, 0, dms, &res );
+    return( res );
+  }
+
+  template< class D >
+  void DistanceKernel::Distances( const D *src, const D *tgt, size_t tgts, size_t stride, size_t dms,
+                                  double *res ) const {
+    switch( type ) {
+        case DistanceFunctionType::Euclidean: {
+        Batch< DistanceFunctionType::Euclidean >( src, tgt, tgts, stride, dms, res );
+        break;
+      }
+        case DistanceFunctionType::SquareEuclidean: {
+        Batch< DistanceFunctionType::SquareEuclidean >( src, tgt, tgts, stride, dms, res );
+        break;
+      }
+        case DistanceFunctionType::CityBlock: {
+        Batch< DistanceFunctionType::CityBlock >( src, tgt, tgts, stride, dms, res );
+        break;
+      }
+        case DistanceFunctionType::ChessBoard: {
+        Batch< DistanceFunctionType::ChessBoard >( src, tgt, tgts, stride, dms, res );
+        break;
+      }
+        case DistanceFunctionType::PreEuclidean: {
+        for( size_t elm = 0; elm < tgts; ++elm ) {
+          res[ elm ] = PreEuclideanDistanceFunction::Distance( src, tgt + elm * stride, dms );
+        }
+        break;
+      }
+    }
+  }
+
+  template< class D >
+  void DistanceKernel::Distances( const Feature< D > &feature, size_t src, size_t first, size_t last,
+                                  double *res ) const {
+    try {
+      if( ( src >= feature.Elements( ) ) || ( first > last ) || ( last > feature.Elements( ) ) ) {
+        std::string msg( BIAL_ERROR( "Element out of range. Elements: " + std::to_string( feature.Elements( ) ) +
+                                     ". Given: source " + std::to_string( src ) + ", range [ " +
+                                     std::to_string( first ) + ", " + std::to_string( last ) + " )." ) );
+        throw( std::out_of_range( msg ) );
+      }
+      size_t features = feature.Features( );
+      Distances( feature.data( ) + src * features, feature.data( ) + first * features, last - first, features,
+                 features, res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Matrix< double > DistanceKernel::Distances( const Feature< D > &src, const Feature< D > &tgt ) const {
+    try {
+      if( src.Features( ) != tgt.Features( ) ) {
+        std::string msg( BIAL_ERROR( "Source and target must have the same number of features. Given: " +
+                                     std::to_string( src.Features( ) ) + ", " + std::to_string( tgt.Features( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      size_t features = src.Features( );
+      size_t tgts = tgt.Elements( );
+      Matrix< double > res( src.Elements( ), tgts );
+      ThreadPool::ParallelFor( 0, src.Elements( ), 1, [ & ]( size_t first, size_t last ) {
+          Vector< double > dist( tgts );
+          for( size_t elm = first; elm < last; ++elm ) {
+            Distances( src.data( ) + elm * features, tgt.data( ), tgts, features, features, dist.data( ) );
+            for( size_t tgt_elm = 0; tgt_elm < tgts; ++tgt_elm ) {
+              res( elm, tgt_elm ) = dist[ tgt_elm ];
+            }
+          }
+        } );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_DistanceKernel
+
+  template double DistanceKernel::Distance( const int *src, const int *tgt, size_t dms ) const;
+  template void DistanceKernel::Distances( const int *src, const int *tgt, size_t tgts, size_t stride, size_t dms,
+                                           double *res ) const;
+  template void DistanceKernel::Distances( const Feature< int > &feature, size_t src, size_t first, size_t last,
+                                           double *res ) const;
+  template Matrix< double > DistanceKernel::Distances( const Feature< int > &src, const Feature< int > &tgt ) const;
+
+  template double DistanceKernel::Distance( const llint *src, const llint *tgt, size_t dms ) const;
+  template void DistanceKernel::Distances( const llint *src, const llint *tgt, size_t tgts, size_t stride, size_t dms,
+                                           double *res ) const;
+  template void DistanceKernel::Distances( const Feature< llint > &feature, size_t src, size_t first, size_t last,
+                                           double *res ) const;
+  template Matrix< double > DistanceKernel::Distances( const Feature< llint > &src, const Feature< llint > &tgt ) const;
+
+  template double DistanceKernel::Distance( const float *src, const float *tgt, size_t dms ) const;
+  template void DistanceKernel::Distances( const float *src, const float *tgt, size_t tgts, size_t stride, size_t dms,
+                                           double *res ) const;
+  template void DistanceKernel::Distances( const Feature< float > &feature, size_t src, size_t first, size_t last,
+                                           double *res ) const;
+  template Matrix< double > DistanceKernel::Distances( const Feature< float > &src, const Feature< float > &tgt ) const;
+
+  template double DistanceKernel::Distance( const double *src, const double *tgt, size_t dms ) const;
+  template void DistanceKernel::Distances( const double *src, const double *tgt, size_t tgts, size_t stride, size_t dms,
+                                           double *res ) const;
+  template void DistanceKernel::Distances( const Feature< double > &feature, size_t src, size_t first, size_t last,
+                                           double *res ) const;
+  template Matrix< double > DistanceKernel::Distances( const Feature< double > &src,
+                                                       const Feature< double > &tgt ) const;
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -203,7 +203,7 @@ namespace Bial {
   }
 
   template< class D >
-  inline bool EdgeMaxPathFunction< D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  inline bool EdgeMaxPathFunction< D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) &&
               ( this->value->operator()( index ) < this->value->operator()( adj_index ) ) );
@@ -227,7 +227,7 @@ namespace Bial {
   }
 
   template< class D >
-  bool EdgeMaxPathFunction< D >::Propagate( int index, int adj_index ) {
+  bool EdgeMaxPathFunction< D >::Propagate( size_t index, size_t adj_index ) {
     try {
       D src_value = this->value->operator()( adj_index );
       D arc_weight = static_cast< D >( std::abs( static_cast< double >( handicap( adj_index ) ) - handicap( index ) ) );
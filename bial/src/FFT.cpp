@@ -0,0 +1,396 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Fast Fourier transform.
+ */
+
+#ifndef BIALFFT_C
+#define BIALFFT_C
+
+#include "FFT.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_FFT )
+#define BIAL_EXPLICIT_FFT
+#endif
+#if defined ( BIAL_EXPLICIT_FFT ) || ( BIAL_IMPLICIT_BIN )
+
+#include "ThreadPool.hpp"
+
+namespace Bial {
+
+  FFT::FFT( size_t size ) try : fft_size( size ) {
+    if( size == 0 ) {
+      std::string msg( BIAL_ERROR( "Transform size must be greater than zero." ) );
+      throw( std::logic_error( msg ) );
+    }
+    COMMENT( "Factoring size. Radix 4 first, then 2, then odd numbers.", 2 );
+    std::vector< size_t > stages;
+    size_t remaining = size;
+    size_t radix = 4;
+    while( remaining > 1 ) {
+      while( remaining % radix != 0 ) {
+        if( radix == 4 ) {
+          radix = 2;
+        }
+        else if( radix == 2 ) {
+          radix = 3;
+        }
+        else {
+          radix += 2;
+        }
+        if( radix * radix > remaining ) {
+          radix = remaining;
+        }
+      }
+      remaining /= radix;
+      stages.push_back( radix );
+      stages.push_back( remaining );
+    }
+    if( stages.empty( ) ) {
+      stages.push_back( 1 );
+      stages.push_back( 1 );
+    }
+    factor = Vector< size_t >( stages );
+    COMMENT( "Computing twiddle factors.", 2 );
+    forward_twiddle = Vector< std::complex< double > >( size );
+    inverse_twiddle = Vector< std::complex< double > >( size );
+    for( size_t idx = 0; idx < size; ++idx ) {
+      double angle = -2.0 * M_PI * static_cast< double >( idx ) / static_cast< double >( size );
+      forward_twiddle[ idx ] = std::polar( 1.0, angle );
+      inverse_twiddle[ idx ] = std::conj( forward_twiddle[ idx ] );
+    }
+    real_twiddle = Vector< std::complex< double > >( size + 1 );
+    for( size_t idx = 0; idx <= size; ++idx ) {
+      real_twiddle[ idx ] = std::polar( 1.0, -M_PI * static_cast< double >( idx ) / static_cast< double >( size ) );
+    }
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  size_t FFT::size( ) const {
+    return( fft_size );
+  }
+
+  size_t FFT::GoodSize( size_t min_size ) {
+    for( size_t size = std::max< size_t >( min_size, 1 ); ; ++size ) {
+      size_t remaining = size;
+      while( remaining % 2 == 0 ) {
+        remaining /= 2;
+      }
+      while( remaining % 3 == 0 ) {
+        remaining /= 3;
+      }
+      while( remaining % 5 == 0 ) {
+        remaining /= 5;
+      }
+      if( remaining == 1 ) {
+        return( size );
+      }
+    }
+  }
+
+  void FFT::Work( std::complex< double > *out, const std::complex< double > *in, size_t fstride, size_t stage,
+                  const Vector< std::complex< double > > &twiddle ) const {
+    size_t radix = factor[ 2 * stage ];
+    size_t sub_size = factor[ 2 * stage + 1 ];
+    if( sub_size == 1 ) {
+      for( size_t rdx = 0; rdx < radix; ++rdx ) {
+        out[ rdx ] = in[ rdx * fstride ];
+      }
+    }
+    else {
+      for( size_t rdx = 0; rdx < radix; ++rdx ) {
+        Work( out + rdx * sub_size, in + rdx * fstride, fstride * radix, stage + 1, twiddle );
+      }
+    }
+    Butterfly( out, fstride, sub_size, radix, twiddle );
+  }
+
+  void FFT::Butterfly( std::complex< double > *data, size_t fstride, size_t sub_size, size_t radix,
+                       const Vector< std::complex< double > > &twiddle ) const {
+    if( radix == 2 ) {
+      for( size_t elm = 0; elm < sub_size; ++elm ) {
+        std::complex< double > odd = data[ elm + sub_size ] * twiddle[ elm * fstride ];
+        data[ elm + sub_size ] = data[ elm ] - odd;
+        data[ elm ] += odd;
+      }
+    }
+    else if( radix == 4 ) {
+      COMMENT( "Multiplication by -i in forward transform, or by i in inverse transform.", 4 );
+      std::complex< double > rotation( 0.0, ( &twiddle == &forward_twiddle ) ? -1.0 : 1.0 );
+      for( size_t elm = 0; elm < sub_size; ++elm ) {
+        std::complex< double > s0 = data[ elm + sub_size ] * twiddle[ elm * fstride ];
+        std::complex< double > s1 = data[ elm + 2 * sub_size ] * twiddle[ 2 * elm * fstride ];
+        std::complex< double > s2 = data[ elm + 3 * sub_size ] * twiddle[ 3 * elm * fstride ];
+        std::complex< double > s5 = data[ elm ] - s1;
+        std::complex< double > s3 = s0 + s2;
+        std::complex< double > s4 = ( s0 - s2 ) * rotation;
+        data[ elm ] += s1;
+        data[ elm + 2 * sub_size ] = data[ elm ] - s3;
+        data[ elm ] += s3;
+        data[ elm + sub_size ] = s5 + s4;
+        data[ elm + 3 * sub_size ] = s5 - s4;
+      }
+    }
+    else {
+      COMMENT( "Generic radix. Direct DFT of size radix for each element of the sub-transforms.", 4 );
+      std::complex< double > local[ 5 ];
+      std::vector< std::complex< double > > large;
+      std::complex< double > *scratch = local;
+      if( radix > 5 ) {
+        large.resize( radix );
+        scratch = large.data( );
+      }
+      for( size_t elm = 0; elm < sub_size; ++elm ) {
+        for( size_t rdx = 0; rdx < radix; ++rdx ) {
+          scratch[ rdx ] = data[ elm + rdx * sub_size ];
+        }
+        for( size_t rdx = 0; rdx < radix; ++rdx ) {
+          size_t index = elm + rdx * sub_size;
+          size_t twd = 0;
+          std::complex< double > sum = scratch[ 0 ];
+          for( size_t src = 1; src < radix; ++src ) {
+            twd += fstride * index;
+            if( twd >= fft_size ) {
+              twd %= fft_size;
+            }
+            sum += scratch[ src ] * twiddle[ twd ];
+          }
+          data[ index ] = sum;
+        }
+      }
+    }
+  }
+
+  void FFT::Forward( const std::complex< double > *in, std::complex< double > *out ) const {
+    Work( out, in, 1, 0, forward_twiddle );
+  }
+
+  void FFT::Inverse( const std::complex< double > *in, std::complex< double > *out ) const {
+    Work( out, in, 1, 0, inverse_twiddle );
+  }
+
+  void FFT::RealForward( const double *in, std::complex< double > *out, std::complex< double > *scratch ) const {
+    COMMENT( "Packing even samples as real part and odd samples as imaginary part.", 4 );
+    for( size_t elm = 0; elm < fft_size; ++elm ) {
+      scratch[ elm ] = std::complex< double >( in[ 2 * elm ], in[ 2 * elm + 1 ] );
+    }
+    Forward( scratch, out );
+    out[ fft_size ] = out[ 0 ];
+    COMMENT( "Splitting even and odd spectra, and combining them. Elements k and size - k are computed together.", 4 );
+    const std::complex< double > minus_half_i( 0.0, -0.5 );
+    for( size_t elm = 0; elm <= fft_size / 2; ++elm ) {
+      std::complex< double > low = out[ elm ];
+      std::complex< double > high = out[ fft_size - elm ];
+      std::complex< double > even = ( low + std::conj( high ) ) * 0.5;
+      std::complex< double > odd = ( low - std::conj( high ) ) * minus_half_i;
+      out[ elm ] = even + real_twiddle[ elm ] * odd;
+      even = ( high + std::conj( low ) ) * 0.5;
+      odd = ( high - std::conj( low ) ) * minus_half_i;
+      out[ fft_size - elm ] = even + real_twiddle[ fft_size - elm ] * odd;
+    }
+  }
+
+  void FFT::RealInverse( const std::complex< double > *in, double *out, std::complex< double > *scratch ) const {
+    COMMENT( "Recovering the spectrum of the packed sequence.", 4 );
+    const std::complex< double > i_unit( 0.0, 1.0 );
+    for( size_t elm = 0; elm < fft_size; ++elm ) {
+      std::complex< double > high = std::conj( in[ fft_size - elm ] );
+      std::complex< double > even = ( in[ elm ] + high ) * 0.5;
+      std::complex< double > odd = ( in[ elm ] - high ) * 0.5 * std::conj( real_twiddle[ elm ] );
+      scratch[ elm ] = even + i_unit * odd;
+    }
+    Inverse( scratch, scratch + fft_size );
+    for( size_t elm = 0; elm < fft_size; ++elm ) {
+      out[ 2 * elm ] = scratch[ fft_size + elm ].real( );
+      out[ 2 * elm + 1 ] = scratch[ fft_size + elm ].imag( );
+    }
+  }
+
+  FFTVolume::FFTVolume( const Vector< size_t > &min_dim ) try : dim_size( 3, 1 ) {
+    if( ( min_dim.size( ) == 0 ) || ( min_dim.size( ) > 3 ) ) {
+      std::string msg( BIAL_ERROR( "Volume must have 1 to 3 dimensions. Given: " +
+                                   std::to_string( min_dim.size( ) ) ) );
+      throw( std::logic_error( msg ) );
+    }
+    for( size_t dms = 1; dms < min_dim.size( ); ++dms ) {
+      dim_size[ dms ] = FFT::GoodSize( min_dim[ dms ] );
+    }
+    dim_size[ 0 ] = 2 * FFT::GoodSize( ( std::max< size_t >( min_dim[ 0 ], 2 ) + 1 ) / 2 );
+    fft_x = FFT( dim_size[ 0 ] / 2 );
+    fft_y = FFT( dim_size[ 1 ] );
+    fft_z = FFT( dim_size[ 2 ] );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  const Vector< size_t > &FFTVolume::Dim( ) const {
+    return( dim_size );
+  }
+
+  size_t FFTVolume::VolumeSize( ) const {
+    return( dim_size[ 0 ] * dim_size[ 1 ] * dim_size[ 2 ] );
+  }
+
+  size_t FFTVolume::SpectrumSize( ) const {
+    return( ( dim_size[ 0 ] / 2 + 1 ) * dim_size[ 1 ] * dim_size[ 2 ] );
+  }
+
+  void FFTVolume::Lines( Vector< std::complex< double > > &spectrum, const FFT &fft, size_t lines, size_t inner,
+                         size_t outer_stride, size_t stride, bool inverse ) const {
+    if( fft.size( ) == 1 ) {
+      return;
+    }
+    size_t length = fft.size( );
+    ThreadPool::ParallelFor( 0, lines, std::max< size_t >( 1, 1024 / length ), [ & ]( size_t first, size_t last ) {
+        std::vector< std::complex< double > > line( 2 * length );
+        for( size_t lne = first; lne < last; ++lne ) {
+          std::complex< double > *data = &spectrum[ lne % inner + ( lne / inner ) * outer_stride ];
+          for( size_t elm = 0; elm < length; ++elm ) {
+            line[ elm ] = data[ elm * stride ];
+          }
+          if( inverse ) {
+            fft.Inverse( line.data( ), line.data( ) + length );
+          }
+          else {
+            fft.Forward( line.data( ), line.data( ) + length );
+          }
+          for( size_t elm = 0; elm < length; ++elm ) {
+            data[ elm * stride ] = line[ length + elm ];
+          }
+        }
+      } );
+  }
+
+  void FFTVolume::Forward( const Vector< double > &volume, const Vector< size_t > &used,
+                           Vector< std::complex< double > > &spectrum ) const {
+    try {
+      if( volume.size( ) != VolumeSize( ) ) {
+        std::string msg( BIAL_ERROR( "Volume size does not match the transform. Given: " +
+                                     std::to_string( volume.size( ) ) + ", expected: " +
+                                     std::to_string( VolumeSize( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      size_t x_bins = dim_size[ 0 ] / 2 + 1;
+      size_t used_y = std::min( used.size( ) > 1 ? used[ 1 ] : 1, dim_size[ 1 ] );
+      size_t used_z = std::min( used.size( ) > 2 ? used[ 2 ] : 1, dim_size[ 2 ] );
+      spectrum = Vector< std::complex< double > >( SpectrumSize( ) );
+      COMMENT( "Real transform of the non-null rows.", 2 );
+      ThreadPool::ParallelFor( 0, used_y * used_z, 1, [ & ]( size_t first, size_t last ) {
+          std::vector< std::complex< double > > scratch( fft_x.size( ) );
+          for( size_t row = first; row < last; ++row ) {
+            size_t position = row % used_y + ( row / used_y ) * dim_size[ 1 ];
+            fft_x.RealForward( &volume[ position * dim_size[ 0 ] ], &spectrum[ position * x_bins ],
+                               scratch.data( ) );
+          }
+        } );
+      COMMENT( "Transform along the second dimension, for the non-null slices.", 2 );
+      Lines( spectrum, fft_y, x_bins * used_z, x_bins, x_bins * dim_size[ 1 ], x_bins, false );
+      COMMENT( "Transform along the third dimension.", 2 );
+      Lines( spectrum, fft_z, x_bins * dim_size[ 1 ], x_bins * dim_size[ 1 ], 0, x_bins * dim_size[ 1 ], false );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void FFTVolume::Inverse( Vector< std::complex< double > > &spectrum, const Vector< size_t > &used,
+                           Vector< double > &volume ) const {
+    try {
+      if( spectrum.size( ) != SpectrumSize( ) ) {
+        std::string msg( BIAL_ERROR( "Spectrum size does not match the transform. Given: " +
+                                     std::to_string( spectrum.size( ) ) + ", expected: " +
+                                     std::to_string( SpectrumSize( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( volume.size( ) != VolumeSize( ) ) {
+        volume = Vector< double >( VolumeSize( ), 0.0 );
+      }
+      size_t x_bins = dim_size[ 0 ] / 2 + 1;
+      size_t used_y = std::min( used.size( ) > 1 ? used[ 1 ] : 1, dim_size[ 1 ] );
+      size_t used_z = std::min( used.size( ) > 2 ? used[ 2 ] : 1, dim_size[ 2 ] );
+      COMMENT( "Inverse transform along the third dimension.", 2 );
+      Lines( spectrum, fft_z, x_bins * dim_size[ 1 ], x_bins * dim_size[ 1 ], 0, x_bins * dim_size[ 1 ], true );
+      COMMENT( "Inverse transform along the second dimension, for the required slices.", 2 );
+      Lines( spectrum, fft_y, x_bins * used_z, x_bins, x_bins * dim_size[ 1 ], x_bins, true );
+      COMMENT( "Inverse real transform of the required rows, with normalization.", 2 );
+      double scale = 1.0 / ( static_cast< double >( fft_x.size( ) ) * dim_size[ 1 ] * dim_size[ 2 ] );
+      ThreadPool::ParallelFor( 0, used_y * used_z, 1, [ & ]( size_t first, size_t last ) {
+          std::vector< std::complex< double > > scratch( 2 * fft_x.size( ) );
+          for( size_t row = first; row < last; ++row ) {
+            size_t position = row % used_y + ( row / used_y ) * dim_size[ 1 ];
+            double *out = &volume[ position * dim_size[ 0 ] ];
+            fft_x.RealInverse( &spectrum[ position * x_bins ], out, scratch.data( ) );
+            for( size_t elm = 0; elm < dim_size[ 0 ]; ++elm ) {
+              out[ elm ] *= scale;
+            }
+          }
+        } );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+}
+
+#endif
+
+#endif
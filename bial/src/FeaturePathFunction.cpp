@@ -108,7 +108,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  inline bool FeatureDistanceFunction< C, D >::Capable( int, int adj_index, BucketState adj_state ) {
+  inline bool FeatureDistanceFunction< C, D >::Capable( size_t, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) && ( this->value->operator()( adj_index ) > 0.0 ) );
     }
@@ -131,7 +131,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  bool FeatureDistanceFunction< C, D >::Propagate( int index, int adj_index ) {
+  bool FeatureDistanceFunction< C, D >::Propagate( size_t index, size_t adj_index ) {
     try {
       double distance = DFIDE::Distance( feats, feats, index * feats.Features( ), adj_index * feats.Features( ),
                                          feats.Features( ) );
@@ -1391,8 +1391,7 @@ namespace Bial {
   std::streamsize IFile::gcount( ) {
     try {
       if( gziped ) {
-        std::string msg( BIAL_ERROR( "No support for random access on gzip files." ) );
-        throw( std::ios_base::failure( msg ) );
+        return( gz_file.gcount( ) );
       }
       return( std_file.gcount( ) );
     }
@@ -1784,8 +1783,7 @@ namespace Bial {
   IFile &IFile::seekg( std::streampos pos ) {
     try {
       if( gziped ) {
-        std::string msg( BIAL_ERROR( "No support for random access on gzip files." ) );
-        throw( std::ios_base::failure( msg ) );
+        gz_file.seekg( pos );
       }
       else {
         std_file.seekg( pos );
@@ -1821,8 +1819,7 @@ namespace Bial {
   IFile &IFile::seekg( std::streamoff off, std::ios_base::seekdir way ) {
     try {
       if( gziped ) {
-        std::string msg( BIAL_ERROR( "No support for random access on gzip files." ) );
-        throw( std::ios_base::failure( msg ) );
+        gz_file.seekg( off, way );
       }
       else {
         std_file.seekg( off, way );
@@ -3322,8 +3319,7 @@ namespace Bial {
   std::streampos OFile::tellp( ) {
     try {
       if( gziped ) {
-        std::string msg( BIAL_ERROR( "No support for random access on gzip files." ) );
-        throw( std::ios_base::failure( msg ) );
+        return( gz_file.tellp( ) );
       }
       else {
         return( std_file.tellp( ) );
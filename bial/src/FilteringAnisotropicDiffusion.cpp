@@ -24,6 +24,7 @@
 #include "FileImage.hpp"
 #endif
 #include "Image.hpp"
+#include "ThreadPool.hpp"
 
 namespace Bial {
 
@@ -88,22 +89,10 @@ namespace Bial {
       for( size_t itr = 0; itr < iterations; ++itr ) {
 
         COMMENT( "Computing diffusion filter.", 2 );
-        try {
-          size_t total_threads = 12;
-          Vector< std::thread > threads;
-          for( size_t thd = 0; thd < total_threads; ++thd ) {
-            threads.push_back( std::thread( &AnisotropicDiffusionThread< D >, std::ref( img ), std::ref( res ),
-                                            integration_constant, diff_func, kappa, std::ref( adj ), thd,
-                                            total_threads ) );
-          }
-          for( size_t thd = 0; thd < total_threads; ++thd ) {
-            threads( thd ).join( );
-          }
-        }
-        catch( std::exception &e ) {
-          BIAL_WARNING( "Failed to run in multi-thread. Exception: " << e.what( ) );
-          Filtering::AnisotropicDiffusionThread( img, res, integration_constant, diff_func, kappa, adj, 0, 1 );
-        }
+        ThreadPool::Run( ThreadPool::Tasks( img.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+            Filtering::AnisotropicDiffusionThread( img, res, integration_constant, diff_func, kappa, adj, thd,
+                                                   total_threads );
+          } );
 
         COMMENT( "Updating image.", 2 );
         std::swap( img, res );
@@ -19,11 +19,15 @@
 #if defined ( BIAL_EXPLICIT_FilteringGaussian ) || ( BIAL_IMPLICIT_BIN )
 
 #include "Correlation.hpp"
+#include "FilteringMean.hpp"
 #ifdef BIAL_DEBUG
 #include "FileImage.hpp"
 #endif
 #include "Image.hpp"
 #include "KernelGaussian.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+#include <cmath>
 
 namespace Bial {
 
@@ -61,6 +65,299 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  Image< D > Filtering::SeparableGaussian( const Image< D > &img, float radius, float std_dev ) {
+    try {
+      if( radius <= 0.0 ) {
+        std::string msg( BIAL_ERROR( "Radius must be greater than 0.0. Given: " + std::to_string( radius ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( std_dev <= 0.0 ) {
+        std::string msg( BIAL_ERROR( "Standard deviation must be greater than 0.0. Given: " +
+                                     std::to_string( std_dev ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "1D kernel generation. The product of the dimensions gives the same amplitude of KernelType::Gaussian.",
+               1 );
+      int krn_radius = static_cast< int >( radius );
+      double amplitude = 1.0 / ( std::sqrt( 2.0 * M_PI ) * std_dev );
+      Vector< double > weight( 2 * krn_radius + 1 );
+      for( int dsp = -krn_radius; dsp <= krn_radius; ++dsp ) {
+        weight[ dsp + krn_radius ] = amplitude * std::exp( -dsp * dsp / ( 2.0 * std_dev * std_dev ) );
+      }
+      COMMENT( "Running 1D correlations. Adjacents out of the image domain are ignored, as in Correlation.", 1 );
+      Image< double > res( img );
+      for( size_t dms = 0; dms < img.Dims( ); ++dms ) {
+        FilterLines( res, dms, [ &weight, krn_radius ]( Vector< double > &line ) {
+            int size = static_cast< int >( line.size( ) );
+            Vector< double > src( line );
+            for( int pxl = 0; pxl < size; ++pxl ) {
+              int first = std::max( -krn_radius, -pxl );
+              int last = std::min( krn_radius, size - 1 - pxl );
+              double sum = 0.0;
+              for( int dsp = first; dsp <= last; ++dsp ) {
+                sum += src[ pxl + dsp ] * weight[ dsp + krn_radius ];
+              }
+              line[ pxl ] = sum;
+            }
+          } );
+      }
+      return( Image< D >( res ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > Filtering::RecursiveGaussian( const Image< D > &img, float std_dev ) {
+    try {
+      if( std_dev < 0.5 ) {
+        std::string msg( BIAL_ERROR( "Standard deviation must be at least 0.5. Given: " + std::to_string( std_dev ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      Image< double > res( img );
+      for( size_t dms = 0; dms < img.Dims( ); ++dms ) {
+        FilterLines( res, dms, [ std_dev ]( Vector< double > &line ) {
+            RecursiveGaussian( line, std_dev );
+          } );
+      }
+      return( Image< D >( res ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > Filtering::RecursiveGaussianDerivative( const Image< D > &img, float std_dev, size_t direction ) {
+    try {
+      if( std_dev < 0.5 ) {
+        std::string msg( BIAL_ERROR( "Standard deviation must be at least 0.5. Given: " + std::to_string( std_dev ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( direction >= img.Dims( ) ) {
+        std::string msg( BIAL_ERROR( "Direction must be smaller than the number of image dimensions. Given: " +
+                                     std::to_string( direction ) + ", dimensions: " +
+                                     std::to_string( img.Dims( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      Image< double > res( img );
+      for( size_t dms = 0; dms < img.Dims( ); ++dms ) {
+        FilterLines( res, dms, [ std_dev, dms, direction ]( Vector< double > &line ) {
+            RecursiveGaussian( line, std_dev );
+            if( dms != direction ) {
+              return;
+            }
+            COMMENT( "Central differences. One-sided differences on the extremities.", 4 );
+            size_t size = line.size( );
+            if( size == 1 ) {
+              line[ 0 ] = 0.0;
+              return;
+            }
+            double previous = line[ 0 ];
+            line[ 0 ] = line[ 1 ] - line[ 0 ];
+            for( size_t pxl = 1; pxl < size - 1; ++pxl ) {
+              double current = line[ pxl ];
+              line[ pxl ] = 0.5 * ( line[ pxl + 1 ] - previous );
+              previous = current;
+            }
+            line[ size - 1 ] = line[ size - 1 ] - previous;
+          } );
+      }
+      return( Image< D >( res ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > Filtering::BoxGaussian( const Image< D > &img, float std_dev, size_t passes ) {
+    try {
+      if( ( std_dev <= 0.0 ) || ( passes == 0 ) ) {
+        std::string msg( BIAL_ERROR( "Standard deviation and number of passes must be positive. Given: " +
+                                     std::to_string( std_dev ) + ", " + std::to_string( passes ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Ideal box width, and the odd widths below and above it.", 2 );
+      double variance = 12.0 * std_dev * std_dev;
+      double ideal = std::sqrt( variance / passes + 1.0 );
+      size_t lower = static_cast< size_t >( ideal );
+      if( lower % 2 == 0 ) {
+        --lower;
+      }
+      size_t upper = lower + 2;
+      COMMENT( "Number of passes with the lower width.", 2 );
+      double lower_passes = ( variance - passes * lower * lower - 4.0 * passes * lower - 3.0 * passes ) /
+        ( -4.0 * lower - 4.0 );
+      size_t lower_total = static_cast< size_t >( std::max( 0.0, std::min( static_cast< double >( passes ),
+                                                                            std::round( lower_passes ) ) ) );
+      Image< double > res( img );
+      for( size_t pass = 0; pass < passes; ++pass ) {
+        size_t width = pass < lower_total ? lower : upper;
+        res = BoxMean( res, Vector< size_t >( img.Dims( ), width / 2 ) );
+      }
+      return( Image< D >( res ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void Filtering::FilterLines( Image< double > &img, size_t direction,
+                               const std::function< void( Vector< double > & ) > &filter ) {
+    try {
+      COMMENT( "Lines along direction start at ( inner + outer * length * stride ), for inner < stride.", 1 );
+      size_t length = img.size( direction );
+      size_t stride = 1;
+      for( size_t dms = 0; dms < direction; ++dms ) {
+        stride *= img.size( dms );
+      }
+      size_t lines = img.size( ) / length;
+      ThreadPool::ParallelFor( 0, lines, std::max< size_t >( 1, 4096 / length ), [ & ]( size_t first, size_t last ) {
+          Vector< double > line( length );
+          for( size_t lne = first; lne < last; ++lne ) {
+            size_t base = lne % stride + ( lne / stride ) * length * stride;
+            for( size_t pxl = 0; pxl < length; ++pxl ) {
+              line[ pxl ] = img[ base + pxl * stride ];
+            }
+            filter( line );
+            for( size_t pxl = 0; pxl < length; ++pxl ) {
+              img[ base + pxl * stride ] = line[ pxl ];
+            }
+          }
+        } );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void Filtering::RecursiveGaussian( Vector< double > &line, float std_dev ) {
+    try {
+      COMMENT( "Filter coefficients from Young and van Vliet, 1995.", 4 );
+      double q;
+      if( std_dev >= 2.5 ) {
+        q = 0.98711 * std_dev - 0.96330;
+      }
+      else {
+        q = 3.97156 - 4.14554 * std::sqrt( 1.0 - 0.26891 * std_dev );
+      }
+      double q2 = q * q;
+      double q3 = q2 * q;
+      double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+      double b1 = ( 2.44413 * q + 2.85619 * q2 + 1.26661 * q3 ) / b0;
+      double b2 = -( 1.4281 * q2 + 1.26661 * q3 ) / b0;
+      double b3 = ( 0.422205 * q3 ) / b0;
+      double gain = 1.0 - ( b1 + b2 + b3 );
+      size_t size = line.size( );
+      COMMENT( "Causal pass. Border is replicated, which is the steady state of a unit gain filter.", 4 );
+      double w1 = line[ 0 ];
+      double w2 = w1;
+      double w3 = w1;
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        double w0 = gain * line[ pxl ] + b1 * w1 + b2 * w2 + b3 * w3;
+        line[ pxl ] = w0;
+        w3 = w2;
+        w2 = w1;
+        w1 = w0;
+      }
+      COMMENT( "Anti-causal pass.", 4 );
+      w1 = line[ size - 1 ];
+      w2 = w1;
+      w3 = w1;
+      for( size_t pxl = size; pxl > 0; --pxl ) {
+        double w0 = gain * line[ pxl - 1 ] + b1 * w1 + b2 * w2 + b3 * w3;
+        line[ pxl - 1 ] = w0;
+        w3 = w2;
+        w2 = w1;
+        w1 = w0;
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
 #ifdef BIAL_EXPLICIT_FilteringGaussian
 
   template Image< int > Filtering::Gaussian( const Image< int > &img, float radius, float std_dev );
@@ -68,6 +365,30 @@ namespace Bial {
   template Image< float > Filtering::Gaussian( const Image< float > &img, float radius, float std_dev );
   template Image< double > Filtering::Gaussian( const Image< double > &img, float radius, float std_dev );
 
+  template Image< int > Filtering::SeparableGaussian( const Image< int > &img, float radius, float std_dev );
+  template Image< int > Filtering::RecursiveGaussian( const Image< int > &img, float std_dev );
+  template Image< int > Filtering::RecursiveGaussianDerivative( const Image< int > &img, float std_dev,
+                                                                size_t direction );
+  template Image< int > Filtering::BoxGaussian( const Image< int > &img, float std_dev, size_t passes );
+
+  template Image< llint > Filtering::SeparableGaussian( const Image< llint > &img, float radius, float std_dev );
+  template Image< llint > Filtering::RecursiveGaussian( const Image< llint > &img, float std_dev );
+  template Image< llint > Filtering::RecursiveGaussianDerivative( const Image< llint > &img, float std_dev,
+                                                                  size_t direction );
+  template Image< llint > Filtering::BoxGaussian( const Image< llint > &img, float std_dev, size_t passes );
+
+  template Image< float > Filtering::SeparableGaussian( const Image< float > &img, float radius, float std_dev );
+  template Image< float > Filtering::RecursiveGaussian( const Image< float > &img, float std_dev );
+  template Image< float > Filtering::RecursiveGaussianDerivative( const Image< float > &img, float std_dev,
+                                                                  size_t direction );
+  template Image< float > Filtering::BoxGaussian( const Image< float > &img, float std_dev, size_t passes );
+
+  template Image< double > Filtering::SeparableGaussian( const Image< double > &img, float radius, float std_dev );
+  template Image< double > Filtering::RecursiveGaussian( const Image< double > &img, float std_dev );
+  template Image< double > Filtering::RecursiveGaussianDerivative( const Image< double > &img, float std_dev,
+                                                                   size_t direction );
+  template Image< double > Filtering::BoxGaussian( const Image< double > &img, float std_dev, size_t passes );
+
 #endif
 
 }
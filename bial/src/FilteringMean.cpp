@@ -19,50 +19,197 @@
 #if defined ( BIAL_EXPLICIT_FilteringMean ) || ( BIAL_IMPLICIT_BIN )
 
 #include "AdjacencyRound.hpp"
-#include "AdjacencyIterator.hpp"
+#include "AdjacencyOffset.hpp"
 #ifdef BIAL_DEBUG
 #include "FileImage.hpp"
 #endif
 #include "Image.hpp"
+#include "Integral.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
 
 namespace Bial {
 
   template< class D >
   Image< D > Filtering::Mean( const Image< D > &img, float radius ) {
-    Image< D > res( img );
-    Adjacency adj = AdjacencyType::HyperSpheric( radius, img.Dims( ) );
-    for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
-      size_t total_voxels = 0;
-      unsigned long long sum = 0;
-      for( AdjacencyIterator itr = begin( adj, img, pxl ); *itr != img.size( ); ++itr ) {
-        size_t adj_pxl = *itr;
-        ++total_voxels;
-        sum += img[ adj_pxl ];
-      }
-      res[ pxl ] = sum / total_voxels;
+    try {
+      Image< D > res( img );
+      AdjacencyOffset offsets( AdjacencyType::HyperSpheric( radius, img.Dims( ) ), img );
+      size_t adjs = offsets.size( );
+      ThreadPool::ParallelFor( 0, img.size( ), 4096, [ & ]( size_t first, size_t last ) {
+          for( size_t pxl = first; pxl < last; ) {
+            COMMENT( "Interior pixels. No bounds checking.", 4 );
+            for( size_t run_end = std::min( last, offsets.InteriorEnd( pxl ) ); pxl < run_end; ++pxl ) {
+              double sum = 0.0;
+              for( size_t idx = 0; idx < adjs; ++idx ) {
+                sum += img[ offsets( pxl, idx ) ];
+              }
+              res[ pxl ] = static_cast< D >( sum / adjs );
+            }
+            COMMENT( "Border pixel.", 4 );
+            if( pxl < last ) {
+              size_t total_voxels = 0;
+              double sum = 0.0;
+              for( size_t idx = 0; idx < adjs; ++idx ) {
+                size_t adj_pxl = offsets.Checked( pxl, idx );
+                if( adj_pxl < img.size( ) ) {
+                  ++total_voxels;
+                  sum += img[ adj_pxl ];
+                }
+              }
+              res[ pxl ] = static_cast< D >( sum / total_voxels );
+              ++pxl;
+            }
+          }
+        } );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
     }
-    return( res );
   }
 
   template< class D >
   Image< D > Filtering::Mean( const Image< D > &img, const Image< D > &msk, float radius ) {
-    Image< D > res( img );
-    Adjacency adj = AdjacencyType::HyperSpheric( radius, img.Dims( ) );
-    for( size_t pxl = 0; pxl < msk.size( ); ++pxl ) {
-      if( msk[ pxl ] != 0 ) {
-        size_t total_voxels = 0;
-        unsigned long long sum = 0;
-        for( AdjacencyIterator itr = begin( adj, msk, pxl ); *itr != msk.size( ); ++itr ) {
-          size_t adj_pxl = *itr;
-          if( msk[ adj_pxl ] != 0 ) {
-            ++total_voxels;
-            sum += img[ adj_pxl ];
+    try {
+      Image< D > res( img );
+      AdjacencyOffset offsets( AdjacencyType::HyperSpheric( radius, img.Dims( ) ), msk );
+      size_t adjs = offsets.size( );
+      ThreadPool::ParallelFor( 0, msk.size( ), 4096, [ & ]( size_t first, size_t last ) {
+          for( size_t pxl = first; pxl < last; ++pxl ) {
+            if( msk[ pxl ] != 0 ) {
+              bool interior = offsets.Interior( pxl );
+              size_t total_voxels = 0;
+              double sum = 0.0;
+              for( size_t idx = 0; idx < adjs; ++idx ) {
+                size_t adj_pxl = interior ? offsets( pxl, idx ) : offsets.Checked( pxl, idx );
+                if( ( adj_pxl < msk.size( ) ) && ( msk[ adj_pxl ] != 0 ) ) {
+                  ++total_voxels;
+                  sum += img[ adj_pxl ];
+                }
+              }
+              res[ pxl ] = static_cast< D >( sum / total_voxels );
+            }
           }
-        }
-        res[ pxl ] = sum / total_voxels;
+        } );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > Filtering::BoxMean( const Image< D > &img, const Vector< size_t > &radius ) {
+    try {
+      COMMENT( "Window sums of the image and window sizes clipped to the image domain.", 2 );
+      Image< double > sum( Integral::WindowSums( Integral::IntegralImage( img ), radius ) );
+      Image< D > res( img );
+      size_t dims = img.Dims( );
+      Vector< size_t > stride( dims, 1 );
+      for( size_t dms = 1; dms < dims; ++dms ) {
+        stride( dms ) = stride( dms - 1 ) * img.size( dms - 1 );
       }
+      ThreadPool::ParallelFor( 0, img.size( ), 4096, [ & ]( size_t first, size_t last ) {
+          for( size_t pxl = first; pxl < last; ++pxl ) {
+            double volume = 1.0;
+            for( size_t dms = 0; dms < dims; ++dms ) {
+              size_t crd = ( pxl / stride( dms ) ) % img.size( dms );
+              size_t low = crd - std::min( crd, radius( dms ) );
+              size_t high = std::min( img.size( dms ), crd + radius( dms ) + 1 );
+              volume *= high - low;
+            }
+            res[ pxl ] = static_cast< D >( sum[ pxl ] / volume );
+          }
+        } );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > Filtering::BoxMean( const Image< D > &img, const Image< D > &msk, const Vector< size_t > &radius ) {
+    try {
+      if( img.size( ) != msk.size( ) ) {
+        std::string msg( BIAL_ERROR( "Image and mask must have the same size." ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Window sums of the masked image and of the mask count.", 2 );
+      Image< double > masked( img );
+      Image< double > count( img );
+      for( size_t pxl = 0; pxl < msk.size( ); ++pxl ) {
+        count[ pxl ] = ( msk[ pxl ] != 0 ) ? 1.0 : 0.0;
+        masked[ pxl ] *= count[ pxl ];
+      }
+      Image< double > sum( Integral::WindowSums( Integral::IntegralImage( masked ), radius ) );
+      Image< double > volume( Integral::WindowSums( Integral::IntegralImage( count ), radius ) );
+      Image< D > res( img );
+      ThreadPool::ParallelFor( 0, msk.size( ), 4096, [ & ]( size_t first, size_t last ) {
+          for( size_t pxl = first; pxl < last; ++pxl ) {
+            if( msk[ pxl ] != 0 ) {
+              res[ pxl ] = static_cast< D >( sum[ pxl ] / volume[ pxl ] );
+            }
+          }
+        } );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
     }
-    return( res );
   }
 
 #ifdef BIAL_EXPLICIT_FilteringMean
@@ -75,6 +222,19 @@ namespace Bial {
   template Image< float > Filtering::Mean( const Image< float > &img, const Image< float > &msk, float radius );
   template Image< double > Filtering::Mean( const Image< double > &img, float radius );
   template Image< double > Filtering::Mean( const Image< double > &img, const Image< double > &msk, float radius );
+
+  template Image< int > Filtering::BoxMean( const Image< int > &img, const Vector< size_t > &radius );
+  template Image< int > Filtering::BoxMean( const Image< int > &img, const Image< int > &msk,
+                                            const Vector< size_t > &radius );
+  template Image< llint > Filtering::BoxMean( const Image< llint > &img, const Vector< size_t > &radius );
+  template Image< llint > Filtering::BoxMean( const Image< llint > &img, const Image< llint > &msk,
+                                              const Vector< size_t > &radius );
+  template Image< float > Filtering::BoxMean( const Image< float > &img, const Vector< size_t > &radius );
+  template Image< float > Filtering::BoxMean( const Image< float > &img, const Image< float > &msk,
+                                              const Vector< size_t > &radius );
+  template Image< double > Filtering::BoxMean( const Image< double > &img, const Vector< size_t > &radius );
+  template Image< double > Filtering::BoxMean( const Image< double > &img, const Image< double > &msk,
+                                               const Vector< size_t > &radius );
   
 #endif
 
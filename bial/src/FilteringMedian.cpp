@@ -19,11 +19,13 @@
 #if defined ( BIAL_EXPLICIT_FilteringMedian ) || ( BIAL_IMPLICIT_BIN )
 
 #include "AdjacencyRound.hpp"
-#include "AdjacencyIterator.hpp"
 #ifdef BIAL_DEBUG
 #include "FileImage.hpp"
 #endif
 #include "Image.hpp"
+#include "SlidingHistogram.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
 
 namespace Bial {
 
@@ -32,22 +34,14 @@ namespace Bial {
     try {
       Image< D > res( img );
       Adjacency adj = AdjacencyType::HyperSpheric( radius, img.Dims( ) );
+      COMMENT( "Quantizing image values to histogram bins.", 2 );
+      Vector< int > bin;
+      Vector< D > value;
+      SlidingHistogram::Quantize( img.data( ), img.size( ), bin, value );
 
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads.push_back( std::thread( &Filtering::MedianThreads< D >, std::ref( img ), std::ref( adj ),
-                                          std::ref( res ), thd, total_threads ) );
-        }
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads[ thd ].join( );
-        }
-      }
-      catch( std::exception &e ) {
-        BIAL_WARNING( "Failed to run in multi-thread. Exception: " << e.what( ) );
-        Filtering::MedianThreads( img, adj, res, 0, 1 );
-      }
+      ThreadPool::Run( ThreadPool::Tasks( img.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          Filtering::MedianThreads( img, adj, bin, value, res, thd, total_threads );
+        } );
 
       return( res );
     }
@@ -70,26 +64,21 @@ namespace Bial {
   }
 
   template< class D >
-  void Filtering::MedianThreads( const Image< D > &img, const Adjacency &adj, Image< D > &res, size_t thread,
-                                 size_t total_threads ) {
+  void Filtering::MedianThreads( const Image< D > &img, const Adjacency &adj, const Vector< int > &bin,
+                                 const Vector< D > &value, Image< D > &res, size_t thread, size_t total_threads ) {
     try {
       COMMENT( "Dealing with thread limits.", 2 );
       size_t min_index = thread * img.Size( ) / total_threads;
       size_t max_index = ( thread + 1 ) * img.Size( ) / total_threads;
 
-      COMMENT( "Computing median filter.", 2 );
-      for( size_t pxl = min_index; pxl < max_index; ++pxl ) {
-        size_t adjs = adj.size( );
-        Vector< float > queue( adjs );
-        size_t idx = 0;
-        for( AdjacencyIterator itr = begin( adj, img, pxl ); *itr < img.size( ); ++itr ) {
-          size_t adj_pxl = *itr;
-          queue[ idx ] = img[ adj_pxl ];
-          ++idx;
-        }
-        sort( queue.begin( ), queue.begin( ) + idx );
-        res[ pxl ] = queue[ ( idx - 1 ) / 2 ];
-      }
+      COMMENT( "Computing median filter with the sliding histogram of the adjacents inside the image.", 2 );
+      SlidingHistogram::Slide( img.Dim( ), bin, value.size( ), SlidingHistogram::Sorted< D >( value.size( ) ), adj,
+                               nullptr, min_index, max_index,
+                               [ &res, &value ]( size_t pxl, SlidingHistogram &histogram ) {
+                                 if( histogram.Size( ) > 0 ) {
+                                   res[ pxl ] = value[ histogram.Select( ( histogram.Size( ) - 1 ) / 2 ) ];
+                                 }
+                               } );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -112,17 +101,21 @@ namespace Bial {
 #ifdef BIAL_EXPLICIT_FilteringMedian
 
   template Image< int > Filtering::Median( const Image< int > &img, float radius );
-  template void Filtering::MedianThreads( const Image< int > &img, const Adjacency &adj, Image< int > &res,
-                                          size_t thread, size_t total_threads );
+  template void Filtering::MedianThreads( const Image< int > &img, const Adjacency &adj, const Vector< int > &bin,
+                                          const Vector< int > &value, Image< int > &res, size_t thread,
+                                          size_t total_threads );
   template Image< llint > Filtering::Median( const Image< llint > &img, float radius );
-  template void Filtering::MedianThreads( const Image< llint > &img, const Adjacency &adj, Image< llint > &res,
-                                          size_t thread, size_t total_threads );
+  template void Filtering::MedianThreads( const Image< llint > &img, const Adjacency &adj, const Vector< int > &bin,
+                                          const Vector< llint > &value, Image< llint > &res, size_t thread,
+                                          size_t total_threads );
   template Image< float > Filtering::Median( const Image< float > &img, float radius );
-  template void Filtering::MedianThreads( const Image< float > &img, const Adjacency &adj, Image< float > &res,
-                                          size_t thread, size_t total_threads );
+  template void Filtering::MedianThreads( const Image< float > &img, const Adjacency &adj, const Vector< int > &bin,
+                                          const Vector< float > &value, Image< float > &res, size_t thread,
+                                          size_t total_threads );
   template Image< double > Filtering::Median( const Image< double > &img, float radius );
-  template void Filtering::MedianThreads( const Image< double > &img, const Adjacency &adj, Image< double > &res,
-                                          size_t thread, size_t total_threads );
+  template void Filtering::MedianThreads( const Image< double > &img, const Adjacency &adj, const Vector< int > &bin,
+                                          const Vector< double > &value, Image< double > &res, size_t thread,
+                                          size_t total_threads );
 
 #endif
 
@@ -23,13 +23,18 @@
 #endif
 #if defined ( BIAL_EXPLICIT_FuzzyCMeans ) || ( BIAL_IMPLICIT_BIN )
 
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
 namespace Bial {
 
   template< class D > FuzzyCMeans< D >::FuzzyCMeans( const Feature< D > &new_feats, int new_clusters, float new_m,
                                                      double new_epsilon, size_t nmax_iterations ) try 
     : feats( new_feats ), centroids( new_clusters, new_feats.Features( ) ),
         membership( new_clusters, new_feats.Elements( ) ), m( new_m ), epsilon( new_epsilon ), 
-        max_iterations( nmax_iterations ) {
+        max_iterations( nmax_iterations ), compression( true ) {
       UniformCentroidInitialization( );
     }
   catch( std::bad_alloc &e ) {
@@ -50,45 +55,64 @@ namespace Bial {
   }
 
   template< class D >
-  double FuzzyCMeans< D >::MembershipUpdate( ) {
-    try {
-      Vector< double > distances( feats.Elements( ) * centroids.Elements( ), 0.0 );
-      COMMENT( "Computing mean distances.", 0 );
-      for( size_t ctd_a = 0; ctd_a < centroids.Elements( ); ++ctd_a ) {
-        for( size_t elm = 0; elm < feats.Elements( ); ++elm ) {
-          for( size_t ftr = 0; ftr < feats.Features( ); ++ftr ) {
-            distances( elm * centroids.Elements( ) + ctd_a ) += 
-              static_cast< double >( ( feats( elm, ftr ) - centroids( ctd_a, ftr ) ) * 
-                                     ( feats( elm, ftr ) - centroids( ctd_a, ftr ) ) );
-          }
-          distances( elm * centroids.Elements( ) + ctd_a ) = sqrt( distances( elm * centroids.Elements( ) + ctd_a ) );
-        }
+  void FuzzyCMeans< D >::ElementMembership( const D *vct, double *res ) const {
+    size_t clusters = centroids.Elements( );
+    size_t features = centroids.Features( );
+    const D *centroid = centroids.data( );
+    double exponent = -1.0 / ( m - 1.0 );
+    double total = 0.0;
+    bool null = false;
+    for( size_t ctd = 0; ctd < clusters; ++ctd, centroid += features ) {
+      double dist = 0.0;
+      for( size_t ftr = 0; ftr < features; ++ftr ) {
+        double diff = static_cast< double >( vct[ ftr ] ) - static_cast< double >( centroid[ ftr ] );
+        dist += diff * diff;
       }
-      double max = 0.0;
-      COMMENT( "Updating memberships.", 0 );
-      for( size_t ctd_a = 0; ctd_a < centroids.Elements( ); ++ctd_a ) {
-        double val = 0.0;
-        for( size_t elm = 0; elm < feats.Elements( ); ++elm ) {
-          if( distances( elm * centroids.Elements( ) + ctd_a ) <= 0.0000001 ) {
-            val = 1.0;
-          }
-          else {
-            for( size_t ctd_b = 0; ctd_b < centroids.Elements( ); ++ctd_b ) {
-              if( distances( elm * centroids.Elements( ) + ctd_b ) <= 0.0000001 ) {
-                val = 9.0e99;
-                break;
+      if( dist <= 0.00000000000001 ) {
+        null = true;
+        res[ ctd ] = -1.0;
+      }
+      else {
+        res[ ctd ] = m == 2.0f ? 1.0 / dist : std::pow( dist, exponent );
+        total += res[ ctd ];
+      }
+    }
+    for( size_t ctd = 0; ctd < clusters; ++ctd ) {
+      if( null ) {
+        res[ ctd ] = res[ ctd ] < 0.0 ? 1.0 : 0.0;
+      }
+      else {
+        res[ ctd ] /= total;
+      }
+    }
+  }
+
+  template< class D >
+  double FuzzyCMeans< D >::MembershipUpdate( const Feature< D > &points, Matrix< double > &mbs ) {
+    try {
+      size_t elements = points.Elements( );
+      size_t features = points.Features( );
+      size_t clusters = centroids.Elements( );
+      size_t blocks = ( elements + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+      Vector< double > block_max( blocks, 0.0 );
+      COMMENT( "Updating memberships from the distance powers of each element.", 0 );
+      ThreadPool::ParallelFor( 0, blocks, 1, [ & ]( size_t first, size_t last ) {
+          Vector< double > res( clusters );
+          for( size_t blk = first; blk < last; ++blk ) {
+            size_t blk_end = std::min( elements, ( blk + 1 ) * BLOCK_SIZE );
+            for( size_t elm = blk * BLOCK_SIZE; elm < blk_end; ++elm ) {
+              ElementMembership( points.data( ) + elm * features, res.data( ) );
+              double *val = mbs.data( ) + elm * clusters;
+              for( size_t ctd = 0; ctd < clusters; ++ctd ) {
+                block_max[ blk ] = std::max( block_max[ blk ], std::abs( val[ ctd ] - res[ ctd ] ) );
+                val[ ctd ] = res[ ctd ];
               }
-              val +=
-                pow( distances( elm * centroids.Elements( ) + ctd_a ) / 
-                     distances( elm * centroids.Elements( ) + ctd_b ), 2.0 / ( m - 1.0 ) );
             }
-            val = 1.0 / val;
-          }
-          if( max < membership( ctd_a, elm ) - val ) {
-            max = membership( ctd_a, elm ) - val;
           }
-          membership( ctd_a, elm ) = val;
-        }
+        } );
+      double max = 0.0;
+      for( size_t blk = 0; blk < blocks; ++blk ) {
+        max = std::max( max, block_max[ blk ] );
       }
       return( max );
     }
@@ -111,25 +135,81 @@ namespace Bial {
   }
 
   template< class D >
-  void FuzzyCMeans< D >::CentroidUpdate( ) {
+  void FuzzyCMeans< D >::Accumulate( const Feature< D > &points, const Matrix< double > &mbs,
+                                     const Vector< double > &weight, Vector< double > &sum,
+                                     Vector< double > &total ) const {
     try {
-      Vector< double > sum( feats.Features( ) );
-      for( size_t ctd = 0; ctd < centroids.Elements( ); ++ctd ) {
-        double sum2 = 0.0;
-        for( size_t ftr = 0; ftr < feats.Features( ); ++ftr ) {
-          sum( ftr ) = 0.0;
-          for( size_t elm = 0; elm < feats.Elements( ); ++elm ) {
-            double power = pow( static_cast< double >( membership( ctd, elm ) ), m );
-            sum( ftr ) += power * static_cast< double >( feats( elm, ftr ) );
-            if( ftr == 0 ) {
-              sum2 += power;
+      size_t elements = points.Elements( );
+      size_t features = points.Features( );
+      size_t clusters = centroids.Elements( );
+      size_t blocks = ( elements + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+      size_t stride = clusters * ( features + 1 );
+      Vector< double > partial( blocks * stride, 0.0 );
+      COMMENT( "Accumulating membership powers per block.", 0 );
+      ThreadPool::ParallelFor( 0, blocks, 1, [ & ]( size_t first, size_t last ) {
+          for( size_t blk = first; blk < last; ++blk ) {
+            double *blk_sum = partial.data( ) + blk * stride;
+            double *blk_total = blk_sum + clusters * features;
+            size_t blk_end = std::min( elements, ( blk + 1 ) * BLOCK_SIZE );
+            for( size_t elm = blk * BLOCK_SIZE; elm < blk_end; ++elm ) {
+              const D *vct = points.data( ) + elm * features;
+              const double *val = mbs.data( ) + elm * clusters;
+              double wgt = weight.empty( ) ? 1.0 : weight[ elm ];
+              for( size_t ctd = 0; ctd < clusters; ++ctd ) {
+                double power = wgt * ( m == 2.0f ? val[ ctd ] * val[ ctd ] : std::pow( val[ ctd ], m ) );
+                blk_total[ ctd ] += power;
+                for( size_t ftr = 0; ftr < features; ++ftr ) {
+                  blk_sum[ ctd * features + ftr ] += power * static_cast< double >( vct[ ftr ] );
+                }
+              }
             }
           }
-          if( ( sum2 > -0.0000001 ) && ( sum2 < 0.0000001 ) ) {
-            std::string msg( BIAL_ERROR( "Division by zero while computing centroids." ) );
-            throw( std::logic_error( msg ) );
-          }
-          centroids( ctd, ftr ) = static_cast< D >( sum( ftr ) / sum2 );
+        } );
+      COMMENT( "Reducing blocks in order.", 0 );
+      for( size_t blk = 0; blk < blocks; ++blk ) {
+        const double *blk_sum = partial.data( ) + blk * stride;
+        for( size_t idx = 0; idx < clusters * features; ++idx ) {
+          sum[ idx ] += blk_sum[ idx ];
+        }
+        for( size_t ctd = 0; ctd < clusters; ++ctd ) {
+          total[ ctd ] += blk_sum[ clusters * features + ctd ];
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void FuzzyCMeans< D >::CentroidUpdate( const Feature< D > &points, const Matrix< double > &mbs,
+                                         const Vector< double > &weight ) {
+    try {
+      size_t features = points.Features( );
+      size_t clusters = centroids.Elements( );
+      Vector< double > sum( clusters * features, 0.0 );
+      Vector< double > total( clusters, 0.0 );
+      Accumulate( points, mbs, weight, sum, total );
+      for( size_t ctd = 0; ctd < clusters; ++ctd ) {
+        if( ( total[ ctd ] > -0.0000001 ) && ( total[ ctd ] < 0.0000001 ) ) {
+          std::string msg( BIAL_ERROR( "Division by zero while computing centroids." ) );
+          throw( std::logic_error( msg ) );
+        }
+        for( size_t ftr = 0; ftr < features; ++ftr ) {
+          centroids( ctd, ftr ) = static_cast< D >( sum[ ctd * features + ftr ] / total[ ctd ] );
         }
       }
     }
@@ -151,22 +231,140 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  void FuzzyCMeans< D >::Iterate( const Feature< D > &points, Matrix< double > &mbs, const Vector< double > &weight,
+                                  bool verbose ) {
+    try {
+      MembershipUpdate( points, mbs );
+      double max_change = epsilon + 1.0;
+      size_t itr = 0;
+      for( ; ( max_change > epsilon ) && ( itr < max_iterations ); ++itr ) {
+        if( verbose ) {
+          PrintIteration( std::cout, itr, max_change );
+        }
+        CentroidUpdate( points, mbs, weight );
+        max_change = MembershipUpdate( points, mbs );
+      }
+      if( verbose ) {
+        PrintIteration( std::cout, itr, max_change );
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
   template< class D >
   Matrix< double > FuzzyCMeans< D >::Run( bool verbose ) {
     try {
-      MembershipUpdate( );
+      size_t elements = feats.Elements( );
+      if( compression && ( feats.Features( ) == 1 ) ) {
+        COMMENT( "Finding the distinct values of the scalar features.", 0 );
+        std::vector< D > value( feats.data( ), feats.data( ) + elements );
+        std::sort( value.begin( ), value.end( ) );
+        value.erase( std::unique( value.begin( ), value.end( ) ), value.end( ) );
+        size_t bins = value.size( );
+        if( bins * 2 <= elements ) {
+          COMMENT( "Clustering " << bins << " distinct values, weighted by their counts.", 0 );
+          Feature< D > points( bins, 1 );
+          std::copy( value.begin( ), value.end( ), points.data( ) );
+          Vector< size_t > bin( elements );
+          Vector< double > count( bins, 0.0 );
+          for( size_t elm = 0; elm < elements; ++elm ) {
+            bin[ elm ] = std::lower_bound( value.begin( ), value.end( ), feats.data( )[ elm ] ) - value.begin( );
+            count[ bin[ elm ] ] += 1.0;
+          }
+          Matrix< double > mbs( centroids.Elements( ), bins );
+          Iterate( points, mbs, count, verbose );
+          COMMENT( "Expanding the memberships of the distinct values to the elements.", 0 );
+          size_t clusters = centroids.Elements( );
+          ThreadPool::ParallelFor( 0, elements, BLOCK_SIZE, [ & ]( size_t first, size_t last ) {
+              for( size_t elm = first; elm < last; ++elm ) {
+                std::copy( mbs.data( ) + bin[ elm ] * clusters, mbs.data( ) + ( bin[ elm ] + 1 ) * clusters,
+                           membership.data( ) + elm * clusters );
+              }
+            } );
+          return( membership );
+        }
+      }
+      Iterate( feats, membership, Vector< double >( ), verbose );
+      return( membership );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Matrix< double > FuzzyCMeans< D >::RunMiniBatch( size_t batch_size, bool verbose ) {
+    try {
+      size_t elements = feats.Elements( );
+      if( batch_size >= elements ) {
+        return( Run( verbose ) );
+      }
+      size_t features = feats.Features( );
+      size_t clusters = centroids.Elements( );
+      Feature< D > batch( batch_size, features );
+      Matrix< double > batch_mbs( clusters, batch_size );
+      Vector< double > sum( clusters * features, 0.0 );
+      Vector< double > total( clusters, 0.0 );
+      std::mt19937 generator( 0 );
+      std::uniform_int_distribution< size_t > pick( 0, elements - 1 );
       double max_change = epsilon + 1.0;
       size_t itr = 0;
       for( ; ( max_change > epsilon ) && ( itr < max_iterations ); ++itr ) {
         if( verbose ) {
           PrintIteration( std::cout, itr, max_change );
         }
-        CentroidUpdate( );
-        max_change = MembershipUpdate( );
+        COMMENT( "Drawing a random batch.", 1 );
+        for( size_t elm = 0; elm < batch_size; ++elm ) {
+          size_t src = pick( generator );
+          std::copy( feats.data( ) + src * features, feats.data( ) + ( src + 1 ) * features,
+                     batch.data( ) + elm * features );
+        }
+        COMMENT( "Moving the centroids to the weighted mean of all batches.", 1 );
+        MembershipUpdate( batch, batch_mbs );
+        Accumulate( batch, batch_mbs, Vector< double >( ), sum, total );
+        for( size_t ctd = 0; ctd < clusters; ++ctd ) {
+          if( total[ ctd ] >= 0.0000001 ) {
+            for( size_t ftr = 0; ftr < features; ++ftr ) {
+              centroids( ctd, ftr ) = static_cast< D >( sum[ ctd * features + ftr ] / total[ ctd ] );
+            }
+          }
+        }
+        max_change = MembershipUpdate( batch, batch_mbs );
       }
       if( verbose ) {
         PrintIteration( std::cout, itr, max_change );
       }
+      COMMENT( "Computing the memberships of all elements.", 0 );
+      MembershipUpdate( feats, membership );
       return( membership );
     }
     catch( std::bad_alloc &e ) {
@@ -192,6 +390,11 @@ namespace Bial {
     return( membership );
   }
 
+  template< class D >
+  void FuzzyCMeans< D >::Compression( bool enable ) {
+    compression = enable;
+  }
+
   template< class D >
   void FuzzyCMeans< D >::UniformCentroidInitialization( ) {
     try {
@@ -275,34 +478,70 @@ namespace Bial {
 
   template FuzzyCMeans< int >::FuzzyCMeans( const Feature< int > &new_feats, int new_clusters, float new_m,
                                                      double new_epsilon, size_t nmax_iterations );
-  template double FuzzyCMeans< int >::MembershipUpdate( );
-  template void FuzzyCMeans< int >::CentroidUpdate( );
+  template void FuzzyCMeans< int >::ElementMembership( const int *vct, double *res ) const;
+  template double FuzzyCMeans< int >::MembershipUpdate( const Feature< int > &points, Matrix< double > &mbs );
+  template void FuzzyCMeans< int >::Accumulate( const Feature< int > &points, const Matrix< double > &mbs,
+                                               const Vector< double > &weight, Vector< double > &sum,
+                                               Vector< double > &total ) const;
+  template void FuzzyCMeans< int >::CentroidUpdate( const Feature< int > &points, const Matrix< double > &mbs,
+                                                   const Vector< double > &weight );
+  template void FuzzyCMeans< int >::Iterate( const Feature< int > &points, Matrix< double > &mbs,
+                                            const Vector< double > &weight, bool verbose );
   template Matrix< double > FuzzyCMeans< int >::Run( bool verbose );
+  template Matrix< double > FuzzyCMeans< int >::RunMiniBatch( size_t batch_size, bool verbose );
   template Matrix< double > FuzzyCMeans< int >::GetMembership( ) const;
+  template void FuzzyCMeans< int >::Compression( bool enable );
   template void FuzzyCMeans< int >::UniformCentroidInitialization( );
 
   template FuzzyCMeans< llint >::FuzzyCMeans( const Feature< llint > &new_feats, int new_clusters, float new_m,
                                                      double new_epsilon, size_t nmax_iterations );
-  template double FuzzyCMeans< llint >::MembershipUpdate( );
-  template void FuzzyCMeans< llint >::CentroidUpdate( );
+  template void FuzzyCMeans< llint >::ElementMembership( const llint *vct, double *res ) const;
+  template double FuzzyCMeans< llint >::MembershipUpdate( const Feature< llint > &points, Matrix< double > &mbs );
+  template void FuzzyCMeans< llint >::Accumulate( const Feature< llint > &points, const Matrix< double > &mbs,
+                                               const Vector< double > &weight, Vector< double > &sum,
+                                               Vector< double > &total ) const;
+  template void FuzzyCMeans< llint >::CentroidUpdate( const Feature< llint > &points, const Matrix< double > &mbs,
+                                                   const Vector< double > &weight );
+  template void FuzzyCMeans< llint >::Iterate( const Feature< llint > &points, Matrix< double > &mbs,
+                                            const Vector< double > &weight, bool verbose );
   template Matrix< double > FuzzyCMeans< llint >::Run( bool verbose );
+  template Matrix< double > FuzzyCMeans< llint >::RunMiniBatch( size_t batch_size, bool verbose );
   template Matrix< double > FuzzyCMeans< llint >::GetMembership( ) const;
+  template void FuzzyCMeans< llint >::Compression( bool enable );
   template void FuzzyCMeans< llint >::UniformCentroidInitialization( );
 
   template FuzzyCMeans< float >::FuzzyCMeans( const Feature< float > &new_feats, int new_clusters, float new_m,
                                                      double new_epsilon, size_t nmax_iterations );
-  template double FuzzyCMeans< float >::MembershipUpdate( );
-  template void FuzzyCMeans< float >::CentroidUpdate( );
+  template void FuzzyCMeans< float >::ElementMembership( const float *vct, double *res ) const;
+  template double FuzzyCMeans< float >::MembershipUpdate( const Feature< float > &points, Matrix< double > &mbs );
+  template void FuzzyCMeans< float >::Accumulate( const Feature< float > &points, const Matrix< double > &mbs,
+                                               const Vector< double > &weight, Vector< double > &sum,
+                                               Vector< double > &total ) const;
+  template void FuzzyCMeans< float >::CentroidUpdate( const Feature< float > &points, const Matrix< double > &mbs,
+                                                   const Vector< double > &weight );
+  template void FuzzyCMeans< float >::Iterate( const Feature< float > &points, Matrix< double > &mbs,
+                                            const Vector< double > &weight, bool verbose );
   template Matrix< double > FuzzyCMeans< float >::Run( bool verbose );
+  template Matrix< double > FuzzyCMeans< float >::RunMiniBatch( size_t batch_size, bool verbose );
   template Matrix< double > FuzzyCMeans< float >::GetMembership( ) const;
+  template void FuzzyCMeans< float >::Compression( bool enable );
   template void FuzzyCMeans< float >::UniformCentroidInitialization( );
 
   template FuzzyCMeans< double >::FuzzyCMeans( const Feature< double > &new_feats, int new_clusters, float new_m,
                                                      double new_epsilon, size_t nmax_iterations );
-  template double FuzzyCMeans< double >::MembershipUpdate( );
-  template void FuzzyCMeans< double >::CentroidUpdate( );
+  template void FuzzyCMeans< double >::ElementMembership( const double *vct, double *res ) const;
+  template double FuzzyCMeans< double >::MembershipUpdate( const Feature< double > &points, Matrix< double > &mbs );
+  template void FuzzyCMeans< double >::Accumulate( const Feature< double > &points, const Matrix< double > &mbs,
+                                               const Vector< double > &weight, Vector< double > &sum,
+                                               Vector< double > &total ) const;
+  template void FuzzyCMeans< double >::CentroidUpdate( const Feature< double > &points, const Matrix< double > &mbs,
+                                                   const Vector< double > &weight );
+  template void FuzzyCMeans< double >::Iterate( const Feature< double > &points, Matrix< double > &mbs,
+                                            const Vector< double > &weight, bool verbose );
   template Matrix< double > FuzzyCMeans< double >::Run( bool verbose );
+  template Matrix< double > FuzzyCMeans< double >::RunMiniBatch( size_t batch_size, bool verbose );
   template Matrix< double > FuzzyCMeans< double >::GetMembership( ) const;
+  template void FuzzyCMeans< double >::Compression( bool enable );
   template void FuzzyCMeans< double >::UniformCentroidInitialization( );
 
   template OFile&FuzzyCMeans< int >::PrintIteration( OFile&os, int itr, double max_change ) const;
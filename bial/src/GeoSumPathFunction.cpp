@@ -168,7 +168,7 @@ namespace Bial {
   }
 
   template< class D >
-  inline bool GeodesicRestrictionPathFunction< D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  inline bool GeodesicRestrictionPathFunction< D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) &&
               ( this->value->operator()( index ) < this->value->operator()( adj_index ) ) );
@@ -192,7 +192,7 @@ namespace Bial {
   }
 
   template< class D >
-  bool GeodesicRestrictionPathFunction< D >::Propagate( int index, int adj_index ) {
+  bool GeodesicRestrictionPathFunction< D >::Propagate( size_t index, size_t adj_index ) {
     try {
       D src_value = this->value->operator()( adj_index );
       COMMENT( "Computing arc weight.", 3 );
@@ -153,7 +153,7 @@ namespace Bial {
   }
 
   template< class D >
-  inline bool GeodesicDistancePathFunction< D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  inline bool GeodesicDistancePathFunction< D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) &&
               ( this->value->operator()( index ) < this->value->operator()( adj_index ) ) );
@@ -177,7 +177,7 @@ namespace Bial {
   }
 
   template< class D >
-  bool GeodesicDistancePathFunction< D >::Propagate( int index, int adj_index ) {
+  bool GeodesicDistancePathFunction< D >::Propagate( size_t index, size_t adj_index ) {
     try {
       D src_value = this->value->operator()( adj_index );
       COMMENT( "Computing spacial distance.", 3 );
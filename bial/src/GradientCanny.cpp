@@ -94,7 +94,8 @@ namespace Bial {
   }
 
   template< class D >
-  Image< D > Gradient::Canny( const Image< D > &img, float lower_threshold, float higher_threshold, float sigma ) {
+  Image< D > Gradient::Canny( const Image< D > &img, float lower_threshold, float higher_threshold, float sigma,
+                              bool recursive ) {
     try {
       COMMENT( "Checking if thresholds make sense.", 0 );
       if( ( lower_threshold > higher_threshold ) || ( lower_threshold < 0.0 ) || ( higher_threshold > 1.0 ) ) {
@@ -103,6 +104,11 @@ namespace Bial {
                                      std::to_string( higher_threshold ) + "." ) );
         throw( std::logic_error( msg ) );
       }
+      if( recursive ) {
+        COMMENT( "Computing Gaussian derivatives, suppressing non-edges pixels.", 0 );
+        return( Gradient::Canny( Gradient::NonMaxGaussianSuppression( img, sigma ), lower_threshold,
+                                 higher_threshold ) );
+      }
       COMMENT( "Computing the filtered image.", 0 );
       Image< D > smooth = Filtering::Gaussian( img, 2.0, sigma );
       COMMENT( "Computing Sobel, suppressing non-edges pixels.", 0 );
@@ -128,6 +134,39 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  Image< D > Gradient::RecursiveCanny( const Image< D > &img, float lower_threshold, float higher_threshold,
+                                       float sigma ) {
+    try {
+      COMMENT( "Checking if thresholds make sense.", 0 );
+      if( ( lower_threshold > higher_threshold ) || ( lower_threshold < 0.0 ) || ( higher_threshold > 1.0 ) ) {
+        std::string msg( BIAL_ERROR( "Invalid thresholds. Required: 0.0 <= lower <= higher <= 1.0. Given: lower:" +
+                                     std::to_string( lower_threshold ) + ", higher: " +
+                                     std::to_string( higher_threshold ) + "." ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Computing Gaussian derivatives, suppressing non-edges pixels.", 0 );
+      Image< D > suppressed = Gradient::NonMaxGaussianSuppression( img, sigma );
+      return( Gradient::Canny( suppressed, lower_threshold, higher_threshold ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
   template< class D >
   Image< D > Gradient::NonMaxSobelSuppression( const Image< D > &img ) {
     try {
@@ -154,6 +193,36 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  Image< D > Gradient::NonMaxGaussianSuppression( const Image< D > &img, float sigma ) {
+    try {
+      Vector< Image< D > > partial;
+      for( size_t dms = 0; dms < img.Dims( ); ++dms ) {
+        partial.push_back( Filtering::RecursiveGaussianDerivative( img, sigma, dms ) );
+      }
+      Image< D > mag( img );
+      Image< int > dir( img );
+      Gradient::MagnitudeAndDirection( partial, &mag, &dir );
+      return( Gradient::NonMaxSobelSuppression( mag, dir ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
   template< class D >
   Image< D > Gradient::NonMaxSobelSuppression( const Image< D > &magnitude, const Image< int > &direction ) {
     try {
@@ -268,32 +337,44 @@ namespace Bial {
   template Image< int > Gradient::Canny( const Image< int > &suppressed_sobel, float lower_threshold, 
                                          float higher_threshold );
   template Image< int > Gradient::Canny( const Image< int > &img, float lower_threshold, float higher_threshold, 
-                                         float sigma );
+                                         float sigma, bool recursive );
+  template Image< int > Gradient::RecursiveCanny( const Image< int > &img, float lower_threshold,
+                                                  float higher_threshold, float sigma );
   template Image< int > Gradient::NonMaxSobelSuppression( const Image< int > &img );
+  template Image< int > Gradient::NonMaxGaussianSuppression( const Image< int > &img, float sigma );
   template Image< int > Gradient::NonMaxSobelSuppression( const Image< int > &magnitude, 
                                                           const Image< int > &direction );
 
   template Image< llint > Gradient::Canny( const Image< llint > &suppressed_sobel, float lower_threshold, 
                                            float higher_threshold );
   template Image< llint > Gradient::Canny( const Image< llint > &img, float lower_threshold, float higher_threshold, 
-                                           float sigma );
+                                           float sigma, bool recursive );
+  template Image< llint > Gradient::RecursiveCanny( const Image< llint > &img, float lower_threshold,
+                                                    float higher_threshold, float sigma );
   template Image< llint > Gradient::NonMaxSobelSuppression( const Image< llint > &img );
+  template Image< llint > Gradient::NonMaxGaussianSuppression( const Image< llint > &img, float sigma );
   template Image< llint > Gradient::NonMaxSobelSuppression( const Image< llint > &magnitude, 
                                                             const Image< int > &direction );
 
   template Image< float > Gradient::Canny( const Image< float > &suppressed_sobel, float lower_threshold, 
                                            float higher_threshold );
   template Image< float > Gradient::Canny( const Image< float > &img, float lower_threshold, float higher_threshold, 
-                                           float sigma );
+                                           float sigma, bool recursive );
+  template Image< float > Gradient::RecursiveCanny( const Image< float > &img, float lower_threshold,
+                                                    float higher_threshold, float sigma );
   template Image< float > Gradient::NonMaxSobelSuppression( const Image< float > &img );
+  template Image< float > Gradient::NonMaxGaussianSuppression( const Image< float > &img, float sigma );
   template Image< float > Gradient::NonMaxSobelSuppression( const Image< float > &magnitude, 
                                                             const Image< int > &direction );
 
   template Image< double > Gradient::Canny( const Image< double > &suppressed_sobel, float lower_threshold, 
                                             float higher_threshold );
   template Image< double > Gradient::Canny( const Image< double > &img, float lower_threshold, float higher_threshold, 
-                                            float sigma );
+                                            float sigma, bool recursive );
+  template Image< double > Gradient::RecursiveCanny( const Image< double > &img, float lower_threshold,
+                                                     float higher_threshold, float sigma );
   template Image< double > Gradient::NonMaxSobelSuppression( const Image< double > &img );
+  template Image< double > Gradient::NonMaxGaussianSuppression( const Image< double > &img, float sigma );
   template Image< double > Gradient::NonMaxSobelSuppression( const Image< double > &magnitude,
                                                              const Image< int > &direction );
 
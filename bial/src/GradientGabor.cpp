@@ -31,11 +31,12 @@ namespace Bial {
     try {
       const double TAN_22_5 = 0.414213562;
       size_t dimensions = img.Dims( );
-      Vector< Image< D > > dir_gabor;
+      COMMENT( "Filter bank with one kernel per direction. The image spectrum is shared by all of them.", 1 );
+      Vector< Kernel > bank;
       for( size_t dir = 0; dir < dimensions; ++dir ) {
-        Kernel krn = KernelType::NormalizedGabor( sigma, dimensions, dir );
-        dir_gabor.push_back( Correlation( img, krn ) );
+        bank.push_back( KernelType::NormalizedGabor( sigma, dimensions, dir ) );
       }
+      Vector< Image< D > > dir_gabor = Correlation( img, bank );
       COMMENT( "Computing Gabor magnitude.", 1 );
       if( magnitude != nullptr ) {
         for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
@@ -24,6 +24,7 @@
 #include "Image.hpp"
 #include "MorphologyDilation.hpp"
 #include "MorphologyErosion.hpp"
+#include "MorphologyLines.hpp"
 
 namespace Bial {
 
@@ -57,6 +58,11 @@ namespace Bial {
         std::string msg( BIAL_ERROR( "Image and adjacency relation dimensions do not match." ) );
         throw( std::logic_error( msg ) );
       }
+      MorphologyLines lines( adjacency );
+      if( lines.Efficient( ) ) {
+        COMMENT( "Dilation and erosion share the decomposition of the structuring element.", 2 );
+        return( lines.Dilate( image ) - lines.Erode( image ) );
+      }
       return( Morphology::Dilate( image, adjacency ) - Morphology::Erode( image, adjacency ) );
     }
     catch( std::bad_alloc &e ) {
@@ -35,7 +35,7 @@ namespace Bial {
 
   template< class D >
   Image< D > Gradient::ScaleCanny( const Image< D > &img, size_t window_scale, float lower_threshold,
-                                   float higher_threshold ) {
+                                   float higher_threshold, float sigma ) {
     try {
       COMMENT( "Checking if thresholds make sense.", 1 );
       if( ( lower_threshold > higher_threshold ) || ( lower_threshold < 0.0 ) || ( higher_threshold > 1.0 ) ) {
@@ -45,7 +45,8 @@ namespace Bial {
         throw( std::logic_error( msg ) );
       }
       COMMENT( "Computing suppressed Sobel.", 0 );
-      Image< D > suppressed_sobel = Gradient::NonMaxSobelSuppression( img );
+      Image< D > suppressed_sobel = sigma > 0.0f ? Gradient::NonMaxGaussianSuppression( img, sigma ) :
+        Gradient::NonMaxSobelSuppression( img );
       // DEBUG_WRITE( suppressed_sobel, "suppressed_sobel", 1 );
 
       COMMENT( "Creating resultant image.", 0 );
@@ -223,10 +224,11 @@ namespace Bial {
 
   template< class D >
   Image< D > Gradient::SubScaleCanny( const Image< D > &img, const Image< D > &base_grad, size_t window_scale,
-                                      float lower_threshold ) {
+                                      float lower_threshold, float sigma ) {
     try {
       COMMENT( "Computing suppressed Sobel.", 0 );
-      Image< D > suppressed_sobel = Gradient::NonMaxSobelSuppression( img );
+      Image< D > suppressed_sobel = sigma > 0.0f ? Gradient::NonMaxGaussianSuppression( img, sigma ) :
+        Gradient::NonMaxSobelSuppression( img );
       DEBUG_WRITE( suppressed_sobel, "suppressed_sobel", 0 );
       COMMENT( "Creating resultant image.", 0 );
       Image< D > canny_scale( img ); /* ( img.Dim( ), img.PixelSize( ), img.Frames( ), img.FrameTime( ) ); */
@@ -387,7 +389,7 @@ namespace Bial {
 
   template< class D >
   Image< D > Gradient::MultiScaleCanny( const Image< D > &img, float lower_threshold, float higher_threshold,
-                                        float sigma, size_t scales ) {
+                                        float sigma, size_t scales, bool recursive ) {
     try {
       COMMENT( "Checking if thresholds make sense.", 1 );
       if( ( lower_threshold > higher_threshold ) || ( lower_threshold < 0.0f ) || ( higher_threshold > 1.0f ) ) {
@@ -398,13 +400,17 @@ namespace Bial {
       }
       //COMMENT( "Getting image maximum dimension.", 0 );
       //Vector< size_t > full_size = img.Dim( );
-      COMMENT( "Computing global Canny with medium and higher thresholds.", 0 );
-      Image< D > global = Gradient::Canny( img, lower_threshold, higher_threshold, sigma );
-      COMMENT( "Computing the filtered image.", 0 );
-      Image< D > smooth = Filtering::Gaussian( img, 2.0, sigma );
+      COMMENT( "Computing the filtered image. Recursive Gaussian derivatives smooth by themselves.", 0 );
+      Image< D > smooth = recursive ? img : Filtering::Gaussian( img, 2.0, sigma );
+      float grad_sigma = recursive ? sigma : 0.0f;
+      COMMENT( "Computing global Canny with medium and higher thresholds. Same as Canny( img, ... ), reusing the " <<
+               "filtered image.", 0 );
+      Image< D > global = Gradient::Canny( recursive ? Gradient::NonMaxGaussianSuppression( smooth, sigma ) :
+                                           Gradient::NonMaxSobelSuppression( smooth ), lower_threshold,
+                                           higher_threshold );
       for( size_t scl = 1; scl < scales; ++scl ) {
         COMMENT( "Computing scale Canny with medium and higher thresholds for scale: " << scl, 0 );
-        Image< D > local = ScaleCanny( smooth, std::pow( 2, scl ), lower_threshold, higher_threshold );
+        Image< D > local = ScaleCanny( smooth, std::pow( 2, scl ), lower_threshold, higher_threshold, grad_sigma );
         for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
           if( ( local[ pxl ] == 1 ) && ( global[ pxl ] == 0 ) )
             global[ pxl ] = scl + 1;
@@ -432,7 +438,7 @@ namespace Bial {
 
   template< class D >
   Image< D > Gradient::MultiSubScaleCanny( const Image< D > &img, float lower_threshold, float higher_threshold,
-                                           float sigma, size_t scales ) {
+                                           float sigma, size_t scales, bool recursive ) {
     try {
       COMMENT( "Checking if thresholds make sense.", 1 );
       if( ( lower_threshold > higher_threshold ) || ( lower_threshold < 0.0f ) || ( higher_threshold > 1.0f ) ) {
@@ -443,13 +449,17 @@ namespace Bial {
       }
       //COMMENT( "Getting image maximum dimension.", 0 );
       //Vector< size_t > full_size = img.Dim( );
-      COMMENT( "Computing global Canny with medium and higher thresholds.", 0 );
-      Image< D > global = Gradient::Canny( img, lower_threshold, higher_threshold, sigma );
-      COMMENT( "Computing the filtered image.", 0 );
-      Image< D > smooth = Filtering::Gaussian( img, 2.0, sigma );
+      COMMENT( "Computing the filtered image. Recursive Gaussian derivatives smooth by themselves.", 0 );
+      Image< D > smooth = recursive ? img : Filtering::Gaussian( img, 2.0, sigma );
+      float grad_sigma = recursive ? sigma : 0.0f;
+      COMMENT( "Computing global Canny with medium and higher thresholds. Same as Canny( img, ... ), reusing the " <<
+               "filtered image.", 0 );
+      Image< D > global = Gradient::Canny( recursive ? Gradient::NonMaxGaussianSuppression( smooth, sigma ) :
+                                           Gradient::NonMaxSobelSuppression( smooth ), lower_threshold,
+                                           higher_threshold );
       for( size_t scl = 1; scl < scales; ++scl ) {
         COMMENT( "Computing scale Canny with medium and higher thresholds for scale: " << scl, 0 );
-        Image< D > local = SubScaleCanny( smooth, global, std::pow( 2, scl ), lower_threshold );
+        Image< D > local = SubScaleCanny( smooth, global, std::pow( 2, scl ), lower_threshold, grad_sigma );
         for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
           if( ( local[ pxl ] == 1 ) && ( global[ pxl ] == 0 ) )
             global[ pxl ] = scl + 1;
@@ -477,7 +487,7 @@ namespace Bial {
 
   template< class D >
   Image< D > Gradient::MultiScaleSizeCanny( const Image< D > &img, float lower_threshold, float higher_threshold,
-                                            float sigma, size_t scales, float fraction ) {
+                                            float sigma, size_t scales, float fraction, bool recursive ) {
     try {
       COMMENT( "Checking if thresholds make sense.", 1 );
       if( ( lower_threshold > higher_threshold ) || ( lower_threshold < 0.0f ) || ( higher_threshold > 1.0f ) ) {
@@ -493,14 +503,15 @@ namespace Bial {
         throw( std::logic_error( msg ) );
       }
       COMMENT( "Computing multscale Canny.", 1 );
-      Image< D > mult( MultiScaleCanny( img, lower_threshold, higher_threshold, sigma, scales ) );
+      Image< D > mult( MultiScaleCanny( img, lower_threshold, higher_threshold, sigma, scales, recursive ) );
 
       COMMENT( "Computing connected components.", 1 );
       Adjacency spheric = AdjacencyType::HyperSpheric( 1.9, img.Dims( ) );
-      Image< int > label( Segmentation::ConnectedComponents( mult, spheric ) );
+      Vector< size_t > size;
+      Image< int > label( Segmentation::ConnectedComponents( mult, spheric, size ) );
 
       COMMENT( "Removing components with less than min_size.", 1 );
-      Image< int > res( Segmentation::RemoveSmallComponents( label, fraction ) );
+      Image< int > res( Segmentation::RemoveSmallComponents( label, size, fraction ) );
       return( res );
     }
     catch( std::bad_alloc &e ) {
@@ -524,52 +535,60 @@ namespace Bial {
 #ifdef BIAL_EXPLICIT_GradientScaleCanny
 
   template Image< int > Gradient::ScaleCanny( const Image< int > &img, size_t window_scale, float lower_threshold,
-                                            float higher_threshold );
+                                            float higher_threshold, float sigma );
   template Image< int > Gradient::SubScaleCanny( const Image< int > &img, const Image< int > &base_grad, 
-                                               size_t window_scale, float lower_threshold );
+                                               size_t window_scale, float lower_threshold, float sigma );
   template Image< int > Gradient::MultiScaleCanny( const Image< int > &img, float lower_threshold, 
-                                                 float higher_threshold, float sigma, size_t scales );
+                                                 float higher_threshold, float sigma, size_t scales,
+                                                 bool recursive );
   template Image< int > Gradient::MultiSubScaleCanny( const Image< int > &img, float lower_threshold, 
-                                                    float higher_threshold, float sigma, size_t scales );
+                                                    float higher_threshold, float sigma, size_t scales,
+                                                    bool recursive );
   template Image< int > Gradient::MultiScaleSizeCanny( const Image< int > &img, float lower_threshold, 
                                                      float higher_threshold, float sigma, size_t scales, 
-                                                     float fraction );
+                                                     float fraction, bool recursive );
 
   template Image< llint > Gradient::ScaleCanny( const Image< llint > &img, size_t window_scale, float lower_threshold,
-                                            float higher_threshold );
+                                            float higher_threshold, float sigma );
   template Image< llint > Gradient::SubScaleCanny( const Image< llint > &img, const Image< llint > &base_grad, 
-                                               size_t window_scale, float lower_threshold );
+                                               size_t window_scale, float lower_threshold, float sigma );
   template Image< llint > Gradient::MultiScaleCanny( const Image< llint > &img, float lower_threshold, 
-                                                 float higher_threshold, float sigma, size_t scales );
+                                                 float higher_threshold, float sigma, size_t scales,
+                                                 bool recursive );
   template Image< llint > Gradient::MultiSubScaleCanny( const Image< llint > &img, float lower_threshold, 
-                                                    float higher_threshold, float sigma, size_t scales );
+                                                    float higher_threshold, float sigma, size_t scales,
+                                                    bool recursive );
   template Image< llint > Gradient::MultiScaleSizeCanny( const Image< llint > &img, float lower_threshold, 
                                                      float higher_threshold, float sigma, size_t scales, 
-                                                     float fraction );
+                                                     float fraction, bool recursive );
 
   template Image< float > Gradient::ScaleCanny( const Image< float > &img, size_t window_scale, float lower_threshold,
-                                            float higher_threshold );
+                                            float higher_threshold, float sigma );
   template Image< float > Gradient::SubScaleCanny( const Image< float > &img, const Image< float > &base_grad, 
-                                               size_t window_scale, float lower_threshold );
+                                               size_t window_scale, float lower_threshold, float sigma );
   template Image< float > Gradient::MultiScaleCanny( const Image< float > &img, float lower_threshold, 
-                                                 float higher_threshold, float sigma, size_t scales );
+                                                 float higher_threshold, float sigma, size_t scales,
+                                                 bool recursive );
   template Image< float > Gradient::MultiSubScaleCanny( const Image< float > &img, float lower_threshold, 
-                                                    float higher_threshold, float sigma, size_t scales );
+                                                    float higher_threshold, float sigma, size_t scales,
+                                                    bool recursive );
   template Image< float > Gradient::MultiScaleSizeCanny( const Image< float > &img, float lower_threshold, 
                                                      float higher_threshold, float sigma, size_t scales, 
-                                                     float fraction );
+                                                     float fraction, bool recursive );
 
   template Image< double > Gradient::ScaleCanny( const Image< double > &img, size_t window_scale, float lower_threshold,
-                                            float higher_threshold );
+                                            float higher_threshold, float sigma );
   template Image< double > Gradient::SubScaleCanny( const Image< double > &img, const Image< double > &base_grad, 
-                                               size_t window_scale, float lower_threshold );
+                                               size_t window_scale, float lower_threshold, float sigma );
   template Image< double > Gradient::MultiScaleCanny( const Image< double > &img, float lower_threshold, 
-                                                 float higher_threshold, float sigma, size_t scales );
+                                                 float higher_threshold, float sigma, size_t scales,
+                                                 bool recursive );
   template Image< double > Gradient::MultiSubScaleCanny( const Image< double > &img, float lower_threshold, 
-                                                    float higher_threshold, float sigma, size_t scales );
+                                                    float higher_threshold, float sigma, size_t scales,
+                                                    bool recursive );
   template Image< double > Gradient::MultiScaleSizeCanny( const Image< double > &img, float lower_threshold, 
                                                      float higher_threshold, float sigma, size_t scales, 
-                                                     float fraction );
+                                                     float fraction, bool recursive );
 #endif
 
 }
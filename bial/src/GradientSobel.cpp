@@ -61,7 +61,6 @@ namespace Bial {
   template< class D >
   void Gradient::Sobel( const Image< D > &img, Image< D > *magnitude, Image< int > *direction ) {
     try {
-      const double TAN_22_5 = std::tan( M_PI / 8.0 ); // 0.414213562;
       size_t dimensions = img.Dims( );
 
       Vector< Image< D > > dir_sobel;
@@ -69,25 +68,52 @@ namespace Bial {
         Kernel krn = KernelType::NormalizedSobel( dimensions, dir );
         dir_sobel.push_back( Correlation( img, krn ) );
       }
-      COMMENT( "Computing Sobel magnitude.", 1 );
+      MagnitudeAndDirection( dir_sobel, magnitude, direction );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void Gradient::MagnitudeAndDirection( const Vector< Image< D > > &partial, Image< D > *magnitude,
+                                        Image< int > *direction ) {
+    try {
+      const double TAN_22_5 = std::tan( M_PI / 8.0 ); // 0.414213562;
+      size_t dimensions = partial.size( );
+      size_t size = partial( 0 ).size( );
+      COMMENT( "Computing gradient magnitude.", 1 );
       if( magnitude != nullptr ) {
-        for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
+        for( size_t pxl = 0; pxl < size; ++pxl ) {
           ( *magnitude )[ pxl ] = 0.0;
           for( size_t dms = 0; dms < dimensions; ++dms ) {
-            ( *magnitude )[ pxl ] += dir_sobel( dms )[ pxl ] * dir_sobel( dms )[ pxl ];
+            ( *magnitude )[ pxl ] += partial( dms )[ pxl ] * partial( dms )[ pxl ];
           }
           ( *magnitude )[ pxl ] = std::sqrt( ( *magnitude )[ pxl ] );
         }
       }
-      COMMENT( "Computing sobel direction.", 1 );
+      COMMENT( "Computing gradient direction.", 1 );
       if( direction != nullptr ) {
-        for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
+        for( size_t pxl = 0; pxl < size; ++pxl ) {
 
           COMMENT( "Finding the maximum gradient direction.", 3 );
           double max_grad_val = 0.0;
           int max_grad_dir = -1; /* Central. */
           for( size_t dms = 0; dms < dimensions; ++dms ) {
-            D dir_sbl = ( dir_sobel( dms )[ pxl ] ) > 0 ? dir_sobel( dms )[ pxl ] : -dir_sobel( dms )[ pxl ];
+            D dir_sbl = ( partial( dms )[ pxl ] ) > 0 ? partial( dms )[ pxl ] : -partial( dms )[ pxl ];
             if( max_grad_val < dir_sbl ) {
               max_grad_val = dir_sbl;
               max_grad_dir = dms;
@@ -99,10 +125,10 @@ namespace Bial {
             continue;
           }
           for( size_t dms = 0; dms < dimensions; ++dms ) {
-            D dir_sbl = ( dir_sobel( dms )[ pxl ] > 0 ) ? dir_sobel( dms )[ pxl ] : -dir_sobel( dms )[ pxl ];
+            D dir_sbl = ( partial( dms )[ pxl ] > 0 ) ? partial( dms )[ pxl ] : -partial( dms )[ pxl ];
             double tangent = dir_sbl / max_grad_val;
             if( tangent > TAN_22_5 ) {
-              if( dir_sobel( dms )[ pxl ] > 0 ) {
+              if( partial( dms )[ pxl ] > 0 ) {
                 ( *direction )[ pxl ] += static_cast< int >( std::pow( 2, dms * 2 ) );
               }
               else {
@@ -136,15 +162,23 @@ namespace Bial {
 
   template Image< int > Gradient::DirectionalSobel( const Image< int > &img, size_t direction );
   template void Gradient::Sobel( const Image< int > &img, Image< int > *magnitude, Image< int > *direction );
+  template void Gradient::MagnitudeAndDirection( const Vector< Image< int > > &partial, Image< int > *magnitude,
+                                                 Image< int > *direction );
 
   template Image< llint > Gradient::DirectionalSobel( const Image< llint > &img, size_t direction );
   template void Gradient::Sobel( const Image< llint > &img, Image< llint > *magnitude, Image< int > *direction );
+  template void Gradient::MagnitudeAndDirection( const Vector< Image< llint > > &partial, Image< llint > *magnitude,
+                                                 Image< int > *direction );
 
   template Image< float > Gradient::DirectionalSobel( const Image< float > &img, size_t direction );
   template void Gradient::Sobel( const Image< float > &img, Image< float > *magnitude, Image< int > *direction );
+  template void Gradient::MagnitudeAndDirection( const Vector< Image< float > > &partial, Image< float > *magnitude,
+                                                 Image< int > *direction );
 
   template Image< double > Gradient::DirectionalSobel( const Image< double > &img, size_t direction );
   template void Gradient::Sobel( const Image< double > &img, Image< double > *magnitude, Image< int > *direction );
+  template void Gradient::MagnitudeAndDirection( const Vector< Image< double > > &partial, Image< double > *magnitude,
+                                                 Image< int > *direction );
 
 #endif
 
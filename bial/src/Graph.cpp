@@ -27,6 +27,7 @@
 #include "SampleRandom.hpp"
 #include "SampleUniform.hpp"
 #include "SortingSort.hpp"
+#include "ThreadPool.hpp"
 
 namespace Bial {
 
@@ -387,21 +388,9 @@ namespace Bial {
         }
       }
       COMMENT( "Propagating other labels.", 1 );
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads.push_back( std::thread( &Graph::PropagateLabelThread< D >, this, std::ref( feature ), scl, thd,
-                                          total_threads ) );
-        }
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads( thd ).join( );
-        }
-      }
-      catch( std::exception &e ) {
-        BIAL_WARNING( "Failed to run in multi-thread. Exception: " << e.what( ) );
-        PropagateLabelThread( feature, scl, 0, 1 );
-      }
+      ThreadPool::Run( ThreadPool::Tasks( feature.Elements( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          PropagateLabelThread( feature, scl, thd, total_threads );
+        } );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -0,0 +1,491 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Block-parallel gzip compression and indexed random access to the compressed files.
+ */
+
+#ifndef BIALGZIPBLOCK_C
+#define BIALGZIPBLOCK_C
+
+#include "GzipBlock.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_GzipBlock )
+#define BIAL_EXPLICIT_GzipBlock
+#endif
+
+#if defined ( BIAL_EXPLICIT_GzipBlock ) || ( BIAL_IMPLICIT_BIN )
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Bial {
+
+  /** @brief Stores val in little-endian order, as gzip requires. */
+  static void GzipStore( unsigned char *dst, size_t val, size_t bytes ) {
+    for( size_t byte = 0; byte < bytes; ++byte ) {
+      dst[ byte ] = static_cast< unsigned char >( ( val >> ( 8 * byte ) ) & 0xFF );
+    }
+  }
+
+  /** @brief Loads a little-endian value. */
+  static size_t GzipLoad( const unsigned char *src, size_t bytes ) {
+    size_t val = 0;
+    for( size_t byte = 0; byte < bytes; ++byte ) {
+      val |= static_cast< size_t >( src[ byte ] ) << ( 8 * byte );
+    }
+    return( val );
+  }
+
+  const size_t GzipBlockWriter::BLOCK;
+
+  GzipBlockWriter::GzipBlockWriter( const std::string &filename, int level ) try
+    : file( nullptr ), level( level ), input( ), filled( 0 ), written( 0 ), members( 0 ) {
+    file = std::fopen( filename.c_str( ), "wb" );
+    if( file == nullptr ) {
+      std::string msg( BIAL_ERROR( "Could not create file " + filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    COMMENT( "Two blocks per thread in each batch, so that threads that finish early take another block.", 2 );
+    input.resize( BLOCK * 2 * std::max( ThreadPool::Threads( ), static_cast< size_t >( 1 ) ) );
+  }
+  catch( std::ios_base::failure &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/writing gzip file." ) );
+    throw( std::ios_base::failure( msg ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  GzipBlockWriter::~GzipBlockWriter( ) {
+    try {
+      Close( );
+    }
+    catch( ... ) {
+      COMMENT( "Destructors must not throw. Errors are reported by Close.", 1 );
+    }
+  }
+
+  void GzipBlockWriter::CompressMember( const char *src, size_t bytes, int level,
+                                        std::vector< unsigned char > &dst ) {
+    try {
+      z_stream strm;
+      std::memset( &strm, 0, sizeof( z_stream ) );
+      COMMENT( "Raw deflate. Header and trailer are written here.", 4 );
+      if( deflateInit2( &strm, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY ) != Z_OK ) {
+        std::string msg( BIAL_ERROR( "Could not initialize gzip compression." ) );
+        throw( std::runtime_error( msg ) );
+      }
+      size_t bound = deflateBound( &strm, static_cast< uLong >( bytes ) );
+      dst.resize( HEADER + bound + 8 );
+      strm.next_in = reinterpret_cast< Bytef* >( const_cast< char* >( src ) );
+      strm.avail_in = static_cast< uInt >( bytes );
+      strm.next_out = dst.data( ) + HEADER;
+      strm.avail_out = static_cast< uInt >( bound );
+      int res = deflate( &strm, Z_FINISH );
+      size_t compressed = bound - strm.avail_out;
+      deflateEnd( &strm );
+      if( res != Z_STREAM_END ) {
+        std::string msg( BIAL_ERROR( "Gzip compression failed." ) );
+        throw( std::runtime_error( msg ) );
+      }
+      COMMENT( "Header: magic, deflate, FEXTRA flag, no time, unknown OS, and the BI field with the member size.", 4 );
+      size_t size = HEADER + compressed + 8;
+      const unsigned char header[ 12 ] = { 0x1F, 0x8B, 8, 4, 0, 0, 0, 0, 0, 255, 8, 0 };
+      std::memcpy( dst.data( ), header, 12 );
+      dst[ 12 ] = 'B';
+      dst[ 13 ] = 'I';
+      GzipStore( dst.data( ) + 14, 4, 2 );
+      GzipStore( dst.data( ) + 16, size, 4 );
+      COMMENT( "Trailer: CRC and uncompressed size.", 4 );
+      uLong crc = crc32( 0L, reinterpret_cast< const Bytef* >( src ), static_cast< uInt >( bytes ) );
+      GzipStore( dst.data( ) + HEADER + compressed, crc, 4 );
+      GzipStore( dst.data( ) + HEADER + compressed + 4, bytes, 4 );
+      dst.resize( size );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void GzipBlockWriter::Flush( ) {
+    try {
+      size_t blocks = ( filled + BLOCK - 1 ) / BLOCK;
+      if( ( blocks == 0 ) && ( members == 0 ) ) {
+        COMMENT( "Empty file. Writing one empty member.", 2 );
+        blocks = 1;
+      }
+      std::vector< std::vector< unsigned char > > output( blocks );
+      const char *data = input.data( );
+      size_t size = filled;
+      int lvl = level;
+      ThreadPool::ParallelFor( 0, blocks, 1, [ data, size, lvl, &output ]( size_t first, size_t last ) {
+          for( size_t blk = first; blk < last; ++blk ) {
+            size_t start = blk * BLOCK;
+            CompressMember( data + start, std::min( BLOCK, size - std::min( start, size ) ), lvl, output[ blk ] );
+          }
+        } );
+      COMMENT( "Writing members in order.", 2 );
+      for( size_t blk = 0; blk < blocks; ++blk ) {
+        if( std::fwrite( output[ blk ].data( ), 1, output[ blk ].size( ), file ) != output[ blk ].size( ) ) {
+          std::string msg( BIAL_ERROR( "Could not write to gzip file." ) );
+          throw( std::ios_base::failure( msg ) );
+        }
+      }
+      members += blocks;
+      written += filled;
+      filled = 0;
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error writing gzip file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void GzipBlockWriter::Write( const char *data, size_t bytes ) {
+    try {
+      while( bytes > 0 ) {
+        size_t count = std::min( bytes, input.size( ) - filled );
+        std::memcpy( input.data( ) + filled, data, count );
+        filled += count;
+        data += count;
+        bytes -= count;
+        if( filled == input.size( ) ) {
+          Flush( );
+        }
+      }
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error writing gzip file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  size_t GzipBlockWriter::Tell( ) const {
+    return( written + filled );
+  }
+
+  void GzipBlockWriter::Close( ) {
+    try {
+      if( file == nullptr ) {
+        return;
+      }
+      if( ( filled > 0 ) || ( members == 0 ) ) {
+        Flush( );
+      }
+      std::FILE *closing = file;
+      file = nullptr;
+      if( std::fclose( closing ) != 0 ) {
+        std::string msg( BIAL_ERROR( "Could not close gzip file." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error writing/closing gzip file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  size_t GzipBlockReader::MemberSize( const unsigned char *hdr, size_t available, size_t &header_size ) {
+    if( ( available < 12 ) || ( hdr[ 0 ] != 0x1F ) || ( hdr[ 1 ] != 0x8B ) || ( hdr[ 2 ] != 8 ) ||
+        ( ( hdr[ 3 ] & 4 ) == 0 ) ) {
+      return( 0 );
+    }
+    if( ( hdr[ 3 ] & 0xFB ) != 0 ) {
+      COMMENT( "Name, comment, or header CRC present. Not written by GzipBlockWriter.", 4 );
+      return( 0 );
+    }
+    size_t xlen = GzipLoad( hdr + 10, 2 );
+    header_size = 12 + xlen;
+    if( available < header_size ) {
+      return( 0 );
+    }
+    COMMENT( "Looking for the BI subfield among the extra subfields.", 4 );
+    size_t field = 12;
+    while( field + 4 <= header_size ) {
+      size_t len = GzipLoad( hdr + field + 2, 2 );
+      if( ( hdr[ field ] == 'B' ) && ( hdr[ field + 1 ] == 'I' ) && ( len == 4 ) && ( field + 8 <= header_size ) ) {
+        return( GzipLoad( hdr + field + 4, 4 ) );
+      }
+      field += 4 + len;
+    }
+    return( 0 );
+  }
+
+  GzipBlockReader::GzipBlockReader( const std::string &filename ) try
+    : mapping( filename ), member_offset( ), data_offset( ), cache( ), cached( 0 ), position( 0 ) {
+    COMMENT( "Building the index from member headers and trailers. Nothing is inflated.", 2 );
+    const unsigned char *data = reinterpret_cast< const unsigned char* >( mapping.Data( ) );
+    size_t bytes = mapping.Size( );
+    size_t offset = 0;
+    size_t total = 0;
+    while( offset < bytes ) {
+      size_t header_size = 0;
+      size_t size = MemberSize( data + offset, bytes - offset, header_size );
+      if( ( size < header_size + 8 ) || ( size > bytes - offset ) ) {
+        std::string msg( BIAL_ERROR( "Gzip file " + filename + " is not block indexed." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      member_offset.push_back( offset );
+      data_offset.push_back( total );
+      total += GzipLoad( data + offset + size - 4, 4 );
+      offset += size;
+    }
+    member_offset.push_back( bytes );
+    data_offset.push_back( total );
+    cached = member_offset.size( );
+  }
+  catch( std::ios_base::failure &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/reading gzip file." ) );
+    throw( std::ios_base::failure( msg ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  bool GzipBlockReader::IsIndexed( const std::string &filename ) {
+    try {
+      std::ifstream file( filename, std::ios::binary );
+      unsigned char hdr[ 64 ];
+      file.read( reinterpret_cast< char* >( hdr ), 64 );
+      size_t header_size = 0;
+      return( MemberSize( hdr, static_cast< size_t >( file.gcount( ) ), header_size ) != 0 );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void GzipBlockReader::Inflate( size_t member, char *dst ) const {
+    try {
+      const unsigned char *data = reinterpret_cast< const unsigned char* >( mapping.Data( ) ) +
+        member_offset[ member ];
+      size_t size = member_offset[ member + 1 ] - member_offset[ member ];
+      size_t bytes = data_offset[ member + 1 ] - data_offset[ member ];
+      size_t header_size = 0;
+      MemberSize( data, size, header_size );
+      z_stream strm;
+      std::memset( &strm, 0, sizeof( z_stream ) );
+      if( inflateInit2( &strm, -15 ) != Z_OK ) {
+        std::string msg( BIAL_ERROR( "Could not initialize gzip decompression." ) );
+        throw( std::runtime_error( msg ) );
+      }
+      strm.next_in = const_cast< Bytef* >( data + header_size );
+      strm.avail_in = static_cast< uInt >( size - header_size - 8 );
+      strm.next_out = reinterpret_cast< Bytef* >( dst );
+      strm.avail_out = static_cast< uInt >( bytes );
+      int res = inflate( &strm, Z_FINISH );
+      inflateEnd( &strm );
+      if( ( res != Z_STREAM_END ) || ( strm.avail_out != 0 ) ||
+          ( crc32( 0L, reinterpret_cast< const Bytef* >( dst ), static_cast< uInt >( bytes ) ) !=
+            GzipLoad( data + size - 8, 4 ) ) ) {
+        std::string msg( BIAL_ERROR( "Corrupted gzip member " + std::to_string( member ) + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading gzip file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  size_t GzipBlockReader::Read( char *dst, size_t bytes ) {
+    try {
+      size_t done = 0;
+      size_t members = member_offset.size( ) - 1;
+      while( ( done < bytes ) && ( position < data_offset[ members ] ) ) {
+        size_t member = static_cast< size_t >( std::upper_bound( data_offset.begin( ), data_offset.end( ), position )
+                                               - data_offset.begin( ) ) - 1;
+        size_t skip = position - data_offset[ member ];
+        size_t last = member;
+        if( skip == 0 ) {
+          while( ( last < members ) && ( data_offset[ last + 1 ] - position <= bytes - done ) ) {
+            ++last;
+          }
+        }
+        if( last > member ) {
+          COMMENT( "Inflating whole members in parallel, straight into the destination.", 2 );
+          char *base = dst + done;
+          size_t start = data_offset[ member ];
+          ThreadPool::ParallelFor( member, last, 1, [ this, base, start ]( size_t first, size_t end ) {
+              for( size_t mbr = first; mbr < end; ++mbr ) {
+                Inflate( mbr, base + ( data_offset[ mbr ] - start ) );
+              }
+            } );
+          done += data_offset[ last ] - position;
+          position = data_offset[ last ];
+        }
+        else {
+          COMMENT( "Partial member. Inflating it to the cache.", 4 );
+          if( cached != member ) {
+            cache.resize( data_offset[ member + 1 ] - data_offset[ member ] );
+            Inflate( member, cache.data( ) );
+            cached = member;
+          }
+          size_t count = std::min( cache.size( ) - skip, bytes - done );
+          std::memcpy( dst + done, cache.data( ) + skip, count );
+          done += count;
+          position += count;
+        }
+      }
+      return( done );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading gzip file." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void GzipBlockReader::Seek( size_t pos ) {
+    position = pos;
+  }
+
+  size_t GzipBlockReader::Tell( ) const {
+    return( position );
+  }
+
+  size_t GzipBlockReader::Size( ) const {
+    return( data_offset.back( ) );
+  }
+
+}
+
+#endif
+
+#endif
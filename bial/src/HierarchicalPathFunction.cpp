@@ -211,7 +211,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  inline bool HierarchicalPathFunction< C, D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  inline bool HierarchicalPathFunction< C, D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) && 
               ( ( split_label->operator()( index ) == split_label->operator()( adj_index ) ) &&
@@ -239,7 +239,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  bool HierarchicalPathFunction< C, D >::Propagate( int index, int adj_index ) {
+  bool HierarchicalPathFunction< C, D >::Propagate( size_t index, size_t adj_index ) {
     try {
       D src_value = this->value->operator()( adj_index );
       COMMENT( "Checking conditions related to merge and split label. Merge_label( index ): " << 
@@ -69,7 +69,7 @@ namespace Bial {
     CreateTables( );
   }
 
-  template< class D > Image< D >::Image( const Vector< size_t > &spc_dim ) try 
+  template< class D > Image< D >::Image( const Vector< size_t > &spc_dim, StorageInit init ) try 
     : _data( 1, 1, 1 ), qk_data( nullptr ), pixel_size( 3, 1.0 ), y_table( nullptr ), z_table( nullptr ) {
       size_t dimensions = spc_dim.size( );
       COMMENT( "Checking for number of spatial dimensions.", 2 );
@@ -89,7 +89,7 @@ namespace Bial {
         }
       }
       COMMENT( "Assigning data matix and image size.", 2 );
-      _data = Matrix< D >( dims );
+      _data = Matrix< D >( dims, init );
 
       COMMENT( "Assigning quick access pointers.", 2 );
       qk_data = &_data[ 0 ];
@@ -312,8 +312,8 @@ namespace Bial {
 
   template< class D > template< class D2 > 
   Image< D >::Image( const Image< D2 > &img ) try 
-    : _data( img._data.dim_size ), qk_data( nullptr ), pixel_size( img.pixel_size ), y_table( nullptr ), 
-        z_table( nullptr ) {
+    : _data( img._data.dim_size, StorageInit::None ), qk_data( nullptr ), pixel_size( img.pixel_size ),
+        y_table( nullptr ), z_table( nullptr ) {
     COMMENT( "Assigning quick access pointers.", 2 );
     qk_data = &_data[ 0 ];
     CreateTables( );
@@ -1140,66 +1140,66 @@ namespace Bial {
   }
 
   template< class D >
-  typename std::vector< D >::iterator Image< D >::begin( ) noexcept {
+  typename Vector< D >::iterator Image< D >::begin( ) noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.begin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Image< D >::begin( ) const noexcept {
+  typename Vector< D >::const_iterator Image< D >::begin( ) const noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.begin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::iterator Image< D >::end( ) noexcept {
+  typename Vector< D >::iterator Image< D >::end( ) noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.end( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Image< D >::end( ) const noexcept {
+  typename Vector< D >::const_iterator Image< D >::end( ) const noexcept {
     COMMENT( "size_of D: " << sizeof( D ), 4 );
     return( _data.end( ) );
   }
 
   template< class D >
-  typename std::vector< D >::reverse_iterator Image< D >::rbegin( ) noexcept {
+  typename Vector< D >::reverse_iterator Image< D >::rbegin( ) noexcept {
     return( _data.rbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Image< D >::rbegin( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Image< D >::rbegin( ) const noexcept {
     return( _data.rbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::reverse_iterator Image< D >::rend( ) noexcept {
+  typename Vector< D >::reverse_iterator Image< D >::rend( ) noexcept {
     return( _data.rend( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Image< D >::rend( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Image< D >::rend( ) const noexcept {
     return( _data.rend( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Image< D >::cbegin( ) const noexcept {
+  typename Vector< D >::const_iterator Image< D >::cbegin( ) const noexcept {
     return( _data.cbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_iterator Image< D >::cend( ) const noexcept {
+  typename Vector< D >::const_iterator Image< D >::cend( ) const noexcept {
     return( _data.cend( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Image< D >::crbegin( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Image< D >::crbegin( ) const noexcept {
     return( _data.crbegin( ) );
   }
 
   template< class D >
-  typename std::vector< D >::const_reverse_iterator Image< D >::crend( ) const noexcept {
+  typename Vector< D >::const_reverse_iterator Image< D >::crend( ) const noexcept {
     return( _data.crend( ) );
   }
 
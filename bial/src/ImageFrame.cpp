@@ -18,6 +18,7 @@
 
 #if defined ( BIAL_EXPLICIT_ImageFrame ) || ( BIAL_IMPLICIT_BIN )
 
+#include "ChunkedImage.hpp"
 #include "Image.hpp"
 #include "ImageResize.hpp"
 
@@ -161,6 +162,34 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  Image< D > ImageOp::RemoveFrame( const ChunkedImage< D > &img, const Vector< size_t > &low_coord,
+                                   const Vector< size_t > &hgh_coord ) {
+    try {
+      return( img.Region( low_coord, hgh_coord ) );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
 #ifdef BIAL_EXPLICIT_ImageFrame
 
   template Image< int > ImageOp::RemoveFrame( const Image< int > &img, const Vector< size_t > &low_coord,
@@ -192,6 +221,16 @@ namespace Bial {
                                               const Vector< size_t > &full_size );
   template Image< double > ImageOp::AddFrame( const Image< double > &img, size_t width );
 
+  template Image< int > ImageOp::RemoveFrame( const ChunkedImage< int > &img, const Vector< size_t > &low_coord,
+                                              const Vector< size_t > &hgh_coord );
+  template Image< llint > ImageOp::RemoveFrame( const ChunkedImage< llint > &img, const Vector< size_t > &low_coord,
+                                                const Vector< size_t > &hgh_coord );
+  template Image< float > ImageOp::RemoveFrame( const ChunkedImage< float > &img, const Vector< size_t > &low_coord,
+                                                const Vector< size_t > &hgh_coord );
+  template Image< double > ImageOp::RemoveFrame( const ChunkedImage< double > &img,
+                                                 const Vector< size_t > &low_coord,
+                                                 const Vector< size_t > &hgh_coord );
+
 
 #endif
 
@@ -18,7 +18,7 @@
 
 #if defined ( BIAL_EXPLICIT_ImageIFT ) || ( BIAL_IMPLICIT_BIN )
 
-#include "AdjacencyIterator.hpp"
+#include "AdjacencyOffset.hpp"
 #include "BucketQueue.hpp"
 
 namespace Bial {
@@ -59,6 +59,8 @@ namespace Bial {
     try {
       COMMENT( "Running.", 1 );
       size_t size = this->value.size( );
+      AdjacencyOffset offsets( adjacency, this->value );
+      size_t adjs = offsets.size( );
       while( ( !this->queue->Empty( ) ) && 
              ( ( !dift_enb ) || ( this->queue->State( dift_elm ) != BucketState::REMOVED ) ) ) {
         COMMENT( "Initializing removed data.", 4 );
@@ -67,8 +69,12 @@ namespace Bial {
         COMMENT( "Index: " << index << ", value: " << this->value[ index ], 4 );
         this->queue->Finished( index );
         if( capable ) {
-          for( AdjacencyIterator adj = begin( adjacency, this->value, index ); *adj < size; ++adj ) {
-            size_t adj_index = *( adj );
+          bool interior = offsets.Interior( index );
+          for( size_t adj = 0; adj < adjs; ++adj ) {
+            size_t adj_index = interior ? offsets( index, adj ) : offsets.Checked( index, adj );
+            if( adj_index >= size ) {
+              continue;
+            }
             if( this->function->Capable( index, adj_index, this->queue->State( adj_index ) ) ) {
               COMMENT( "Conquering: " << adj_index, 4 );
               D previous_value = this->value[ adj_index ];
@@ -19,6 +19,8 @@
 
 #if defined ( BIAL_EXPLICIT_ImageROI ) || ( BIAL_IMPLICIT_BIN )
 
+#include "ChunkedImage.hpp"
+
 namespace Bial {
 
   template< class D >
@@ -69,6 +71,61 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const ChunkedImage< D > &img ) {
+    try {
+      COMMENT( "Computing low and high coordinates of each row of chunks.", 0 );
+      Vector< size_t > dim( img.Dim( ) );
+      Vector< size_t > chunk( img.ChunkDim( ) );
+      Vector< size_t > low_coord( dim );
+      Vector< size_t > hgh_coord( 3, 0 );
+      for( size_t z_0 = 0; z_0 < dim[ 2 ]; z_0 += chunk[ 2 ] ) {
+        for( size_t y_0 = 0; y_0 < dim[ 1 ]; y_0 += chunk[ 1 ] ) {
+          Vector< size_t > row_low( { 0, y_0, z_0 } );
+          Vector< size_t > row_hgh( { dim[ 0 ] - 1, std::min( y_0 + chunk[ 1 ], dim[ 1 ] ) - 1,
+                                      std::min( z_0 + chunk[ 2 ], dim[ 2 ] ) - 1 } );
+          Image< D > row( img.Region( row_low, row_hgh ) );
+          Vector< size_t > row_dim( row.Dim( ) );
+          for( size_t z = 0; z < row_dim[ 2 ]; ++z ) {
+            for( size_t y = 0; y < row_dim[ 1 ]; ++y ) {
+              for( size_t x = 0; x < row_dim[ 0 ]; ++x ) {
+                if( row( x, y, z ) != 0 ) {
+                  low_coord( 0 ) = std::min( low_coord( 0 ), x );
+                  low_coord( 1 ) = std::min( low_coord( 1 ), y + y_0 );
+                  low_coord( 2 ) = std::min( low_coord( 2 ), z + z_0 );
+                  hgh_coord( 0 ) = std::max( hgh_coord( 0 ), x );
+                  hgh_coord( 1 ) = std::max( hgh_coord( 1 ), y + y_0 );
+                  hgh_coord( 2 ) = std::max( hgh_coord( 2 ), z + z_0 );
+                }
+              }
+            }
+          }
+        }
+      }
+      return( std::make_tuple( low_coord, hgh_coord ) );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
 #ifdef BIAL_EXPLICIT_ImageROI
 
   template std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const Image< int > &img );
@@ -76,6 +133,11 @@ namespace Bial {
   template std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const Image< float > &img );
   template std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const Image< double > &img );
 
+  template std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const ChunkedImage< int > &img );
+  template std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const ChunkedImage< llint > &img );
+  template std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const ChunkedImage< float > &img );
+  template std::tuple< Vector< size_t >, Vector< size_t > > ImageOp::ROI( const ChunkedImage< double > &img );
+
 #endif
 
 }
@@ -18,6 +18,7 @@
 
 #if defined ( BIAL_EXPLICIT_ImageSplit ) || ( BIAL_IMPLICIT_BIN )
 
+#include "ChunkedImage.hpp"
 #include "Image.hpp"
 
 namespace Bial {
@@ -97,6 +98,46 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  Vector< Image< D > > ImageOp::Split( const ChunkedImage< D > &img, size_t dimension ) {
+    try {
+      if( img.Dims( ) < 3 ) {
+        std::string msg( BIAL_ERROR( " Source image must have three dimensions." ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( ( img.Dims( ) <= dimension ) || ( img.size( dimension ) <= 1 ) ) {
+        std::string msg( BIAL_ERROR( " Split dimension does not exist or has less than two elements. Split " +
+                                     std::string( "dimension: " ) + std::to_string( dimension ) + "." ) );
+        throw( std::logic_error( msg ) );
+      }
+      Vector< Image< D > > res;
+      for( size_t spt_coord = 0; spt_coord < img.size( dimension ); ++spt_coord ) {
+        res.push_back( img.Slice( dimension, spt_coord ) );
+      }
+      return( res );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading chunked volume." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
 #ifdef BIAL_EXPLICIT_ImageSplit
 
   template Vector< Image< int > > ImageOp::Split( const Image< int > &img, size_t dimension );
@@ -104,6 +145,11 @@ namespace Bial {
   template Vector< Image< float > > ImageOp::Split( const Image< float > &img, size_t dimension );
   template Vector< Image< double > > ImageOp::Split( const Image< double > &img, size_t dimension );
 
+  template Vector< Image< int > > ImageOp::Split( const ChunkedImage< int > &img, size_t dimension );
+  template Vector< Image< llint > > ImageOp::Split( const ChunkedImage< llint > &img, size_t dimension );
+  template Vector< Image< float > > ImageOp::Split( const ChunkedImage< float > &img, size_t dimension );
+  template Vector< Image< double > > ImageOp::Split( const ChunkedImage< double > &img, size_t dimension );
+
 #endif
 
 }
@@ -0,0 +1,196 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Connected component labeling of images with union-find, with the image domain split in blocks processed by
+ * the thread pool.
+ */
+
+#ifndef BIALIMAGEUNIONFIND_C
+#define BIALIMAGEUNIONFIND_C
+
+#include "ImageUnionFind.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_ImageUnionFind )
+#define BIAL_EXPLICIT_ImageUnionFind
+#endif
+
+#if defined ( BIAL_EXPLICIT_ImageUnionFind ) || ( BIAL_IMPLICIT_BIN )
+
+#include "AdjacencyOffset.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace Bial {
+
+  template< class D >
+  ImageUnionFind< D >::ImageUnionFind( const Image< D > &input, const Adjacency &adjacency ) try :
+    input( input ), adjacency( adjacency ) {
+      if( input.Dims( ) != adjacency.Dims( ) ) {
+        std::string msg( BIAL_ERROR( "Image and adjacency relation dimensions do not match. Image dimensions: " +
+                                     std::to_string( input.Dims( ) ) + ", adjacency dimensions: " +
+                                     std::to_string( adjacency.Dims( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D >
+  inline size_t ImageUnionFind< D >::Find( size_t pxl ) {
+    while( parent[ pxl ] != pxl ) {
+      parent[ pxl ] = parent[ parent[ pxl ] ];
+      pxl = parent[ pxl ];
+    }
+    return( pxl );
+  }
+
+  template< class D >
+  inline void ImageUnionFind< D >::Union( size_t pxl, size_t adj_pxl ) {
+    size_t pxl_root = Find( pxl );
+    size_t adj_root = Find( adj_pxl );
+    if( pxl_root < adj_root ) {
+      parent[ adj_root ] = pxl_root;
+    }
+    else if( adj_root < pxl_root ) {
+      parent[ pxl_root ] = adj_root;
+    }
+  }
+
+  template< class D >
+  void ImageUnionFind< D >::Join( const AdjacencyOffset &offsets, size_t blk, size_t first, size_t last,
+                                  bool seam ) {
+    size_t img_size = input.size( );
+    size_t adjs = offsets.size( );
+    const D *data = input.data( );
+    for( size_t pxl = first; pxl < last; ++pxl ) {
+      if( data[ pxl ] == 0 ) {
+        continue;
+      }
+      bool interior = offsets.Interior( pxl );
+      for( size_t adj = 0; adj < adjs; ++adj ) {
+        size_t adj_pxl = interior ? offsets( pxl, adj ) : offsets.Checked( pxl, adj );
+        if( ( adj_pxl >= img_size ) || ( data[ adj_pxl ] == 0 ) ) {
+          continue;
+        }
+        bool inside = ( adj_pxl >= bound[ blk ] ) && ( adj_pxl < bound[ blk + 1 ] );
+        if( inside != seam ) {
+          Union( pxl, adj_pxl );
+        }
+      }
+    }
+  }
+
+  template< class D >
+  void ImageUnionFind< D >::Run( ) {
+    try {
+      size_t img_size = input.size( );
+      AdjacencyOffset offsets( adjacency, input );
+      size_t reach = 1;
+      for( size_t adj = 0; adj < offsets.size( ); ++adj ) {
+        reach = std::max( reach, static_cast< size_t >( std::abs( offsets.Offset( adj ) ) ) );
+      }
+      COMMENT( "Blocks are larger than the adjacency reach, so that only pixels near seams reach other blocks.", 0 );
+      size_t blocks = std::max< size_t >( 1, std::min( ThreadPool::Threads( ),
+                                                       img_size / std::max< size_t >( 4096, 2 * reach ) ) );
+      bound = Vector< size_t >( blocks + 1, img_size );
+      for( size_t blk = 0; blk < blocks; ++blk ) {
+        bound[ blk ] = img_size * blk / blocks;
+      }
+      parent = Vector< size_t >( img_size );
+      for( size_t pxl = 0; pxl < img_size; ++pxl ) {
+        parent[ pxl ] = pxl;
+      }
+      COMMENT( "Joining adjacent pixels inside each block. Each block only writes the parents of its pixels.", 0 );
+      ThreadPool::ParallelFor( 0, blocks, 1, [ this, &offsets ]( size_t first, size_t last ) {
+          for( size_t blk = first; blk < last; ++blk ) {
+            Join( offsets, blk, bound[ blk ], bound[ blk + 1 ], false );
+          }
+        } );
+      COMMENT( "Joining adjacent pixels across block seams.", 0 );
+      for( size_t blk = 0; blk < blocks; ++blk ) {
+        size_t head = std::min( bound[ blk + 1 ], bound[ blk ] + reach );
+        size_t tail = std::max( head, bound[ blk + 1 ] - std::min( bound[ blk + 1 ], reach ) );
+        Join( offsets, blk, bound[ blk ], head, true );
+        Join( offsets, blk, tail, bound[ blk + 1 ], true );
+      }
+      COMMENT( "Labeling roots in raster order. Roots are the first pixels of their components.", 0 );
+      label = Image< int >( input.Dim( ), input.PixelSize( ) );
+      size = Vector< size_t >( 1, 0 );
+      const D *data = input.data( );
+      for( size_t pxl = 0; pxl < img_size; ++pxl ) {
+        if( data[ pxl ] == 0 ) {
+          label[ pxl ] = 0;
+          ++size[ 0 ];
+          continue;
+        }
+        size_t pxl_root = Find( pxl );
+        if( pxl_root == pxl ) {
+          label[ pxl ] = static_cast< int >( size.size( ) );
+          size.push_back( 1 );
+        }
+        else {
+          label[ pxl ] = label[ pxl_root ];
+          ++size[ label[ pxl ] ];
+        }
+      }
+      COMMENT( "Found " << size.size( ) - 1 << " components.", 0 );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  const Image< int > &ImageUnionFind< D >::Label( ) const {
+    return( label );
+  }
+
+  template< class D >
+  const Vector< size_t > &ImageUnionFind< D >::Size( ) const {
+    return( size );
+  }
+
+#ifdef BIAL_EXPLICIT_ImageUnionFind
+
+  template class ImageUnionFind< int >;
+  template class ImageUnionFind< llint >;
+  template class ImageUnionFind< float >;
+  template class ImageUnionFind< double >;
+
+#endif
+
+}
+
+#endif
+
+#endif
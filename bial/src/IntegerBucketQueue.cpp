@@ -0,0 +1,306 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief
+ * Content: Bucket-sort queue with 64-bit element identifiers and integer weights.
+ */
+
+#ifndef BIALINTEGERBUCKETQUEUE_C
+#define BIALINTEGERBUCKETQUEUE_C
+
+#include "IntegerBucketQueue.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_IntegerBucketQueue )
+#define BIAL_EXPLICIT_IntegerBucketQueue
+#endif
+
+#if defined ( BIAL_EXPLICIT_IntegerBucketQueue ) || ( BIAL_IMPLICIT_BIN )
+
+namespace Bial {
+
+  IntegerBucketQueue::IntegerBucketQueue( size_t size, ldbl bucket_size, bool increasing_order, bool fifo_tie ) try
+    : next( size, -1 ), prev( size, -1 ), state( size, BucketState::NOT_VISITED ), first( 256, -1 ),
+        last( 256, -1 ), mask( 255 ), minimum( 0 ), maximum( 0 ),
+        delta( std::max< llint >( 1, std::llround( bucket_size ) ) ), elements( 0 ), increasing( increasing_order ),
+        fifo( fifo_tie ) {
+      COMMENT( "Created with size : " << first.size( ) << ", delta: " << delta, 3 );
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  void IntegerBucketQueue::Grow( size_t new_size ) {
+    try {
+      COMMENT( "Growing queue. Current size: " << first.size( ) << ", new size: " << new_size << ".", 3 );
+      Vector< llint > new_first( new_size, -1 );
+      Vector< llint > new_last( new_size, -1 );
+      size_t new_mask = new_size - 1;
+      if( elements != 0 ) {
+        for( llint bucket = minimum; bucket <= maximum; ++bucket ) {
+          size_t cur_idx = Index( bucket );
+          size_t new_idx = static_cast< size_t >( bucket ) & new_mask;
+          new_first[ new_idx ] = first[ cur_idx ];
+          new_last[ new_idx ] = last[ cur_idx ];
+        }
+      }
+      first = std::move( new_first );
+      last = std::move( new_last );
+      mask = new_mask;
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void IntegerBucketQueue::Insert( size_t idt, llint wgt ) {
+    try {
+      COMMENT( "Inserting element: " << idt << ", with weight: " << wgt << ".", 4 );
+      if( ( state[ idt ] == BucketState::INSERTED ) || ( state[ idt ] == BucketState::UPDATED ) ) {
+        std::string msg( BIAL_ERROR( "Inserting element that is already in queue." ) );
+        throw( std::logic_error( msg ) );
+      }
+      llint bucket = Bucket( wgt );
+      if( elements == 0 ) {
+        COMMENT( "First element.", 4 );
+        minimum = bucket;
+        maximum = bucket;
+      }
+      else if( ( bucket < minimum ) || ( bucket > maximum ) ) {
+        COMMENT( "Verify bucket bounds and eventual growth.", 4 );
+        llint new_min = std::min( bucket, minimum );
+        llint new_max = std::max( bucket, maximum );
+        ullint new_size = static_cast< ullint >( new_max - new_min ) + 1;
+        if( new_size > 1000000 ) {
+          if( new_size > 10000000 ) {
+            std::string msg( BIAL_ERROR( std::string( "IntegerBucketQueue is too big. This will take forever to run. " )
+                                         + "Fix your program. Minimum: " + std::to_string( new_min * delta ) +
+                                         " Maximum: " + std::to_string( new_max * delta ) + " wgt: " +
+                                         std::to_string( wgt ) ) );
+            throw( std::runtime_error( msg ) );
+          }
+          BIAL_WARNING( std::string( "IntegerBucketQueue is becaming huge. This may take forever to run. " ) +
+                        "Fix your program or continue at your own risk. Minimum: " + std::to_string( new_min * delta ) +
+                        " Maximum: " + std::to_string( new_max * delta ) + " wgt: " + std::to_string( wgt ) );
+        }
+        if( new_size > first.size( ) ) {
+          size_t buckets = first.size( );
+          while( buckets < 2 * new_size ) {
+            buckets *= 2;
+          }
+          Grow( buckets );
+        }
+        minimum = new_min;
+        maximum = new_max;
+      }
+      COMMENT( "Inserting element.", 4 );
+      size_t weight_idx = Index( bucket );
+      llint elm = static_cast< llint >( idt );
+      ++elements;
+      if( fifo ) {
+        if( first[ weight_idx ] == -1 ) {
+          first[ weight_idx ] = elm;
+        }
+        else {
+          next[ last[ weight_idx ] ] = elm;
+        }
+        prev[ idt ] = last[ weight_idx ];
+        next[ idt ] = -1;
+        last[ weight_idx ] = elm;
+      }
+      else { /* LIFO */
+        if( first[ weight_idx ] == -1 ) {
+          last[ weight_idx ] = elm;
+        }
+        else {
+          prev[ first[ weight_idx ] ] = elm;
+        }
+        next[ idt ] = first[ weight_idx ];
+        prev[ idt ] = -1;
+        first[ weight_idx ] = elm;
+      }
+      state[ idt ] = BucketState::INSERTED;
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  size_t IntegerBucketQueue::Remove( ) {
+    try {
+      if( elements == 0 ) {
+        std::string msg( BIAL_ERROR( "Removing element from empty queue." ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Finding next non-empty bucket.", 4 );
+      size_t weight_idx;
+      if( increasing ) {
+        weight_idx = Index( minimum );
+        while( first[ weight_idx ] == -1 ) {
+          ++minimum;
+          weight_idx = Index( minimum );
+        }
+      }
+      else {
+        weight_idx = Index( maximum );
+        while( first[ weight_idx ] == -1 ) {
+          --maximum;
+          weight_idx = Index( maximum );
+        }
+      }
+      --elements;
+      llint idt = first[ weight_idx ];
+      llint nxt = next[ idt ];
+      COMMENT( "Removing idt: " << idt << ", weight_idx: " << weight_idx << ", next:" << nxt, 3 );
+      first[ weight_idx ] = nxt;
+      if( nxt == -1 ) {
+        last[ weight_idx ] = -1;
+      }
+      else {
+        prev[ nxt ] = -1;
+      }
+      return( static_cast< size_t >( idt ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void IntegerBucketQueue::Remove( size_t idt, llint wgt ) {
+    try {
+      if( elements == 0 ) {
+        return;
+      }
+      COMMENT( "Removing element " << idt << " with weight " << wgt << ".", 3 );
+      size_t weight_idx = Index( Bucket( wgt ) );
+      llint prv = prev[ idt ];
+      llint nxt = next[ idt ];
+      --elements;
+      if( prv == -1 ) {
+        first[ weight_idx ] = nxt;
+      }
+      else {
+        next[ prv ] = nxt;
+      }
+      if( nxt == -1 ) {
+        last[ weight_idx ] = prv;
+      }
+      else {
+        prev[ nxt ] = prv;
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void IntegerBucketQueue::Update( size_t idt, llint cur_wgt, llint new_wgt ) {
+    try {
+      if( ( state[ idt ] == BucketState::INSERTED ) || ( state[ idt ] == BucketState::UPDATED ) ) {
+        COMMENT( "Updating element: " << idt << " from " << cur_wgt << " to " << new_wgt << ".", 3 );
+        Remove( idt, cur_wgt );
+      }
+      else {
+        COMMENT( "Inserting element: " << idt << " with weight: " << new_wgt << ".", 3 );
+      }
+      state[ idt ] = BucketState::REMOVED;
+      Insert( idt, new_wgt );
+      state[ idt ] = BucketState::UPDATED;
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void IntegerBucketQueue::ResetState( ) {
+    size_t size = state.size( );
+    for( size_t elm = 0; elm < size; ++elm ) {
+      state[ elm ] = BucketState::NOT_VISITED;
+    }
+  }
+
+}
+
+#endif
+
+#endif
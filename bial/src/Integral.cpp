@@ -17,17 +17,23 @@
 #endif
 #if defined ( BIAL_EXPLICIT_Integral ) || ( BIAL_IMPLICIT_BIN )
 
+#include "FilteringGaussian.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+
 namespace Bial {
 
   template< class D >
   Image< double > Integral::IntegralImage( const Image< D > &img ) {
     try {
-      Image< double > integral( img.Dim( ), img.PixelSize( ) );
-      Vector< size_t > window_size( 3, 1 );
-      for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
-        COMMENT( "Window greater coordinates in N-dimensional space.", 4 );
-        Vector< size_t > window_end = integral.Coordinates( pxl );
-        integral[ pxl ] = img[ pxl ] - Integral::WindowIntegralValue( integral, window_end, window_size );
+      Image< double > integral( img );
+      COMMENT( "Cumulative sums along each dimension, over the result of the previous ones.", 2 );
+      for( size_t dms = 0; dms < img.Dims( ); ++dms ) {
+        Filtering::FilterLines( integral, dms, [ ]( Vector< double > &line ) {
+            for( size_t pxl = 1; pxl < line.size( ); ++pxl ) {
+              line[ pxl ] += line[ pxl - 1 ];
+            }
+          } );
       }
       return( integral );
     }
@@ -49,6 +55,71 @@ namespace Bial {
     }
   }
 
+  Image< double > Integral::WindowSums( const Image< double > &integral, const Vector< size_t > &radius ) {
+    try {
+      size_t dims = integral.Dims( );
+      if( ( dims != 2 ) && ( dims != 3 ) ) {
+        std::string msg( BIAL_ERROR( "Only 2D and 3D images are supported. Given dimensions: " +
+                                     std::to_string( dims ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( radius.size( ) != dims ) {
+        std::string msg( BIAL_ERROR( "Image and radius dimensions do not match." ) );
+        throw( std::logic_error( msg ) );
+      }
+      size_t xsize = integral.size( 0 );
+      size_t ysize = integral.size( 1 );
+      size_t zsize = ( dims == 3 ) ? integral.size( 2 ) : 1;
+      size_t zradius = ( dims == 3 ) ? radius( 2 ) : 0;
+      size_t xysize = xsize * ysize;
+      const double *data = integral.data( );
+      Image< double > res( integral.Dim( ), integral.PixelSize( ) );
+      double *sum = res.data( );
+      COMMENT( "Integral value up to ( x, y, z ), inclusive. Coordinates are shifted by one, so that 0 stands "
+               << "before the image domain.", 2 );
+      auto value = [ data, xsize, xysize ]( size_t x, size_t y, size_t z ) -> double {
+        if( ( x == 0 ) || ( y == 0 ) || ( z == 0 ) ) {
+          return( 0.0 );
+        }
+        return( data[ ( x - 1 ) + ( y - 1 ) * xsize + ( z - 1 ) * xysize ] );
+      };
+      ThreadPool::ParallelFor( 0, zsize, 1, [ & ]( size_t first, size_t last ) {
+          for( size_t z = first; z < last; ++z ) {
+            size_t z0 = z - std::min( z, zradius );
+            size_t z1 = std::min( zsize, z + zradius + 1 );
+            for( size_t y = 0; y < ysize; ++y ) {
+              size_t y0 = y - std::min( y, radius( 1 ) );
+              size_t y1 = std::min( ysize, y + radius( 1 ) + 1 );
+              size_t pxl = y * xsize + z * xysize;
+              for( size_t x = 0; x < xsize; ++x, ++pxl ) {
+                size_t x0 = x - std::min( x, radius( 0 ) );
+                size_t x1 = std::min( xsize, x + radius( 0 ) + 1 );
+                sum[ pxl ] = value( x1, y1, z1 ) - value( x0, y1, z1 ) - value( x1, y0, z1 ) + value( x0, y0, z1 ) -
+                  value( x1, y1, z0 ) + value( x0, y1, z0 ) + value( x1, y0, z0 ) - value( x0, y0, z0 );
+              }
+            }
+          }
+        } );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
   double Integral::WindowIntegralValue( const Image< double > &integral, const Vector< size_t > &window_end,
                                         const Vector< size_t > &window_size ) {
     try {
@@ -0,0 +1,252 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Kd-tree for exact k-nearest neighbor search among feature vectors.
+ */
+
+#ifndef BIALKDTREE_C
+#define BIALKDTREE_C
+
+#include "KdTree.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_KdTree )
+#define BIAL_EXPLICIT_KdTree
+#endif
+
+#if defined ( BIAL_EXPLICIT_KdTree ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Feature.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Bial {
+
+  template< class D >
+  KdTree< D >::KdTree( const Feature< D > &feature, const DistanceKernel &kernel, size_t leaf_size ) try :
+    kernel( kernel ), features( feature.Features( ) ), leaf_size( std::max< size_t >( leaf_size, 1 ) ),
+    order( feature.Elements( ) ), point( feature.Elements( ) * feature.Features( ) ),
+    position( feature.Elements( ) ) {
+      if( !Supports( kernel.Type( ) ) ) {
+        std::string msg( BIAL_ERROR( "Distance function not supported by the kd-tree." ) );
+        throw( std::logic_error( msg ) );
+      }
+      size_t elements = feature.Elements( );
+      for( size_t elm = 0; elm < elements; ++elm ) {
+        order[ elm ] = elm;
+      }
+      if( elements > 0 ) {
+        COMMENT( "Building the nodes.", 1 );
+        Build( feature.data( ), 0, elements );
+      }
+      COMMENT( "Copying the feature vectors in tree order.", 1 );
+      for( size_t pos = 0; pos < elements; ++pos ) {
+        position[ order[ pos ] ] = pos;
+        std::copy( feature.data( ) + order[ pos ] * features, feature.data( ) + ( order[ pos ] + 1 ) * features,
+                   point.begin( ) + pos * features );
+      }
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D >
+  size_t KdTree< D >::Build( const D *data, size_t first, size_t last ) {
+    try {
+      size_t node = node_first.size( );
+      node_first.push_back( first );
+      node_last.push_back( last );
+      node_left.push_back( 0 );
+      node_right.push_back( 0 );
+      COMMENT( "Computing the bounding box of the node.", 3 );
+      size_t split = 0;
+      double spread = 0.0;
+      for( size_t ftr = 0; ftr < features; ++ftr ) {
+        double lower = std::numeric_limits< double >::max( );
+        double upper = std::numeric_limits< double >::lowest( );
+        for( size_t pos = first; pos < last; ++pos ) {
+          double val = static_cast< double >( data[ order[ pos ] * features + ftr ] );
+          lower = std::min( lower, val );
+          upper = std::max( upper, val );
+        }
+        node_lower.push_back( lower );
+        node_upper.push_back( upper );
+        if( upper - lower > spread ) {
+          spread = upper - lower;
+          split = ftr;
+        }
+      }
+      COMMENT( "Splitting at the median of the feature with largest spread. Nodes of equal elements are leaves.", 3 );
+      if( ( last - first > leaf_size ) && ( spread > 0.0 ) ) {
+        size_t middle = first + ( last - first ) / 2;
+        std::nth_element( order.begin( ) + first, order.begin( ) + middle, order.begin( ) + last,
+                          [ data, split, this ]( size_t elm, size_t other ) {
+                            return( data[ elm * features + split ] < data[ other * features + split ] );
+                          } );
+        size_t left = Build( data, first, middle );
+        size_t right = Build( data, middle, last );
+        node_left[ node ] = left;
+        node_right[ node ] = right;
+      }
+      return( node );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  double KdTree< D >::Bound( const D *query, size_t node ) const {
+    const double *lower = &node_lower[ node * features ];
+    const double *upper = &node_upper[ node * features ];
+    DistanceFunctionType type = kernel.Type( );
+    double bound = 0.0;
+    for( size_t ftr = 0; ftr < features; ++ftr ) {
+      double val = static_cast< double >( query[ ftr ] );
+      double gap = val < lower[ ftr ] ? lower[ ftr ] - val : ( val > upper[ ftr ] ? val - upper[ ftr ] : 0.0 );
+      if( type == DistanceFunctionType::ChessBoard ) {
+        bound = std::max( bound, gap );
+      }
+      else if( type == DistanceFunctionType::CityBlock ) {
+        bound += gap;
+      }
+      else {
+        bound += gap * gap;
+      }
+    }
+    return( type == DistanceFunctionType::Euclidean ? std::sqrt( bound ) : bound );
+  }
+
+  template< class D >
+  bool KdTree< D >::Supports( DistanceFunctionType type ) {
+    return( ( type == DistanceFunctionType::Euclidean ) || ( type == DistanceFunctionType::SquareEuclidean ) ||
+            ( type == DistanceFunctionType::CityBlock ) || ( type == DistanceFunctionType::ChessBoard ) );
+  }
+
+  template< class D >
+  size_t KdTree< D >::Neighbors( size_t src, size_t k, size_t *index, double *distance ) const {
+    try {
+      k = std::min( k, order.size( ) - 1 );
+      if( k == 0 ) {
+        return( 0 );
+      }
+      const D *query = &point[ position[ src ] * features ];
+      COMMENT( "Max-heap of the best candidates, ordered by distance and index, and stack of nodes to visit.", 4 );
+      std::vector< std::pair< double, size_t > > heap;
+      heap.reserve( k + 1 );
+      std::vector< std::pair< double, size_t > > stack( 1, std::make_pair( 0.0, static_cast< size_t >( 0 ) ) );
+      std::vector< double > leaf_distance( leaf_size );
+      COMMENT( "Nodes as far as the k-th candidate are still visited, as they may hold ties of smaller index. The "
+               << "relative tolerance covers the rounding of the bounds.", 4 );
+      const double tolerance = 1.0 + 1e-9;
+      while( !stack.empty( ) ) {
+        double bound = stack.back( ).first;
+        size_t node = stack.back( ).second;
+        stack.pop_back( );
+        if( ( heap.size( ) == k ) && ( bound > heap.front( ).first * tolerance ) ) {
+          continue;
+        }
+        if( node_left[ node ] == 0 ) {
+          size_t first = node_first[ node ];
+          size_t last = node_last[ node ];
+          leaf_distance.resize( last - first );
+          kernel.Distances( query, &point[ first * features ], last - first, features, features,
+                            leaf_distance.data( ) );
+          for( size_t pos = first; pos < last; ++pos ) {
+            if( order[ pos ] != src ) {
+              std::pair< double, size_t > candidate( leaf_distance[ pos - first ], order[ pos ] );
+              if( heap.size( ) < k ) {
+                heap.push_back( candidate );
+                std::push_heap( heap.begin( ), heap.end( ) );
+              }
+              else if( candidate < heap.front( ) ) {
+                std::pop_heap( heap.begin( ), heap.end( ) );
+                heap.back( ) = candidate;
+                std::push_heap( heap.begin( ), heap.end( ) );
+              }
+            }
+          }
+        }
+        else {
+          COMMENT( "Pushing the farthest child first, so that the nearest one is visited first.", 4 );
+          double left_bound = Bound( query, node_left[ node ] );
+          double right_bound = Bound( query, node_right[ node ] );
+          if( left_bound < right_bound ) {
+            stack.push_back( std::make_pair( right_bound, node_right[ node ] ) );
+            stack.push_back( std::make_pair( left_bound, node_left[ node ] ) );
+          }
+          else {
+            stack.push_back( std::make_pair( left_bound, node_left[ node ] ) );
+            stack.push_back( std::make_pair( right_bound, node_right[ node ] ) );
+          }
+        }
+      }
+      std::sort_heap( heap.begin( ), heap.end( ) );
+      for( size_t knn = 0; knn < k; ++knn ) {
+        distance[ knn ] = heap[ knn ].first;
+        index[ knn ] = heap[ knn ].second;
+      }
+      return( k );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_KdTree
+
+  template class KdTree< int >;
+  template class KdTree< llint >;
+  template class KdTree< float >;
+  template class KdTree< double >;
+
+#endif
+
+}
+
+#endif
+
+#endif
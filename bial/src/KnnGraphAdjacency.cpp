@@ -19,14 +19,19 @@
 #if defined ( BIAL_EXPLICIT_KnnGraphAdjacency ) || ( BIAL_IMPLICIT_BIN )
 
 #include "DFIDE.hpp"
+#include "DistanceKernel.hpp"
 #include "Feature.hpp"
+#include "KdTree.hpp"
+#include "NNDescent.hpp"
 #include "Sample.hpp"
+#include "ThreadPool.hpp"
+#include <memory>
 
 namespace Bial {
 
   template< class D >
-  void KnnGraphAdjacency::Initialize( const Feature< D > &feature, const Sample &sample, float scl_min, 
-                                      float scl_max ) {
+  void KnnGraphAdjacency::Initialize( const Feature< D > &feature, const Sample &sample, float scl_min,
+                                      float scl_max, const DistanceKernel &kernel, KnnSearchType search ) {
     try {
       COMMENT( "Computing the number of neighbors based on the given scale.", 1 );
       EstimateK( feature, scl_min, scl_max );
@@ -45,44 +50,87 @@ namespace Bial {
       const Feature< D > &used_feature = elements < feature.Elements( ) ? subfeature : feature;
       COMMENT( "Used feature elements: " << used_feature.Elements( ) << ", features: " << used_feature.Features( ), 1 );
       COMMENT( "Features: " << used_feature, 3 );
-      COMMENT( "Computing the adjacent samples.", 1 );
-      for( size_t src = 0; src < elements; ++src ) {
-        COMMENT( "Setting repeated samples to zero.", 3 );
-        size_t equal_samples = std::min( sample.size( src ) - 1, kmax );
-        COMMENT( "equal_samples: " << equal_samples << ", kmax: " << kmax, 3 );
-        for( size_t knn = 0; knn < equal_samples; ++knn ) {
-          arc_weight( src, knn ) = 0.0;
-          arc( src, knn ) = src;
+      COMMENT( "Choosing the search of the nearest neighbors.", 1 );
+      if( !KdTree< D >::Supports( kernel.Type( ) ) ) {
+        search = KnnSearchType::Exhaustive;
+      }
+      else if( search == KnnSearchType::Automatic ) {
+        search = ( used_feature.Features( ) <= KDTREE_MAX_FEATURES ) && ( elements >= KDTREE_MIN_SAMPLES ) ?
+          KnnSearchType::KdTree : KnnSearchType::Exhaustive;
+      }
+      if( search != KnnSearchType::Exhaustive ) {
+        COMMENT( "Computing the adjacent samples by " << ( search == KnnSearchType::KdTree ? "kd-tree" :
+                                                           "NN-Descent" ) << " search.", 1 );
+        std::unique_ptr< KdTree< D > > tree;
+        std::unique_ptr< NNDescent< D > > descent;
+        if( search == KnnSearchType::KdTree ) {
+          tree.reset( new KdTree< D >( used_feature, kernel ) );
         }
-        for( size_t knn = equal_samples; knn < kmax; ++knn ) {
-          arc_weight( src, knn ) = std::numeric_limits< double >::max( );
+        else {
+          descent.reset( new NNDescent< D >( used_feature, kmax, kernel ) );
+          descent->Run( );
         }
-        COMMENT( "Checking if more arcs are necessary as there are not enough equal features.", 4 );
-        if( equal_samples < kmax ) {
-          COMMENT( "Compute and sort the nearst kmax of each node.", 4 );
-          for( size_t tgt = 0; tgt < elements; ++tgt ) {
-            if( tgt != src ) {
-              COMMENT( "src: " << src << ", tgt: " << tgt << ", dms: " << used_feature.Features( ), 4 );
-              double dist = DFIDE::Distance( used_feature, src * used_feature.Features( ),
-                                             tgt * used_feature.Features( ), used_feature.Features( ) );
-              /*
-               * double dist = ( *BialDistanceFunction )( &used_feature( src, 0 ), &used_feature( tgt, 0 ),
-               * used_feature.Features( ) );
-               */
-              size_t index = tgt;
+        ThreadPool::ParallelFor( 0, elements, 16, [ & ]( size_t first, size_t last ) {
+            Vector< size_t > index( kmax );
+            Vector< double > distance( kmax );
+            for( size_t src = first; src < last; ++src ) {
+              COMMENT( "Setting repeated samples to zero.", 3 );
+              size_t equal_samples = std::min( sample.size( src ) - 1, kmax );
+              for( size_t knn = 0; knn < equal_samples; ++knn ) {
+                arc_weight( src, knn ) = 0.0;
+                arc( src, knn ) = src;
+              }
               for( size_t knn = equal_samples; knn < kmax; ++knn ) {
-                if( dist < arc_weight( src, knn ) ) {
-                  std::swap( dist, arc_weight( src, knn ) );
-                  std::swap( index, arc( src, knn ) );
-                  if( dist == std::numeric_limits< double >::max( ) ) {
-                    break;
+                arc_weight( src, knn ) = std::numeric_limits< double >::max( );
+              }
+              size_t found = search == KnnSearchType::KdTree ?
+                tree->Neighbors( src, kmax - equal_samples, index.data( ), distance.data( ) ) :
+                std::min( descent->Neighbors( src, index.data( ), distance.data( ) ), kmax - equal_samples );
+              for( size_t knn = 0; knn < found; ++knn ) {
+                arc_weight( src, equal_samples + knn ) = distance[ knn ];
+                arc( src, equal_samples + knn ) = index[ knn ];
+              }
+            }
+          } );
+        COMMENT( "Graph arcs: " << arc, 3 );
+        COMMENT( "Arc weights: " << arc_weight, 3 );
+        return;
+      }
+      COMMENT( "Computing the adjacent samples. Distances from each sample to all samples are computed in one "
+               << "batch.", 1 );
+      ThreadPool::ParallelFor( 0, elements, 16, [ & ]( size_t first, size_t last ) {
+          Vector< double > distance( elements );
+          for( size_t src = first; src < last; ++src ) {
+            COMMENT( "Setting repeated samples to zero.", 3 );
+            size_t equal_samples = std::min( sample.size( src ) - 1, kmax );
+            COMMENT( "equal_samples: " << equal_samples << ", kmax: " << kmax, 3 );
+            for( size_t knn = 0; knn < equal_samples; ++knn ) {
+              arc_weight( src, knn ) = 0.0;
+              arc( src, knn ) = src;
+            }
+            for( size_t knn = equal_samples; knn < kmax; ++knn ) {
+              arc_weight( src, knn ) = std::numeric_limits< double >::max( );
+            }
+            COMMENT( "Checking if more arcs are necessary as there are not enough equal features.", 4 );
+            if( equal_samples < kmax ) {
+              COMMENT( "Compute and sort the nearst kmax of each node.", 4 );
+              kernel.Distances( used_feature, src, 0, elements, distance.data( ) );
+              COMMENT( "Ties are kept in increasing order of index, as in the kd-tree search.", 4 );
+              for( size_t tgt = 0; tgt < elements; ++tgt ) {
+                double dist = distance[ tgt ];
+                if( ( tgt != src ) && ( dist < arc_weight( src, kmax - 1 ) ) ) {
+                  size_t knn = kmax - 1;
+                  for( ; ( knn > equal_samples ) && ( dist < arc_weight( src, knn - 1 ) ); --knn ) {
+                    arc_weight( src, knn ) = arc_weight( src, knn - 1 );
+                    arc( src, knn ) = arc( src, knn - 1 );
                   }
+                  arc_weight( src, knn ) = dist;
+                  arc( src, knn ) = tgt;
                 }
               }
             }
           }
-        }
-      }
+        } );
       COMMENT( "Graph arcs: " << arc, 3 );
       COMMENT( "Arc weights: " << arc_weight, 3 );
     }
@@ -327,23 +375,29 @@ namespace Bial {
 
   /* Initializing Graphs Maximum samples. */
   const size_t KnnGraphAdjacency::MAX_SAMPLES = 10000;
+  const size_t KnnGraphAdjacency::KDTREE_MAX_FEATURES = 16;
+  const size_t KnnGraphAdjacency::KDTREE_MIN_SAMPLES = 1024;
 
 
 #ifdef BIAL_EXPLICIT_KnnGraphAdjacency
 
   template class GraphAdjacency< KnnGraphAdjacency >;
 
-  template void KnnGraphAdjacency::Initialize( const Feature< int > &feature, const Sample &sample, float scl_min, 
-                                               float scl_max );
+  template void KnnGraphAdjacency::Initialize( const Feature< int > &feature, const Sample &sample, float scl_min,
+                                               float scl_max, const DistanceKernel &kernel,
+                                               KnnSearchType search );
   template void KnnGraphAdjacency::EstimateK( const Feature< int > &feature, float scl_min, float scl_max );
   template void KnnGraphAdjacency::Initialize( const Feature< llint > &feature, const Sample &sample, float scl_min,
-                                               float scl_max );
+                                               float scl_max, const DistanceKernel &kernel,
+                                               KnnSearchType search );
   template void KnnGraphAdjacency::EstimateK( const Feature< llint > &feature, float scl_min, float scl_max );
   template void KnnGraphAdjacency::Initialize( const Feature< float > &feature, const Sample &sample, float scl_min,
-                                               float scl_max );
+                                               float scl_max, const DistanceKernel &kernel,
+                                               KnnSearchType search );
   template void KnnGraphAdjacency::EstimateK( const Feature< float > &feature, float scl_min, float scl_max );
   template void KnnGraphAdjacency::Initialize( const Feature< double > &feature, const Sample &sample, float scl_min,
-                                               float scl_max );
+                                               float scl_max, const DistanceKernel &kernel,
+                                               KnnSearchType search );
   template void KnnGraphAdjacency::EstimateK( const Feature< double > &feature, float scl_min, float scl_max );
 
 #endif
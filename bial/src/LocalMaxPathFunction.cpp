@@ -126,7 +126,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  inline bool LocalMaxPathFunction< C, D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  inline bool LocalMaxPathFunction< C, D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       //return( this->value->operator()( adj_index ) < handicap( adj_index ) );
       return( ( adj_state == BucketState::NOT_VISITED ) || ( adj_state == BucketState::INSERTED ) );
@@ -150,7 +150,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  bool LocalMaxPathFunction< C, D >::Propagate( int index, int adj_index ) {
+  bool LocalMaxPathFunction< C, D >::Propagate( size_t index, size_t adj_index ) {
     try {
       // D src_value = this->value->operator()( adj_index );
       // D arc_weight = handicap( adj_index );
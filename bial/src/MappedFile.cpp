@@ -0,0 +1,184 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Read-only memory mapping of a whole file.
+ */
+
+#ifndef BIALMAPPEDFILE_C
+#define BIALMAPPEDFILE_C
+
+#include "MappedFile.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_MappedFile )
+#define BIAL_EXPLICIT_MappedFile
+#endif
+
+#if defined ( BIAL_EXPLICIT_MappedFile ) || ( BIAL_IMPLICIT_BIN )
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Bial {
+
+  MappedFile::MappedFile( const std::string &filename ) try : data( nullptr ), bytes( 0 ), copied( false ) {
+#ifdef _WIN32
+    COMMENT( "No mmap. Reading the whole file.", 2 );
+    std::ifstream file( filename, std::ios::binary | std::ios::ate );
+    if( !file.is_open( ) ) {
+      std::string msg( BIAL_ERROR( "Could not open file " + filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    bytes = static_cast< size_t >( file.tellg( ) );
+    copied = true;
+    if( bytes > 0 ) {
+      data = new char[ bytes ];
+      file.seekg( 0 );
+      if( !file.read( data, bytes ) ) {
+        Close( );
+        std::string msg( BIAL_ERROR( "Could not read file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+    }
+#else
+    int fd = open( filename.c_str( ), O_RDONLY );
+    if( fd < 0 ) {
+      std::string msg( BIAL_ERROR( "Could not open file " + filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    struct stat status;
+    if( fstat( fd, &status ) != 0 ) {
+      close( fd );
+      std::string msg( BIAL_ERROR( "Could not get size of file " + filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    bytes = static_cast< size_t >( status.st_size );
+    if( bytes > 0 ) {
+      COMMENT( "Private mapping: pages written are copied, and the file is never modified.", 2 );
+      void *ptr = mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+      if( ptr == MAP_FAILED ) {
+        close( fd );
+        bytes = 0;
+        std::string msg( BIAL_ERROR( "Could not map file " + filename + "." ) );
+        throw( std::ios_base::failure( msg ) );
+      }
+      data = static_cast< char* >( ptr );
+    }
+    COMMENT( "The mapping stays valid after closing the descriptor.", 2 );
+    close( fd );
+#endif
+  }
+  catch( std::ios_base::failure &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/mapping file." ) );
+    throw( std::ios_base::failure( msg ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  MappedFile::MappedFile( const std::vector< char > &buffer ) try
+    : data( nullptr ), bytes( buffer.size( ) ), copied( true ) {
+    if( bytes > 0 ) {
+      data = new char[ bytes ];
+      std::memcpy( data, buffer.data( ), bytes );
+    }
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+
+  MappedFile::MappedFile( MappedFile &&other ) noexcept
+    : data( other.data ), bytes( other.bytes ), copied( other.copied ) {
+    other.data = nullptr;
+    other.bytes = 0;
+    other.copied = false;
+  }
+
+  MappedFile &MappedFile::operator=( MappedFile &&other ) noexcept {
+    if( this != &other ) {
+      Close( );
+      data = other.data;
+      bytes = other.bytes;
+      copied = other.copied;
+      other.data = nullptr;
+      other.bytes = 0;
+      other.copied = false;
+    }
+    return( *this );
+  }
+
+  MappedFile::~MappedFile( ) {
+    Close( );
+  }
+
+  void MappedFile::Close( ) noexcept {
+    if( data != nullptr ) {
+      if( copied ) {
+        delete[] data;
+      }
+#ifndef _WIN32
+      else {
+        munmap( data, bytes );
+      }
+#endif
+    }
+    data = nullptr;
+    bytes = 0;
+    copied = false;
+  }
+
+  char *MappedFile::Data( ) {
+    return( data );
+  }
+
+  const char *MappedFile::Data( ) const {
+    return( data );
+  }
+
+  size_t MappedFile::Size( ) const {
+    return( bytes );
+  }
+
+  void MappedFile::WillNeed( size_t offset, size_t length ) const {
+#if !defined( _WIN32 ) && defined( MADV_WILLNEED )
+    if( ( copied ) || ( offset >= bytes ) ) {
+      return;
+    }
+    COMMENT( "madvise requires a page aligned address.", 4 );
+    size_t page = static_cast< size_t >( sysconf( _SC_PAGESIZE ) );
+    size_t first = offset / page * page;
+    length = std::min( length, bytes - offset ) + ( offset - first );
+    madvise( data + first, length, MADV_SEQUENTIAL );
+    madvise( data + first, length, MADV_WILLNEED );
+#endif
+  }
+
+}
+
+#endif
+
+#endif
@@ -19,6 +19,7 @@
 #if defined ( BIAL_EXPLICIT_MatrixDeterminant ) || ( BIAL_IMPLICIT_BIN )
 
 #include "Matrix.hpp"
+#include "MatrixSolve.hpp"
 
 namespace Bial {
 
@@ -50,39 +51,14 @@ namespace Bial {
                 mat( 2, 0 ) * mat( 0, 1 ) * mat( 1, 2 ) -
                 mat( 2, 0 ) * mat( 1, 1 ) * mat( 0, 2 ) );
       }
-      COMMENT( "For more than three dimensions.", 0 );
-      COMMENT( "Setting minor matrix.", 0 );
-      size_t minor_dim_0 = dim_0 - 1;
-      Matrix< D > minor_mat( minor_dim_0, minor_dim_0 );
-      for( size_t i = 0; i < minor_dim_0; ++i ) {
-        for( size_t j = 0; j < minor_dim_0; ++j ) {
-          minor_mat( i, j ) = mat( i + 1, j + 1 );
-        }
+      COMMENT( "For more than three dimensions, product of the pivots of the LU decomposition.", 0 );
+      Matrix< double > lu;
+      Vector< size_t > pivot;
+      double det = MatrixOp::LU( mat, lu, pivot );
+      for( size_t i = 0; ( i < dim_0 ) && ( det != 0.0 ); ++i ) {
+        det *= lu( i, i );
       }
-      COMMENT( "Computing determinant.", 0 );
-      double det = 0.0;
-      for( size_t i = 0; i < dim_0; ++i ) {
-        for( size_t j = 0; j < dim_0; ++j ) {
-          det += pow( -1.0, i + j + 2.0 ) * mat( j, i ) * MatrixOp::Determinant( minor_mat );
-          if( j < minor_dim_0 ) {
-            for( size_t k = 0; k < minor_dim_0; k++ ) {
-              if( k < i )
-                minor_mat( j, k ) = mat( j, k );
-              else
-                minor_mat( j, k ) = mat( j, k + 1 );
-            }
-          }
-        }
-        for( size_t k = 0; k < minor_dim_0; ++k ) {
-          for( size_t l = 0; l < minor_dim_0; ++l ) {
-            if( k <= i ) 
-              minor_mat( l, k ) = mat( l + 1, k );
-            else
-              minor_mat( l, k ) = mat( l + 1, k + 1 );
-          }
-        }
-      }
-      return( det / dim_0 );
+      return( det );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -21,6 +21,7 @@
 #include "Matrix.hpp"
 #include "MatrixTranspose.hpp"
 #include "MatrixDeterminant.hpp"
+#include "MatrixSolve.hpp"
 
 namespace Bial {
 
@@ -108,98 +109,32 @@ namespace Bial {
         std::string msg( BIAL_ERROR( "Matrix must be square." ) );
         throw( std::logic_error( msg ) );
       }
-      COMMENT( "Avoiding matrices with 0 in any eigenvector element.", 2 );
-      for( size_t i = 0; i < dim_0; ++i ) {
-        if( mat( i, i ) == 0.0 ) {
-          MatrixOp::Inverse3( mat );
-          return;
-        }
-      }
-      COMMENT( "Normalizing row 0.", 2 );
-      for( size_t i = 1; i < dim_0; ++i ) {
-        mat( i ) /= mat( 0 );
-      }
-      for( size_t i = 1; i < dim_0; ++i ) {
-        COMMENT( "Do a column of L", 3 );
-        for( size_t j = i; j < dim_0; ++j ) {
-          D sum = 0.0;
-          for( size_t k = 0; k < i; ++k ) {
-            sum += mat( j * dim_0 + k ) * mat( k * dim_0 + i );
-          }
-          mat( j * dim_0 + i ) -= sum;
-        }
-        if( i == dim_0 - 1 ) {
-          continue;
-        }
-        COMMENT( "Do a row of U.", 3 );
-        for( size_t j = i + 1; j < dim_0; ++j ) {
-          D sum = 0.0;
-          for( size_t k = 0; k < i; ++k ) {
-            sum += mat( i * dim_0 + k ) * mat( k * dim_0 + j );
-          }
-          mat( i * dim_0 + j ) = ( mat( i * dim_0 + j ) - sum ) /
-            mat( i * dim_0 + i );
-        }
-      }
-      COMMENT( "Invert L.", 2 );
-      for( size_t i = 0; i < dim_0; ++i ) {
-        for( size_t j = i; j < dim_0; ++j ) {
-          D x = 1.0;
-          if( i != j ) {
-            x = 0.0;
-            for( size_t k = i; k < j; k++ ) {
-              x -= mat( j * dim_0 + k ) * mat( k * dim_0 + i );
-            }
-          }
-          mat( j * dim_0 + i ) = x / mat( j * dim_0 + j );
-        }
+      COMMENT( "LU decomposition with partial pivoting.", 2 );
+      Matrix< double > lu;
+      Vector< size_t > pivot;
+      if( MatrixOp::LU( const_cast< const Matrix< D > & >( mat ), lu, pivot ) == 0 ) {
+        std::string msg( BIAL_ERROR( "Singular matrix." ) );
+        throw( std::logic_error( msg ) );
       }
-      COMMENT( "Invert U.", 2 );
+      COMMENT( "Solving for the columns of the identity.", 2 );
+      Matrix< double > res( dim_0, dim_0 );
       for( size_t i = 0; i < dim_0; ++i ) {
-        for( size_t j = i; j < dim_0; ++j ) {
-          if( i == j ) {
-            continue;
-          }
-          D sum = 0.0;
-          for( size_t k = i; k < j; ++k ) {
-            if( i == k ) {
-              sum += mat( k * dim_0 + j );
-            }
-            else {
-              sum += mat( k * dim_0 + j ) * mat( i * dim_0 + k );
-            }
-          }
-          mat( i * dim_0 + j ) = -sum;
-        }
+        res( i, i ) = 1.0;
       }
-      COMMENT( "Invert the other elements.", 2 );
-      for( size_t i = 0; i < dim_0; ++i ) {
-        for( size_t j = 0; j < dim_0; ++j ) {
-          D sum = 0.0;
-          if( i > j ) {
-            for( size_t k = i; k < dim_0; ++k ) {
-              if( j == k ) {
-                sum += mat( k * dim_0 + i );
-              }
-              else {
-                sum += mat( j * dim_0 + k ) * mat( k * dim_0 + i );
-              }
-            }
-          }
-          else {
-            for( size_t k = j; k < dim_0; ++k ) {
-              if( j == k ) {
-                sum += mat( k * dim_0 + i );
-              }
-              else {
-                sum += mat( j * dim_0 + k ) * mat( k * dim_0 + i );
-              }
-            }
-          }
-          mat( j * dim_0 + i ) = sum;
-        }
+      MatrixOp::LUSolve( lu, pivot, res );
+      size_t size = mat.size( );
+      for( size_t i = 0; i < size; ++i ) {
+        mat[ i ] = static_cast< D >( res[ i ] );
       }
     }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
     catch( const std::out_of_range &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
       throw( std::out_of_range( msg ) );
@@ -0,0 +1,529 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Matrix multiplication kernels for row-major data.
+ */
+
+#ifndef BIALMATRIXMULTIPLY_C
+#define BIALMATRIXMULTIPLY_C
+
+#include "MatrixMultiply.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_MatrixMultiply )
+#define BIAL_EXPLICIT_MatrixMultiply
+#endif
+
+#if defined ( BIAL_EXPLICIT_MatrixMultiply ) || ( BIAL_IMPLICIT_BIN )
+
+#include "DistanceKernel.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <vector>
+
+#if ( defined ( __GNUC__ ) || defined ( __clang__ ) ) && ( defined ( __x86_64__ ) || defined ( __i386__ ) )
+#define BIAL_MATRIX_MULTIPLY_AVX
+#include <immintrin.h>
+#endif
+
+namespace Bial {
+
+  const size_t MatrixMultiply::MR;
+  const size_t MatrixMultiply::MAX_NR;
+  const size_t MatrixMultiply::MC;
+  const size_t MatrixMultiply::KC;
+  const size_t MatrixMultiply::NC;
+  const size_t MatrixMultiply::MIN_TILED;
+  const size_t MatrixMultiply::MIN_PARALLEL;
+
+  template< class D, size_t NR >
+  void MatrixMultiply::KernelScalar( size_t kc, const D *pa, const D *pb, D *tile ) {
+    D acc[ MR * NR ];
+    std::fill( acc, acc + MR * NR, static_cast< D >( 0 ) );
+    for( size_t k = 0; k < kc; ++k, pa += MR, pb += NR ) {
+      for( size_t row = 0; row < MR; ++row ) {
+        D val = pa[ row ];
+        for( size_t col = 0; col < NR; ++col ) {
+          acc[ row * NR + col ] += val * pb[ col ];
+        }
+      }
+    }
+    std::copy( acc, acc + MR * NR, tile );
+  }
+
+#ifdef BIAL_MATRIX_MULTIPLY_AVX
+
+  /* Horizontal sums of 256-bit registers, in the same order for all kernels. */
+  __attribute__( ( target( "avx2" ) ) )
+  static inline float MatrixMultiplySum( __m256 vec ) {
+    float lane[ 8 ];
+    _mm256_storeu_ps( lane, vec );
+    return( ( ( lane[ 0 ] + lane[ 1 ] ) + ( lane[ 2 ] + lane[ 3 ] ) ) +
+            ( ( lane[ 4 ] + lane[ 5 ] ) + ( lane[ 6 ] + lane[ 7 ] ) ) );
+  }
+
+  __attribute__( ( target( "avx2" ) ) )
+  static inline double MatrixMultiplySum( __m256d vec ) {
+    double lane[ 4 ];
+    _mm256_storeu_pd( lane, vec );
+    return( ( lane[ 0 ] + lane[ 1 ] ) + ( lane[ 2 ] + lane[ 3 ] ) );
+  }
+
+  __attribute__( ( target( "avx2,fma" ) ) )
+  void MatrixMultiply::KernelAVX2( size_t kc, const float *pa, const float *pb, float *tile ) {
+    __m256 acc0 = _mm256_setzero_ps( ), acc1 = _mm256_setzero_ps( ), acc2 = _mm256_setzero_ps( );
+    __m256 acc3 = _mm256_setzero_ps( ), acc4 = _mm256_setzero_ps( ), acc5 = _mm256_setzero_ps( );
+    __m256 acc6 = _mm256_setzero_ps( ), acc7 = _mm256_setzero_ps( ), acc8 = _mm256_setzero_ps( );
+    __m256 acc9 = _mm256_setzero_ps( ), acc10 = _mm256_setzero_ps( ), acc11 = _mm256_setzero_ps( );
+    for( size_t k = 0; k < kc; ++k, pa += MR, pb += 16 ) {
+      __m256 b0 = _mm256_loadu_ps( pb );
+      __m256 b1 = _mm256_loadu_ps( pb + 8 );
+      __m256 val = _mm256_broadcast_ss( pa );
+      acc0 = _mm256_fmadd_ps( val, b0, acc0 );
+      acc1 = _mm256_fmadd_ps( val, b1, acc1 );
+      val = _mm256_broadcast_ss( pa + 1 );
+      acc2 = _mm256_fmadd_ps( val, b0, acc2 );
+      acc3 = _mm256_fmadd_ps( val, b1, acc3 );
+      val = _mm256_broadcast_ss( pa + 2 );
+      acc4 = _mm256_fmadd_ps( val, b0, acc4 );
+      acc5 = _mm256_fmadd_ps( val, b1, acc5 );
+      val = _mm256_broadcast_ss( pa + 3 );
+      acc6 = _mm256_fmadd_ps( val, b0, acc6 );
+      acc7 = _mm256_fmadd_ps( val, b1, acc7 );
+      val = _mm256_broadcast_ss( pa + 4 );
+      acc8 = _mm256_fmadd_ps( val, b0, acc8 );
+      acc9 = _mm256_fmadd_ps( val, b1, acc9 );
+      val = _mm256_broadcast_ss( pa + 5 );
+      acc10 = _mm256_fmadd_ps( val, b0, acc10 );
+      acc11 = _mm256_fmadd_ps( val, b1, acc11 );
+    }
+    _mm256_storeu_ps( tile, acc0 );
+    _mm256_storeu_ps( tile + 8, acc1 );
+    _mm256_storeu_ps( tile + 16, acc2 );
+    _mm256_storeu_ps( tile + 24, acc3 );
+    _mm256_storeu_ps( tile + 32, acc4 );
+    _mm256_storeu_ps( tile + 40, acc5 );
+    _mm256_storeu_ps( tile + 48, acc6 );
+    _mm256_storeu_ps( tile + 56, acc7 );
+    _mm256_storeu_ps( tile + 64, acc8 );
+    _mm256_storeu_ps( tile + 72, acc9 );
+    _mm256_storeu_ps( tile + 80, acc10 );
+    _mm256_storeu_ps( tile + 88, acc11 );
+  }
+
+  __attribute__( ( target( "avx2,fma" ) ) )
+  void MatrixMultiply::KernelAVX2( size_t kc, const double *pa, const double *pb, double *tile ) {
+    __m256d acc0 = _mm256_setzero_pd( ), acc1 = _mm256_setzero_pd( ), acc2 = _mm256_setzero_pd( );
+    __m256d acc3 = _mm256_setzero_pd( ), acc4 = _mm256_setzero_pd( ), acc5 = _mm256_setzero_pd( );
+    __m256d acc6 = _mm256_setzero_pd( ), acc7 = _mm256_setzero_pd( ), acc8 = _mm256_setzero_pd( );
+    __m256d acc9 = _mm256_setzero_pd( ), acc10 = _mm256_setzero_pd( ), acc11 = _mm256_setzero_pd( );
+    for( size_t k = 0; k < kc; ++k, pa += MR, pb += 8 ) {
+      __m256d b0 = _mm256_loadu_pd( pb );
+      __m256d b1 = _mm256_loadu_pd( pb + 4 );
+      __m256d val = _mm256_broadcast_sd( pa );
+      acc0 = _mm256_fmadd_pd( val, b0, acc0 );
+      acc1 = _mm256_fmadd_pd( val, b1, acc1 );
+      val = _mm256_broadcast_sd( pa + 1 );
+      acc2 = _mm256_fmadd_pd( val, b0, acc2 );
+      acc3 = _mm256_fmadd_pd( val, b1, acc3 );
+      val = _mm256_broadcast_sd( pa + 2 );
+      acc4 = _mm256_fmadd_pd( val, b0, acc4 );
+      acc5 = _mm256_fmadd_pd( val, b1, acc5 );
+      val = _mm256_broadcast_sd( pa + 3 );
+      acc6 = _mm256_fmadd_pd( val, b0, acc6 );
+      acc7 = _mm256_fmadd_pd( val, b1, acc7 );
+      val = _mm256_broadcast_sd( pa + 4 );
+      acc8 = _mm256_fmadd_pd( val, b0, acc8 );
+      acc9 = _mm256_fmadd_pd( val, b1, acc9 );
+      val = _mm256_broadcast_sd( pa + 5 );
+      acc10 = _mm256_fmadd_pd( val, b0, acc10 );
+      acc11 = _mm256_fmadd_pd( val, b1, acc11 );
+    }
+    _mm256_storeu_pd( tile, acc0 );
+    _mm256_storeu_pd( tile + 4, acc1 );
+    _mm256_storeu_pd( tile + 8, acc2 );
+    _mm256_storeu_pd( tile + 12, acc3 );
+    _mm256_storeu_pd( tile + 16, acc4 );
+    _mm256_storeu_pd( tile + 20, acc5 );
+    _mm256_storeu_pd( tile + 24, acc6 );
+    _mm256_storeu_pd( tile + 28, acc7 );
+    _mm256_storeu_pd( tile + 32, acc8 );
+    _mm256_storeu_pd( tile + 36, acc9 );
+    _mm256_storeu_pd( tile + 40, acc10 );
+    _mm256_storeu_pd( tile + 44, acc11 );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) )
+  void MatrixMultiply::KernelAVX512( size_t kc, const float *pa, const float *pb, float *tile ) {
+    __m512 acc0 = _mm512_setzero_ps( ), acc1 = _mm512_setzero_ps( ), acc2 = _mm512_setzero_ps( );
+    __m512 acc3 = _mm512_setzero_ps( ), acc4 = _mm512_setzero_ps( ), acc5 = _mm512_setzero_ps( );
+    __m512 acc6 = _mm512_setzero_ps( ), acc7 = _mm512_setzero_ps( ), acc8 = _mm512_setzero_ps( );
+    __m512 acc9 = _mm512_setzero_ps( ), acc10 = _mm512_setzero_ps( ), acc11 = _mm512_setzero_ps( );
+    for( size_t k = 0; k < kc; ++k, pa += MR, pb += 32 ) {
+      __m512 b0 = _mm512_loadu_ps( pb );
+      __m512 b1 = _mm512_loadu_ps( pb + 16 );
+      __m512 val = _mm512_set1_ps( pa[ 0 ] );
+      acc0 = _mm512_fmadd_ps( val, b0, acc0 );
+      acc1 = _mm512_fmadd_ps( val, b1, acc1 );
+      val = _mm512_set1_ps( pa[ 1 ] );
+      acc2 = _mm512_fmadd_ps( val, b0, acc2 );
+      acc3 = _mm512_fmadd_ps( val, b1, acc3 );
+      val = _mm512_set1_ps( pa[ 2 ] );
+      acc4 = _mm512_fmadd_ps( val, b0, acc4 );
+      acc5 = _mm512_fmadd_ps( val, b1, acc5 );
+      val = _mm512_set1_ps( pa[ 3 ] );
+      acc6 = _mm512_fmadd_ps( val, b0, acc6 );
+      acc7 = _mm512_fmadd_ps( val, b1, acc7 );
+      val = _mm512_set1_ps( pa[ 4 ] );
+      acc8 = _mm512_fmadd_ps( val, b0, acc8 );
+      acc9 = _mm512_fmadd_ps( val, b1, acc9 );
+      val = _mm512_set1_ps( pa[ 5 ] );
+      acc10 = _mm512_fmadd_ps( val, b0, acc10 );
+      acc11 = _mm512_fmadd_ps( val, b1, acc11 );
+    }
+    _mm512_storeu_ps( tile, acc0 );
+    _mm512_storeu_ps( tile + 16, acc1 );
+    _mm512_storeu_ps( tile + 32, acc2 );
+    _mm512_storeu_ps( tile + 48, acc3 );
+    _mm512_storeu_ps( tile + 64, acc4 );
+    _mm512_storeu_ps( tile + 80, acc5 );
+    _mm512_storeu_ps( tile + 96, acc6 );
+    _mm512_storeu_ps( tile + 112, acc7 );
+    _mm512_storeu_ps( tile + 128, acc8 );
+    _mm512_storeu_ps( tile + 144, acc9 );
+    _mm512_storeu_ps( tile + 160, acc10 );
+    _mm512_storeu_ps( tile + 176, acc11 );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) )
+  void MatrixMultiply::KernelAVX512( size_t kc, const double *pa, const double *pb, double *tile ) {
+    __m512d acc0 = _mm512_setzero_pd( ), acc1 = _mm512_setzero_pd( ), acc2 = _mm512_setzero_pd( );
+    __m512d acc3 = _mm512_setzero_pd( ), acc4 = _mm512_setzero_pd( ), acc5 = _mm512_setzero_pd( );
+    __m512d acc6 = _mm512_setzero_pd( ), acc7 = _mm512_setzero_pd( ), acc8 = _mm512_setzero_pd( );
+    __m512d acc9 = _mm512_setzero_pd( ), acc10 = _mm512_setzero_pd( ), acc11 = _mm512_setzero_pd( );
+    for( size_t k = 0; k < kc; ++k, pa += MR, pb += 16 ) {
+      __m512d b0 = _mm512_loadu_pd( pb );
+      __m512d b1 = _mm512_loadu_pd( pb + 8 );
+      __m512d val = _mm512_set1_pd( pa[ 0 ] );
+      acc0 = _mm512_fmadd_pd( val, b0, acc0 );
+      acc1 = _mm512_fmadd_pd( val, b1, acc1 );
+      val = _mm512_set1_pd( pa[ 1 ] );
+      acc2 = _mm512_fmadd_pd( val, b0, acc2 );
+      acc3 = _mm512_fmadd_pd( val, b1, acc3 );
+      val = _mm512_set1_pd( pa[ 2 ] );
+      acc4 = _mm512_fmadd_pd( val, b0, acc4 );
+      acc5 = _mm512_fmadd_pd( val, b1, acc5 );
+      val = _mm512_set1_pd( pa[ 3 ] );
+      acc6 = _mm512_fmadd_pd( val, b0, acc6 );
+      acc7 = _mm512_fmadd_pd( val, b1, acc7 );
+      val = _mm512_set1_pd( pa[ 4 ] );
+      acc8 = _mm512_fmadd_pd( val, b0, acc8 );
+      acc9 = _mm512_fmadd_pd( val, b1, acc9 );
+      val = _mm512_set1_pd( pa[ 5 ] );
+      acc10 = _mm512_fmadd_pd( val, b0, acc10 );
+      acc11 = _mm512_fmadd_pd( val, b1, acc11 );
+    }
+    _mm512_storeu_pd( tile, acc0 );
+    _mm512_storeu_pd( tile + 8, acc1 );
+    _mm512_storeu_pd( tile + 16, acc2 );
+    _mm512_storeu_pd( tile + 24, acc3 );
+    _mm512_storeu_pd( tile + 32, acc4 );
+    _mm512_storeu_pd( tile + 40, acc5 );
+    _mm512_storeu_pd( tile + 48, acc6 );
+    _mm512_storeu_pd( tile + 56, acc7 );
+    _mm512_storeu_pd( tile + 64, acc8 );
+    _mm512_storeu_pd( tile + 72, acc9 );
+    _mm512_storeu_pd( tile + 80, acc10 );
+    _mm512_storeu_pd( tile + 88, acc11 );
+  }
+
+  __attribute__( ( target( "avx2,fma" ) ) )
+  float MatrixMultiply::DotAVX2( const float *lhs, const float *rhs, size_t size ) {
+    size_t vec_end = size - size % 16;
+    __m256 acc0 = _mm256_setzero_ps( );
+    __m256 acc1 = _mm256_setzero_ps( );
+    for( size_t elm = 0; elm < vec_end; elm += 16 ) {
+      acc0 = _mm256_fmadd_ps( _mm256_loadu_ps( lhs + elm ), _mm256_loadu_ps( rhs + elm ), acc0 );
+      acc1 = _mm256_fmadd_ps( _mm256_loadu_ps( lhs + elm + 8 ), _mm256_loadu_ps( rhs + elm + 8 ), acc1 );
+    }
+    return( MatrixMultiplySum( _mm256_add_ps( acc0, acc1 ) ) +
+            DotScalar( lhs + vec_end, rhs + vec_end, size - vec_end ) );
+  }
+
+  __attribute__( ( target( "avx2,fma" ) ) )
+  double MatrixMultiply::DotAVX2( const double *lhs, const double *rhs, size_t size ) {
+    size_t vec_end = size - size % 8;
+    __m256d acc0 = _mm256_setzero_pd( );
+    __m256d acc1 = _mm256_setzero_pd( );
+    for( size_t elm = 0; elm < vec_end; elm += 8 ) {
+      acc0 = _mm256_fmadd_pd( _mm256_loadu_pd( lhs + elm ), _mm256_loadu_pd( rhs + elm ), acc0 );
+      acc1 = _mm256_fmadd_pd( _mm256_loadu_pd( lhs + elm + 4 ), _mm256_loadu_pd( rhs + elm + 4 ), acc1 );
+    }
+    return( MatrixMultiplySum( _mm256_add_pd( acc0, acc1 ) ) +
+            DotScalar( lhs + vec_end, rhs + vec_end, size - vec_end ) );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) )
+  float MatrixMultiply::DotAVX512( const float *lhs, const float *rhs, size_t size ) {
+    size_t vec_end = size - size % 32;
+    __m512 acc0 = _mm512_setzero_ps( );
+    __m512 acc1 = _mm512_setzero_ps( );
+    for( size_t elm = 0; elm < vec_end; elm += 32 ) {
+      acc0 = _mm512_fmadd_ps( _mm512_loadu_ps( lhs + elm ), _mm512_loadu_ps( rhs + elm ), acc0 );
+      acc1 = _mm512_fmadd_ps( _mm512_loadu_ps( lhs + elm + 16 ), _mm512_loadu_ps( rhs + elm + 16 ), acc1 );
+    }
+    COMMENT( "Reducing through 256-bit halves. The reduction intrinsics read undefined registers.", 4 );
+    __m512d acc = _mm512_castps_pd( _mm512_add_ps( acc0, acc1 ) );
+    __m256 low = _mm256_castpd_ps( _mm512_maskz_extractf64x4_pd( static_cast< __mmask8 >( 0xF ), acc, 0 ) );
+    __m256 high = _mm256_castpd_ps( _mm512_maskz_extractf64x4_pd( static_cast< __mmask8 >( 0xF ), acc, 1 ) );
+    return( MatrixMultiplySum( _mm256_add_ps( low, high ) ) +
+            DotScalar( lhs + vec_end, rhs + vec_end, size - vec_end ) );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) )
+  double MatrixMultiply::DotAVX512( const double *lhs, const double *rhs, size_t size ) {
+    size_t vec_end = size - size % 16;
+    __m512d acc0 = _mm512_setzero_pd( );
+    __m512d acc1 = _mm512_setzero_pd( );
+    for( size_t elm = 0; elm < vec_end; elm += 16 ) {
+      acc0 = _mm512_fmadd_pd( _mm512_loadu_pd( lhs + elm ), _mm512_loadu_pd( rhs + elm ), acc0 );
+      acc1 = _mm512_fmadd_pd( _mm512_loadu_pd( lhs + elm + 8 ), _mm512_loadu_pd( rhs + elm + 8 ), acc1 );
+    }
+    COMMENT( "Reducing through 256-bit halves. The reduction intrinsics read undefined registers.", 4 );
+    __m512d acc = _mm512_add_pd( acc0, acc1 );
+    __m256d low = _mm512_maskz_extractf64x4_pd( static_cast< __mmask8 >( 0xF ), acc, 0 );
+    __m256d high = _mm512_maskz_extractf64x4_pd( static_cast< __mmask8 >( 0xF ), acc, 1 );
+    return( MatrixMultiplySum( _mm256_add_pd( low, high ) ) +
+            DotScalar( lhs + vec_end, rhs + vec_end, size - vec_end ) );
+  }
+
+#endif
+
+  template< class D >
+  D MatrixMultiply::DotScalar( const D *lhs, const D *rhs, size_t size ) {
+    D res = static_cast< D >( 0 );
+    for( size_t elm = 0; elm < size; ++elm ) {
+      res += lhs[ elm ] * rhs[ elm ];
+    }
+    return( res );
+  }
+
+  template< class D >
+  void MatrixMultiply::Select( size_t&, void ( *& )( size_t, const D*, const D*, D* ),
+                               D ( *& )( const D*, const D*, size_t ) ) {
+  }
+
+  void MatrixMultiply::Select( size_t &nr, void ( *&kernel )( size_t, const float*, const float*, float* ),
+                               float ( *&dot )( const float*, const float*, size_t ) ) {
+    SelectVector( nr, kernel, dot );
+  }
+
+  void MatrixMultiply::Select( size_t &nr, void ( *&kernel )( size_t, const double*, const double*, double* ),
+                               double ( *&dot )( const double*, const double*, size_t ) ) {
+    SelectVector( nr, kernel, dot );
+  }
+
+  template< class D >
+  void MatrixMultiply::SelectVector( size_t &nr, void ( *&kernel )( size_t, const D*, const D*, D* ),
+                                     D ( *&dot )( const D*, const D*, size_t ) ) {
+#ifdef BIAL_MATRIX_MULTIPLY_AVX
+    DistanceKernel::InstructionSet instructions = DistanceKernel::Instructions( );
+    if( instructions == DistanceKernel::InstructionSet::AVX512 ) {
+      nr = 128 / sizeof( D );
+      kernel = &KernelAVX512;
+      dot = &DotAVX512;
+    }
+    else if( instructions == DistanceKernel::InstructionSet::AVX2 ) {
+      nr = 64 / sizeof( D );
+      kernel = &KernelAVX2;
+      dot = &DotAVX2;
+    }
+#endif
+  }
+
+  template< class D >
+  void MatrixMultiply::PackRows( const D *src, size_t lds, size_t src_rows, size_t row, size_t rows, size_t col,
+                                 size_t cols, size_t width, D *dst ) {
+    for( size_t first = row; first < row + rows; first += width ) {
+      for( size_t k = 0; k < cols; ++k ) {
+        for( size_t idx = 0; idx < width; ++idx, ++dst ) {
+          *dst = first + idx < src_rows ? src[ ( first + idx ) * lds + col + k ] : static_cast< D >( 0 );
+        }
+      }
+    }
+  }
+
+  template< class D >
+  void MatrixMultiply::PackColumns( const D *src, size_t lds, size_t src_cols, size_t row, size_t rows, size_t col,
+                                    size_t cols, size_t width, D *dst ) {
+    for( size_t first = col; first < col + cols; first += width ) {
+      size_t valid = std::min( width, src_cols - first );
+      for( size_t k = 0; k < rows; ++k, dst += width ) {
+        const D *line = src + ( row + k ) * lds + first;
+        std::copy( line, line + valid, dst );
+        std::fill( dst + valid, dst + width, static_cast< D >( 0 ) );
+      }
+    }
+  }
+
+  template< class D >
+  void MatrixMultiply::Tiled( const D *lhs, const D *rhs, size_t rows, size_t inner, size_t cols, D *res ) {
+    COMMENT( "Selecting the micro-kernel.", 2 );
+    size_t nr = 8;
+    void ( *kernel )( size_t, const D*, const D*, D* ) = &KernelScalar< D, 8 >;
+    D ( *dot )( const D*, const D*, size_t ) = &DotScalar< D >;
+    Select( nr, kernel, dot );
+    size_t blocks = ( rows + MC - 1 ) / MC;
+    bool parallel = rows * inner * cols >= MIN_PARALLEL;
+    std::vector< D > pb( KC * std::min( NC, ( cols + nr - 1 ) / nr * nr ) );
+    for( size_t jc = 0; jc < cols; jc += NC ) {
+      size_t nc = std::min( NC, cols - jc );
+      for( size_t pc = 0; pc < inner; pc += KC ) {
+        size_t kc = std::min( KC, inner - pc );
+        COMMENT( "Packing the panel of the right matrix, shared by all blocks.", 3 );
+        PackColumns( rhs, cols, cols, pc, kc, jc, nc, nr, pb.data( ) );
+        auto body = [ & ]( size_t first, size_t last ) {
+          std::vector< D > pa( MC * KC );
+          D tile[ MR * MAX_NR ];
+          for( size_t blk = first; blk < last; ++blk ) {
+            size_t ic = blk * MC;
+            size_t mc = std::min( MC, rows - ic );
+            PackRows( lhs, inner, rows, ic, mc, pc, kc, MR, pa.data( ) );
+            for( size_t jr = 0; jr < nc; jr += nr ) {
+              for( size_t ir = 0; ir < mc; ir += MR ) {
+                kernel( kc, pa.data( ) + ir * kc, pb.data( ) + jr * kc, tile );
+                size_t tile_rows = std::min( MR, mc - ir );
+                size_t tile_cols = std::min( nr, nc - jr );
+                D *dst = res + ( ic + ir ) * cols + jc + jr;
+                for( size_t row = 0; row < tile_rows; ++row, dst += cols ) {
+                  const D *src = tile + row * nr;
+                  for( size_t col = 0; col < tile_cols; ++col ) {
+                    dst[ col ] = pc == 0 ? src[ col ] : dst[ col ] + src[ col ];
+                  }
+                }
+              }
+            }
+          }
+        };
+        if( parallel ) {
+          ThreadPool::ParallelFor( 0, blocks, 1, body );
+        }
+        else {
+          body( 0, blocks );
+        }
+      }
+    }
+  }
+
+  template< class D >
+  void MatrixMultiply::Multiply( const D *lhs, const D *rhs, size_t rows, size_t inner, size_t cols, D *res ) {
+    try {
+      if( inner == 0 ) {
+        std::fill( res, res + rows * cols, static_cast< D >( 0 ) );
+        return;
+      }
+      if( cols == 1 ) {
+        MultiplyVector( lhs, rhs, rows, inner, res );
+        return;
+      }
+      size_t work = rows * inner * cols;
+      if( ( work >= MIN_TILED ) && ( rows > 1 ) ) {
+        Tiled( lhs, rhs, rows, inner, cols, res );
+        return;
+      }
+      COMMENT( "Small products and row vectors: each result row accumulates rows of the right matrix.", 2 );
+      for( size_t row = 0; row < rows; ++row ) {
+        D *dst = res + row * cols;
+        std::fill( dst, dst + cols, static_cast< D >( 0 ) );
+        for( size_t k = 0; k < inner; ++k ) {
+          D val = lhs[ row * inner + k ];
+          const D *src = rhs + k * cols;
+          for( size_t col = 0; col < cols; ++col ) {
+            dst[ col ] += val * src[ col ];
+          }
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void MatrixMultiply::MultiplyVector( const D *mat, const D *vct, size_t rows, size_t cols, D *res ) {
+    try {
+      size_t nr = 8;
+      void ( *kernel )( size_t, const D*, const D*, D* ) = &KernelScalar< D, 8 >;
+      D ( *dot )( const D*, const D*, size_t ) = &DotScalar< D >;
+      Select( nr, kernel, dot );
+      auto body = [ & ]( size_t first, size_t last ) {
+        for( size_t row = first; row < last; ++row ) {
+          res[ row ] = dot( mat + row * cols, vct, cols );
+        }
+      };
+      if( rows * cols >= MIN_PARALLEL ) {
+        ThreadPool::ParallelFor( 0, rows, 64, body );
+      }
+      else {
+        body( 0, rows );
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_MatrixMultiply
+
+  template void MatrixMultiply::Multiply( const int *lhs, const int *rhs, size_t rows, size_t inner, size_t cols,
+                                          int *res );
+  template void MatrixMultiply::Multiply( const llint *lhs, const llint *rhs, size_t rows, size_t inner,
+                                          size_t cols, llint *res );
+  template void MatrixMultiply::Multiply( const float *lhs, const float *rhs, size_t rows, size_t inner,
+                                          size_t cols, float *res );
+  template void MatrixMultiply::Multiply( const double *lhs, const double *rhs, size_t rows, size_t inner,
+                                          size_t cols, double *res );
+  template void MatrixMultiply::MultiplyVector( const int *mat, const int *vct, size_t rows, size_t cols,
+                                                int *res );
+  template void MatrixMultiply::MultiplyVector( const llint *mat, const llint *vct, size_t rows, size_t cols,
+                                                llint *res );
+  template void MatrixMultiply::MultiplyVector( const float *mat, const float *vct, size_t rows, size_t cols,
+                                                float *res );
+  template void MatrixMultiply::MultiplyVector( const double *mat, const double *vct, size_t rows, size_t cols,
+                                                double *res );
+
+#endif
+
+}
+
+#endif
+
+#endif
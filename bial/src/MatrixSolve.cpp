@@ -0,0 +1,569 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief LU and Cholesky decompositions and solution of linear systems.
+ */
+
+#ifndef BIALMATRIXSOLVE_C
+#define BIALMATRIXSOLVE_C
+
+#include "MatrixSolve.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_MatrixSolve )
+#define BIAL_EXPLICIT_MatrixSolve
+#endif
+
+#if defined ( BIAL_EXPLICIT_MatrixSolve ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Matrix.hpp"
+#include "MatrixMultiply.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Bial {
+
+  /** @brief Number of columns of a panel, and of rows of a block of the triangular solves. */
+  const size_t MATRIX_SOLVE_BLOCK = 64;
+  /** @brief Number of columns updated by each product of the panel blocks. */
+  const size_t MATRIX_SOLVE_UPDATE = 512;
+
+  template< class D >
+  int MatrixOp::LU( const Matrix< D > &mat, Matrix< double > &lu, Vector< size_t > &pivot ) {
+    try {
+      if( mat.Dims( ) != 2 ) {
+        std::string msg( BIAL_ERROR( "Invalid number of dimensions. Expected 2." ) );
+        throw( std::logic_error( msg ) );
+      }
+      size_t size = mat.size( 0 );
+      if( size != mat.size( 1 ) ) {
+        std::string msg( BIAL_ERROR( "Matrix must be square." ) );
+        throw( std::logic_error( msg ) );
+      }
+      lu = Matrix< double >( size, size );
+      pivot = Vector< size_t >( size );
+      double *data = lu.data( );
+      for( size_t elm = 0; elm < size * size; ++elm ) {
+        data[ elm ] = static_cast< double >( mat[ elm ] );
+      }
+      int sign = 1;
+      std::vector< double > lower;
+      std::vector< double > upper;
+      std::vector< double > product;
+      for( size_t first = 0; first < size; first += MATRIX_SOLVE_BLOCK ) {
+        size_t last = std::min( first + MATRIX_SOLVE_BLOCK, size );
+        COMMENT( "Factorizing the panel of columns [ first, last ), exchanging whole rows.", 3 );
+        for( size_t col = first; col < last; ++col ) {
+          size_t max_row = col;
+          double max_val = std::abs( data[ col * size + col ] );
+          for( size_t row = col + 1; row < size; ++row ) {
+            double val = std::abs( data[ row * size + col ] );
+            if( val > max_val ) {
+              max_val = val;
+              max_row = row;
+            }
+          }
+          pivot[ col ] = max_row;
+          if( max_val == 0.0 ) {
+            sign = 0;
+            continue;
+          }
+          if( max_row != col ) {
+            std::swap_ranges( data + col * size, data + ( col + 1 ) * size, data + max_row * size );
+            sign = -sign;
+          }
+          const double *pivot_row = data + col * size;
+          for( size_t row = col + 1; row < size; ++row ) {
+            double *cur_row = data + row * size;
+            double factor = cur_row[ col ] / pivot_row[ col ];
+            cur_row[ col ] = factor;
+            if( factor != 0.0 ) {
+              for( size_t elm = col + 1; elm < last; ++elm ) {
+                cur_row[ elm ] -= factor * pivot_row[ elm ];
+              }
+            }
+          }
+        }
+        if( last == size ) {
+          break;
+        }
+        COMMENT( "Computing the rows of U at the right of the panel.", 3 );
+        for( size_t col = first; col < last; ++col ) {
+          const double *pivot_row = data + col * size;
+          for( size_t row = col + 1; row < last; ++row ) {
+            double *cur_row = data + row * size;
+            double factor = cur_row[ col ];
+            if( factor != 0.0 ) {
+              for( size_t elm = last; elm < size; ++elm ) {
+                cur_row[ elm ] -= factor * pivot_row[ elm ];
+              }
+            }
+          }
+        }
+        COMMENT( "Subtracting the product of the panel blocks of L and U from the trailing matrix.", 3 );
+        size_t rows = size - last;
+        size_t width = last - first;
+        lower.resize( rows * width );
+        for( size_t row = 0; row < rows; ++row ) {
+          std::copy( data + ( last + row ) * size + first, data + ( last + row ) * size + last,
+                     lower.begin( ) + row * width );
+        }
+        for( size_t col = last; col < size; col += MATRIX_SOLVE_UPDATE ) {
+          size_t cols = std::min( MATRIX_SOLVE_UPDATE, size - col );
+          upper.resize( width * cols );
+          product.resize( rows * cols );
+          for( size_t row = 0; row < width; ++row ) {
+            std::copy( data + ( first + row ) * size + col, data + ( first + row ) * size + col + cols,
+                       upper.begin( ) + row * cols );
+          }
+          MatrixMultiply::Multiply( lower.data( ), upper.data( ), rows, width, cols, product.data( ) );
+          for( size_t row = 0; row < rows; ++row ) {
+            double *cur_row = data + ( last + row ) * size + col;
+            const double *prd_row = product.data( ) + row * cols;
+            for( size_t elm = 0; elm < cols; ++elm ) {
+              cur_row[ elm ] -= prd_row[ elm ];
+            }
+          }
+        }
+      }
+      return( sign );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  bool MatrixOp::Cholesky( const Matrix< D > &mat, Matrix< double > &chol ) {
+    try {
+      if( mat.Dims( ) != 2 ) {
+        std::string msg( BIAL_ERROR( "Invalid number of dimensions. Expected 2." ) );
+        throw( std::logic_error( msg ) );
+      }
+      size_t size = mat.size( 0 );
+      if( size != mat.size( 1 ) ) {
+        std::string msg( BIAL_ERROR( "Matrix must be square." ) );
+        throw( std::logic_error( msg ) );
+      }
+      chol = Matrix< double >( size, size );
+      double *data = chol.data( );
+      for( size_t row = 0; row < size; ++row ) {
+        for( size_t col = 0; col <= row; ++col ) {
+          data[ row * size + col ] = static_cast< double >( mat[ row * size + col ] );
+        }
+      }
+      std::vector< double > lower;
+      std::vector< double > upper;
+      std::vector< double > product;
+      for( size_t first = 0; first < size; first += MATRIX_SOLVE_BLOCK ) {
+        size_t last = std::min( first + MATRIX_SOLVE_BLOCK, size );
+        COMMENT( "Factorizing the panel of columns [ first, last ).", 3 );
+        for( size_t col = first; col < last; ++col ) {
+          double diag = data[ col * size + col ];
+          if( !( diag > 0.0 ) || !std::isfinite( diag ) ) {
+            return( false );
+          }
+          diag = std::sqrt( diag );
+          data[ col * size + col ] = diag;
+          for( size_t row = col + 1; row < size; ++row ) {
+            data[ row * size + col ] /= diag;
+          }
+          for( size_t row = col + 1; row < size; ++row ) {
+            double *cur_row = data + row * size;
+            double factor = cur_row[ col ];
+            if( factor != 0.0 ) {
+              size_t end = std::min( row + 1, last );
+              for( size_t elm = col + 1; elm < end; ++elm ) {
+                cur_row[ elm ] -= factor * data[ elm * size + col ];
+              }
+            }
+          }
+        }
+        if( last == size ) {
+          break;
+        }
+        COMMENT( "Subtracting the product of the panel block by its transpose from the trailing lower triangle.", 3 );
+        size_t rows = size - last;
+        size_t width = last - first;
+        lower.resize( rows * width );
+        for( size_t row = 0; row < rows; ++row ) {
+          std::copy( data + ( last + row ) * size + first, data + ( last + row ) * size + last,
+                     lower.begin( ) + row * width );
+        }
+        for( size_t col = 0; col < rows; col += MATRIX_SOLVE_UPDATE ) {
+          size_t cols = std::min( MATRIX_SOLVE_UPDATE, rows - col );
+          upper.resize( width * cols );
+          product.resize( ( rows - col ) * cols );
+          for( size_t row = 0; row < width; ++row ) {
+            for( size_t elm = 0; elm < cols; ++elm ) {
+              upper[ row * cols + elm ] = lower[ ( col + elm ) * width + row ];
+            }
+          }
+          MatrixMultiply::Multiply( lower.data( ) + col * width, upper.data( ), rows - col, width, cols,
+                                    product.data( ) );
+          for( size_t row = col; row < rows; ++row ) {
+            double *cur_row = data + ( last + row ) * size + last + col;
+            const double *prd_row = product.data( ) + ( row - col ) * cols;
+            size_t end = std::min( cols, row - col + 1 );
+            for( size_t elm = 0; elm < end; ++elm ) {
+              cur_row[ elm ] -= prd_row[ elm ];
+            }
+          }
+        }
+      }
+      return( true );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void MatrixOp::LowerSolve( const Matrix< double > &tri, bool unit, Matrix< double > &rhs ) {
+    try {
+      size_t size = tri.size( 0 );
+      size_t rows = rhs.Dims( ) == 1 ? rhs.size( 0 ) : rhs.size( 1 );
+      if( ( rhs.Dims( ) > 2 ) || ( rows != size ) ) {
+        std::string msg( BIAL_ERROR( "Right-hand side rows do not match the triangular matrix." ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( size == 0 ) {
+        return;
+      }
+      size_t cols = rhs.size( ) / size;
+      const double *data = tri.data( );
+      double *res = rhs.data( );
+      std::vector< double > block;
+      std::vector< double > product;
+      for( size_t first = 0; first < size; first += MATRIX_SOLVE_BLOCK ) {
+        size_t last = std::min( first + MATRIX_SOLVE_BLOCK, size );
+        size_t width = last - first;
+        if( first > 0 ) {
+          COMMENT( "Subtracting the product of the block of rows at the left of the diagonal by the solved rows.", 4 );
+          block.resize( width * first );
+          product.resize( width * cols );
+          for( size_t row = 0; row < width; ++row ) {
+            std::copy( data + ( first + row ) * size, data + ( first + row ) * size + first,
+                       block.begin( ) + row * first );
+          }
+          MatrixMultiply::Multiply( block.data( ), res, width, first, cols, product.data( ) );
+          double *cur_row = res + first * cols;
+          for( size_t elm = 0; elm < width * cols; ++elm ) {
+            cur_row[ elm ] -= product[ elm ];
+          }
+        }
+        COMMENT( "Forward substitution in the diagonal block.", 4 );
+        for( size_t row = first; row < last; ++row ) {
+          double *cur_row = res + row * cols;
+          for( size_t col = first; col < row; ++col ) {
+            double factor = data[ row * size + col ];
+            if( factor != 0.0 ) {
+              const double *src_row = res + col * cols;
+              for( size_t elm = 0; elm < cols; ++elm ) {
+                cur_row[ elm ] -= factor * src_row[ elm ];
+              }
+            }
+          }
+          if( !unit ) {
+            double diag = data[ row * size + row ];
+            for( size_t elm = 0; elm < cols; ++elm ) {
+              cur_row[ elm ] /= diag;
+            }
+          }
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void MatrixOp::UpperSolve( const Matrix< double > &tri, bool transposed, Matrix< double > &rhs ) {
+    try {
+      size_t size = tri.size( 0 );
+      size_t rows = rhs.Dims( ) == 1 ? rhs.size( 0 ) : rhs.size( 1 );
+      if( ( rhs.Dims( ) > 2 ) || ( rows != size ) ) {
+        std::string msg( BIAL_ERROR( "Right-hand side rows do not match the triangular matrix." ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( size == 0 ) {
+        return;
+      }
+      size_t cols = rhs.size( ) / size;
+      const double *data = tri.data( );
+      double *res = rhs.data( );
+      std::vector< double > block;
+      std::vector< double > product;
+      for( size_t last = size; last > 0; ) {
+        size_t first = last > MATRIX_SOLVE_BLOCK ? last - MATRIX_SOLVE_BLOCK : 0;
+        size_t width = last - first;
+        size_t trailing = size - last;
+        if( trailing > 0 ) {
+          COMMENT( "Subtracting the product of the block of rows at the right of the diagonal by the solved rows.", 4 );
+          block.resize( width * trailing );
+          product.resize( width * cols );
+          if( !transposed ) {
+            for( size_t row = 0; row < width; ++row ) {
+              std::copy( data + ( first + row ) * size + last, data + ( first + row ) * size + size,
+                         block.begin( ) + row * trailing );
+            }
+          }
+          else {
+            for( size_t col = 0; col < trailing; ++col ) {
+              const double *src_row = data + ( last + col ) * size + first;
+              for( size_t row = 0; row < width; ++row ) {
+                block[ row * trailing + col ] = src_row[ row ];
+              }
+            }
+          }
+          MatrixMultiply::Multiply( block.data( ), res + last * cols, width, trailing, cols, product.data( ) );
+          double *cur_row = res + first * cols;
+          for( size_t elm = 0; elm < width * cols; ++elm ) {
+            cur_row[ elm ] -= product[ elm ];
+          }
+        }
+        COMMENT( "Backward substitution in the diagonal block.", 4 );
+        for( size_t row = last; row-- > first; ) {
+          double *cur_row = res + row * cols;
+          if( !transposed ) {
+            for( size_t col = row + 1; col < last; ++col ) {
+              double factor = data[ row * size + col ];
+              if( factor != 0.0 ) {
+                const double *src_row = res + col * cols;
+                for( size_t elm = 0; elm < cols; ++elm ) {
+                  cur_row[ elm ] -= factor * src_row[ elm ];
+                }
+              }
+            }
+          }
+          double diag = data[ row * size + row ];
+          for( size_t elm = 0; elm < cols; ++elm ) {
+            cur_row[ elm ] /= diag;
+          }
+          if( transposed ) {
+            COMMENT( "Row of the lower triangle is a column of its transpose.", 4 );
+            for( size_t col = first; col < row; ++col ) {
+              double factor = data[ row * size + col ];
+              if( factor != 0.0 ) {
+                double *tgt_row = res + col * cols;
+                for( size_t elm = 0; elm < cols; ++elm ) {
+                  tgt_row[ elm ] -= factor * cur_row[ elm ];
+                }
+              }
+            }
+          }
+        }
+        last = first;
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void MatrixOp::LUSolve( const Matrix< double > &lu, const Vector< size_t > &pivot, Matrix< double > &rhs ) {
+    try {
+      size_t size = lu.size( 0 );
+      size_t rows = rhs.Dims( ) == 1 ? rhs.size( 0 ) : rhs.size( 1 );
+      if( ( rhs.Dims( ) > 2 ) || ( rows != size ) || ( pivot.size( ) != size ) ) {
+        std::string msg( BIAL_ERROR( "Right-hand side rows do not match the decomposition." ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( size == 0 ) {
+        return;
+      }
+      size_t cols = rhs.size( ) / size;
+      double *res = rhs.data( );
+      COMMENT( "Exchanging rows in the order of the decomposition.", 2 );
+      for( size_t row = 0; row < size; ++row ) {
+        if( pivot[ row ] != row ) {
+          std::swap_ranges( res + row * cols, res + ( row + 1 ) * cols, res + pivot[ row ] * cols );
+        }
+      }
+      MatrixOp::LowerSolve( lu, true, rhs );
+      MatrixOp::UpperSolve( lu, false, rhs );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void MatrixOp::CholeskySolve( const Matrix< double > &chol, Matrix< double > &rhs ) {
+    try {
+      MatrixOp::LowerSolve( chol, false, rhs );
+      MatrixOp::UpperSolve( chol, true, rhs );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Matrix< D > MatrixOp::Solve( const Matrix< D > &mat, const Matrix< D > &rhs ) {
+    try {
+      if( mat.Dims( ) != 2 ) {
+        std::string msg( BIAL_ERROR( "Invalid number of dimensions. Expected 2." ) );
+        throw( std::logic_error( msg ) );
+      }
+      size_t size = mat.size( 0 );
+      if( size != mat.size( 1 ) ) {
+        std::string msg( BIAL_ERROR( "Matrix must be square." ) );
+        throw( std::logic_error( msg ) );
+      }
+      Matrix< double > res( rhs.Dim( ) );
+      for( size_t elm = 0; elm < rhs.size( ); ++elm ) {
+        res[ elm ] = static_cast< double >( rhs[ elm ] );
+      }
+      COMMENT( "Checking for symmetry.", 2 );
+      bool symmetric = true;
+      for( size_t row = 1; ( row < size ) && ( symmetric ); ++row ) {
+        for( size_t col = 0; col < row; ++col ) {
+          if( mat[ row * size + col ] != mat[ col * size + row ] ) {
+            symmetric = false;
+            break;
+          }
+        }
+      }
+      Matrix< double > factor;
+      if( ( symmetric ) && ( MatrixOp::Cholesky( mat, factor ) ) ) {
+        COMMENT( "Solving with the Cholesky decomposition.", 2 );
+        MatrixOp::CholeskySolve( factor, res );
+      }
+      else {
+        COMMENT( "Solving with the LU decomposition.", 2 );
+        Vector< size_t > pivot;
+        if( MatrixOp::LU( mat, factor, pivot ) == 0 ) {
+          std::string msg( BIAL_ERROR( "Singular matrix." ) );
+          throw( std::logic_error( msg ) );
+        }
+        MatrixOp::LUSolve( factor, pivot, res );
+      }
+      Matrix< D > sol( rhs.Dim( ) );
+      for( size_t elm = 0; elm < sol.size( ); ++elm ) {
+        sol[ elm ] = static_cast< D >( res[ elm ] );
+      }
+      return( sol );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_MatrixSolve
+
+  template int MatrixOp::LU( const Matrix< int > &mat, Matrix< double > &lu, Vector< size_t > &pivot );
+  template bool MatrixOp::Cholesky( const Matrix< int > &mat, Matrix< double > &chol );
+  template Matrix< int > MatrixOp::Solve( const Matrix< int > &mat, const Matrix< int > &rhs );
+
+  template int MatrixOp::LU( const Matrix< llint > &mat, Matrix< double > &lu, Vector< size_t > &pivot );
+  template bool MatrixOp::Cholesky( const Matrix< llint > &mat, Matrix< double > &chol );
+  template Matrix< llint > MatrixOp::Solve( const Matrix< llint > &mat, const Matrix< llint > &rhs );
+
+  template int MatrixOp::LU( const Matrix< float > &mat, Matrix< double > &lu, Vector< size_t > &pivot );
+  template bool MatrixOp::Cholesky( const Matrix< float > &mat, Matrix< double > &chol );
+  template Matrix< float > MatrixOp::Solve( const Matrix< float > &mat, const Matrix< float > &rhs );
+
+  template int MatrixOp::LU( const Matrix< double > &mat, Matrix< double > &lu, Vector< size_t > &pivot );
+  template bool MatrixOp::Cholesky( const Matrix< double > &mat, Matrix< double > &chol );
+  template Matrix< double > MatrixOp::Solve( const Matrix< double > &mat, const Matrix< double > &rhs );
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -188,7 +188,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  bool MaxSumPathFunction< C, D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  bool MaxSumPathFunction< C, D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) && 
               ( this->value->operator()( index ) < this->value->operator()( adj_index ) ) );
@@ -212,7 +212,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  bool MaxSumPathFunction< C, D >::Propagate( int index, int adj_index ) {
+  bool MaxSumPathFunction< C, D >::Propagate( size_t index, size_t adj_index ) {
     try {
       D src_value = this->value->operator()( adj_index );
       COMMENT( "Computing arc weight.", 3 );
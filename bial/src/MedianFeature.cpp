@@ -23,6 +23,9 @@
 #include "Feature.hpp"
 #include "Image.hpp"
 #include "Matrix.hpp"
+#include "SlidingHistogram.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
 
 namespace Bial {
 
@@ -40,22 +43,14 @@ namespace Bial {
       }
       size_t elements = src.size( );
       Feature< D > res( elements, features );
+      COMMENT( "Quantizing values to histogram bins.", 0 );
+      Vector< int > bin;
+      Vector< D > value;
+      SlidingHistogram::Quantize( src.data( ), src.size( ), bin, value );
       COMMENT( "Computing median features.", 0 );
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads.push_back( std::thread( &MedianFeatureThread< D >, std::ref( src ), std::ref( adj_rel ),
-                                          std::ref( res ), thd, total_threads ) );
-        }
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads( thd ).join( );
-        }
-      }
-      catch( std::exception &e ) {
-        std::cout << "Warning: Failed to run in multi-thread. Exception: " << e.what( ) << std::endl;
-        MedianFeatureThread( src, adj_rel, res, 0, 1 );
-      }
+      ThreadPool::Run( ThreadPool::Tasks( src.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          MedianFeatureThread( src, adj_rel, bin, value, res, thd, total_threads );
+        } );
       return( res );
     }
     catch( std::bad_alloc &e ) {
@@ -99,29 +94,42 @@ namespace Bial {
           ++elements;
       } // msk.Elements( 1, msk.Maximum( ) );
       Feature< D > res( elements, features );
-      COMMENT( "Computing median features.", 0 );
-      Vector< D > median( adj_rel.size( ) );
-      size_t adj_base = ( adj_rel.size( ) / 2 ) - ( features / 2 );
+      COMMENT( "Quantizing values to histogram bins. Feature rows follow the order of the mask elements.", 0 );
+      Vector< int > bin;
+      Vector< D > value;
+      SlidingHistogram::Quantize( src.data( ), src.size( ), bin, value );
+      Vector< bool > inside( msk.size( ) );
+      Vector< size_t > row( msk.size( ) );
       size_t tgt_elm = 0;
-      for( size_t src_elm = 0; src_elm < src.size( ); ++src_elm ) {
-        if( msk[ src_elm ] != 0 ) {
-          for( size_t adj = 0; adj < adj_rel.size( ); ++adj ) {
-            size_t elm_adj = adj_rel( src, src_elm, adj );
-            if( ( elm_adj < src.size( ) ) && ( msk[ elm_adj ] != 0 ) ) {
-              median( adj ) = src[ elm_adj ];
-            }
-            else {
-              median( adj ) = src[ src_elm ];
-            }
-          }
-          sort( median.begin( ), median.end( ) );
-          for( size_t ftr = 0; ftr < features; ++ftr ) {
-            res( tgt_elm, ftr ) = median( adj_base + ftr );
-            res.Index( tgt_elm ) = src_elm;
-          }
+      for( size_t src_elm = 0; src_elm < msk.size( ); ++src_elm ) {
+        inside[ src_elm ] = ( msk[ src_elm ] != 0 );
+        row[ src_elm ] = tgt_elm;
+        if( inside[ src_elm ] ) {
+          res.Index( tgt_elm ) = src_elm;
           ++tgt_elm;
         }
       }
+      COMMENT( "Computing median features. Adjacents out of the mask count as the central value.", 0 );
+      size_t adjs = adj_rel.size( );
+      size_t adj_base = ( adjs / 2 ) - ( features / 2 );
+      bool sorted = SlidingHistogram::Sorted< D >( value.size( ) );
+      COMMENT( "One histogram per thread, sliding along the lines of its range.", 0 );
+      ThreadPool::Run( ThreadPool::Tasks( src.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          size_t min_index = thd * src.size( ) / total_threads;
+          size_t max_index = ( thd + 1 ) * src.size( ) / total_threads;
+          SlidingHistogram::Slide( src.Dim( ), bin, value.size( ), sorted, adj_rel, &inside, min_index, max_index,
+                                   [ & ]( size_t src_elm, SlidingHistogram &histogram ) {
+                                     if( !inside[ src_elm ] ) {
+                                       return;
+                                     }
+                                     size_t missing = adjs - histogram.Size( );
+                                     histogram.Insert( bin[ src_elm ], missing );
+                                     for( size_t ftr = 0; ftr < features; ++ftr ) {
+                                       res( row[ src_elm ], ftr ) = value[ histogram.Select( adj_base + ftr ) ];
+                                     }
+                                     histogram.Remove( bin[ src_elm ], missing );
+                                   } );
+        } );
       return( res );
     }
     catch( std::bad_alloc &e ) {
@@ -143,32 +151,27 @@ namespace Bial {
   }
 
   template< class D >
-  void MedianFeatureThread( const Matrix< D > &src, const Adjacency &adj_rel, Feature< D > &res, size_t thread, 
-                            size_t total_threads ) {
+  void MedianFeatureThread( const Matrix< D > &src, const Adjacency &adj_rel, const Vector< int > &bin,
+                            const Vector< D > &value, Feature< D > &res, size_t thread, size_t total_threads ) {
     try {
       COMMENT( "Dealing with thread limits.", 2 );
       size_t features = res.Features( );
       size_t elements = res.Elements( );
       size_t min_index = thread * elements / total_threads;
       size_t max_index = ( thread + 1 ) * elements / total_threads;
-      COMMENT( "Computing median features.", 2 );
-      Vector< D > median( adj_rel.size( ) );
-      size_t adj_base = ( adj_rel.size( ) / 2 ) - ( features / 2 );
-      for( size_t src_elm = min_index; src_elm < max_index; ++src_elm ) {
-        for( size_t adj = 0; adj < adj_rel.size( ); ++adj ) {
-          size_t elm_adj = adj_rel( src, src_elm, adj );
-          if( elm_adj < src.size( ) ) {
-            median( adj ) = src[ elm_adj ];
-          }
-          else {
-            median( adj ) = src[ src_elm ];
-          }
-        }
-        std::sort( median.begin( ), median.end( ) );
-        for( size_t ftr = 0; ftr < features; ++ftr ) {
-          res( src_elm, ftr ) = median( adj_base + ftr );
-        }
-      }
+      COMMENT( "Computing median features. Adjacents out of the domain count as the central value.", 2 );
+      size_t adjs = adj_rel.size( );
+      size_t adj_base = ( adjs / 2 ) - ( features / 2 );
+      SlidingHistogram::Slide( src.Dim( ), bin, value.size( ), SlidingHistogram::Sorted< D >( value.size( ) ),
+                               adj_rel, nullptr, min_index, max_index,
+                               [ & ]( size_t src_elm, SlidingHistogram &histogram ) {
+                                 size_t missing = adjs - histogram.Size( );
+                                 histogram.Insert( bin[ src_elm ], missing );
+                                 for( size_t ftr = 0; ftr < features; ++ftr ) {
+                                   res( src_elm, ftr ) = value[ histogram.Select( adj_base + ftr ) ];
+                                 }
+                                 histogram.Remove( bin[ src_elm ], missing );
+                               } );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -251,14 +254,18 @@ namespace Bial {
   template Feature< double > MedianFeature( const Matrix< double > &src, const Matrix< double > &msk, 
                                             const Adjacency &adj, float proportion );
 
-  template void MedianFeatureThread( const Matrix< int > &src, const Adjacency &adj_rel, Feature< int > &res,
-                            size_t thread, size_t total_threads );
-  template void MedianFeatureThread( const Matrix< llint > &src, const Adjacency &adj_rel, Feature< llint > &res,
-                            size_t thread, size_t total_threads );
-  template void MedianFeatureThread( const Matrix< float > &src, const Adjacency &adj_rel, Feature< float > &res,
-                            size_t thread, size_t total_threads );
-  template void MedianFeatureThread( const Matrix< double > &src, const Adjacency &adj_rel, Feature< double > &res,
-                            size_t thread, size_t total_threads );
+  template void MedianFeatureThread( const Matrix< int > &src, const Adjacency &adj_rel, const Vector< int > &bin,
+                                     const Vector< int > &value, Feature< int > &res, size_t thread,
+                                     size_t total_threads );
+  template void MedianFeatureThread( const Matrix< llint > &src, const Adjacency &adj_rel, const Vector< int > &bin,
+                                     const Vector< llint > &value, Feature< llint > &res, size_t thread,
+                                     size_t total_threads );
+  template void MedianFeatureThread( const Matrix< float > &src, const Adjacency &adj_rel, const Vector< int > &bin,
+                                     const Vector< float > &value, Feature< float > &res, size_t thread,
+                                     size_t total_threads );
+  template void MedianFeatureThread( const Matrix< double > &src, const Adjacency &adj_rel, const Vector< int > &bin,
+                                     const Vector< double > &value, Feature< double > &res, size_t thread,
+                                     size_t total_threads );
 
   template Feature< int > MedianFeature( const Image< int > &src, const Adjacency &adj, float proportion );
   template Feature< llint > MedianFeature( const Image< llint > &src, const Adjacency &adj, float proportion );
@@ -18,8 +18,10 @@
 #if defined ( BIAL_EXPLICIT_MorphologyErosion ) || ( BIAL_IMPLICIT_BIN )
 
 #include "AdjacencyRound.hpp"
-#include "AdjacencyIterator.hpp"
+#include "AdjacencyOffset.hpp"
 #include "Image.hpp"
+#include "MorphologyLines.hpp"
+#include "ThreadPool.hpp"
 
 namespace Bial {
 
@@ -55,22 +57,15 @@ namespace Bial {
                          ": error: Image and adjacency relation dimensions do not match." );
         throw( std::logic_error( msg ) );
       }
-      Image< D > result( image );
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads.push_back( std::thread( &Morphology::ErodeThreads< D >, std::ref( image ), std::ref( adjacency ),
-                                          std::ref( result ), thd, total_threads ) );
-        }
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads( thd ).join( );
-        }
-      }
-      catch( std::exception &e ) {
-        std::cout << "Warning: Failed to run in multi-thread. Exception: " << e.what( ) << std::endl;
-        Morphology::ErodeThreads( image, adjacency, result, 0, 1 );
+      MorphologyLines lines( adjacency );
+      if( lines.Efficient( ) ) {
+        COMMENT( "Structuring element decomposed in line operations.", 2 );
+        return( lines.Erode( image ) );
       }
+      Image< D > result( image );
+      ThreadPool::Run( ThreadPool::Tasks( image.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          Morphology::ErodeThreads( image, adjacency, result, thd, total_threads );
+        } );
       return( result );
     }
     catch( std::bad_alloc &e ) {
@@ -98,12 +93,28 @@ namespace Bial {
       COMMENT( "Dealing with thread limits.", 3 );
       size_t min_index = thread * image.Size( ) / total_threads;
       size_t max_index = ( thread + 1 ) * image.Size( ) / total_threads;
-      for( size_t img_index = min_index; img_index < max_index; ++img_index ) {
-        for( AdjacencyIterator adj_it = begin( adjacency, image, img_index ); *adj_it != image.size( ); ++adj_it ) {
-          size_t adj_index = *adj_it;
-          if( result[ img_index ] > image[ adj_index ] ) {
-            result[ img_index ] = image[ adj_index ];
+      AdjacencyOffset offsets( adjacency, image );
+      size_t adjs = offsets.size( );
+      for( size_t img_index = min_index; img_index < max_index; ) {
+        COMMENT( "Interior pixels. No bounds checking.", 4 );
+        for( size_t run_end = std::min( offsets.InteriorEnd( img_index ), max_index ); img_index < run_end;
+             ++img_index ) {
+          for( size_t adj = 0; adj < adjs; ++adj ) {
+            size_t adj_index = offsets( img_index, adj );
+            if( result[ img_index ] > image[ adj_index ] ) {
+              result[ img_index ] = image[ adj_index ];
+            }
+          }
+        }
+        COMMENT( "Border pixel.", 4 );
+        if( img_index < max_index ) {
+          for( size_t adj = 0; adj < adjs; ++adj ) {
+            size_t adj_index = offsets.Checked( img_index, adj );
+            if( ( adj_index < image.size( ) ) && ( result[ img_index ] > image[ adj_index ] ) ) {
+              result[ img_index ] = image[ adj_index ];
+            }
           }
+          ++img_index;
         }
       }
     }
@@ -128,6 +139,13 @@ namespace Bial {
   template< class D >
   Image< D > Morphology::ErodeBin( const Image< D > &image, const Adjacency &adjacency ) {
     try {
+      if( image.Dims( ) == adjacency.Dims( ) ) {
+        MorphologyLines lines( adjacency );
+        if( lines.Efficient( ) || lines.Distance( ) ) {
+          COMMENT( "Structuring element decomposed in line operations or distance transform.", 2 );
+          return( lines.ErodeBin( image ) );
+        }
+      }
       COMMENT( "Inserting pixels into the priority queue.", 2 );
       Vector< size_t > seeds;
       for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
@@ -137,21 +155,9 @@ namespace Bial {
       }
       COMMENT( "Computing erosion result.", 2 );
       Image< D > res( image );
-      try {
-        size_t total_threads = 12;
-        Vector< std::thread > threads;
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads.push_back( std::thread( &Morphology::ErodeBinThreads< D >, std::ref( image ), std::ref( adjacency ),
-                                          std::ref( seeds ), std::ref( res ), thd, total_threads ) );
-        }
-        for( size_t thd = 0; thd < total_threads; ++thd ) {
-          threads( thd ).join( );
-        }
-      }
-      catch( std::exception &e ) {
-        std::cout << "Warning: Failed to run in multi-thread. Exception: " << e.what( ) << std::endl;
-        Morphology::ErodeBinThreads( image, adjacency, seeds, res, 0, 1 );
-      }
+      ThreadPool::Run( ThreadPool::Tasks( seeds.size( ) ), [ & ]( size_t thd, size_t total_threads ) {
+          Morphology::ErodeBinThreads( image, adjacency, seeds, res, thd, total_threads );
+        } );
       return( res );
     }
     catch( std::bad_alloc &e ) {
@@ -179,11 +185,15 @@ namespace Bial {
       COMMENT( "Dealing with thread limits.", 3 );
       size_t min_index = thread * seeds.size( ) / total_threads;
       size_t max_index = ( thread + 1 ) * seeds.size( ) / total_threads;
+      AdjacencyOffset offsets( adjacency, image );
+      size_t adjs = offsets.size( );
       for( size_t pxl = min_index; pxl < max_index; ++pxl ) {
-        for( AdjacencyIterator itr = begin( adjacency, image, seeds( pxl ) ); *itr != image.size( ); ++itr ) {
-          size_t adj_pxl = *itr;
-          if( image[ adj_pxl ] == 0 ) {
-            result[ seeds( pxl ) ] = 0;
+        size_t src_pxl = seeds( pxl );
+        bool interior = offsets.Interior( src_pxl );
+        for( size_t adj = 0; adj < adjs; ++adj ) {
+          size_t adj_pxl = interior ? offsets( src_pxl, adj ) : offsets.Checked( src_pxl, adj );
+          if( ( adj_pxl < image.size( ) ) && ( image[ adj_pxl ] == 0 ) ) {
+            result[ src_pxl ] = 0;
             break;
           }
         }
@@ -0,0 +1,530 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Morphological dilation and erosion decomposed in 1D line operations.
+ */
+
+#ifndef BIALMORPHOLOGYLINES_C
+#define BIALMORPHOLOGYLINES_C
+
+#include "MorphologyLines.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_MorphologyLines )
+#define BIAL_EXPLICIT_MorphologyLines
+#endif
+
+#if defined ( BIAL_EXPLICIT_MorphologyLines ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Adjacency.hpp"
+#include "Image.hpp"
+#include "ThreadPool.hpp"
+#include "TransformEuclDist.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace Bial {
+
+  MorphologyLines::MorphologyLines( const Adjacency &adjacency ) try :
+    dims( adjacency.Dims( ) ), adjs( 0 ), integral( true ), box( false ), cross( false ), sphere( false ),
+    squared_radius( 0 ), lower( dims, 0 ), upper( dims, 0 ), run_lower( ), run_upper( ), run_shift( ),
+    run_lengths( ) {
+      COMMENT( "Distinct integer displacements, with the origin. Keys hold dimension 0 last, so that runs along "
+               << "dimension 0 are consecutive.", 2 );
+      std::set< std::vector< llint > > element;
+      element.insert( std::vector< llint >( dims, 0 ) );
+      for( size_t idx = 0; idx < adjacency.size( ); ++idx ) {
+        std::vector< llint > key( dims, 0 );
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          float dsp = adjacency.Displacement( dms, idx );
+          if( dsp != std::floor( dsp ) ) {
+            integral = false;
+          }
+          key[ ( dms + dims - 1 ) % dims ] = static_cast< llint >( dsp );
+        }
+        element.insert( key );
+      }
+      adjs = element.size( );
+      bool on_axes = true;
+      for( const std::vector< llint > &key : element ) {
+        llint norm = 0;
+        size_t non_zero = 0;
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          llint dsp = key[ ( dms + dims - 1 ) % dims ];
+          lower[ dms ] = std::min( lower[ dms ], dsp );
+          upper[ dms ] = std::max( upper[ dms ], dsp );
+          norm += dsp * dsp;
+          non_zero += ( dsp != 0 ) ? 1 : 0;
+        }
+        squared_radius = std::max( squared_radius, norm );
+        on_axes = on_axes && ( non_zero <= 1 );
+      }
+      COMMENT( "Box: all displacements within the bounds. Cross: a run through the origin in each dimension.", 2 );
+      size_t volume = 1;
+      size_t axes = 1;
+      for( size_t dms = 0; dms < dims; ++dms ) {
+        volume *= upper[ dms ] - lower[ dms ] + 1;
+        axes += upper[ dms ] - lower[ dms ];
+      }
+      box = ( volume == adjs );
+      cross = ( !box ) && on_axes && ( axes == adjs );
+      COMMENT( "Hypersphere: all displacements with squared norm up to squared_radius are in the element.", 2 );
+      llint radius = static_cast< llint >( std::sqrt( static_cast< double >( squared_radius ) ) + 0.5 );
+      size_t in_sphere = 0;
+      std::vector< llint > point( dims, -radius );
+      for( bool done = ( dims == 0 ); !done; ) {
+        llint norm = 0;
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          norm += point[ dms ] * point[ dms ];
+        }
+        in_sphere += ( norm <= squared_radius ) ? 1 : 0;
+        done = true;
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          if( point[ dms ] < radius ) {
+            ++point[ dms ];
+            done = false;
+            break;
+          }
+          point[ dms ] = -radius;
+        }
+      }
+      sphere = ( in_sphere == adjs );
+      COMMENT( "Runs of consecutive displacements along dimension 0.", 2 );
+      std::set< size_t > lengths;
+      const std::vector< llint > *previous = nullptr;
+      for( const std::vector< llint > &key : element ) {
+        bool same_line = ( previous != nullptr ) && ( key[ dims - 1 ] == ( *previous )[ dims - 1 ] + 1 ) &&
+          std::equal( key.begin( ), key.end( ) - 1, previous->begin( ) );
+        if( same_line ) {
+          ++run_upper[ run_upper.size( ) - 1 ];
+        }
+        else {
+          run_lower.push_back( key[ dims - 1 ] );
+          run_upper.push_back( key[ dims - 1 ] );
+          run_shift.push_back( 0 );
+          for( size_t dms = 1; dms < dims; ++dms ) {
+            run_shift.push_back( key[ dms - 1 ] );
+          }
+        }
+        previous = &key;
+      }
+      for( size_t run = 0; run < run_lower.size( ); ++run ) {
+        lengths.insert( run_upper[ run ] - run_lower[ run ] + 1 );
+      }
+      run_lengths = Vector< size_t >( lengths.begin( ), lengths.end( ) );
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  size_t MorphologyLines::Cost( ) const {
+    size_t lines = 0;
+    for( size_t dms = 0; dms < dims; ++dms ) {
+      lines += ( upper[ dms ] > lower[ dms ] ) ? 1 : 0;
+    }
+    if( box ) {
+      return( 3 * lines );
+    }
+    if( cross ) {
+      return( 4 * lines );
+    }
+    size_t running = 0;
+    for( size_t length : run_lengths ) {
+      running += ( length > 1 ) ? 3 : 0;
+    }
+    return( running + run_lower.size( ) );
+  }
+
+  bool MorphologyLines::Efficient( ) const {
+    return( integral && ( Cost( ) < adjs ) );
+  }
+
+  bool MorphologyLines::Sphere( ) const {
+    return( sphere );
+  }
+
+  bool MorphologyLines::Distance( ) const {
+    return( integral && sphere && ( Cost( ) > distance_cost * dims ) );
+  }
+
+  template< class D, class C >
+  void MorphologyLines::RunningExtremum( const Vector< D > &line, size_t length, C extremum, Vector< D > &prefix,
+                                         Vector< D > &suffix, Vector< D > &res ) {
+    size_t size = line.size( );
+    for( size_t blk = 0; blk < size; blk += length ) {
+      size_t blk_end = std::min( size, blk + length );
+      prefix[ blk ] = line[ blk ];
+      for( size_t idx = blk + 1; idx < blk_end; ++idx ) {
+        prefix[ idx ] = extremum( prefix[ idx - 1 ], line[ idx ] );
+      }
+      suffix[ blk_end - 1 ] = line[ blk_end - 1 ];
+      for( size_t idx = blk_end - 1; idx > blk; --idx ) {
+        suffix[ idx - 1 ] = extremum( suffix[ idx ], line[ idx - 1 ] );
+      }
+    }
+    for( size_t idx = 0; idx + length <= size; ++idx ) {
+      res[ idx ] = extremum( suffix[ idx ], prefix[ idx + length - 1 ] );
+    }
+  }
+
+  template< class D, class C >
+  void MorphologyLines::LineExtremum( const Image< D > &src, size_t dms, llint low, llint high, D neutral,
+                                      C extremum, Image< D > &dst, bool combine ) {
+    try {
+      size_t size = src.size( dms );
+      size_t length = high - low + 1;
+      size_t stride = 1;
+      for( size_t prv = 0; prv < dms; ++prv ) {
+        stride *= src.size( prv );
+      }
+      size_t lines = src.size( ) / size;
+      ThreadPool::ParallelFor( 0, lines, std::max< size_t >( 1, 4096 / size ), [ & ]( size_t first, size_t last ) {
+          COMMENT( "Padded line with length - 1 neutral elements on each side.", 4 );
+          Vector< D > line( size + 2 * ( length - 1 ), neutral );
+          Vector< D > prefix( line.size( ) );
+          Vector< D > suffix( line.size( ) );
+          Vector< D > res( size + length - 1 );
+          for( size_t lne = first; lne < last; ++lne ) {
+            size_t base = ( lne / stride ) * stride * size + lne % stride;
+            for( size_t idx = 0; idx < size; ++idx ) {
+              line[ idx + length - 1 ] = src[ base + idx * stride ];
+            }
+            RunningExtremum( line, length, extremum, prefix, suffix, res );
+            COMMENT( "Window [ idx + low, idx + high ] starts at padded index idx + high.", 4 );
+            for( size_t idx = 0; idx < size; ++idx ) {
+              D &value = dst[ base + idx * stride ];
+              value = combine ? extremum( value, res[ idx + high ] ) : res[ idx + high ];
+            }
+          }
+        } );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D, class C >
+  Image< D > MorphologyLines::Extremum( const Image< D > &image, D neutral, C extremum ) const {
+    try {
+      if( image.Dims( ) != dims ) {
+        std::string msg( BIAL_ERROR( "Image and adjacency relation dimensions do not match." ) );
+        throw( std::logic_error( msg ) );
+      }
+      Image< D > res( image );
+      if( box ) {
+        COMMENT( "Separable box: one run per dimension over the result of the previous ones.", 2 );
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          if( upper[ dms ] > lower[ dms ] ) {
+            LineExtremum( res, dms, lower[ dms ], upper[ dms ], neutral, extremum, res, false );
+          }
+        }
+        return( res );
+      }
+      if( cross ) {
+        COMMENT( "Cross: one run per dimension over the input image.", 2 );
+        for( size_t dms = 0; dms < dims; ++dms ) {
+          if( upper[ dms ] > lower[ dms ] ) {
+            LineExtremum( image, dms, lower[ dms ], upper[ dms ], neutral, extremum, res, true );
+          }
+        }
+        return( res );
+      }
+      COMMENT( "Runs along dimension 0, shifted over the other dimensions.", 2 );
+      size_t size = image.size( 0 );
+      size_t lines = image.size( ) / size;
+      Vector< size_t > line_stride( dims, 1 );
+      for( size_t dms = 2; dms < dims; ++dms ) {
+        line_stride[ dms ] = line_stride[ dms - 1 ] * image.size( dms - 1 );
+      }
+      size_t grain = std::max< size_t >( 1, 4096 / size );
+      for( size_t length : run_lengths ) {
+        COMMENT( "Running extremum of the windows of this length, starting at each padded index.", 3 );
+        size_t padded = size + length - 1;
+        Vector< D > running;
+        if( length > 1 ) {
+          running = Vector< D >( lines * padded );
+          ThreadPool::ParallelFor( 0, lines, grain, [ & ]( size_t first, size_t last ) {
+              Vector< D > line( size + 2 * ( length - 1 ), neutral );
+              Vector< D > prefix( line.size( ) );
+              Vector< D > suffix( line.size( ) );
+              Vector< D > res_line( padded );
+              for( size_t lne = first; lne < last; ++lne ) {
+                std::copy( &image[ lne * size ], &image[ lne * size ] + size, &line[ length - 1 ] );
+                RunningExtremum( line, length, extremum, prefix, suffix, res_line );
+                std::copy( &res_line[ 0 ], &res_line[ 0 ] + padded, &running[ lne * padded ] );
+              }
+            } );
+        }
+        COMMENT( "Combining the shifted runs of this length.", 3 );
+        ThreadPool::ParallelFor( 0, lines, grain, [ & ]( size_t first, size_t last ) {
+            for( size_t lne = first; lne < last; ++lne ) {
+              D *target = &res[ lne * size ];
+              for( size_t run = 0; run < run_lower.size( ); ++run ) {
+                llint low = run_lower[ run ];
+                llint high = run_upper[ run ];
+                if( static_cast< size_t >( high - low + 1 ) != length ) {
+                  continue;
+                }
+                COMMENT( "Source line of the run, if it is in the image domain.", 4 );
+                llint src_line = static_cast< llint >( lne );
+                bool inside = true;
+                for( size_t dms = 1; ( dms < dims ) && ( inside ); ++dms ) {
+                  llint crd = static_cast< llint >( ( lne / line_stride[ dms ] ) % image.size( dms ) );
+                  llint shift = run_shift[ run * dims + dms ];
+                  inside = ( crd + shift >= 0 ) && ( crd + shift < static_cast< llint >( image.size( dms ) ) );
+                  src_line += shift * static_cast< llint >( line_stride[ dms ] );
+                }
+                if( !inside ) {
+                  continue;
+                }
+                COMMENT( "Pixels whose window [ x + low, x + high ] meets the line.", 4 );
+                llint first_x = std::max< llint >( 0, -high );
+                llint last_x = std::min< llint >( size, static_cast< llint >( size ) - low );
+                if( length == 1 ) {
+                  const D *source = &image[ src_line * size ] + low;
+                  for( llint x = first_x; x < last_x; ++x ) {
+                    target[ x ] = extremum( target[ x ], source[ x ] );
+                  }
+                }
+                else {
+                  const D *source = &running[ src_line * padded ] + high;
+                  for( llint x = first_x; x < last_x; ++x ) {
+                    target[ x ] = extremum( target[ x ], source[ x ] );
+                  }
+                }
+              }
+            }
+          } );
+      }
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > MorphologyLines::Dilate( const Image< D > &image ) const {
+    try {
+      return( Extremum( image, std::numeric_limits< D >::lowest( ), []( D fst, D snd ) {
+            return( fst < snd ? snd : fst );
+          } ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > MorphologyLines::Erode( const Image< D > &image ) const {
+    try {
+      return( Extremum( image, std::numeric_limits< D >::max( ), []( D fst, D snd ) {
+            return( snd < fst ? snd : fst );
+          } ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > MorphologyLines::DilateBin( const Image< D > &image ) const {
+    try {
+      COMMENT( "Object value and binary object.", 2 );
+      D value = 0;
+      Image< int > object( image );
+      for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
+        object[ pxl ] = ( image[ pxl ] != 0 ) ? 1 : 0;
+        if( object[ pxl ] != 0 ) {
+          value = image[ pxl ];
+        }
+      }
+      Image< D > res( image );
+      if( Distance( ) ) {
+        COMMENT( "Hypersphere: pixels within squared_radius from the object.", 2 );
+        for( size_t dms = 0; dms < object.Dims( ); ++dms ) {
+          object.PixelSize( dms, 1.0f );
+        }
+        Image< double > distance( Transform::SquaredEDT( object ) );
+        for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
+          if( distance[ pxl ] <= squared_radius ) {
+            res[ pxl ] = value;
+          }
+        }
+        return( res );
+      }
+      Image< int > dilation( Dilate( object ) );
+      for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
+        if( dilation[ pxl ] != 0 ) {
+          res[ pxl ] = value;
+        }
+      }
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > MorphologyLines::ErodeBin( const Image< D > &image ) const {
+    try {
+      Image< int > object( image );
+      for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
+        object[ pxl ] = ( image[ pxl ] != 0 ) ? 1 : 0;
+      }
+      Image< D > res( image );
+      if( Distance( ) ) {
+        COMMENT( "Hypersphere: object pixels within squared_radius from the background.", 2 );
+        for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
+          object[ pxl ] = 1 - object[ pxl ];
+        }
+        for( size_t dms = 0; dms < object.Dims( ); ++dms ) {
+          object.PixelSize( dms, 1.0f );
+        }
+        Image< double > distance( Transform::SquaredEDT( object ) );
+        for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
+          if( distance[ pxl ] <= squared_radius ) {
+            res[ pxl ] = 0;
+          }
+        }
+        return( res );
+      }
+      Image< int > erosion( Erode( object ) );
+      for( size_t pxl = 0; pxl < image.size( ); ++pxl ) {
+        if( erosion[ pxl ] == 0 ) {
+          res[ pxl ] = 0;
+        }
+      }
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_MorphologyLines
+
+  template Image< int > MorphologyLines::Dilate( const Image< int > &image ) const;
+  template Image< int > MorphologyLines::Erode( const Image< int > &image ) const;
+  template Image< int > MorphologyLines::DilateBin( const Image< int > &image ) const;
+  template Image< int > MorphologyLines::ErodeBin( const Image< int > &image ) const;
+
+  template Image< llint > MorphologyLines::Dilate( const Image< llint > &image ) const;
+  template Image< llint > MorphologyLines::Erode( const Image< llint > &image ) const;
+  template Image< llint > MorphologyLines::DilateBin( const Image< llint > &image ) const;
+  template Image< llint > MorphologyLines::ErodeBin( const Image< llint > &image ) const;
+
+  template Image< float > MorphologyLines::Dilate( const Image< float > &image ) const;
+  template Image< float > MorphologyLines::Erode( const Image< float > &image ) const;
+  template Image< float > MorphologyLines::DilateBin( const Image< float > &image ) const;
+  template Image< float > MorphologyLines::ErodeBin( const Image< float > &image ) const;
+
+  template Image< double > MorphologyLines::Dilate( const Image< double > &image ) const;
+  template Image< double > MorphologyLines::Erode( const Image< double > &image ) const;
+  template Image< double > MorphologyLines::DilateBin( const Image< double > &image ) const;
+  template Image< double > MorphologyLines::ErodeBin( const Image< double > &image ) const;
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,279 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Approximate k-nearest neighbor graph by NN-Descent, for high-dimensional feature vectors.
+ */
+
+#ifndef BIALNNDESCENT_C
+#define BIALNNDESCENT_C
+
+#include "NNDescent.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_NNDescent )
+#define BIAL_EXPLICIT_NNDescent
+#endif
+
+#if defined ( BIAL_EXPLICIT_NNDescent ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Feature.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace Bial {
+
+  template< class D >
+  NNDescent< D >::NNDescent( const Feature< D > &feature, size_t k, const DistanceKernel &kernel ) try :
+    feature( feature ), kernel( kernel ),
+    k( std::min( k, feature.Elements( ) > 0 ? feature.Elements( ) - 1 : 0 ) ),
+    neighbor( feature.Elements( ) * this->k ), neighbor_distance( feature.Elements( ) * this->k ),
+    neighbor_new( feature.Elements( ) * this->k ), neighbor_size( feature.Elements( ), 0 ) {
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D >
+  size_t NNDescent< D >::Insert( size_t elm, size_t nbr, double dist ) {
+    size_t *index = &neighbor[ elm * k ];
+    double *distance = &neighbor_distance[ elm * k ];
+    char *fresh = &neighbor_new[ elm * k ];
+    size_t size = neighbor_size[ elm ];
+    std::pair< double, size_t > candidate( dist, nbr );
+    if( ( size == k ) && !( candidate < std::make_pair( distance[ k - 1 ], index[ k - 1 ] ) ) ) {
+      return( 0 );
+    }
+    size_t pos = 0;
+    for( ; pos < size; ++pos ) {
+      if( index[ pos ] == nbr ) {
+        return( 0 );
+      }
+      if( candidate < std::make_pair( distance[ pos ], index[ pos ] ) ) {
+        break;
+      }
+    }
+    for( size_t nxt = pos; nxt < size; ++nxt ) {
+      if( index[ nxt ] == nbr ) {
+        return( 0 );
+      }
+    }
+    size_t end = std::min( size, k - 1 );
+    for( size_t nxt = end; nxt > pos; --nxt ) {
+      index[ nxt ] = index[ nxt - 1 ];
+      distance[ nxt ] = distance[ nxt - 1 ];
+      fresh[ nxt ] = fresh[ nxt - 1 ];
+    }
+    index[ pos ] = nbr;
+    distance[ pos ] = dist;
+    fresh[ pos ] = 1;
+    neighbor_size[ elm ] = end + 1;
+    return( 1 );
+  }
+
+  template< class D >
+  size_t NNDescent< D >::Run( size_t max_iterations, double delta, double sample_rate ) {
+    try {
+      size_t elements = feature.Elements( );
+      size_t features = feature.Features( );
+      const D *data = feature.data( );
+      if( k == 0 ) {
+        return( 0 );
+      }
+      COMMENT( "Initializing random neighbors. Small sets take all elements.", 1 );
+      ThreadPool::ParallelFor( 0, elements, 64, [ & ]( size_t first, size_t last ) {
+          for( size_t elm = first; elm < last; ++elm ) {
+            neighbor_size[ elm ] = 0;
+            if( 2 * k >= elements ) {
+              for( size_t nbr = 0; nbr < elements; ++nbr ) {
+                if( nbr != elm ) {
+                  Insert( elm, nbr, kernel.Distance( data + elm * features, data + nbr * features, features ) );
+                }
+              }
+            }
+            else {
+              std::mt19937 generator( static_cast< unsigned >( elm ) );
+              std::uniform_int_distribution< size_t > pick( 0, elements - 1 );
+              while( neighbor_size[ elm ] < k ) {
+                size_t nbr = pick( generator );
+                if( nbr != elm ) {
+                  Insert( elm, nbr, kernel.Distance( data + elm * features, data + nbr * features, features ) );
+                }
+              }
+            }
+          }
+        } );
+      size_t samples = std::max< size_t >( 1, static_cast< size_t >( sample_rate * k ) );
+      std::vector< std::mutex > lock( elements );
+      std::vector< std::vector< size_t > > new_list( elements );
+      std::vector< std::vector< size_t > > old_list( elements );
+      std::vector< std::vector< size_t > > reverse_new( elements );
+      std::vector< std::vector< size_t > > reverse_old( elements );
+      size_t iteration = 0;
+      while( iteration < max_iterations ) {
+        ++iteration;
+        COMMENT( "Iteration " << iteration << ". Splitting new and old neighbors, and their reverse.", 1 );
+        for( size_t elm = 0; elm < elements; ++elm ) {
+          new_list[ elm ].clear( );
+          old_list[ elm ].clear( );
+          reverse_new[ elm ].clear( );
+          reverse_old[ elm ].clear( );
+        }
+        for( size_t elm = 0; elm < elements; ++elm ) {
+          std::vector< size_t > fresh;
+          for( size_t pos = 0; pos < neighbor_size[ elm ]; ++pos ) {
+            size_t nbr = neighbor[ elm * k + pos ];
+            if( neighbor_new[ elm * k + pos ] != 0 ) {
+              fresh.push_back( pos );
+            }
+            else {
+              old_list[ elm ].push_back( nbr );
+              reverse_old[ nbr ].push_back( elm );
+            }
+          }
+          COMMENT( "Only the sampled new neighbors are joined and turn old.", 4 );
+          if( fresh.size( ) > samples ) {
+            std::mt19937 generator( static_cast< unsigned >( elm * max_iterations + iteration ) );
+            std::shuffle( fresh.begin( ), fresh.end( ), generator );
+            fresh.resize( samples );
+          }
+          for( size_t pos : fresh ) {
+            size_t nbr = neighbor[ elm * k + pos ];
+            neighbor_new[ elm * k + pos ] = 0;
+            new_list[ elm ].push_back( nbr );
+            reverse_new[ nbr ].push_back( elm );
+          }
+        }
+        COMMENT( "Joining up to the sample size of random reverse neighbors to each list.", 1 );
+        ThreadPool::ParallelFor( 0, elements, 64, [ & ]( size_t first, size_t last ) {
+            for( size_t elm = first; elm < last; ++elm ) {
+              std::mt19937 generator( static_cast< unsigned >( elm * max_iterations + iteration ) );
+              for( size_t lst = 0; lst < 2; ++lst ) {
+                std::vector< size_t > &reverse = lst == 0 ? reverse_new[ elm ] : reverse_old[ elm ];
+                std::vector< size_t > &list = lst == 0 ? new_list[ elm ] : old_list[ elm ];
+                if( reverse.size( ) > samples ) {
+                  std::shuffle( reverse.begin( ), reverse.end( ), generator );
+                  reverse.resize( samples );
+                }
+                list.insert( list.end( ), reverse.begin( ), reverse.end( ) );
+                std::sort( list.begin( ), list.end( ) );
+                list.erase( std::unique( list.begin( ), list.end( ) ), list.end( ) );
+              }
+            }
+          } );
+        COMMENT( "Local joins: new with new, and new with old neighbors.", 1 );
+        std::atomic< size_t > updates( 0 );
+        auto join = [ & ]( size_t elm, size_t other ) {
+          double dist = kernel.Distance( data + elm * features, data + other * features, features );
+          size_t count = 0;
+          {
+            std::lock_guard< std::mutex > guard( lock[ elm ] );
+            count += Insert( elm, other, dist );
+          }
+          {
+            std::lock_guard< std::mutex > guard( lock[ other ] );
+            count += Insert( other, elm, dist );
+          }
+          return( count );
+        };
+        ThreadPool::ParallelFor( 0, elements, 16, [ & ]( size_t first, size_t last ) {
+            size_t count = 0;
+            for( size_t elm = first; elm < last; ++elm ) {
+              const std::vector< size_t > &fresh = new_list[ elm ];
+              const std::vector< size_t > &old = old_list[ elm ];
+              for( size_t idx = 0; idx < fresh.size( ); ++idx ) {
+                for( size_t nxt = idx + 1; nxt < fresh.size( ); ++nxt ) {
+                  count += join( fresh[ idx ], fresh[ nxt ] );
+                }
+                for( size_t nxt = 0; nxt < old.size( ); ++nxt ) {
+                  if( fresh[ idx ] != old[ nxt ] ) {
+                    count += join( fresh[ idx ], old[ nxt ] );
+                  }
+                }
+              }
+            }
+            updates += count;
+          } );
+        COMMENT( "Updates: " << updates, 1 );
+        if( static_cast< double >( updates ) < delta * k * elements ) {
+          break;
+        }
+      }
+      return( iteration );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  size_t NNDescent< D >::Neighbors( size_t src, size_t *index, double *distance ) const {
+    try {
+      size_t size = neighbor_size( src );
+      std::copy( &neighbor[ src * k ], &neighbor[ src * k ] + size, index );
+      std::copy( &neighbor_distance[ src * k ], &neighbor_distance[ src * k ] + size, distance );
+      return( size );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_NNDescent
+
+  template class NNDescent< int >;
+  template class NNDescent< llint >;
+  template class NNDescent< float >;
+  template class NNDescent< double >;
+
+#endif
+
+}
+
+#endif
+
+#endif
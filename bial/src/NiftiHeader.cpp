@@ -42,7 +42,8 @@ namespace Bial {
         time_units( NiftiUnit::UNKNOWN ), cal_max( 0.0 ), cal_min( 0.0 ), slice_duration( 0.0 ), toffset( 0.0 ), 
         glmax( 255 ), glmin( 0 ), descrip( 80, '\0' ), aux_file( 24, '\0' ), qform_code( NiftiXForm::UNKNOWN ), 
         sform_code( NiftiXForm::UNKNOWN ), quatern_b( 0.0 ), quatern_c( 0.0 ), quatern_d( 0.0 ), qoffset_x( 0.0 ), 
-        qoffset_y( 0.0 ), qoffset_z( 0.0 ), qfac( 1.0 ), qtm( 4, 4 ), stm( 4, 4 ), intent_name( 16, '\0' ) {
+        qoffset_y( 0.0 ), qoffset_z( 0.0 ), qfac( 1.0 ), qtm( 4, 4 ), stm( 4, 4 ), intent_name( 16, '\0' ),
+        swapped( false ) {
       qtm.Set( 0.0 );
       stm.Set( 0.0 );
       qtm[ 15 ] = 1.0;
@@ -75,7 +76,8 @@ namespace Bial {
         time_units( NiftiUnit::UNKNOWN ), cal_max( 0.0 ), cal_min( 0.0 ), slice_duration( 0.0 ), toffset( 0.0 ), 
         glmax( 255 ), glmin( 0 ), descrip( 80, '\0' ), aux_file( 24, '\0' ), qform_code( NiftiXForm::UNKNOWN ), 
         sform_code( NiftiXForm::UNKNOWN ), quatern_b( 0.0 ), quatern_c( 0.0 ), quatern_d( 0.0 ), qoffset_x( 0.0 ), 
-        qoffset_y( 0.0 ), qoffset_z( 0.0 ), qfac( 1.0 ), qtm( 4, 4 ), stm( 4, 4 ), intent_name( 16, '\0' ) {
+        qoffset_y( 0.0 ), qoffset_z( 0.0 ), qfac( 1.0 ), qtm( 4, 4 ), stm( 4, 4 ), intent_name( 16, '\0' ),
+        swapped( false ) {
 
       qtm.Set( 0.0 );
       stm.Set( 0.0 );
@@ -114,7 +116,7 @@ namespace Bial {
         slice_duration( 0.0 ), toffset( 0.0 ), glmax( 255 ), glmin( 0 ), descrip( 80, '\0' ), aux_file( 24, '\0' ),
         qform_code( NiftiXForm::UNKNOWN ), sform_code( NiftiXForm::UNKNOWN ), quatern_b( 0.0 ), quatern_c( 0.0 ),
         quatern_d( 0.0 ), qoffset_x( 0.0 ), qoffset_y( 0.0 ), qoffset_z( 0.0 ), qfac( 1.0 ), qtm( 4, 4 ), stm( 4, 4 ),
-        intent_name( 16, '\0' ) {
+        intent_name( 16, '\0' ), swapped( false ) {
       if( img.Dims( ) == 2 )
         dim.pop_back( );
       qtm.Set( 0.0 );
@@ -153,7 +155,8 @@ namespace Bial {
         time_units( NiftiUnit::UNKNOWN ), cal_max( 0.0 ), cal_min( 0.0 ), slice_duration( 0.0 ), toffset( 0.0 ), 
         glmax( 255 ), glmin( 0 ), descrip( 80, '\0' ), aux_file( 24, '\0' ), qform_code( NiftiXForm::UNKNOWN ), 
         sform_code( NiftiXForm::UNKNOWN ), quatern_b( 0.0 ), quatern_c( 0.0 ), quatern_d( 0.0 ), qoffset_x( 0.0 ),
-        qoffset_y( 0.0 ), qoffset_z( 0.0 ), qfac( 1.0 ), qtm( 4, 4 ), stm( 4, 4 ), intent_name( 16, '\0' ) {
+        qoffset_y( 0.0 ), qoffset_z( 0.0 ), qfac( 1.0 ), qtm( 4, 4 ), stm( 4, 4 ), intent_name( 16, '\0' ),
+        swapped( false ) {
       
       /* Opening file. */
       std::string hdrname( NiftiHeader::ExistingHeaderFileName( filename ) );
@@ -278,6 +281,7 @@ namespace Bial {
       if( swap ) {
         Swap( );
       }
+      swapped = swap;
       if( ( datatype != NiftiType::UINT8 ) && ( datatype != NiftiType::INT16 ) && ( datatype != NiftiType::INT32 ) &&
           ( datatype != NiftiType::INT64 ) && ( datatype != NiftiType::FLOAT32 ) && ( datatype != NiftiType::FLOAT64 )
           && ( datatype != NiftiType::INT8 ) && ( datatype != NiftiType::UINT16 ) && ( datatype != NiftiType::UINT32 )
@@ -375,6 +379,14 @@ namespace Bial {
     return( datatype );
   }
 
+  bool NiftiHeader::Swapped( ) const {
+    return( swapped );
+  }
+
+  size_t NiftiHeader::VoxOffset( ) const {
+    return( static_cast< size_t >( std::max( vox_offset, 0.0f ) ) );
+  }
+
   NiftiHeader NiftiHeader::Read( const std::string &filename ) {
     try {
       return( NiftiHeader( filename ) );
@@ -0,0 +1,418 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Zero-copy reading of uncompressed Nifti files through memory mapping.
+ */
+
+#ifndef BIALNIFTIMAPPING_C
+#define BIALNIFTIMAPPING_C
+
+#include "NiftiMapping.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_NiftiMapping )
+#define BIAL_EXPLICIT_NiftiMapping
+#endif
+
+#if defined ( BIAL_EXPLICIT_NiftiMapping ) || ( BIAL_IMPLICIT_BIN )
+
+#include "File.hpp"
+#include "Image.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace Bial {
+
+  NiftiMapping::NiftiMapping( const std::string &filename ) try : NiftiMapping( filename, NiftiHeader( filename ) ) {
+  }
+  catch( std::ios_base::failure &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/reading/mapping Nifti file." ) );
+    throw( std::ios_base::failure( msg ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  NiftiMapping::NiftiMapping( const std::string &filename, const NiftiHeader &header ) try
+    : hdr( header ), mapping( MappableFileName( filename ) ), offset( 0 ), elements( 1 ), spc_dims( ), pixel_size( ),
+      native( !header.Swapped( ) ) {
+    const Vector< size_t > &dim = hdr.Dim( );
+    const Vector< float > &pixdim = hdr.PixelSize( );
+    COMMENT( "Checking for time series and channels.", 2 );
+    if( ( dim.size( ) > 3 ) && ( dim[ 3 ] > 1 ) ) {
+      std::string msg( BIAL_ERROR( "Cannot map Nifti time series." ) );
+      throw( std::logic_error( msg ) );
+    }
+    if( ( dim.size( ) > 4 ) && ( dim[ 4 ] > 1 ) ) {
+      std::string msg( BIAL_ERROR( "Cannot map multi-channel Nifti image." ) );
+      throw( std::logic_error( msg ) );
+    }
+    COMMENT( "Setting image and pixel dimensions.", 2 );
+    spc_dims = Vector< size_t >( { dim[ 0 ], dim[ 1 ] } );
+    pixel_size = Vector< float >( { pixdim[ 0 ], pixdim[ 1 ] } );
+    if( dim.size( ) > 2 ) {
+      spc_dims.push_back( dim[ 2 ] );
+      pixel_size.push_back( pixdim[ 2 ] );
+    }
+    for( size_t dms = 0; dms < spc_dims.size( ); ++dms ) {
+      elements *= spc_dims[ dms ];
+    }
+    COMMENT( "Data of .nii files starts after the header and its extensions.", 2 );
+    std::string imgname( MappableFileName( filename ) );
+    std::string extension( File::ToLowerExtension( imgname, imgname.size( ) - std::min( imgname.size( ),
+                                                                                    static_cast< size_t >( 4 ) ) ) );
+    if( extension.compare( ".nii" ) == 0 ) {
+      offset = std::max( hdr.VoxOffset( ), static_cast< size_t >( NiftiHeader::NIFTI_HEADER_SIZE + 4 ) );
+    }
+    size_t bytes = elements * static_cast< size_t >( hdr.BitPix( ) / 8 );
+    if( offset + bytes > mapping.Size( ) ) {
+      std::string msg( BIAL_ERROR( "Nifti data file is shorter than stated in its header." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+  }
+  catch( std::ios_base::failure &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error opening/reading/mapping Nifti file." ) );
+    throw( std::ios_base::failure( msg ) );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  std::string NiftiMapping::MappableFileName( const std::string &filename ) {
+    try {
+      std::string imgname( NiftiHeader::ExistingDataFileName( filename ) );
+      if( !IsMappable( imgname ) ) {
+        std::string msg( BIAL_ERROR( "Cannot map compressed Nifti file " + imgname + "." ) );
+        throw( std::logic_error( msg ) );
+      }
+      return( imgname );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  bool NiftiMapping::IsMappable( const std::string &filename ) {
+    try {
+      std::string imgname( NiftiHeader::ExistingDataFileName( filename ) );
+      std::string extension( File::ToLowerExtension( imgname, imgname.size( ) - std::min( imgname.size( ),
+                                                                                      static_cast< size_t >( 3 ) ) ) );
+      return( extension.compare( ".gz" ) != 0 );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  const NiftiHeader &NiftiMapping::Header( ) const {
+    return( hdr );
+  }
+
+  template< class S >
+  S NiftiMapping::SwapBytes( S val ) {
+    char *byte = reinterpret_cast< char* >( &val );
+    std::reverse( byte, byte + sizeof( S ) );
+    return( val );
+  }
+
+  template< class S, class D >
+  void NiftiMapping::Convert( const char *src, bool swap, D *dst, size_t size ) {
+    auto body = [ src, swap, dst ]( size_t first, size_t last ) {
+      if( swap ) {
+        for( size_t pxl = first; pxl < last; ++pxl ) {
+          S val;
+          std::memcpy( &val, src + pxl * sizeof( S ), sizeof( S ) );
+          val = SwapBytes( val );
+          if( std::is_floating_point< S >::value && !std::isfinite( val ) ) {
+            dst[ pxl ] = static_cast< D >( 0 );
+          }
+          else {
+            dst[ pxl ] = static_cast< D >( val );
+          }
+        }
+      }
+      else {
+#pragma omp simd
+        for( size_t pxl = first; pxl < last; ++pxl ) {
+          S val;
+          std::memcpy( &val, src + pxl * sizeof( S ), sizeof( S ) );
+          if( std::is_floating_point< S >::value && !std::isfinite( val ) ) {
+            dst[ pxl ] = static_cast< D >( 0 );
+          }
+          else {
+            dst[ pxl ] = static_cast< D >( val );
+          }
+        }
+      }
+    };
+    size_t blocks = ( size + GRAIN - 1 ) / GRAIN;
+    ThreadPool::ParallelFor( 0, blocks, 1, [ &body, size ]( size_t first, size_t last ) {
+        body( first * GRAIN, std::min( last * GRAIN, size ) );
+      } );
+  }
+
+  template< class D >
+  bool NiftiMapping::IsZeroCopy( ) const {
+    return( ( hdr.DataType( ) == NiftiHeader::DataTypeDecode( D( ) ) ) &&
+            ( reinterpret_cast< size_t >( mapping.Data( ) + offset ) % alignof( D ) == 0 ) );
+  }
+
+  template< class D >
+  Image< D > NiftiMapping::View( ) {
+    try {
+      if( !IsZeroCopy< D >( ) ) {
+        COMMENT( "Stored type differs from D. Converting.", 2 );
+        return( Read< D >( ) );
+      }
+      char *data = mapping.Data( ) + offset;
+      if( ( !native ) && ( sizeof( D ) > 1 ) ) {
+        COMMENT( "Swapping bytes in place, in private pages of the mapping.", 2 );
+        size_t size = elements;
+        size_t blocks = ( size + GRAIN - 1 ) / GRAIN;
+        ThreadPool::ParallelFor( 0, blocks, 1, [ data, size ]( size_t first, size_t last ) {
+            size_t first_pxl = first * GRAIN;
+            size_t last_pxl = std::min( last * GRAIN, size );
+            NiftiHeader::SwapNBytes( last_pxl - first_pxl, sizeof( D ), data + first_pxl * sizeof( D ) );
+          } );
+      }
+      native = true;
+      COMMENT( "Wrapping mapped data.", 2 );
+      Image< D > res( reinterpret_cast< D* >( data ), spc_dims );
+      for( size_t dms = 0; dms < spc_dims.size( ); ++dms ) {
+        res.PixelSize( dms, pixel_size[ dms ] );
+      }
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > NiftiMapping::Read( ) const {
+    try {
+      COMMENT( "Creating resultant image. Every pixel is converted, so it is not zeroed.", 2 );
+      Image< D > res( spc_dims, StorageInit::None );
+      for( size_t dms = 0; dms < spc_dims.size( ); ++dms ) {
+        res.PixelSize( dms, pixel_size[ dms ] );
+      }
+      Read( 0, elements, &res[ 0 ] );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void NiftiMapping::Read( size_t first, size_t size, D *dst ) const {
+    try {
+      if( ( first > elements ) || ( size > elements - first ) ) {
+        std::string msg( BIAL_ERROR( "Pixel range " + std::to_string( first ) + " + " + std::to_string( size ) +
+                                     " exceeds image size " + std::to_string( elements ) + "." ) );
+        throw( std::out_of_range( msg ) );
+      }
+      size_t bytes = static_cast< size_t >( hdr.BitPix( ) / 8 );
+      mapping.WillNeed( offset + first * bytes, size * bytes );
+      ConvertData( hdr.DataType( ), mapping.Data( ) + offset + first * bytes, !native, dst, size );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, D *dst, size_t size ) {
+    try {
+      COMMENT( "Data type conversion.", 2 );
+      switch( type ) {
+        case NiftiType::INT8:
+          Convert< signed char >( src, swap, dst, size );
+          break;
+        case NiftiType::UINT8:
+          Convert< unsigned char >( src, swap, dst, size );
+          break;
+        case NiftiType::INT16:
+          Convert< short >( src, swap, dst, size );
+          break;
+        case NiftiType::UINT16:
+          Convert< unsigned short >( src, swap, dst, size );
+          break;
+        case NiftiType::INT32:
+          Convert< int >( src, swap, dst, size );
+          break;
+        case NiftiType::UINT32:
+          Convert< unsigned int >( src, swap, dst, size );
+          break;
+        case NiftiType::INT64:
+          Convert< llint >( src, swap, dst, size );
+          break;
+        case NiftiType::UINT64:
+          Convert< unsigned long long >( src, swap, dst, size );
+          break;
+        case NiftiType::FLOAT32:
+          Convert< float >( src, swap, dst, size );
+          break;
+        case NiftiType::FLOAT64:
+          Convert< double >( src, swap, dst, size );
+          break;
+        default: {
+          std::string msg( BIAL_ERROR( "Unsupported nifti data type." ) );
+          throw( std::logic_error( msg ) );
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_NiftiMapping
+
+  template bool NiftiMapping::IsZeroCopy< int >( ) const;
+  template Image< int > NiftiMapping::View< int >( );
+  template Image< int > NiftiMapping::Read< int >( ) const;
+  template void NiftiMapping::Read( size_t first, size_t size, int *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, int *dst, size_t size );
+  template bool NiftiMapping::IsZeroCopy< llint >( ) const;
+  template Image< llint > NiftiMapping::View< llint >( );
+  template Image< llint > NiftiMapping::Read< llint >( ) const;
+  template void NiftiMapping::Read( size_t first, size_t size, llint *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, llint *dst, size_t size );
+  template bool NiftiMapping::IsZeroCopy< float >( ) const;
+  template Image< float > NiftiMapping::View< float >( );
+  template Image< float > NiftiMapping::Read< float >( ) const;
+  template void NiftiMapping::Read( size_t first, size_t size, float *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, float *dst, size_t size );
+  template bool NiftiMapping::IsZeroCopy< double >( ) const;
+  template Image< double > NiftiMapping::View< double >( );
+  template Image< double > NiftiMapping::Read< double >( ) const;
+  template void NiftiMapping::Read( size_t first, size_t size, double *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, double *dst, size_t size );
+  template void NiftiMapping::Read( size_t first, size_t size, signed char *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, signed char *dst, size_t size );
+  template void NiftiMapping::Read( size_t first, size_t size, uchar *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, uchar *dst, size_t size );
+  template void NiftiMapping::Read( size_t first, size_t size, short *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, short *dst, size_t size );
+  template void NiftiMapping::Read( size_t first, size_t size, ushort *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, ushort *dst, size_t size );
+  template void NiftiMapping::Read( size_t first, size_t size, uint *dst ) const;
+  template void NiftiMapping::ConvertData( NiftiType type, const char *src, bool swap, uint *dst, size_t size );
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -19,17 +19,17 @@
 
 #include "Adjacency.hpp"
 #include "AdjacencyIterator.hpp"
-#include "DFIDE.hpp"
 #include "Feature.hpp"
 #include "Image.hpp"
 #include "ImageIFT.hpp"
 #include "MinPathFunction.hpp"
+#include "ThreadPool.hpp"
 
 namespace Bial {
 
   template< class D >
   size_t OPF::SpacialClustering( const Feature< D > &feature, Image< int > &label, const Adjacency &adjacency,
-                                 float intensity_fraction ) {
+                                 float intensity_fraction, const DistanceKernel &kernel ) {
     COMMENT(
 	    "Sanity check: verify if feature, label and adjacency dimensions are compatible, and if intensity_fraction"
 	    << " is in the expected range.",
@@ -55,10 +55,10 @@ namespace Bial {
       COMMENT( "Creating density image for IFT computation.", 0 );
       Image< float > density( label.Dim( ), label.PixelSize( ) );
       COMMENT( "Computing arc weights.", 0 );
-      float max_weight = OPF::MaxWeight( feature, label, adjacency, intensity_fraction );
+      float max_weight = OPF::MaxWeight( feature, label, adjacency, intensity_fraction, kernel );
       COMMENT( "max_weight: " << max_weight, 1 );
       COMMENT( "Computing PDF", 0 );
-      float delta = OPF::PDF( feature, adjacency, density, max_weight );
+      float delta = OPF::PDF( feature, adjacency, density, max_weight, kernel );
       COMMENT( "delta: " << delta, 1 );
       COMMENT( "Clustering.", 1 );
       MinPathFunction< Image, float > pf( density + delta, delta );
@@ -90,21 +90,15 @@ namespace Bial {
 
   template< class D >
   float OPF::MaxWeight( const Feature< D > &feature, Image< int > &label, const Adjacency &adjacency,
-                        float intensity_fraction ) {
+                        float intensity_fraction, const DistanceKernel &kernel ) {
     try {
       COMMENT( "Computing the maximum arc weight.", 1 );
-      size_t total_threads = 12;
-      Vector< float > max_distance( total_threads, 0.0 );
-      Vector< std::thread > threads;
-      for( size_t thd = 0; thd < total_threads; ++thd ) {
-        threads.push_back( std::thread( &OPF::MaxWeightThread< D >, std::ref( feature ), std::ref( label ),
-                                        std::ref( adjacency ), std::ref( max_distance( thd ) ),
-                                        thd, total_threads ) );
-      }
-      for( size_t thd = 0; thd < total_threads; ++thd ) {
-        threads( thd ).join( );
-      }
-      for( size_t thd = 1; thd < total_threads; ++thd ) {
+      size_t total_tasks = ThreadPool::Tasks( label.size( ) );
+      Vector< float > max_distance( total_tasks, 0.0 );
+      ThreadPool::Run( total_tasks, [ & ]( size_t thd, size_t total_threads ) {
+          OPF::MaxWeightThread( feature, label, adjacency, max_distance( thd ), thd, total_threads, kernel );
+        } );
+      for( size_t thd = 1; thd < total_tasks; ++thd ) {
         max_distance( 0 ) = std::max( max_distance( 0 ), max_distance( thd ) );
       }
       return( static_cast< float >( intensity_fraction ) * max_distance( 0 ) );
@@ -112,24 +106,26 @@ namespace Bial {
     catch( std::exception &e ) {
       BIAL_WARNING( "Failed to run in multi-thread. Exception: " << e.what( ) );
       float max_distance = 0.0;
-      MaxWeightThread( feature, label, adjacency, max_distance, 0, 1 );
+      MaxWeightThread( feature, label, adjacency, max_distance, 0, 1, kernel );
       return( static_cast< float >( intensity_fraction ) * max_distance );
     }
   }
 
   template< class D >
   void OPF::MaxWeightThread( const Feature< D > &feature, Image< int > &label, const Adjacency &adjacency,
-                             float &max_distance, size_t thread, size_t total_threads ) {
+                             float &max_distance, size_t thread, size_t total_threads,
+                             const DistanceKernel &kernel ) {
     try {
       size_t size = label.size( );
       size_t min_pxl = thread * size / total_threads;
       size_t max_pxl = ( thread + 1 ) * size / total_threads;
+      size_t features = feature.Features( );
       COMMENT( "Computing distance from all samples.", 2 );
       for( size_t pxl = min_pxl; pxl < max_pxl; ++pxl ) {
         for( AdjacencyIterator itr = begin( adjacency, label, pxl ); *itr != size; ++itr ) {
           size_t adj_pxl = *itr;
-          double distance = DFIDE::Distance( feature, pxl * feature.Features( ), adj_pxl * feature.Features( ),
-                                             feature.Features( ) );
+          double distance = kernel.Distance( feature.data( ) + pxl * features, feature.data( ) + adj_pxl * features,
+                                             features );
           /* float distance = ( *BialDistanceFunction )( &feature( pxl, 0 ), &feature( adj_pxl, 0 ), feature.Features( )
            * ); 
 	   */
@@ -159,7 +155,7 @@ namespace Bial {
 
   template< class D >
   float OPF::PDF( const Feature< D > &feature, const Adjacency &adjacency, Image< float > &density,
-                  float max_weight ) {
+                  float max_weight, const DistanceKernel &kernel ) {
     COMMENT( "Computing sigma or variance of gaussian.", 1 );
     float sigma = ( 2.0 * max_weight / 9.0 );
     if( sigma == 0.0 ) {
@@ -167,18 +163,12 @@ namespace Bial {
     }
     COMMENT( "sigma: " << sigma, 2 );
     try {
-      size_t total_threads = 12;
-      Vector< float > max_dens_diff( total_threads, 0.0 );
-      Vector< std::thread > threads;
-      for( size_t thd = 0; thd < total_threads; ++thd ) {
-        threads.push_back( std::thread( &OPF::PDFThread< D >, std::ref( feature ), std::ref( adjacency ),
-                                        std::ref( density ), sigma, std::ref( max_dens_diff( thd ) ), thd,
-                                        total_threads ) );
-      }
-      for( size_t thd = 0; thd < total_threads; ++thd ) {
-        threads( thd ).join( );
-      }
-      for( size_t thd = 1; thd < total_threads; ++thd ) {
+      size_t total_tasks = ThreadPool::Tasks( density.size( ) );
+      Vector< float > max_dens_diff( total_tasks, 0.0 );
+      ThreadPool::Run( total_tasks, [ & ]( size_t thd, size_t total_threads ) {
+          OPF::PDFThread( feature, adjacency, density, sigma, max_dens_diff( thd ), thd, total_threads, kernel );
+        } );
+      for( size_t thd = 1; thd < total_tasks; ++thd ) {
         max_dens_diff( 0 ) = std::max( max_dens_diff( 0 ), max_dens_diff( thd ) );
       }
       return( max_dens_diff( 0 ) / 10000.0 );
@@ -186,18 +176,20 @@ namespace Bial {
     catch( std::exception &e ) {
       BIAL_WARNING( "Failed to run in multi-thread. Exception: " << e.what( ) );
       float max_dens_diff = 0.0;
-      PDFThread( feature, adjacency, density, sigma, max_dens_diff, 0, 1 );
+      PDFThread( feature, adjacency, density, sigma, max_dens_diff, 0, 1, kernel );
       return( max_dens_diff / 10000.0 );
     }
   }
 
   template< class D >
   float OPF::PDFThread( const Feature< D > &feature, const Adjacency &adjacency, Image< float > &density, float sigma,
-                        float &max_dens_diff, size_t thread, size_t total_threads ) {
+                        float &max_dens_diff, size_t thread, size_t total_threads,
+                        const DistanceKernel &kernel ) {
     try {
       size_t size = density.size( );
       size_t min_pxl = thread * size / total_threads;
       size_t max_pxl = ( thread + 1 ) * size / total_threads;
+      size_t features = feature.Features( );
       float mindens = std::numeric_limits< float >::max( );
       float maxdens = std::numeric_limits< float >::min( );
       COMMENT( "Computing nodes density and the minimal and maximal densities.", 2 );
@@ -206,8 +198,8 @@ namespace Bial {
         size_t pixels = 1;
         for( AdjacencyIterator itr = begin( adjacency, density, pxl ); *itr != size; ++itr ) {
           size_t adj_pxl = *itr;
-          double arc_weight = DFIDE::Distance( feature, pxl * feature.Features( ), adj_pxl * feature.Features( ),
-                                               feature.Features( ) );
+          double arc_weight = kernel.Distance( feature.data( ) + pxl * features,
+                                               feature.data( ) + adj_pxl * features, features );
           /* float arc_weight = ( *BialDistanceFunction )( &feature( pxl, 0 ), &feature( adj_pxl, 0 ), feature.Features(
            * ) ); 
 	   */
@@ -253,56 +245,68 @@ namespace Bial {
 #ifdef BIAL_EXPLICIT_OPFSpatialClustering
 
   template size_t OPF::SpacialClustering( const Feature< int > &feature, Image< int > &label, 
-				     const Adjacency &adjacency, float intensity_fraction );
+				     const Adjacency &adjacency, float intensity_fraction,
+				     const DistanceKernel &kernel );
   template float OPF::MaxWeight( const Feature< int > &feature, Image< int > &label,
-				 const Adjacency &adjacency, float intensity_fraction );
+				 const Adjacency &adjacency, float intensity_fraction,
+				 const DistanceKernel &kernel );
   template void OPF::MaxWeightThread( const Feature< int > &feature, Image< int > &label,
 				      const Adjacency &adjacency, float &max_distance,
-				      size_t thread, size_t total_threads );
+				      size_t thread, size_t total_threads,
+				      const DistanceKernel &kernel );
   template float OPF::PDF( const Feature< int > &feature, const Adjacency &adjacency, Image< float > &density,
-			   float max_weight );
+			   float max_weight, const DistanceKernel &kernel );
   template float OPF::PDFThread( const Feature< int > &feature, const Adjacency &adjacency, 
 				 Image< float > &density, float sigma, float &max_dens_diff, size_t thread,
-				 size_t total_threads );
+				 size_t total_threads, const DistanceKernel &kernel );
 
   template size_t OPF::SpacialClustering( const Feature< llint > &feature, Image< int > &label, 
-				     const Adjacency &adjacency, float intensity_fraction );
+				     const Adjacency &adjacency, float intensity_fraction,
+				     const DistanceKernel &kernel );
   template float OPF::MaxWeight( const Feature< llint > &feature, Image< int > &label,
-				 const Adjacency &adjacency, float intensity_fraction );
+				 const Adjacency &adjacency, float intensity_fraction,
+				 const DistanceKernel &kernel );
   template void OPF::MaxWeightThread( const Feature< llint > &feature, Image< int > &label,
 				      const Adjacency &adjacency, float &max_distance,
-				      size_t thread, size_t total_threads );
+				      size_t thread, size_t total_threads,
+				      const DistanceKernel &kernel );
   template float OPF::PDF( const Feature< llint > &feature, const Adjacency &adjacency, Image< float > &density,
-			   float max_weight );
+			   float max_weight, const DistanceKernel &kernel );
   template float OPF::PDFThread( const Feature< llint > &feature, const Adjacency &adjacency, 
 				 Image< float > &density, float sigma, float &max_dens_diff, size_t thread,
-				 size_t total_threads );
+				 size_t total_threads, const DistanceKernel &kernel );
 
   template size_t OPF::SpacialClustering( const Feature< float > &feature, Image< int > &label,
-                                          const Adjacency &adjacency, float intensity_fraction );
+                                          const Adjacency &adjacency, float intensity_fraction,
+                                          const DistanceKernel &kernel );
   template float OPF::MaxWeight( const Feature< float > &feature, Image< int > &label,
-				 const Adjacency &adjacency, float intensity_fraction );
+				 const Adjacency &adjacency, float intensity_fraction,
+				 const DistanceKernel &kernel );
   template void OPF::MaxWeightThread( const Feature< float > &feature, Image< int > &label,
 				      const Adjacency &adjacency, float &max_distance,
-				      size_t thread, size_t total_threads );
+				      size_t thread, size_t total_threads,
+				      const DistanceKernel &kernel );
   template float OPF::PDF( const Feature< float > &feature, const Adjacency &adjacency, Image< float > &density,
-			   float max_weight );
+			   float max_weight, const DistanceKernel &kernel );
   template float OPF::PDFThread( const Feature< float > &feature, const Adjacency &adjacency, 
 				 Image< float > &density, float sigma, float &max_dens_diff, size_t thread,
-				 size_t total_threads );
+				 size_t total_threads, const DistanceKernel &kernel );
 
   template size_t OPF::SpacialClustering( const Feature< double > &feature, Image< int > &label, 
-				     const Adjacency &adjacency, float intensity_fraction );
+				     const Adjacency &adjacency, float intensity_fraction,
+				     const DistanceKernel &kernel );
   template float OPF::MaxWeight( const Feature< double > &feature, Image< int > &label,
-				 const Adjacency &adjacency, float intensity_fraction );
+				 const Adjacency &adjacency, float intensity_fraction,
+				 const DistanceKernel &kernel );
   template void OPF::MaxWeightThread( const Feature< double > &feature, Image< int > &label,
 				      const Adjacency &adjacency, float &max_distance,
-				      size_t thread, size_t total_threads );
+				      size_t thread, size_t total_threads,
+				      const DistanceKernel &kernel );
   template float OPF::PDF( const Feature< double > &feature, const Adjacency &adjacency, Image< float > &density,
-			   float max_weight );
+			   float max_weight, const DistanceKernel &kernel );
   template float OPF::PDFThread( const Feature< double > &feature, const Adjacency &adjacency, 
 				 Image< float > &density, float sigma, float &max_dens_diff, size_t thread,
-				 size_t total_threads );
+				 size_t total_threads, const DistanceKernel &kernel );
 
 #endif
 
@@ -179,7 +179,7 @@ namespace Bial {
   }
 
   template< class D >
-  inline bool OrientedInternPathFunction< D >::Capable( int index, int adj_index, BucketState adj_state ) {
+  inline bool OrientedInternPathFunction< D >::Capable( size_t index, size_t adj_index, BucketState adj_state ) {
     try {
       return( ( adj_state != BucketState::REMOVED ) && 
               ( this->value->operator()( index ) < this->value->operator()( adj_index ) ) );
@@ -203,7 +203,7 @@ namespace Bial {
   }
 
   template< class D >
-  bool OrientedInternPathFunction< D >::Propagate( int index, int adj_index ) {
+  bool OrientedInternPathFunction< D >::Propagate( size_t index, size_t adj_index ) {
     try {
       D src_value = this->value->operator()( adj_index );
       COMMENT( "Computing arc weight.", 3 );
@@ -224,8 +224,13 @@ namespace Bial {
       ++arc_weight;
       COMMENT( "Zero weight edges.", 3 );
       if( geodesic_restriction != nullptr ) {
-        if( ( ( this->label->operator()( index ) != 0 ) && ( ( *geodesic_restriction )[ index ] == adj_index ) ) ||
-            ( ( this->label->operator()( index ) == 0 ) && ( ( *geodesic_restriction )[ adj_index ] == index ) ) ) {
+        COMMENT( "Restriction holds predecessors. Negative values are roots, which match no pixel.", 3 );
+        int idx_pred = ( *geodesic_restriction )[ index ];
+        int adj_pred = ( *geodesic_restriction )[ adj_index ];
+        if( ( ( this->label->operator()( index ) != 0 ) && ( idx_pred >= 0 ) &&
+              ( static_cast< size_t >( idx_pred ) == adj_index ) ) ||
+            ( ( this->label->operator()( index ) == 0 ) && ( adj_pred >= 0 ) &&
+              ( static_cast< size_t >( adj_pred ) == index ) ) ) {
           arc_weight = 0;
         }
       }
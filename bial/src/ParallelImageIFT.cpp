@@ -0,0 +1,364 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief IFT algorithm running on Images, with the image domain split in blocks processed by the thread pool.
+ */
+
+#ifndef BIALPARALLELIMAGEIFT_C
+#define BIALPARALLELIMAGEIFT_C
+
+#include "ParallelImageIFT.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_ParallelImageIFT )
+#define BIAL_EXPLICIT_ParallelImageIFT
+#endif
+
+#if defined ( BIAL_EXPLICIT_ParallelImageIFT ) || ( BIAL_IMPLICIT_BIN )
+
+#include "AdjacencyOffset.hpp"
+#include "BucketQueueElements.hpp"
+#include "IntegerBucketQueue.hpp"
+#include "MaxPathFunction.hpp"
+#include "StaticImageIFT.hpp"
+#include "SumPathFunction.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Bial {
+
+  template< class D, class PF, class Q, class L >
+  ParallelImageIFT< D, PF, Q, L >::ParallelImageIFT( Image< D > &value, const Adjacency &adjacency, PF *function,
+                                                     const Vector< bool > *seed, Image< L > *label,
+                                                     Image< L > *predecessor, bool sequential_label,
+                                                     long double bucket_size, bool fifo_tie ) try :
+    value( value ), adjacency( adjacency ), function( function ), seed( seed ), label( label ),
+      predecessor( predecessor ), sequential_label( sequential_label ), bucket_size( bucket_size ),
+      fifo_tie( fifo_tie ), plane_size( 1 ) {
+      if( value.Dims( ) != adjacency.Dims( ) ) {
+        std::string msg( BIAL_ERROR( "Image and adjacency relation dimensions do not match. Image dimensions: " +
+                                     std::to_string( value.Dims( ) ) + ", adjacency dimensions: " +
+                                     std::to_string( adjacency.Dims( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      if( ( ( seed != nullptr ) && ( seed->size( ) != value.size( ) ) ) ||
+          ( ( label != nullptr ) && ( label->size( ) != value.size( ) ) ) ||
+          ( ( predecessor != nullptr ) && ( predecessor->size( ) != value.size( ) ) ) ) {
+        std::string msg( BIAL_ERROR( "Value image, seed, label, and predecessor maps must have the same size." ) );
+        throw( std::logic_error( msg ) );
+      }
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D, class PF, class Q, class L >
+  void ParallelImageIFT< D, PF, Q, L >::LocalRun( size_t first_blk, size_t last_blk,
+                                                  const AdjacencyOffset &offsets ) {
+    size_t first = bound[ first_blk ];
+    size_t last = bound[ last_blk ];
+    size_t adjs = offsets.size( );
+    D *val = value.data( );
+    COMMENT( "Restoring the initial values of the range.", 2 );
+    for( size_t pxl = first; pxl < last; ++pxl ) {
+      val[ pxl ] = seed_value[ pxl ];
+      pred[ pxl ] = -1;
+      root[ pxl ] = 0;
+    }
+    COMMENT( "Inserting the seeds of the range in the same order as the sequential IFT.", 2 );
+    Q queue( last - first, bucket_size, function->PF::Increasing( ), fifo_tie );
+    for( size_t pxl = first; pxl < last; ++pxl ) {
+      if( ( seed == nullptr ) || ( ( *seed )[ pxl ] ) ) {
+        queue.Q::Insert( pxl - first, val[ pxl ] );
+      }
+    }
+    while( !queue.Q::Empty( ) ) {
+      size_t index = first + queue.Q::Remove( );
+      BucketState state = queue.Q::State( index - first );
+      if( state == BucketState::INSERTED ) {
+        root[ index ] = 1;
+      }
+      bool capable = function->PF::RemoveSimple( index, state );
+      queue.Q::Finished( index - first );
+      if( !capable ) {
+        continue;
+      }
+      bool interior = offsets.Interior( index );
+      for( size_t adj = 0; adj < adjs; ++adj ) {
+        size_t adj_index = interior ? offsets( index, adj ) : offsets.Checked( index, adj );
+        if( ( adj_index < first ) || ( adj_index >= last ) ) {
+          continue;
+        }
+        if( function->PF::Capable( index, adj_index, queue.Q::State( adj_index - first ) ) ) {
+          D previous_value = val[ adj_index ];
+          if( function->PF::Propagate( index, adj_index ) ) {
+            queue.Q::Update( adj_index - first, previous_value, val[ adj_index ] );
+            pred[ adj_index ] = static_cast< llint >( index );
+          }
+        }
+      }
+    }
+  }
+
+  template< class D, class PF, class Q, class L >
+  bool ParallelImageIFT< D, PF, Q, L >::Crossing( size_t src, size_t tgt ) {
+    if( ( !root[ src ] ) && ( pred[ src ] == -1 ) ) {
+      COMMENT( "src never entered the queue. It does not propagate.", 4 );
+      return( false );
+    }
+    bool increasing = function->PF::Increasing( );
+    D *val = value.data( );
+    D tgt_value = val[ tgt ];
+    val[ tgt ] = increasing ? std::numeric_limits< D >::max( ) : std::numeric_limits< D >::lowest( );
+    bool offer = ( ( function->PF::Capable( src, tgt, BucketState::NOT_VISITED ) ) &&
+                   ( function->PF::Propagate( src, tgt ) ) );
+    D offer_value = val[ tgt ];
+    val[ tgt ] = tgt_value;
+    if( !offer ) {
+      return( false );
+    }
+    if( ( root[ tgt ] ) || ( pred[ tgt ] == -1 ) ) {
+      COMMENT( "A better cost would conquer the seed, or conquer a pixel the range did not reach.", 4 );
+      return( increasing ? ( offer_value < seed_value[ tgt ] ) : ( offer_value > seed_value[ tgt ] ) );
+    }
+    COMMENT( "An offer in the same or in a better bucket may change the position of tgt in the queue.", 4 );
+    ldbl offer_key = std::floor( static_cast< ldbl >( offer_value ) / bucket_size );
+    ldbl tgt_key = std::floor( static_cast< ldbl >( tgt_value ) / bucket_size );
+    return( increasing ? ( offer_key <= tgt_key ) : ( offer_key >= tgt_key ) );
+  }
+
+  template< class D, class PF, class Q, class L >
+  bool ParallelImageIFT< D, PF, Q, L >::Exchange( const AdjacencyOffset &offsets, size_t reach,
+                                                  Vector< char > &merge ) {
+    size_t size = value.size( );
+    size_t blocks = bound.size( ) - 1;
+    size_t adjs = offsets.size( );
+    bool changed = false;
+    COMMENT( "Verifying arcs that cross range boundaries.", 2 );
+    for( size_t blk = 1; blk < blocks; ++blk ) {
+      if( range[ blk ] == range[ blk - 1 ] ) {
+        continue;
+      }
+      size_t band_first = bound[ blk ] - std::min( bound[ blk ], reach * plane_size );
+      size_t band_last = std::min( size, bound[ blk ] + reach * plane_size );
+      for( size_t pxl = band_first; ( pxl < band_last ) && ( !merge[ blk ] ); ++pxl ) {
+        size_t pxl_blk = plane_block[ pxl / plane_size ];
+        bool interior = offsets.Interior( pxl );
+        for( size_t adj = 0; adj < adjs; ++adj ) {
+          size_t adj_index = interior ? offsets( pxl, adj ) : offsets.Checked( pxl, adj );
+          if( adj_index >= size ) {
+            continue;
+          }
+          size_t adj_blk = plane_block[ adj_index / plane_size ];
+          if( range[ adj_blk ] == range[ pxl_blk ] ) {
+            continue;
+          }
+          if( Crossing( pxl, adj_index ) ) {
+            COMMENT( "Blocks have at least reach planes. Arcs only cross one boundary.", 4 );
+            merge[ std::max( pxl_blk, adj_blk ) ] = 1;
+            changed = true;
+          }
+        }
+      }
+    }
+    return( changed );
+  }
+
+  template< class D, class PF, class Q, class L >
+  void ParallelImageIFT< D, PF, Q, L >::SetMaps( ) {
+    size_t size = value.size( );
+    if( label != nullptr ) {
+      if( sequential_label ) {
+        COMMENT( "Numbering roots in the order they leave the sequential queue. Seeds are inserted in index " <<
+                 "order, and roots are never moved.", 2 );
+        Vector< size_t > forest_roots;
+        for( size_t pxl = 0; pxl < size; ++pxl ) {
+          if( root[ pxl ] ) {
+            forest_roots.push_back( pxl );
+          }
+        }
+        bool increasing = function->PF::Increasing( );
+        std::sort( forest_roots.begin( ), forest_roots.end( ), [ this, increasing ]( size_t lhs, size_t rhs ) {
+            ldbl lhs_key = std::floor( static_cast< ldbl >( seed_value[ lhs ] ) / bucket_size );
+            ldbl rhs_key = std::floor( static_cast< ldbl >( seed_value[ rhs ] ) / bucket_size );
+            if( lhs_key != rhs_key ) {
+              return( increasing ? ( lhs_key < rhs_key ) : ( lhs_key > rhs_key ) );
+            }
+            return( fifo_tie ? ( lhs < rhs ) : ( lhs > rhs ) );
+          } );
+        for( size_t rnk = 0; rnk < forest_roots.size( ); ++rnk ) {
+          ( *label )[ forest_roots[ rnk ] ] = static_cast< L >( rnk );
+        }
+      }
+      COMMENT( "Copying root labels along the forest.", 2 );
+      Vector< char > done( size, 0 );
+      Vector< size_t > path;
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        size_t anc = pxl;
+        while( ( !done[ anc ] ) && ( pred[ anc ] != -1 ) ) {
+          path.push_back( anc );
+          anc = static_cast< size_t >( pred[ anc ] );
+        }
+        done[ anc ] = 1;
+        L lbl = ( *label )[ anc ];
+        for( size_t elm = 0; elm < path.size( ); ++elm ) {
+          ( *label )[ path[ elm ] ] = lbl;
+          done[ path[ elm ] ] = 1;
+        }
+        path.clear( );
+      }
+    }
+    if( predecessor != nullptr ) {
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        ( *predecessor )[ pxl ] = static_cast< L >( pred[ pxl ] );
+      }
+    }
+  }
+
+  template< class D, class PF, class Q, class L >
+  void ParallelImageIFT< D, PF, Q, L >::Run( ) {
+    try {
+      size_t size = value.size( );
+      size_t last_dim = value.Dims( ) - 1;
+      size_t planes = value.size( last_dim );
+      plane_size = size / planes;
+      size_t reach = 1;
+      for( size_t adj = 0; adj < adjacency.size( ); ++adj ) {
+        reach = std::max( reach, static_cast< size_t >( std::ceil( std::abs( adjacency.Displacement( last_dim,
+                                                                                                      adj ) ) ) ) );
+      }
+      size_t blocks = std::min( ThreadPool::Threads( ), planes / reach );
+      if( blocks < 2 ) {
+        COMMENT( "Not enough threads or planes. Running sequential IFT.", 0 );
+        StaticImageIFT< D, PF, Q, L > ift( value, adjacency, function, seed, label, predecessor, sequential_label,
+                                           bucket_size, fifo_tie );
+        ift.Run( );
+        return;
+      }
+      COMMENT( "Splitting " << planes << " planes in " << blocks << " blocks.", 0 );
+      bound = Vector< size_t >( blocks + 1, size );
+      plane_block = Vector< size_t >( planes, 0 );
+      range = Vector< size_t >( blocks, 0 );
+      for( size_t blk = 0; blk < blocks; ++blk ) {
+        size_t first_plane = planes * blk / blocks;
+        size_t last_plane = planes * ( blk + 1 ) / blocks;
+        bound[ blk ] = first_plane * plane_size;
+        range[ blk ] = blk;
+        for( size_t pln = first_plane; pln < last_plane; ++pln ) {
+          plane_block[ pln ] = blk;
+        }
+      }
+      function->PF::Initialize( value, static_cast< Image< int >* >( nullptr ), static_cast< Image< int >* >( nullptr ),
+                                false );
+      seed_value = Vector< D >( size );
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        seed_value[ pxl ] = value[ pxl ];
+      }
+      pred = Vector< llint >( size, -1 );
+      root = Vector< char >( size, 0 );
+      AdjacencyOffset offsets( adjacency, value );
+      COMMENT( "First and last blocks of the ranges to be run. Initially, each block is a range.", 1 );
+      Vector< size_t > run_first;
+      Vector< size_t > run_last;
+      for( size_t blk = 0; blk < blocks; ++blk ) {
+        run_first.push_back( blk );
+        run_last.push_back( blk + 1 );
+      }
+      size_t rounds = 0;
+      while( true ) {
+        COMMENT( "Running " << run_first.size( ) << " ranges.", 1 );
+        ThreadPool::ParallelFor( 0, run_first.size( ), 1, [ & ]( size_t first_rng, size_t last_rng ) {
+            for( size_t rng = first_rng; rng < last_rng; ++rng ) {
+              LocalRun( run_first[ rng ], run_last[ rng ], offsets );
+            }
+          } );
+        Vector< char > merge( blocks, 0 );
+        if( !Exchange( offsets, reach, merge ) ) {
+          break;
+        }
+        ++rounds;
+        COMMENT( "Round " << rounds << ". Merging ranges across boundaries that change the result.", 1 );
+        Vector< size_t > old_range( range );
+        for( size_t blk = 1; blk < blocks; ++blk ) {
+          if( ( merge[ blk ] ) || ( old_range[ blk ] == old_range[ blk - 1 ] ) ) {
+            range[ blk ] = range[ blk - 1 ];
+          }
+        }
+        run_first.clear( );
+        run_last.clear( );
+        for( size_t blk = 0; blk < blocks; ) {
+          size_t end = blk + 1;
+          bool merged = false;
+          while( ( end < blocks ) && ( range[ end ] == range[ blk ] ) ) {
+            merged = merged || merge[ end ];
+            ++end;
+          }
+          if( merged ) {
+            run_first.push_back( blk );
+            run_last.push_back( end );
+          }
+          blk = end;
+        }
+      }
+      COMMENT( "Converged after " << rounds << " rounds.", 0 );
+      SetMaps( );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_ParallelImageIFT
+
+  template class ParallelImageIFT< int, MaxPathFunction< Image, int > >;
+  template class ParallelImageIFT< llint, MaxPathFunction< Image, llint > >;
+  template class ParallelImageIFT< float, MaxPathFunction< Image, float > >;
+  template class ParallelImageIFT< double, MaxPathFunction< Image, double > >;
+
+  template class ParallelImageIFT< int, SumPathFunction< Image, int > >;
+  template class ParallelImageIFT< llint, SumPathFunction< Image, llint > >;
+  template class ParallelImageIFT< float, SumPathFunction< Image, float > >;
+  template class ParallelImageIFT< double, SumPathFunction< Image, double > >;
+
+  template class ParallelImageIFT< int, MaxPathFunction< Image, int >, IntegerBucketQueue, llint >;
+  template class ParallelImageIFT< llint, MaxPathFunction< Image, llint >, IntegerBucketQueue, llint >;
+  template class ParallelImageIFT< int, SumPathFunction< Image, int >, IntegerBucketQueue, llint >;
+  template class ParallelImageIFT< llint, SumPathFunction< Image, llint >, IntegerBucketQueue, llint >;
+
+#endif
+
+}
+
+#endif
+
+#endif
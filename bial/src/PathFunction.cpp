@@ -114,7 +114,7 @@ namespace Bial {
   }
 
   template< template< class D > class C, class D >
-  D PathFunction< C, D >::BestValue( int index ) {
+  D PathFunction< C, D >::BestValue( size_t index ) {
     std::cout << "Bestvalue pathfunction." << std::endl;
     return( ( *value )[ index ] );
   }
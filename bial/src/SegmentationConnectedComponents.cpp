@@ -21,26 +21,46 @@
 #ifdef BIAL_DEBUG
 #include "FileImage.hpp"
 #endif
-#include "Histogram.hpp"
 #include "Image.hpp"
-#include "ImageIFT.hpp"
-#include "ConnPathFunction.hpp"
-#include "Signal.hpp"
+#include "ImageUnionFind.hpp"
+#include "Vector.hpp"
+#include <algorithm>
 
 namespace Bial {
 
   template< class D >
   Image< int > Segmentation::ConnectedComponents( const Image< D > &input, const Adjacency &adj ) {
     try {
-      Image< int > label( input.Dim( ), input.PixelSize( ) );
-      Image< D > value( input );
-      Image< D > handicap( input.Dim( ) );
-      ConnPathFunction< Image, D > connection_function( handicap, value );
-      value.Set( 1.0 );
-      ImageIFT< D > ift( value, adj, &connection_function, static_cast< Vector< bool >* >( nullptr ), &label,
-                         static_cast< Image< int >* >( nullptr ), true, static_cast< D >( 1 ), false );
-      ift.Run( );
-      return( label );
+      Vector< size_t > size;
+      return( ConnectedComponents( input, adj, size ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< int > Segmentation::ConnectedComponents( const Image< D > &input, const Adjacency &adj,
+                                                  Vector< size_t > &size ) {
+    try {
+      COMMENT( "Labeling components with union-find.", 1 );
+      ImageUnionFind< D > union_find( input, adj );
+      union_find.Run( );
+      size = union_find.Size( );
+      return( union_find.Label( ) );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -62,18 +82,46 @@ namespace Bial {
 
   Image< int > Segmentation::RemoveSmallComponents( const Image< int > &label, float fraction ) {
     try {
-      Image< int > res( label );
       COMMENT( "Computing the size of each component.", 1 );
-      Signal hist( SignalType::Histogram( label ) );
-      hist[ 0 ] = 0;
-      double max_size = hist.MaximumFrequency( );
-      double min_size = max_size * fraction;
+      Vector< size_t > size( static_cast< size_t >( std::max( 0, label.Maximum( ) ) ) + 1, 0 );
+      for( size_t pxl = 0; pxl < label.size( ); ++pxl ) {
+        ++size[ label[ pxl ] ];
+      }
+      return( RemoveSmallComponents( label, size, fraction ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
 
+  Image< int > Segmentation::RemoveSmallComponents( const Image< int > &label, const Vector< size_t > &size,
+                                                    float fraction ) {
+    try {
+      Image< int > res( label );
+      size_t max_size = 0;
+      for( size_t lbl = 1; lbl < size.size( ); ++lbl ) {
+        max_size = std::max( max_size, size[ lbl ] );
+      }
+      double min_size = max_size * fraction;
       COMMENT( "Fraction: " << fraction << ", min size: " << min_size << ", max size: " << max_size << ".", 2 );
       COMMENT( "Removing components with less than min_size.", 1 );
       for( size_t pxl = 0; pxl < label.size( ); ++pxl ) {
-        if( hist[ label[ pxl ] ] < min_size )
+        if( size[ label[ pxl ] ] < min_size ) {
           res[ pxl ] = 0;
+        }
       }
       return( res );
     }
@@ -102,6 +150,15 @@ namespace Bial {
   template Image< int > Segmentation::ConnectedComponents( const Image< float > &input, const Adjacency &adj );
   template Image< int > Segmentation::ConnectedComponents( const Image< double > &input, const Adjacency &adj );
 
+  template Image< int > Segmentation::ConnectedComponents( const Image< int > &input, const Adjacency &adj,
+                                                           Vector< size_t > &size );
+  template Image< int > Segmentation::ConnectedComponents( const Image< llint > &input, const Adjacency &adj,
+                                                           Vector< size_t > &size );
+  template Image< int > Segmentation::ConnectedComponents( const Image< float > &input, const Adjacency &adj,
+                                                           Vector< size_t > &size );
+  template Image< int > Segmentation::ConnectedComponents( const Image< double > &input, const Adjacency &adj,
+                                                           Vector< size_t > &size );
+
 #endif
 
 }
@@ -19,18 +19,19 @@
 
 #include "AdjacencyRound.hpp"
 #include "Image.hpp"
-#include "ImageIFT.hpp"
 #include "IntensityLocals.hpp"
+#include "ParallelImageIFT.hpp"
 #include "SumPathFunction.hpp"
+#include "StaticImageIFT.hpp"
 
 namespace Bial {
 
   template< class D >
-  Image< int > Segmentation::FSum( Image< D > &gradient, float radius ) {
+  Image< int > Segmentation::FSum( Image< D > &gradient, float radius, bool parallel ) {
     try {
       Adjacency spheric = AdjacencyType::HyperSpheric( radius, gradient.Dims( ) );
       Vector< bool > local_minima = Intensity::LocalMinima( gradient, spheric );
-      return( Segmentation::FSum( gradient, local_minima ) );
+      return( Segmentation::FSum( gradient, local_minima, parallel ) );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -51,7 +52,7 @@ namespace Bial {
   }
 
   template< class D >
-  Image< int > Segmentation::FSum( Image< D > &gradient, const Vector< bool > &seeds ) {
+  Image< int > Segmentation::FSum( Image< D > &gradient, const Vector< bool > &seeds, bool parallel ) {
     try {
       if( seeds.size( ) != gradient.size( ) ) {
         std::string msg( BIAL_ERROR( "Gradient image and seed vector must have the same number of elements." ) );
@@ -64,15 +65,24 @@ namespace Bial {
       size_t size = gradient.size( );
       COMMENT( "Setting seeds. Image size: " << size, 0 );
       for( size_t pxl = 0; pxl < size; ++pxl ) {
-        if( !seeds[ pxl ] )
+        if( seeds[ pxl ] )
           gradient[ pxl ] += 1.0;
         else
           gradient[ pxl ] = std::numeric_limits< D >::max( );
       }
       COMMENT( "Running IFT.", 0 );
-      ImageIFT< D > ift( gradient, spheric, &max_function, &seeds, &label, static_cast< Image< int >* >( nullptr ), 
-                         true, static_cast< D >( 1.0 ), true );
-      ift.Run( );
+      if( parallel ) {
+        ParallelImageIFT< D, SumPathFunction< Image, D > > ift( gradient, spheric, &max_function, &seeds, &label,
+                                                                static_cast< Image< int >* >( nullptr ), true,
+                                                                static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
+      else {
+        StaticImageIFT< D, SumPathFunction< Image, D > > ift( gradient, spheric, &max_function, &seeds, &label,
+                                                              static_cast< Image< int >* >( nullptr ), true,
+                                                              static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
       return( label );
     }
     catch( std::bad_alloc &e ) {
@@ -96,7 +106,7 @@ namespace Bial {
 
   template< class D >
   Image< int > Segmentation::FSum( Image< D > &gradient, const Vector< size_t > &obj_seeds,
-                                   const Vector< size_t > &bkg_seeds ) {
+                                   const Vector< size_t > &bkg_seeds, bool parallel ) {
     try {
       if( ( obj_seeds.size( ) == 0 ) || ( bkg_seeds.size( ) == 0 ) ) {
         std::string msg( BIAL_ERROR( "Object seeds and background seeds should not be empty vectors. Given: " +
@@ -124,9 +134,18 @@ namespace Bial {
         if( !seeds[ elm ] )
           gradient[ elm ] = std::numeric_limits< D >::max( );
       }
-      ImageIFT< D > ift( gradient, spheric, &min_function, &seeds, &label, static_cast< Image< int >* >( nullptr ), 
-                         false, static_cast< D >( 1.0 ), true );
-      ift.Run( );
+      if( parallel ) {
+        ParallelImageIFT< D, SumPathFunction< Image, D > > ift( gradient, spheric, &min_function, &seeds, &label,
+                                                                static_cast< Image< int >* >( nullptr ), false,
+                                                                static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
+      else {
+        StaticImageIFT< D, SumPathFunction< Image, D > > ift( gradient, spheric, &min_function, &seeds, &label,
+                                                              static_cast< Image< int >* >( nullptr ), false,
+                                                              static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
       return( label );
     }
     catch( std::bad_alloc &e ) {
@@ -150,22 +169,22 @@ namespace Bial {
 
 #ifdef BIAL_EXPLICIT_SegmentationFSum
 
-  template Image< int > Segmentation::FSum( Image< int > &gradient, float radius );
-  template Image< int > Segmentation::FSum( Image< int > &gradient, const Vector< bool > &seeds );
+  template Image< int > Segmentation::FSum( Image< int > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::FSum( Image< int > &gradient, const Vector< bool > &seeds, bool parallel );
   template Image< int > Segmentation::FSum( Image< int > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
-  template Image< int > Segmentation::FSum( Image< llint > &gradient, float radius );
-  template Image< int > Segmentation::FSum( Image< llint > &gradient, const Vector< bool > &seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
+  template Image< int > Segmentation::FSum( Image< llint > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::FSum( Image< llint > &gradient, const Vector< bool > &seeds, bool parallel );
   template Image< int > Segmentation::FSum( Image< llint > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
-  template Image< int > Segmentation::FSum( Image< float > &gradient, float radius );
-  template Image< int > Segmentation::FSum( Image< float > &gradient, const Vector< bool > &seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
+  template Image< int > Segmentation::FSum( Image< float > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::FSum( Image< float > &gradient, const Vector< bool > &seeds, bool parallel );
   template Image< int > Segmentation::FSum( Image< float > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
-  template Image< int > Segmentation::FSum( Image< double > &gradient, float radius );
-  template Image< int > Segmentation::FSum( Image< double > &gradient, const Vector< bool > &seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
+  template Image< int > Segmentation::FSum( Image< double > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::FSum( Image< double > &gradient, const Vector< bool > &seeds, bool parallel );
   template Image< int > Segmentation::FSum( Image< double > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
 
 #endif
 
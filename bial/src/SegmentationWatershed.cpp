@@ -19,18 +19,19 @@
 
 #include "AdjacencyRound.hpp"
 #include "Image.hpp"
-#include "ImageIFT.hpp"
 #include "IntensityLocals.hpp"
 #include "MaxPathFunction.hpp"
+#include "ParallelImageIFT.hpp"
+#include "StaticImageIFT.hpp"
 
 namespace Bial {
 
   template< class D >
-  Image< int > Segmentation::Watershed( Image< D > &gradient, float radius ) {
+  Image< int > Segmentation::Watershed( Image< D > &gradient, float radius, bool parallel ) {
     try {
       Adjacency spheric = AdjacencyType::HyperSpheric( radius, gradient.Dims( ) );
       Vector< bool > local_minima = Intensity::LocalMinima( gradient, spheric );
-      return( Segmentation::Watershed( gradient, local_minima ) );
+      return( Segmentation::Watershed( gradient, local_minima, parallel ) );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -51,7 +52,7 @@ namespace Bial {
   }
 
   template< class D >
-  Image< int > Segmentation::Watershed( Image< D > &gradient, const Vector< bool > &seeds ) {
+  Image< int > Segmentation::Watershed( Image< D > &gradient, const Vector< bool > &seeds, bool parallel ) {
     try {
       if( seeds.size( ) != gradient.size( ) ) {
         std::string msg( BIAL_ERROR( "Gradient image and seed vector must have the same number of elements." ) );
@@ -70,9 +71,18 @@ namespace Bial {
           gradient[ pxl ] = std::numeric_limits< D >::max( );
       }
       COMMENT( "Running IFT.", 0 );
-      ImageIFT< D > ift( gradient, spheric, &max_function, &seeds, &label, static_cast< Image< int >* >( nullptr ), 
-                         true, static_cast< D >( 1.0 ), true );
-      ift.Run( );
+      if( parallel ) {
+        ParallelImageIFT< D, MaxPathFunction< Image, D > > ift( gradient, spheric, &max_function, &seeds, &label,
+                                                                static_cast< Image< int >* >( nullptr ), true,
+                                                                static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
+      else {
+        StaticImageIFT< D, MaxPathFunction< Image, D > > ift( gradient, spheric, &max_function, &seeds, &label,
+                                                              static_cast< Image< int >* >( nullptr ), true,
+                                                              static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
       return( label );
     }
     catch( std::bad_alloc &e ) {
@@ -96,7 +106,7 @@ namespace Bial {
 
   template< class D >
   Image< int > Segmentation::Watershed( Image< D > &gradient, const Vector< size_t > &obj_seeds,
-                                        const Vector< size_t > &bkg_seeds ) {
+                                        const Vector< size_t > &bkg_seeds, bool parallel ) {
     try {
       if( ( obj_seeds.size( ) == 0 ) || ( bkg_seeds.size( ) == 0 ) ) {
         std::string msg( BIAL_ERROR( "Object seeds and background seeds should not be empty vectors. Given: " +
@@ -124,9 +134,18 @@ namespace Bial {
         if( !seeds[ elm ] )
           gradient[ elm ] = std::numeric_limits< D >::max( );
       }
-      ImageIFT< D > ift( gradient, spheric, &min_function, &seeds, &label, static_cast< Image< int >* >( nullptr ), 
-                         false, static_cast< D >( 1.0 ), true );
-      ift.Run( );
+      if( parallel ) {
+        ParallelImageIFT< D, MaxPathFunction< Image, D > > ift( gradient, spheric, &min_function, &seeds, &label,
+                                                                static_cast< Image< int >* >( nullptr ), false,
+                                                                static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
+      else {
+        StaticImageIFT< D, MaxPathFunction< Image, D > > ift( gradient, spheric, &min_function, &seeds, &label,
+                                                              static_cast< Image< int >* >( nullptr ), false,
+                                                              static_cast< D >( 1.0 ), true );
+        ift.Run( );
+      }
       return( label );
     }
     catch( std::bad_alloc &e ) {
@@ -150,22 +169,23 @@ namespace Bial {
 
 #ifdef BIAL_EXPLICIT_SegmentationWatershed
 
-  template Image< int > Segmentation::Watershed( Image< int > &gradient, float radius );
-  template Image< int > Segmentation::Watershed( Image< int > &gradient, const Vector< bool > &seeds );
+  template Image< int > Segmentation::Watershed( Image< int > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::Watershed( Image< int > &gradient, const Vector< bool > &seeds, bool parallel );
   template Image< int > Segmentation::Watershed( Image< int > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
-  template Image< int > Segmentation::Watershed( Image< llint > &gradient, float radius );
-  template Image< int > Segmentation::Watershed( Image< llint > &gradient, const Vector< bool > &seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
+  template Image< int > Segmentation::Watershed( Image< llint > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::Watershed( Image< llint > &gradient, const Vector< bool > &seeds, bool parallel );
   template Image< int > Segmentation::Watershed( Image< llint > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
-  template Image< int > Segmentation::Watershed( Image< float > &gradient, float radius );
-  template Image< int > Segmentation::Watershed( Image< float > &gradient, const Vector< bool > &seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
+  template Image< int > Segmentation::Watershed( Image< float > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::Watershed( Image< float > &gradient, const Vector< bool > &seeds, bool parallel );
   template Image< int > Segmentation::Watershed( Image< float > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
-  template Image< int > Segmentation::Watershed( Image< double > &gradient, float radius );
-  template Image< int > Segmentation::Watershed( Image< double > &gradient, const Vector< bool > &seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
+  template Image< int > Segmentation::Watershed( Image< double > &gradient, float radius, bool parallel );
+  template Image< int > Segmentation::Watershed( Image< double > &gradient, const Vector< bool > &seeds,
+                                                 bool parallel );
   template Image< int > Segmentation::Watershed( Image< double > &gradient, const Vector< size_t > &obj_seeds,
-                                                 const Vector< size_t > &bkg_seeds );
+                                                 const Vector< size_t > &bkg_seeds, bool parallel );
 
 #endif
 
@@ -0,0 +1,257 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Histogram of the pixels of an adjacency window sliding along image lines, for rank filters.
+ */
+
+#ifndef BIALSLIDINGHISTOGRAM_C
+#define BIALSLIDINGHISTOGRAM_C
+
+#include "SlidingHistogram.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_SlidingHistogram )
+#define BIAL_EXPLICIT_SlidingHistogram
+#endif
+
+#if defined ( BIAL_EXPLICIT_SlidingHistogram ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Adjacency.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace Bial {
+
+  SlidingHistogram::SlidingHistogram( size_t bins, bool sorted ) try :
+    count( ), coarse( ), window( ), coarse_size( 1 ), total( 0 ), sorted( sorted ) {
+      if( !sorted ) {
+        coarse_size = std::max< size_t >( 1, static_cast< size_t >( std::ceil( std::sqrt( bins ) ) ) );
+        count = Vector< size_t >( bins, 0 );
+        coarse = Vector< size_t >( bins / coarse_size + 1, 0 );
+      }
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  size_t SlidingHistogram::Select( size_t rank ) const {
+    if( sorted ) {
+      return( window[ rank ] );
+    }
+    size_t crs = 0;
+    while( coarse[ crs ] <= rank ) {
+      rank -= coarse[ crs ];
+      ++crs;
+    }
+    size_t bin = crs * coarse_size;
+    while( count[ bin ] <= rank ) {
+      rank -= count[ bin ];
+      ++bin;
+    }
+    return( bin );
+  }
+
+  template< class D >
+  size_t SlidingHistogram::Quantize( const D *data, size_t size, Vector< int > &bin, Vector< D > &value ) {
+    try {
+      bin = Vector< int >( size );
+      if( size == 0 ) {
+        value = Vector< D >( );
+        return( 0 );
+      }
+      if( std::numeric_limits< D >::is_integer ) {
+        D min = *std::min_element( data, data + size );
+        D max = *std::max_element( data, data + size );
+        if( static_cast< double >( max ) - static_cast< double >( min ) < static_cast< double >( max_direct_bins ) ) {
+          COMMENT( "One bin per value in the range of data.", 2 );
+          size_t bins = static_cast< size_t >( max - min ) + 1;
+          value = Vector< D >( bins );
+          for( size_t bn = 0; bn < bins; ++bn ) {
+            value[ bn ] = static_cast< D >( min + static_cast< D >( bn ) );
+          }
+          for( size_t elm = 0; elm < size; ++elm ) {
+            bin[ elm ] = static_cast< int >( data[ elm ] - min );
+          }
+          return( bins );
+        }
+      }
+      COMMENT( "One bin per distinct value, in increasing order.", 2 );
+      std::vector< D > sorted( data, data + size );
+      std::sort( sorted.begin( ), sorted.end( ) );
+      sorted.erase( std::unique( sorted.begin( ), sorted.end( ) ), sorted.end( ) );
+      value = Vector< D >( sorted.size( ) );
+      std::copy( sorted.begin( ), sorted.end( ), value.begin( ) );
+      for( size_t elm = 0; elm < size; ++elm ) {
+        bin[ elm ] = static_cast< int >( std::lower_bound( sorted.begin( ), sorted.end( ), data[ elm ] ) -
+                                         sorted.begin( ) );
+      }
+      return( sorted.size( ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  void SlidingHistogram::Slide( const Vector< size_t > &dim, const Vector< int > &bin, size_t bins, bool sorted,
+                                const Adjacency &adj, const Vector< bool > *mask, size_t first, size_t last,
+                                const std::function< void( size_t, SlidingHistogram & ) > &body ) {
+    try {
+      size_t dims = dim.size( );
+      size_t adjs = adj.size( );
+      llint width = static_cast< llint >( dim[ 0 ] );
+      COMMENT( "Integer displacements of the adjacents.", 2 );
+      std::vector< std::vector< llint > > disp( adjs, std::vector< llint >( dims, 0 ) );
+      for( size_t idx = 0; idx < adjs; ++idx ) {
+        for( size_t dms = 0; dms < std::min( dims, adj.Dims( ) ); ++dms ) {
+          disp[ idx ][ dms ] = static_cast< llint >( std::round( adj.Displacement( dms, idx ) ) );
+        }
+      }
+      COMMENT( "Moving the window from x to x + 1, adjacent d enters if d + 1 is not adjacent, and leaves if d - 1 "
+               << "is not adjacent.", 2 );
+      std::set< std::vector< llint > > member( disp.begin( ), disp.end( ) );
+      Vector< size_t > entering;
+      Vector< size_t > leaving;
+      for( size_t idx = 0; idx < adjs; ++idx ) {
+        std::vector< llint > next( disp[ idx ] );
+        ++next[ 0 ];
+        if( member.count( next ) == 0 ) {
+          entering.push_back( idx );
+        }
+        next[ 0 ] -= 2;
+        if( member.count( next ) == 0 ) {
+          leaving.push_back( idx );
+        }
+      }
+      SlidingHistogram histogram( bins, sorted );
+      Vector< llint > line_offset( adjs );
+      Vector< bool > line_valid( adjs );
+      llint line_base = 0;
+      auto update = [ & ]( size_t idx, llint col, bool insert ) {
+        llint adj_col = col + disp[ idx ][ 0 ];
+        if( ( !line_valid[ idx ] ) || ( adj_col < 0 ) || ( adj_col >= width ) ) {
+          return;
+        }
+        size_t adj_pxl = static_cast< size_t >( line_base + adj_col + line_offset[ idx ] );
+        if( ( mask != nullptr ) && ( !( *mask )[ adj_pxl ] ) ) {
+          return;
+        }
+        if( insert ) {
+          histogram.Insert( bin[ adj_pxl ] );
+        }
+        else {
+          histogram.Remove( bin[ adj_pxl ] );
+        }
+      };
+      size_t pxl = first;
+      while( pxl < last ) {
+        size_t line = pxl / dim[ 0 ];
+        size_t line_end = std::min( last, ( line + 1 ) * dim[ 0 ] );
+        line_base = static_cast< llint >( line * dim[ 0 ] );
+        COMMENT( "Offsets of the adjacents along the other dimensions, and whether they are in the domain.", 3 );
+        for( size_t idx = 0; idx < adjs; ++idx ) {
+          size_t rest = line;
+          llint stride = width;
+          llint offset = 0;
+          bool valid = true;
+          for( size_t dms = 1; dms < dims; ++dms ) {
+            llint crd = static_cast< llint >( rest % dim[ dms ] ) + disp[ idx ][ dms ];
+            rest /= dim[ dms ];
+            valid = valid && ( crd >= 0 ) && ( crd < static_cast< llint >( dim[ dms ] ) );
+            offset += disp[ idx ][ dms ] * stride;
+            stride *= static_cast< llint >( dim[ dms ] );
+          }
+          line_offset[ idx ] = offset;
+          line_valid[ idx ] = valid;
+        }
+        COMMENT( "Building the window at the first pixel and sliding it up to the last pixel of the line.", 3 );
+        llint col = static_cast< llint >( pxl - line * dim[ 0 ] );
+        for( size_t idx = 0; idx < adjs; ++idx ) {
+          update( idx, col, true );
+        }
+        while( true ) {
+          body( pxl, histogram );
+          if( pxl + 1 == line_end ) {
+            break;
+          }
+          for( size_t idx = 0; idx < leaving.size( ); ++idx ) {
+            update( leaving[ idx ], col, false );
+          }
+          ++col;
+          ++pxl;
+          for( size_t idx = 0; idx < entering.size( ); ++idx ) {
+            update( entering[ idx ], col, true );
+          }
+        }
+        for( size_t idx = 0; idx < adjs; ++idx ) {
+          update( idx, col, false );
+        }
+        pxl = line_end;
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_SlidingHistogram
+
+  template size_t SlidingHistogram::Quantize( const int *data, size_t size, Vector< int > &bin,
+                                              Vector< int > &value );
+  template size_t SlidingHistogram::Quantize( const llint *data, size_t size, Vector< int > &bin,
+                                              Vector< llint > &value );
+  template size_t SlidingHistogram::Quantize( const float *data, size_t size, Vector< int > &bin,
+                                              Vector< float > &value );
+  template size_t SlidingHistogram::Quantize( const double *data, size_t size, Vector< int > &bin,
+                                              Vector< double > &value );
+
+#endif
+
+}
+
+#endif
+
+#endif
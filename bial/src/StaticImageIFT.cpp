@@ -0,0 +1,276 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief IFT algorithm running on Images, statically dispatched on the path function and queue types.
+ */
+
+#ifndef BIALSTATICIMAGEIFT_C
+#define BIALSTATICIMAGEIFT_C
+
+#include "StaticImageIFT.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_StaticImageIFT )
+#define BIAL_EXPLICIT_StaticImageIFT
+#endif
+
+#if defined ( BIAL_EXPLICIT_StaticImageIFT ) || ( BIAL_IMPLICIT_BIN )
+
+#include "AdjacencyOffset.hpp"
+#include "BucketQueueElements.hpp"
+#include "ConnPathFunction.hpp"
+#include "GeodesicPathFunction.hpp"
+#include "IntegerBucketQueue.hpp"
+#include "MaxPathFunction.hpp"
+#include "SumPathFunction.hpp"
+
+namespace Bial {
+
+  template< class D, class PF, class Q, class L >
+  StaticImageIFT< D, PF, Q, L >::StaticImageIFT( Image< D > &value, const Adjacency &adjacency, PF *function,
+                                                 const Vector< bool > *seed, Image< L > *label,
+                                                 Image< L > *predecessor, bool sequential_label,
+                                                 long double bucket_size, bool fifo_tie ) try :
+    queue( nullptr ), value( value ), adjacency( adjacency ), function( function ), seed( seed ), label( label ),
+      predecessor( predecessor ), sequential_label( sequential_label ), next_label( 0 ), bucket_size( bucket_size ),
+      fifo_tie( fifo_tie ), dift_enb( false ), dift_elm( 0 ) {
+      if( value.Dims( ) != adjacency.Dims( ) ) {
+        std::string msg( BIAL_ERROR( "Image and adjacency relation dimensions do not match. Image dimensions: " +
+                                     std::to_string( value.Dims( ) ) + ", adjacency dimensions: " +
+                                     std::to_string( adjacency.Dims( ) ) ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Initializing.", 1 );
+      Initialize( );
+    }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D, class PF, class Q, class L >
+  StaticImageIFT< D, PF, Q, L >::~StaticImageIFT( ) {
+    delete ( queue );
+  }
+
+  template< class D, class PF, class Q, class L >
+  void StaticImageIFT< D, PF, Q, L >::Initialize( ) {
+    try {
+      queue = new Q( value.size( ), bucket_size, function->PF::Increasing( ), fifo_tie );
+      COMMENT( "Initializing data in path function.", 1 );
+      function->PF::Initialize( value, PathFunctionMap( label ), PathFunctionMap( predecessor ), sequential_label );
+      next_label = 0;
+      COMMENT( "Initializing the maps.", 1 );
+      if( predecessor != nullptr ) {
+        predecessor->Set( -1 );
+      }
+      if( seed != nullptr ) {
+        COMMENT( "Initializing data with seeds.", 1 );
+        for( size_t it = 0; it < value.size( ); ++it ) {
+          if( seed->operator()( it ) ) {
+            queue->Q::Insert( it, value[ it ] );
+          }
+        }
+      }
+      else {
+        COMMENT( "Initializing data without seeds.", 1 );
+        for( size_t it = 0; it < value.size( ); ++it ) {
+          queue->Q::Insert( it, value[ it ] );
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D, class PF, class Q, class L >
+  Image< int > *StaticImageIFT< D, PF, Q, L >::PathFunctionMap( Image< int > *map ) {
+    return( map );
+  }
+
+  template< class D, class PF, class Q, class L >
+  Image< int > *StaticImageIFT< D, PF, Q, L >::PathFunctionMap( Image< llint > * ) {
+    return( nullptr );
+  }
+
+  template< class D, class PF, class Q, class L >
+  template< bool LABEL, bool PREDECESSOR, bool SEQUENTIAL >
+  void StaticImageIFT< D, PF, Q, L >::Propagate( ) {
+    size_t size = value.size( );
+    AdjacencyOffset offsets( adjacency, value );
+    size_t adjs = offsets.size( );
+    D *val = value.data( );
+    L *lbl = LABEL ? label->data( ) : nullptr;
+    L *prd = PREDECESSOR ? predecessor->data( ) : nullptr;
+    bool function_label = std::is_same< L, int >::value;
+    while( ( !queue->Q::Empty( ) ) &&
+           ( ( !dift_enb ) || ( queue->Q::State( dift_elm ) != BucketState::REMOVED ) ) ) {
+      size_t index = queue->Q::Remove( );
+      BucketState state = queue->Q::State( index );
+      bool capable;
+      if( SEQUENTIAL && function_label ) {
+        capable = function->PF::RemoveLabel( index, state );
+      }
+      else {
+        capable = function->PF::RemoveSimple( index, state );
+        if( SEQUENTIAL && LABEL && ( state == BucketState::INSERTED ) ) {
+          COMMENT( "Root. Assigning a new label.", 4 );
+          lbl[ index ] = static_cast< L >( next_label++ );
+        }
+      }
+      COMMENT( "Index: " << index << ", value: " << val[ index ], 4 );
+      queue->Q::Finished( index );
+      if( !capable ) {
+        continue;
+      }
+      bool interior = offsets.Interior( index );
+      for( size_t adj = 0; adj < adjs; ++adj ) {
+        size_t adj_index = interior ? offsets( index, adj ) : offsets.Checked( index, adj );
+        if( adj_index >= size ) {
+          continue;
+        }
+        if( function->PF::Capable( index, adj_index, queue->Q::State( adj_index ) ) ) {
+          D previous_value = val[ adj_index ];
+          if( function->PF::Propagate( index, adj_index ) ) {
+            queue->Q::Update( adj_index, previous_value, val[ adj_index ] );
+            if( PREDECESSOR ) {
+              prd[ adj_index ] = index;
+            }
+            if( LABEL ) {
+              lbl[ adj_index ] = lbl[ index ];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  template< class D, class PF, class Q, class L >
+  void StaticImageIFT< D, PF, Q, L >::Run( ) {
+    try {
+      COMMENT( "Running.", 1 );
+      bool has_label = ( label != nullptr );
+      bool has_predecessor = ( predecessor != nullptr );
+      if( sequential_label ) {
+        if( has_label && has_predecessor ) {
+          Propagate< true, true, true >( );
+        }
+        else if( has_label ) {
+          Propagate< true, false, true >( );
+        }
+        else if( has_predecessor ) {
+          Propagate< false, true, true >( );
+        }
+        else {
+          Propagate< false, false, true >( );
+        }
+      }
+      else {
+        if( has_label && has_predecessor ) {
+          Propagate< true, true, false >( );
+        }
+        else if( has_label ) {
+          Propagate< true, false, false >( );
+        }
+        else if( has_predecessor ) {
+          Propagate< false, true, false >( );
+        }
+        else {
+          Propagate< false, false, false >( );
+        }
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D, class PF, class Q, class L >
+  void StaticImageIFT< D, PF, Q, L >::EnableDifferentialIFT( size_t elm ) {
+    dift_enb = true;
+    dift_elm = elm;
+  }
+
+  template< class D, class PF, class Q, class L >
+  void StaticImageIFT< D, PF, Q, L >::DisableDifferentialIFT( ) {
+    dift_enb = false;
+    dift_elm = 0;
+  }
+
+#ifdef BIAL_EXPLICIT_StaticImageIFT
+
+  template class StaticImageIFT< int, MaxPathFunction< Image, int > >;
+  template class StaticImageIFT< llint, MaxPathFunction< Image, llint > >;
+  template class StaticImageIFT< float, MaxPathFunction< Image, float > >;
+  template class StaticImageIFT< double, MaxPathFunction< Image, double > >;
+
+  template class StaticImageIFT< int, SumPathFunction< Image, int > >;
+  template class StaticImageIFT< llint, SumPathFunction< Image, llint > >;
+  template class StaticImageIFT< float, SumPathFunction< Image, float > >;
+  template class StaticImageIFT< double, SumPathFunction< Image, double > >;
+
+  template class StaticImageIFT< int, ConnPathFunction< Image, int > >;
+  template class StaticImageIFT< llint, ConnPathFunction< Image, llint > >;
+  template class StaticImageIFT< float, ConnPathFunction< Image, float > >;
+  template class StaticImageIFT< double, ConnPathFunction< Image, double > >;
+
+  template class StaticImageIFT< int, GeodesicDistancePathFunction< int > >;
+  template class StaticImageIFT< llint, GeodesicDistancePathFunction< llint > >;
+  template class StaticImageIFT< float, GeodesicDistancePathFunction< float > >;
+  template class StaticImageIFT< double, GeodesicDistancePathFunction< double > >;
+
+  template class StaticImageIFT< int, MaxPathFunction< Image, int >, IntegerBucketQueue, llint >;
+  template class StaticImageIFT< llint, MaxPathFunction< Image, llint >, IntegerBucketQueue, llint >;
+  template class StaticImageIFT< int, SumPathFunction< Image, int >, IntegerBucketQueue, llint >;
+  template class StaticImageIFT< llint, SumPathFunction< Image, llint >, IntegerBucketQueue, llint >;
+  template class StaticImageIFT< int, ConnPathFunction< Image, int >, IntegerBucketQueue, llint >;
+  template class StaticImageIFT< llint, ConnPathFunction< Image, llint >, IntegerBucketQueue, llint >;
+
+#endif
+
+}
+
+#endif
+
+#endif
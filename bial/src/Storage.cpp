@@ -0,0 +1,171 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Aligned and pooled storage of the data of Vector, Matrix and Image.
+ */
+
+#ifndef BIALSTORAGE_C
+#define BIALSTORAGE_C
+
+#include "Storage.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_Storage )
+#define BIAL_EXPLICIT_Storage
+#endif
+
+#if defined ( BIAL_EXPLICIT_Storage ) || ( BIAL_IMPLICIT_BIN )
+
+#include <algorithm>
+#include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace Bial {
+
+  Storage::Pool &Storage::Instance( ) {
+    static Pool *pool = new Pool( );
+    return( *pool );
+  }
+
+  size_t Storage::SizeClass( size_t bytes ) {
+    if( bytes < MIN_POOLED ) {
+      return( std::max( ( bytes + ALIGNMENT - 1 ) / ALIGNMENT, static_cast< size_t >( 1 ) ) * ALIGNMENT );
+    }
+    COMMENT( "Four classes per power of two, wasting at most a quarter of the requested bytes.", 4 );
+    size_t power = MIN_POOLED;
+    while( power <= bytes / 2 ) {
+      power *= 2;
+    }
+    size_t step = power / 4;
+    return( ( bytes + step - 1 ) / step * step );
+  }
+
+  void *Storage::SystemAllocate( size_t bytes ) {
+    size_t alignment = bytes >= HUGE_PAGE ? HUGE_PAGE : ALIGNMENT;
+    void *ptr = nullptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc( bytes, alignment );
+#else
+    if( posix_memalign( &ptr, alignment, bytes ) != 0 ) {
+      ptr = nullptr;
+    }
+#endif
+    if( ptr == nullptr ) {
+      throw( std::bad_alloc( ) );
+    }
+#if defined( __linux__ ) && defined( MADV_HUGEPAGE )
+    if( bytes >= HUGE_PAGE ) {
+      madvise( ptr, bytes, MADV_HUGEPAGE );
+    }
+#endif
+    return( ptr );
+  }
+
+  void *Storage::Allocate( size_t bytes ) {
+    Pool &pool = Instance( );
+    size_t size = SizeClass( bytes );
+    void *ptr = nullptr;
+    if( size >= MIN_POOLED ) {
+      std::lock_guard< std::mutex > lock( pool.mutex );
+      auto blocks = pool.blocks.find( size );
+      if( ( blocks != pool.blocks.end( ) ) && ( !blocks->second.empty( ) ) ) {
+        ptr = blocks->second.back( );
+        blocks->second.pop_back( );
+        pool.pooled -= size;
+      }
+    }
+    if( ptr == nullptr ) {
+      ptr = SystemAllocate( size );
+    }
+    size_t in_use = pool.in_use += size;
+    size_t peak = pool.peak.load( );
+    while( ( in_use > peak ) && ( !pool.peak.compare_exchange_weak( peak, in_use ) ) ) {
+    }
+    return( ptr );
+  }
+
+  void Storage::Release( void *ptr, size_t bytes ) noexcept {
+    if( ptr == nullptr ) {
+      return;
+    }
+    Pool &pool = Instance( );
+    size_t size = SizeClass( bytes );
+    pool.in_use -= size;
+    if( size >= MIN_POOLED ) {
+      std::lock_guard< std::mutex > lock( pool.mutex );
+      if( pool.pooled + size <= pool.limit ) {
+        try {
+          pool.blocks[ size ].push_back( ptr );
+          pool.pooled += size;
+          return;
+        }
+        catch( std::bad_alloc & ) {
+          COMMENT( "No memory to keep the buffer. Releasing it to the system.", 4 );
+        }
+      }
+    }
+#ifdef _WIN32
+    _aligned_free( ptr );
+#else
+    free( ptr );
+#endif
+  }
+
+  size_t Storage::BytesInUse( ) {
+    return( Instance( ).in_use );
+  }
+
+  size_t Storage::PeakBytes( ) {
+    return( Instance( ).peak );
+  }
+
+  size_t Storage::PooledBytes( ) {
+    return( Instance( ).pooled );
+  }
+
+  void Storage::ResetPeak( ) {
+    Pool &pool = Instance( );
+    pool.peak = pool.in_use.load( );
+  }
+
+  void Storage::PoolLimit( size_t bytes ) {
+    Pool &pool = Instance( );
+    std::vector< void* > released;
+    {
+      std::lock_guard< std::mutex > lock( pool.mutex );
+      pool.limit = bytes;
+      for( auto &blocks : pool.blocks ) {
+        while( ( pool.pooled > bytes ) && ( !blocks.second.empty( ) ) ) {
+          released.push_back( blocks.second.back( ) );
+          blocks.second.pop_back( );
+          pool.pooled -= blocks.first;
+        }
+      }
+    }
+    for( void *ptr : released ) {
+#ifdef _WIN32
+      _aligned_free( ptr );
+#else
+      free( ptr );
+#endif
+    }
+  }
+
+  void Storage::Trim( ) {
+    Pool &pool = Instance( );
+    size_t limit = pool.limit;
+    PoolLimit( 0 );
+    pool.limit = limit;
+  }
+
+}
+
+#endif
+
+#endif
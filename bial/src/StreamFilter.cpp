@@ -0,0 +1,680 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Out-of-core execution of chains of local filters.
+ */
+
+#ifndef BIALSTREAMFILTER_C
+#define BIALSTREAMFILTER_C
+
+#include "StreamFilter.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_StreamFilter )
+#define BIAL_EXPLICIT_StreamFilter
+#endif
+
+#if defined ( BIAL_EXPLICIT_StreamFilter ) || ( BIAL_IMPLICIT_BIN )
+
+#include "Adjacency.hpp"
+#include "AdjacencyRound.hpp"
+#include "ChunkedImage.hpp"
+#include "Correlation.hpp"
+#include "File.hpp"
+#include "FilteringMean.hpp"
+#include "FilteringMedian.hpp"
+#include "GradientSobel.hpp"
+#include "Image.hpp"
+#include "KernelGaussian.hpp"
+#include "KernelSobel.hpp"
+#include "MorphologyDilation.hpp"
+#include "MorphologyErosion.hpp"
+#include "NiftiHeader.hpp"
+#include "NiftiMapping.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <thread>
+
+namespace Bial {
+
+  template< class D >
+  const size_t StreamFilter< D >::DEFAULT_SLAB;
+
+  template< class D >
+  StreamFilter< D >::StreamFilter( size_t slab_size ) try : operation( ), halo( ), slab( 1 ) {
+    SlabSize( slab_size );
+  }
+  catch( std::bad_alloc &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( std::runtime_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+    throw( std::runtime_error( msg ) );
+  }
+  catch( const std::out_of_range &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+    throw( std::out_of_range( msg ) );
+  }
+  catch( const std::logic_error &e ) {
+    std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+    throw( std::logic_error( msg ) );
+  }
+
+  template< class D >
+  StreamFilter< D > &StreamFilter< D >::Add( const Operator &op, size_t op_halo ) {
+    try {
+      operation.push_back( op );
+      halo.push_back( op_halo );
+      return( *this );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  StreamFilter< D > &StreamFilter< D >::Gaussian( float radius, float std_dev ) {
+    try {
+      return( Add( [ radius, std_dev ]( const Image< D > &img ) {
+            return( SpatialCorrelation( img, KernelType::Gaussian( img.Dims( ), radius, std_dev ) ) );
+          }, Halo( KernelType::Gaussian( 3, radius, std_dev ) ) ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  StreamFilter< D > &StreamFilter< D >::Mean( float radius ) {
+    try {
+      return( Add( [ radius ]( const Image< D > &img ) {
+            return( Filtering::Mean( img, radius ) );
+          }, Halo( AdjacencyType::HyperSpheric( radius, 3 ) ) ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  StreamFilter< D > &StreamFilter< D >::Median( float radius ) {
+    try {
+      return( Add( [ radius ]( const Image< D > &img ) {
+            return( Filtering::Median( img, radius ) );
+          }, Halo( AdjacencyType::HyperSpheric( radius, 3 ) ) ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  StreamFilter< D > &StreamFilter< D >::Dilate( const Adjacency &adjacency ) {
+    try {
+      return( Add( [ adjacency ]( const Image< D > &img ) {
+            return( Morphology::Dilate( img, adjacency ) );
+          }, Halo( adjacency ) ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  StreamFilter< D > &StreamFilter< D >::Erode( const Adjacency &adjacency ) {
+    try {
+      return( Add( [ adjacency ]( const Image< D > &img ) {
+            return( Morphology::Erode( img, adjacency ) );
+          }, Halo( adjacency ) ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  StreamFilter< D > &StreamFilter< D >::Sobel( ) {
+    try {
+      return( Add( [ ]( const Image< D > &img ) {
+            Vector< Image< D > > dir_sobel;
+            for( size_t dir = 0; dir < img.Dims( ); ++dir ) {
+              dir_sobel.push_back( SpatialCorrelation( img, KernelType::NormalizedSobel( img.Dims( ), dir ) ) );
+            }
+            Image< D > magnitude( img.Dim( ), img.PixelSize( ) );
+            Gradient::MagnitudeAndDirection( dir_sobel, &magnitude );
+            return( magnitude );
+          }, Halo( KernelType::NormalizedSobel( 3, 0 ) ) ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  size_t StreamFilter< D >::size( ) const {
+    return( operation.size( ) );
+  }
+
+  template< class D >
+  size_t StreamFilter< D >::Halo( ) const {
+    size_t res = 0;
+    for( size_t op = 0; op < halo.size( ); ++op ) {
+      res += halo[ op ];
+    }
+    return( res );
+  }
+
+  template< class D >
+  size_t StreamFilter< D >::Halo( const Adjacency &adj ) {
+    try {
+      float res = 0.0f;
+      for( size_t elm = 0; elm < adj.size( ); ++elm ) {
+        for( size_t dms = 0; dms < adj.Dims( ); ++dms ) {
+          res = std::max( res, std::fabs( adj( elm, dms ) ) );
+        }
+      }
+      return( static_cast< size_t >( std::ceil( res ) ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  size_t StreamFilter< D >::SlabSize( ) const {
+    return( slab );
+  }
+
+  template< class D >
+  void StreamFilter< D >::SlabSize( size_t slab_size ) {
+    try {
+      if( slab_size == 0 ) {
+        std::string msg( BIAL_ERROR( "Slab size must be greater than 0." ) );
+        throw( std::logic_error( msg ) );
+      }
+      slab = slab_size;
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > StreamFilter< D >::Apply( const Image< D > &src, size_t first, size_t slices ) const {
+    try {
+      COMMENT( "Applying the chain. Each operator result replaces the previous one.", 3 );
+      Image< D > filtered;
+      const Image< D > *current = &src;
+      for( size_t op = 0; op < operation.size( ); ++op ) {
+        Image< D > res( operation[ op ]( *current ) );
+        for( size_t dms = 0; dms < 3; ++dms ) {
+          if( res.size( dms ) != src.size( dms ) ) {
+            std::string msg( BIAL_ERROR( "Operator " + std::to_string( op ) + " changed the image dimensions." ) );
+            throw( std::logic_error( msg ) );
+          }
+        }
+        filtered = std::move( res );
+        current = &filtered;
+      }
+      COMMENT( "Cropping the output slices. Slices are contiguous, as the slab dimension varies slowest.", 3 );
+      size_t dimension = src.Dims( ) - 1;
+      size_t slice = src.size( ) / src.size( dimension );
+      Vector< size_t > spc_dim( src.Dims( ), 0 );
+      for( size_t dms = 0; dms < spc_dim.size( ); ++dms ) {
+        spc_dim[ dms ] = src.size( dms );
+      }
+      spc_dim[ dimension ] = slices;
+      Image< D > res( spc_dim, StorageInit::None );
+      res.PixelSize( src.PixelSize( ) );
+      const D *data = &( *current )[ 0 ] + first * slice;
+      std::copy( data, data + res.size( ), &res[ 0 ] );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void StreamFilter< D >::Execute( const Vector< size_t > &spc_dim, const Vector< float > &pixel_size,
+                                   const SliceReader &read, const SlabWriter &write ) const {
+    try {
+      size_t dimension = spc_dim.size( ) - 1;
+      size_t total = spc_dim[ dimension ];
+      size_t slice = 1;
+      for( size_t dms = 0; dms < dimension; ++dms ) {
+        slice *= spc_dim[ dms ];
+      }
+      size_t slab_halo = Halo( );
+      size_t slabs = ( total + slab - 1 ) / slab;
+      COMMENT( "Input slices of each slab: its output slices extended by the halo. A single slice would turn a 3D " <<
+               "slab into a 2D image, so one more slice is added.", 2 );
+      std::vector< size_t > low( slabs );
+      std::vector< size_t > hgh( slabs );
+      for( size_t slb = 0; slb < slabs; ++slb ) {
+        size_t first = slb * slab;
+        low[ slb ] = first > slab_halo ? first - slab_halo : 0;
+        hgh[ slb ] = std::min( total, first + slab + slab_halo );
+        if( ( dimension == 2 ) && ( total > 1 ) && ( hgh[ slb ] - low[ slb ] == 1 ) ) {
+          if( hgh[ slb ] < total ) {
+            ++hgh[ slb ];
+          }
+          else {
+            --low[ slb ];
+          }
+        }
+      }
+      COMMENT( "Slices shared with the previous slab are copied, so that each slice is read once, in order.", 2 );
+      auto load = [ & ]( size_t slb, const Image< D > *previous ) {
+        Vector< size_t > slab_dim( spc_dim );
+        slab_dim[ dimension ] = hgh[ slb ] - low[ slb ];
+        Image< D > res( slab_dim, StorageInit::None );
+        res.PixelSize( pixel_size );
+        size_t first = low[ slb ];
+        if( ( previous != nullptr ) && ( hgh[ slb - 1 ] > first ) ) {
+          const D *shared = &( *previous )[ 0 ] + ( first - low[ slb - 1 ] ) * slice;
+          std::copy( shared, shared + ( hgh[ slb - 1 ] - first ) * slice, &res[ 0 ] );
+          first = hgh[ slb - 1 ];
+        }
+        if( first < hgh[ slb ] ) {
+          read( first, hgh[ slb ] - first, &res[ 0 ] + ( first - low[ slb ] ) * slice );
+        }
+        return( res );
+      };
+      COMMENT( "Pipeline: slab slb is filtered while slab slb + 1 is read and slab slb - 1 is written.", 2 );
+      std::exception_ptr read_error;
+      std::exception_ptr write_error;
+      Image< D > current( load( 0, nullptr ) );
+      Image< D > output;
+      std::thread writer;
+      for( size_t slb = 0; slb < slabs; ++slb ) {
+        Image< D > next;
+        std::thread reader;
+        if( slb + 1 < slabs ) {
+          reader = std::thread( [ &, slb ]( ) {
+              try {
+                COMMENT( "Parallel loops of the reader run serially, so that it does not wait for the pool.", 4 );
+                ThreadPool::Serial( [ & ]( ) {
+                    next = load( slb + 1, &current );
+                  } );
+              }
+              catch( ... ) {
+                read_error = std::current_exception( );
+              }
+            } );
+        }
+        std::exception_ptr apply_error;
+        Image< D > res;
+        try {
+          size_t first = slb * slab;
+          res = Apply( current, first - low[ slb ], std::min( total, first + slab ) - first );
+        }
+        catch( ... ) {
+          apply_error = std::current_exception( );
+        }
+        if( reader.joinable( ) ) {
+          reader.join( );
+        }
+        if( writer.joinable( ) ) {
+          writer.join( );
+        }
+        for( std::exception_ptr error : { apply_error, read_error, write_error } ) {
+          if( error ) {
+            std::rethrow_exception( error );
+          }
+        }
+        output = std::move( res );
+        writer = std::thread( [ & ]( ) {
+            try {
+              ThreadPool::Serial( [ & ]( ) {
+                  write( output );
+                } );
+            }
+            catch( ... ) {
+              write_error = std::current_exception( );
+            }
+          } );
+        current = std::move( next );
+      }
+      if( writer.joinable( ) ) {
+        writer.join( );
+      }
+      if( write_error ) {
+        std::rethrow_exception( write_error );
+      }
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error reading or writing slab." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  Image< D > StreamFilter< D >::Run( const Image< D > &img ) const {
+    try {
+      Vector< size_t > spc_dim( img.Dim( ) );
+      if( img.Dims( ) == 2 ) {
+        spc_dim.pop_back( );
+      }
+      size_t slice = img.size( ) / spc_dim[ spc_dim.size( ) - 1 ];
+      Image< D > res( img.Dim( ), StorageInit::None );
+      res.PixelSize( img.PixelSize( ) );
+      D *dst = &res[ 0 ];
+      Execute( spc_dim, img.PixelSize( ), [ &img, slice ]( size_t first, size_t slices, D *slab_data ) {
+          const D *src = &img[ 0 ] + first * slice;
+          std::copy( src, src + slices * slice, slab_data );
+        }, [ &dst ]( const Image< D > &slab_res ) {
+          dst = std::copy( &slab_res[ 0 ], &slab_res[ 0 ] + slab_res.size( ), dst );
+        } );
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+  template< class D >
+  void StreamFilter< D >::Run( const std::string &src_filename, const std::string &dst_filename ) const {
+    try {
+      if( src_filename == dst_filename ) {
+        std::string msg( BIAL_ERROR( "Source and destination must be different files." ) );
+        throw( std::logic_error( msg ) );
+      }
+      std::string src_extension( File::ToLowerExtension( src_filename, static_cast< size_t >
+                                                          ( std::max( 0, static_cast< int >
+                                                                      ( src_filename.size( ) ) - 8 ) ) ) );
+      Vector< size_t > spc_dim;
+      Vector< float > pixel_size;
+      SliceReader read;
+      std::unique_ptr< ChunkedImage< D > > chunked;
+      std::unique_ptr< NiftiMapping > mapping;
+      std::unique_ptr< NiftiHeader > hdr;
+      IFile file;
+      std::vector< char > raw;
+      if( src_extension.rfind( ".bvol" ) != std::string::npos ) {
+        COMMENT( "Chunked volume. Slices are read by regions, caching two layers of chunks.", 2 );
+        chunked.reset( new ChunkedImage< D >( src_filename, 0 ) );
+        spc_dim = chunked->Dim( );
+        spc_dim.resize( chunked->Dims( ) );
+        pixel_size = chunked->PixelSize( );
+        size_t dimension = spc_dim.size( ) - 1;
+        size_t slice = chunked->size( ) / spc_dim[ dimension ];
+        chunked->CacheLimit( 2 * slice * chunked->ChunkDim( )[ dimension ] * sizeof( D ) );
+        read = [ &chunked, &spc_dim, dimension, slice ]( size_t first, size_t slices, D *dst ) {
+          Vector< size_t > low_coord( 3, 0 );
+          Vector< size_t > hgh_coord( 3, 0 );
+          for( size_t dms = 0; dms < dimension; ++dms ) {
+            hgh_coord[ dms ] = spc_dim[ dms ] - 1;
+          }
+          low_coord[ dimension ] = first;
+          hgh_coord[ dimension ] = first + slices - 1;
+          Image< D > region( chunked->Region( low_coord, hgh_coord ) );
+          std::copy( &region[ 0 ], &region[ 0 ] + slices * slice, dst );
+        };
+      }
+      else if( ( src_extension.rfind( ".hdr" ) != std::string::npos ) ||
+               ( src_extension.rfind( ".img" ) != std::string::npos ) ||
+               ( src_extension.rfind( ".nii" ) != std::string::npos ) ) {
+        hdr.reset( new NiftiHeader( src_filename ) );
+        Vector< size_t > dim( hdr->Dim( ) );
+        Vector< float > pixdim( hdr->PixelSize( ) );
+        if( ( ( dim.size( ) > 4 ) && ( dim[ 4 ] > 1 ) ) || ( ( dim.size( ) > 3 ) && ( dim[ 3 ] > 1 ) ) ) {
+          std::string msg( BIAL_ERROR( "Cannot stream multi-channel or time series Nifti images." ) );
+          throw( std::runtime_error( msg ) );
+        }
+        spc_dim = Vector< size_t >( { dim[ 0 ], dim[ 1 ] } );
+        pixel_size = Vector< float >( { pixdim[ 0 ], pixdim[ 1 ], 1.0f } );
+        if( dim.size( ) > 2 ) {
+          spc_dim.push_back( dim[ 2 ] );
+          pixel_size[ 2 ] = pixdim[ 2 ];
+        }
+        size_t slice = spc_dim[ 0 ] * ( spc_dim.size( ) > 2 ? spc_dim[ 1 ] : 1 );
+        if( NiftiMapping::IsMappable( src_filename ) ) {
+          COMMENT( "Uncompressed data. Slices are converted straight from the mapping.", 2 );
+          mapping.reset( new NiftiMapping( src_filename, *hdr ) );
+          read = [ &mapping, slice ]( size_t first, size_t slices, D *dst ) {
+            mapping->Read( first * slice, slices * slice, dst );
+          };
+        }
+        else {
+          COMMENT( "Compressed data. Slices are decompressed in order.", 2 );
+          file.exceptions( std::ios::eofbit | std::ios::failbit | std::ios::badbit );
+          file.open( NiftiHeader::ExistingDataFileName( src_filename ) );
+          if( src_extension.rfind( ".nii" ) != std::string::npos ) {
+            file.ignore( std::max( hdr->VoxOffset( ), static_cast< size_t >( NiftiHeader::NIFTI_HEADER_SIZE + 4 ) ) );
+          }
+          size_t bytes = static_cast< size_t >( hdr->BitPix( ) / 8 );
+          read = [ &file, &raw, &hdr, slice, bytes ]( size_t, size_t slices, D *dst ) {
+            raw.resize( slices * slice * bytes );
+            file.read( raw.data( ), raw.size( ) );
+            if( ( !file.good( ) ) || file.eof( ) || file.fail( ) || file.bad( ) ) {
+              std::string msg( BIAL_ERROR( "Error reading Nifti file." ) );
+              throw( std::ios_base::failure( msg ) );
+            }
+            NiftiMapping::ConvertData( hdr->DataType( ), raw.data( ), hdr->Swapped( ), dst, slices * slice );
+          };
+        }
+      }
+      else {
+        std::string msg( BIAL_ERROR( "Unsupported extension of " + src_filename + ". Currently supported: " +
+                                     ".img(.gz), .hdr(.gz), .nii(.gz), .bvol." ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Writing the header. Slabs are appended as they are filtered.", 2 );
+      bool one_file = dst_filename.rfind( ".nii" ) != std::string::npos;
+      NiftiHeader dst_hdr( spc_dim, pixel_size, NiftiHeader::DataTypeDecode( D( ) ), one_file );
+      OFile out;
+      out.exceptions( std::fstream::failbit | std::fstream::badbit );
+      out.open( NiftiHeader::HeaderFileName( dst_filename ) );
+      dst_hdr.Write( out, one_file );
+      if( !one_file ) {
+        out.close( );
+        out.open( NiftiHeader::DataFileName( dst_filename ) );
+      }
+      Execute( spc_dim, pixel_size, read, [ &out ]( const Image< D > &slab_res ) {
+          out.write( reinterpret_cast< const char* >( &slab_res[ 0 ] ), slab_res.size( ) * sizeof( D ) );
+        } );
+      out.close( );
+    }
+    catch( std::ios_base::failure &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Error streaming " + src_filename + " to " +
+                                                                     dst_filename + "." ) );
+      throw( std::ios_base::failure( msg ) );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
+#ifdef BIAL_EXPLICIT_StreamFilter
+
+  template class StreamFilter< int >;
+  template class StreamFilter< llint >;
+  template class StreamFilter< float >;
+  template class StreamFilter< double >;
+
+#endif
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,262 @@
+/* Biomedical Image Analysis Library
+ * See README file in the root instalation directory for more information.
+ */
+
+/**
+ * @date 2026/Oct/17
+ * @brief Library-wide persistent thread pool.
+ */
+
+#ifndef BIALTHREADPOOL_C
+#define BIALTHREADPOOL_C
+
+#include "ThreadPool.hpp"
+
+#if defined ( BIAL_EXPLICIT_LIB ) && ( BIAL_ThreadPool )
+#define BIAL_EXPLICIT_ThreadPool
+#endif
+#if defined ( BIAL_EXPLICIT_ThreadPool ) || ( BIAL_IMPLICIT_BIN )
+
+namespace Bial {
+
+  /** @brief Whether the current thread is running a pool job. Nested parallel loops run serially. */
+  static thread_local bool thread_pool_inside_job = false;
+
+  ThreadPool::ThreadPool( ) : slots( 1 ), body( nullptr ), grain( 1 ), generation( 0 ), active( 0 ), stop( false ) {
+    size_t total_threads = 0;
+    const char *env = std::getenv( "BIAL_THREADS" );
+    if( env != nullptr ) {
+      total_threads = static_cast< size_t >( std::strtoul( env, nullptr, 10 ) );
+    }
+    std::lock_guard< std::mutex > job_lock( job_mutex );
+    Resize( total_threads );
+  }
+
+  ThreadPool::~ThreadPool( ) {
+    {
+      std::lock_guard< std::mutex > state_lock( state_mutex );
+      stop = true;
+    }
+    wake.notify_all( );
+    for( size_t thd = 0; thd < worker.size( ); ++thd ) {
+      worker[ thd ].join( );
+    }
+  }
+
+  ThreadPool &ThreadPool::Instance( ) {
+    static ThreadPool pool;
+    return( pool );
+  }
+
+  void ThreadPool::Resize( size_t total_threads ) {
+    COMMENT( "Stopping current workers.", 1 );
+    {
+      std::lock_guard< std::mutex > state_lock( state_mutex );
+      stop = true;
+    }
+    wake.notify_all( );
+    for( size_t thd = 0; thd < worker.size( ); ++thd ) {
+      worker[ thd ].join( );
+    }
+    worker.clear( );
+    stop = false;
+    COMMENT( "Creating new workers.", 1 );
+    if( total_threads == 0 ) {
+      total_threads = std::max( std::thread::hardware_concurrency( ), 1u );
+    }
+    range.clear( );
+    for( size_t slot = 0; slot < total_threads; ++slot ) {
+      range.push_back( std::unique_ptr< WorkRange >( new WorkRange( ) ) );
+      range.back( )->first = range.back( )->last = 0;
+    }
+    try {
+      for( size_t slot = 1; slot < total_threads; ++slot ) {
+        worker.push_back( std::thread( &ThreadPool::WorkerLoop, this, slot, generation ) );
+      }
+    }
+    catch( std::exception &e ) {
+      BIAL_WARNING( "Failed to create all threads. Running with " << worker.size( ) + 1 << " threads. Exception: " <<
+                    e.what( ) );
+      range.resize( worker.size( ) + 1 );
+    }
+    slots = range.size( );
+  }
+
+  void ThreadPool::WorkerLoop( size_t slot, size_t seen ) {
+    while( true ) {
+      {
+        std::unique_lock< std::mutex > state_lock( state_mutex );
+        wake.wait( state_lock, [ this, seen ] { return( stop || ( generation != seen ) ); } );
+        if( stop ) {
+          return;
+        }
+        seen = generation;
+      }
+      Execute( slot );
+      {
+        std::lock_guard< std::mutex > state_lock( state_mutex );
+        --active;
+        if( active == 0 ) {
+          done.notify_all( );
+        }
+      }
+    }
+  }
+
+  bool ThreadPool::Pop( size_t slot, size_t &first, size_t &last ) {
+    WorkRange &own = *range[ slot ];
+    std::lock_guard< std::mutex > range_lock( own.lock );
+    if( own.first >= own.last ) {
+      return( false );
+    }
+    first = own.first;
+    last = std::min( own.last, first + grain );
+    own.first = last;
+    return( true );
+  }
+
+  bool ThreadPool::Steal( size_t slot, size_t &first, size_t &last ) {
+    size_t slots = range.size( );
+    for( size_t ofs = 1; ofs < slots; ++ofs ) {
+      WorkRange &victim = *range[ ( slot + ofs ) % slots ];
+      size_t stolen_first;
+      size_t stolen_last;
+      {
+        std::lock_guard< std::mutex > range_lock( victim.lock );
+        if( victim.first >= victim.last ) {
+          continue;
+        }
+        stolen_last = victim.last;
+        if( victim.last - victim.first > grain ) {
+          victim.last = victim.first + ( victim.last - victim.first + 1 ) / 2;
+        }
+        else {
+          victim.last = victim.first;
+        }
+        stolen_first = victim.last;
+      }
+      first = stolen_first;
+      last = std::min( stolen_last, first + grain );
+      WorkRange &own = *range[ slot ];
+      std::lock_guard< std::mutex > range_lock( own.lock );
+      own.first = last;
+      own.last = stolen_last;
+      return( true );
+    }
+    return( false );
+  }
+
+  void ThreadPool::Execute( size_t slot ) {
+    thread_pool_inside_job = true;
+    size_t first;
+    size_t last;
+    while( Pop( slot, first, last ) || Steal( slot, first, last ) ) {
+      try {
+        ( *body )( first, last );
+      }
+      catch( ... ) {
+        std::lock_guard< std::mutex > state_lock( state_mutex );
+        if( !error ) {
+          error = std::current_exception( );
+        }
+      }
+    }
+    thread_pool_inside_job = false;
+  }
+
+  size_t ThreadPool::Threads( ) {
+    return( Instance( ).slots );
+  }
+
+  void ThreadPool::Threads( size_t total_threads ) {
+    ThreadPool &pool = Instance( );
+    std::lock_guard< std::mutex > job_lock( pool.job_mutex );
+    pool.Resize( total_threads );
+  }
+
+  size_t ThreadPool::Tasks( size_t elements ) {
+    return( std::max< size_t >( std::min( elements, 4 * Threads( ) ), 1 ) );
+  }
+
+  void ThreadPool::ParallelFor( size_t first, size_t last, size_t grain,
+                                const std::function< void( size_t, size_t ) > &body ) {
+    if( first >= last ) {
+      return;
+    }
+    grain = std::max< size_t >( grain, 1 );
+    if( ( thread_pool_inside_job ) || ( last - first <= grain ) ) {
+      COMMENT( "Nested or small loop. Running in the calling thread.", 3 );
+      body( first, last );
+      return;
+    }
+    ThreadPool &pool = Instance( );
+    std::lock_guard< std::mutex > job_lock( pool.job_mutex );
+    if( pool.worker.empty( ) ) {
+      COMMENT( "Single thread pool. Running in the calling thread.", 3 );
+      thread_pool_inside_job = true;
+      try {
+        body( first, last );
+      }
+      catch( ... ) {
+        thread_pool_inside_job = false;
+        throw;
+      }
+      thread_pool_inside_job = false;
+      return;
+    }
+    COMMENT( "Splitting the range among the threads.", 3 );
+    size_t slots = pool.range.size( );
+    size_t size = last - first;
+    for( size_t slot = 0; slot < slots; ++slot ) {
+      pool.range[ slot ]->first = first + slot * size / slots;
+      pool.range[ slot ]->last = first + ( slot + 1 ) * size / slots;
+    }
+    pool.body = &body;
+    pool.grain = grain;
+    {
+      std::lock_guard< std::mutex > state_lock( pool.state_mutex );
+      pool.error = nullptr;
+      pool.active = pool.worker.size( );
+      ++pool.generation;
+    }
+    pool.wake.notify_all( );
+    pool.Execute( 0 );
+    std::exception_ptr error;
+    {
+      std::unique_lock< std::mutex > state_lock( pool.state_mutex );
+      pool.done.wait( state_lock, [ &pool ] { return( pool.active == 0 ); } );
+      pool.body = nullptr;
+      error = pool.error;
+      pool.error = nullptr;
+    }
+    if( error ) {
+      std::rethrow_exception( error );
+    }
+  }
+
+  void ThreadPool::Run( size_t total_tasks, const std::function< void( size_t, size_t ) > &task ) {
+    ParallelFor( 0, total_tasks, 1, [ &task, total_tasks ]( size_t first, size_t last ) {
+        for( size_t thd = first; thd < last; ++thd ) {
+          task( thd, total_tasks );
+        }
+      } );
+  }
+
+  void ThreadPool::Serial( const std::function< void( ) > &body ) {
+    bool inside_job = thread_pool_inside_job;
+    thread_pool_inside_job = true;
+    try {
+      body( );
+    }
+    catch( ... ) {
+      thread_pool_inside_job = inside_job;
+      throw;
+    }
+    thread_pool_inside_job = inside_job;
+  }
+
+}
+
+#endif
+
+#endif
@@ -18,34 +18,93 @@
 
 #if defined ( BIAL_EXPLICIT_TransformEuclDist ) || ( BIAL_IMPLICIT_BIN )
 
-#include "AdjacencyRound.hpp"
+#include "FilteringGaussian.hpp"
 #include "Image.hpp"
-#include "ImageIFT.hpp"
-#include "GeodesicPathFunction.hpp"
+#include "Vector.hpp"
+#include <cmath>
+#include <limits>
 
 namespace Bial {
 
+  void Transform::SquaredDistanceLine( Vector< double > &line, double spacing ) {
+    try {
+      COMMENT( "Lower envelope of the parabolas. vertex holds their roots, and range[ k ] is where parabola k starts.",
+               3 );
+      size_t size = line.size( );
+      Vector< size_t > vertex( size );
+      Vector< double > range( size + 1 );
+      Vector< double > height( line );
+      double infinity = std::numeric_limits< double >::infinity( );
+      size_t parabolas = 0;
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        if( height[ pxl ] == infinity ) {
+          continue;
+        }
+        double pos = pxl * spacing;
+        double start = -infinity;
+        while( parabolas > 0 ) {
+          double top_pos = vertex[ parabolas - 1 ] * spacing;
+          start = ( ( height[ pxl ] + pos * pos ) - ( height[ vertex[ parabolas - 1 ] ] + top_pos * top_pos ) ) /
+            ( 2.0 * ( pos - top_pos ) );
+          if( start > range[ parabolas - 1 ] ) {
+            break;
+          }
+          COMMENT( "Parabola at the top is below the new one everywhere it was the lowest.", 4 );
+          --parabolas;
+          start = -infinity;
+        }
+        vertex[ parabolas ] = pxl;
+        range[ parabolas ] = start;
+        ++parabolas;
+      }
+      if( parabolas == 0 ) {
+        return;
+      }
+      range[ parabolas ] = infinity;
+      size_t prb = 0;
+      for( size_t pxl = 0; pxl < size; ++pxl ) {
+        double pos = pxl * spacing;
+        while( range[ prb + 1 ] < pos ) {
+          ++prb;
+        }
+        double dist = pos - vertex[ prb ] * spacing;
+        line[ pxl ] = dist * dist + height[ vertex[ prb ] ];
+      }
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
   template< class D >
-  Image< D > Transform::EDT( const Image< D > &border ) {
+  Image< double > Transform::SquaredEDT( const Image< D > &border ) {
     try {
-      Image< float > value( border );
-      value.Set( 0.0f );
-      Adjacency adj = AdjacencyType::HyperSpheric( 1.8, border.Dims( ) );
-      GeodesicDistancePathFunction< float > path_func( value );
       COMMENT( "Setting seed pixels.", 0 );
-      Vector< bool > seed( border.size( ) );
+      Image< double > value( border );
+      double infinity = std::numeric_limits< double >::infinity( );
       for( size_t pxl = 0; pxl < border.size( ); ++pxl ) {
-        if( border[ pxl ] != 0 ) {
-          seed( pxl ) = true;
-          value[ pxl ] = 0;
-        }
-        else
-          value[ pxl ] = std::numeric_limits< D >::max( );          
+        value[ pxl ] = ( border[ pxl ] != 0 ) ? 0.0 : infinity;
+      }
+      COMMENT( "Computing squared distances along each dimension, over the result of the previous ones.", 0 );
+      for( size_t dms = 0; dms < border.Dims( ); ++dms ) {
+        double spacing = border.PixelSize( dms );
+        Filtering::FilterLines( value, dms, [ spacing ]( Vector< double > &line ) {
+            SquaredDistanceLine( line, spacing );
+          } );
       }
-      COMMENT( "Computing distance transform with geodesic path function and image IFT.", 0 );
-      ImageIFT< float > ift( value, adj, &path_func, &seed, static_cast< Image< int >* >( nullptr ),
-                             static_cast< Image< int >* >( nullptr ), false, 0.001f, true );
-      ift.Run( );
       return( value );
     }
     catch( std::bad_alloc &e ) {
@@ -66,35 +125,62 @@ namespace Bial {
     }
   }
 
+  template< class D >
+  Image< D > Transform::EDT( const Image< D > &border ) {
+    try {
+      Image< double > value( SquaredEDT( border ) );
+      COMMENT( "Computing distances from squared distances.", 0 );
+      Image< D > res( border );
+      for( size_t pxl = 0; pxl < border.size( ); ++pxl ) {
+        if( value[ pxl ] == std::numeric_limits< double >::infinity( ) ) {
+          res[ pxl ] = std::numeric_limits< D >::max( );
+        }
+        else {
+          res[ pxl ] = static_cast< D >( std::sqrt( value[ pxl ] ) );
+        }
+      }
+      return( res );
+    }
+    catch( std::bad_alloc &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( std::runtime_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Runtime error." ) );
+      throw( std::runtime_error( msg ) );
+    }
+    catch( const std::out_of_range &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Out of range exception." ) );
+      throw( std::out_of_range( msg ) );
+    }
+    catch( const std::logic_error &e ) {
+      std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Logic Error." ) );
+      throw( std::logic_error( msg ) );
+    }
+  }
+
   template< class D >
   Image< D > Transform::EDT( const Image< D > &border, const Image< D > &mask ) {
     try {
-      Image< float > value( mask );
-      Adjacency adj = AdjacencyType::HyperSpheric( 1.8, mask.Dims( ) );
-      COMMENT( "Setting value for mask.", 0 );
+      if( border.size( ) != mask.size( ) ) {
+        std::string msg( BIAL_ERROR( "Border and mask images must have the same size." ) );
+        throw( std::logic_error( msg ) );
+      }
+      COMMENT( "Setting seed pixels inside mask.", 0 );
+      Image< D > seed( border );
       for( size_t pxl = 0; pxl < mask.size( ); ++pxl ) {
         if( mask[ pxl ] == 0 ) {
-          value[ pxl ] = 0;
+          seed[ pxl ] = 0;
         }
       }
-      GeodesicDistancePathFunction< float > path_func( value );
-      COMMENT( "Setting seed pixels.", 0 );
-      Vector< bool > seed( mask.size( ) );
+      Image< D > res( EDT( seed ) );
+      COMMENT( "Setting value for mask.", 0 );
       for( size_t pxl = 0; pxl < mask.size( ); ++pxl ) {
-        if( border[ pxl ] != 0 ) {
-          seed( pxl ) = true;
-          value[ pxl ] = 0;
-        }
-        else {
-          value[ pxl ] = std::numeric_limits< float >::max( );
-          seed( pxl ) = false;
+        if( mask[ pxl ] == 0 ) {
+          res[ pxl ] = 0;
         }
       }
-      COMMENT( "Computing distance transform with geodesic path function and image IFT.", 0 );
-      ImageIFT< float > ift( value, adj, &path_func, &seed, static_cast< Image< int >* >( nullptr ),
-                             static_cast< Image< int >* >( nullptr ), false, 0.001f, true );
-      ift.Run( );
-      return( value );
+      return( res );
     }
     catch( std::bad_alloc &e ) {
       std::string msg( e.what( ) + std::string( "\n" ) + BIAL_ERROR( "Memory allocation error." ) );
@@ -116,6 +202,11 @@ namespace Bial {
 
 #ifdef BIAL_EXPLICIT_TransformEuclDist
 
+  template Image< double > Transform::SquaredEDT( const Image< int > &border );
+  template Image< double > Transform::SquaredEDT( const Image< llint > &border );
+  template Image< double > Transform::SquaredEDT( const Image< float > &border );
+  template Image< double > Transform::SquaredEDT( const Image< double > &border );
+
   template Image< int > Transform::EDT( const Image< int > &border );
   template Image< llint > Transform::EDT( const Image< llint > &border );
   template Image< float > Transform::EDT( const Image< float > &border );
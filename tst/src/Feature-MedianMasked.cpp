@@ -0,0 +1,85 @@
+/* Biomedical Image Analysis Library */
+/* See README file in the root instalation directory for more information. */
+
+/* Date: 2026/Oct/17 */
+/* Content: Test file. */
+/* Description: Compares MedianFeature of a float image, with and without a mask, with the features obtained by */
+/* sorting the adjacents of each pixel. Adjacents out of the domain or of the mask count as the central value. The */
+/* mask holds the pixels above the mean intensity. Returns non-zero if any feature differs. */
+
+#include "AdjacencyRound.hpp"
+#include "Feature.hpp"
+#include "FileImage.hpp"
+#include "Image.hpp"
+#include "MedianFeature.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+using namespace std;
+using namespace Bial;
+
+size_t Compare( const Image< float > &img, const Image< float > &msk, const Adjacency &adj,
+                const Feature< float > &feat ) {
+  size_t features = feat.Features( );
+  size_t adj_base = ( adj.size( ) / 2 ) - ( features / 2 );
+  Vector< float > median( adj.size( ) );
+  size_t diff = 0;
+  size_t tgt_elm = 0;
+  for( size_t src_elm = 0; src_elm < img.size( ); ++src_elm ) {
+    if( msk[ src_elm ] == 0.0f )
+      continue;
+    for( size_t idx = 0; idx < adj.size( ); ++idx ) {
+      size_t elm_adj = adj( img, src_elm, idx );
+      if( ( elm_adj < img.size( ) ) && ( msk[ elm_adj ] != 0.0f ) )
+        median[ idx ] = img[ elm_adj ];
+      else
+        median[ idx ] = img[ src_elm ];
+    }
+    sort( median.begin( ), median.end( ) );
+    for( size_t ftr = 0; ftr < features; ++ftr ) {
+      if( feat( tgt_elm, ftr ) != median[ adj_base + ftr ] )
+        ++diff;
+    }
+    ++tgt_elm;
+  }
+  if( tgt_elm != feat.Elements( ) )
+    diff += feat.Elements( ) + tgt_elm;
+  return( diff );
+}
+
+int main( int argc, char **argv ) {
+  if( ( argc < 2 ) || ( argc > 5 ) ) {
+    cout << "Usage: " << argv[ 0 ] << " <input image> [<radius> [<proportion> [<threads>] ] ]" << endl;
+    cout << "\t\t<radius>: Adjacency radius. Default: 1.5." << endl;
+    cout << "\t\t<proportion>: Proportion of the adjacents taken as features. Default: 0.6." << endl;
+    cout << "\t\t<threads>: Number of threads. Default: BIAL_THREADS, or hardware threads." << endl;
+    return( 0 );
+  }
+  float radius = ( argc > 2 ) ? atof( argv[ 2 ] ) : 1.5f;
+  float proportion = ( argc > 3 ) ? atof( argv[ 3 ] ) : 0.6f;
+  if( argc > 4 )
+    ThreadPool::Threads( atoi( argv[ 4 ] ) );
+  Image< float > img( Read< float >( argv[ 1 ] ) );
+  Adjacency adj( AdjacencyType::HyperSpheric( radius, img.Dims( ) ) );
+
+  double mean = 0.0;
+  for( size_t pxl = 0; pxl < img.size( ); ++pxl )
+    mean += img[ pxl ];
+  mean /= img.size( );
+  Image< float > msk( img.Dim( ), img.PixelSize( ) );
+  Image< float > all( img.Dim( ), img.PixelSize( ) );
+  for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
+    msk[ pxl ] = ( img[ pxl ] > mean ) ? 1.0f : 0.0f;
+    all[ pxl ] = 1.0f;
+  }
+
+  size_t masked_diff = Compare( img, msk, adj, MedianFeature( img, msk, adj, proportion ) );
+  size_t whole_diff = Compare( img, all, adj, MedianFeature( img, adj, proportion ) );
+  cout << "Threads: " << ThreadPool::Threads( ) << ", adjacents: " << adj.size( ) << ". Different features: masked "
+       << masked_diff << ", whole image " << whole_diff << "." << endl;
+  if( ( masked_diff != 0 ) || ( whole_diff != 0 ) ) {
+    cout << "Error: median features differ from the sorted adjacents." << endl;
+    return( 1 );
+  }
+  return( 0 );
+}
@@ -0,0 +1,50 @@
+/* Biomedical Image Analysis Library */
+/* See README file in the root instalation directory for more information. */
+
+/* Date: 2026/Oct/17 */
+/* Version: 1.0.00 */
+/* Content: Test file. */
+/* Description: Test with recursive Gaussian filter and its derivatives. */
+
+#include "FileImage.hpp"
+#include "FilteringGaussian.hpp"
+#include "Image.hpp"
+
+using namespace std;
+using namespace Bial;
+
+int main( int argc, char **argv ) {
+  if( ( argc < 3 ) || ( argc > 5 ) ) {
+    cout << "Usage: " << argv[ 0 ] << " <input image> <output image> [<standard deviation> [ <direction> ] ]"
+         << endl;
+    cout << "\t\t<standard deviation>: [0.5,+oo). Default: 2.0" << endl;
+    cout << "\t\t<direction>: Dimension of the first derivative. Default: no derivative." << endl;
+    return( 0 );
+  }
+
+  /* reading parameters */
+  float std_dev = 2.0;
+  if( argc > 3 ) {
+    std_dev = atof( argv[ 3 ] );
+  }
+  if( std_dev < 0.5 ) {
+    cout << "Error: Standard deviation range: [0.5, +oo). Given: " << std_dev << endl;
+    return( 0 );
+  }
+  Image< float > img( Read< float >( argv[ 1 ] ) );
+  if( argc > 4 ) {
+    size_t direction = atoi( argv[ 4 ] );
+    if( direction >= img.Dims( ) ) {
+      cout << "Error: Direction range: [0, " << img.Dims( ) - 1 << "]. Given: " << direction << endl;
+      return( 0 );
+    }
+    Image< float > res( Filtering::RecursiveGaussianDerivative( img, std_dev, direction ) );
+    Write( res, argv[ 2 ], argv[ 1 ] );
+  }
+  else {
+    Image< float > res( Filtering::RecursiveGaussian( img, std_dev ) );
+    Write( res, argv[ 2 ], argv[ 1 ] );
+  }
+
+  return( 0 );
+}
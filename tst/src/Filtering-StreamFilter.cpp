@@ -0,0 +1,102 @@
+/* Biomedical Image Analysis Library */
+/* See README file in the root instalation directory for more information. */
+
+/* Date: 2026/Oct/17 */
+/* Content: Test file. */
+/* Description: Compares StreamFilter::Run( img ), slab by slab, with the same operators applied to the whole */
+/* image, for each supported operator and for the chain of all of them. Returns non-zero if any pixel differs. */
+/* Gaussian and Sobel are compared with the spatial correlation, as Filtering::Gaussian and Gradient::Sobel may run */
+/* whole images in the frequency domain, which rounds differently. */
+
+#include "AdjacencyRound.hpp"
+#include "Correlation.hpp"
+#include "FileImage.hpp"
+#include "FilteringMean.hpp"
+#include "FilteringMedian.hpp"
+#include "GradientSobel.hpp"
+#include "Image.hpp"
+#include "KernelGaussian.hpp"
+#include "KernelSobel.hpp"
+#include "MorphologyDilation.hpp"
+#include "MorphologyErosion.hpp"
+#include "StreamFilter.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+using namespace Bial;
+
+typedef function< Image< float >( const Image< float > & ) > Operator;
+
+bool Compare( const string &name, const StreamFilter< float > &stream, const Operator &whole,
+              const Image< float > &img ) {
+  Image< float > stream_res( stream.Run( img ) );
+  Image< float > whole_res( whole( img ) );
+  size_t diff = 0;
+  for( size_t pxl = 0; pxl < img.size( ); ++pxl ) {
+    if( stream_res[ pxl ] != whole_res[ pxl ] )
+      ++diff;
+  }
+  cout << name << ": halo " << stream.Halo( ) << ", different pixels: " << diff << " of " << img.size( ) << "."
+       << endl;
+  return( diff == 0 );
+}
+
+int main( int argc, char **argv ) {
+  if( ( argc < 2 ) || ( argc > 4 ) ) {
+    cout << "Usage: " << argv[ 0 ] << " <input image> [<slab size> [<threads>] ]" << endl;
+    cout << "\t\t<slab size>: Number of output slices of each slab. Default: 2." << endl;
+    cout << "\t\t<threads>: Number of threads of the operators. Default: BIAL_THREADS, or hardware threads." << endl;
+    return( 0 );
+  }
+  size_t slab = 2;
+  if( argc > 2 )
+    slab = atoi( argv[ 2 ] );
+  if( argc > 3 )
+    ThreadPool::Threads( atoi( argv[ 3 ] ) );
+  Image< float > img( Read< float >( argv[ 1 ] ) );
+  cout << "Slab size: " << slab << ", threads: " << ThreadPool::Threads( ) << endl;
+
+  Adjacency adj( AdjacencyType::HyperSpheric( 1.5, img.Dims( ) ) );
+  vector< string > name( { "Gaussian", "Mean", "Median", "Dilate", "Erode", "Sobel" } );
+  vector< Operator > whole( {
+      [ ]( const Image< float > &src ) {
+        return( SpatialCorrelation( src, KernelType::Gaussian( src.Dims( ), 1.5, 1.0 ) ) );
+      },
+      [ ]( const Image< float > &src ) { return( Filtering::Mean( src, 1.5 ) ); },
+      [ ]( const Image< float > &src ) { return( Filtering::Median( src, 1.5 ) ); },
+      [ &adj ]( const Image< float > &src ) { return( Morphology::Dilate( src, adj ) ); },
+      [ &adj ]( const Image< float > &src ) { return( Morphology::Erode( src, adj ) ); },
+      [ ]( const Image< float > &src ) {
+        Vector< Image< float > > dir_sobel;
+        for( size_t dir = 0; dir < src.Dims( ); ++dir )
+          dir_sobel.push_back( SpatialCorrelation( src, KernelType::NormalizedSobel( src.Dims( ), dir ) ) );
+        Image< float > magnitude( src.Dim( ), src.PixelSize( ) );
+        Gradient::MagnitudeAndDirection( dir_sobel, &magnitude );
+        return( magnitude );
+      } } );
+  vector< StreamFilter< float > > stream( name.size( ), StreamFilter< float >( slab ) );
+  stream[ 0 ].Gaussian( 1.5, 1.0 );
+  stream[ 1 ].Mean( 1.5 );
+  stream[ 2 ].Median( 1.5 );
+  stream[ 3 ].Dilate( adj );
+  stream[ 4 ].Erode( adj );
+  stream[ 5 ].Sobel( );
+
+  bool equal = true;
+  for( size_t op = 0; op < name.size( ); ++op )
+    equal = Compare( name[ op ], stream[ op ], whole[ op ], img ) && equal;
+  StreamFilter< float > all( slab );
+  all.Gaussian( 1.5, 1.0 ).Mean( 1.5 ).Median( 1.5 ).Dilate( adj ).Erode( adj ).Sobel( );
+  equal = Compare( "Chain", all, [ &whole ]( const Image< float > &src ) {
+      Image< float > res( src );
+      for( size_t op = 0; op < whole.size( ); ++op )
+        res = whole[ op ]( res );
+      return( res );
+    }, img ) && equal;
+
+  if( !equal ) {
+    cout << "Error: streamed and whole image results differ." << endl;
+    return( 1 );
+  }
+  return( 0 );
+}
@@ -0,0 +1,105 @@
+/* Biomedical Image Analysis Library */
+/* See README file in the root instalation directory for more information. */
+
+/* Date: 2026/Oct/17 */
+/* Content: Test file. */
+/* Description: Adds and removes seeds of a watershed segmentation with the differential IFT, and compares each edit
+ * with a segmentation from scratch on the remaining seeds. Every third edit removes a previous stroke. Returns non-zero
+ * if costs differ, or if the differential forest has a path that is not optimum. Labels may only differ where a pixel
+ * has optimum paths from seeds of different labels. */
+
+#include "AdjacencyRound.hpp"
+#include "DifferentialImageIFT.hpp"
+#include "FileImage.hpp"
+#include "Image.hpp"
+#include "MaxPathFunction.hpp"
+#include "SegmentationWatershed.hpp"
+#include <chrono>
+#include <map>
+#include <random>
+
+using namespace std;
+using namespace Bial;
+
+int main( int argc, char **argv ) {
+  if( ( argc < 3 ) || ( argc > 4 ) ) {
+    cout << "Usage: " << argv[ 0 ] << " <gradient image> <output label> [<edits>]" << endl;
+    cout << "\t\t<edits>: Number of seed additions and removals. Default: 10." << endl;
+    return( 0 );
+  }
+  Image< int > gradient( Read< int >( argv[ 1 ] ) );
+  size_t edits = ( argc == 4 ) ? atoi( argv[ 3 ] ) : 10;
+  Adjacency adjacency( AdjacencyType::HyperSpheric( 1.0, gradient.Dims( ) ) );
+  DifferentialImageIFT< int, MaxPathFunction< Image, int > > dift( gradient, adjacency );
+  mt19937 generator( 0 );
+  Vector< Vector< size_t > > strokes;
+  map< size_t, int > seed_label;
+  bool valid = true;
+  for( size_t edt = 0; edt < edits; ++edt ) {
+    if( ( edt % 3 == 2 ) && ( !strokes.empty( ) ) ) {
+      size_t removed = generator( ) % strokes.size( );
+      dift.RemoveSeeds( strokes[ removed ] );
+      for( size_t pxl : strokes[ removed ] )
+        seed_label.erase( pxl );
+      strokes.erase( strokes.begin( ) + removed );
+    }
+    else {
+      Vector< size_t > stroke;
+      size_t start = generator( ) % gradient.size( );
+      for( size_t pxl = start; ( pxl < start + 10 ) && ( pxl < gradient.size( ) ); ++pxl )
+        stroke.push_back( pxl );
+      int lbl = ( edt % 3 == 0 ) ? 1 : 0;
+      dift.AddSeeds( stroke, lbl );
+      for( size_t pxl : stroke )
+        seed_label[ pxl ] = lbl;
+      strokes.push_back( stroke );
+    }
+    Vector< size_t > obj_seeds;
+    Vector< size_t > bkg_seeds;
+    for( auto seed = seed_label.begin( ); seed != seed_label.end( ); ++seed ) {
+      if( seed->second == 1 )
+        obj_seeds.push_back( seed->first );
+      else
+        bkg_seeds.push_back( seed->first );
+    }
+    auto start_time = chrono::steady_clock::now( );
+    dift.Run( );
+    double dift_time = chrono::duration< double >( chrono::steady_clock::now( ) - start_time ).count( );
+    if( ( obj_seeds.empty( ) ) || ( bkg_seeds.empty( ) ) ) {
+      cout << "Edit " << edt << ": differential " << dift_time << "s. Visited " << dift.Visited( ) << " pixels."
+           << endl;
+      continue;
+    }
+    Image< int > cost( gradient );
+    start_time = chrono::steady_clock::now( );
+    Image< int > label( Segmentation::Watershed( cost, obj_seeds, bkg_seeds ) );
+    double full_time = chrono::duration< double >( chrono::steady_clock::now( ) - start_time ).count( );
+    size_t cost_diff = 0;
+    size_t label_diff = 0;
+    size_t arc_error = 0;
+    const Image< int > &dift_cost = dift.Value( );
+    const Image< int > &dift_label = dift.Label( );
+    const Image< int > &dift_pred = dift.Predecessor( );
+    for( size_t pxl = 0; pxl < gradient.size( ); ++pxl ) {
+      if( cost[ pxl ] != dift_cost[ pxl ] )
+        ++cost_diff;
+      if( label[ pxl ] != dift_label[ pxl ] )
+        ++label_diff;
+      int prd = dift_pred[ pxl ];
+      if( ( prd != -1 ) && ( ( dift_label[ prd ] != dift_label[ pxl ] ) ||
+                             ( std::max( dift_cost[ prd ], gradient[ pxl ] ) != dift_cost[ pxl ] ) ) )
+        ++arc_error;
+    }
+    cout << "Edit " << edt << ": differential " << dift_time << "s, from scratch " << full_time << "s. Visited "
+         << dift.Visited( ) << " pixels. Different costs: " << cost_diff << ", different labels (ties): "
+         << label_diff << ", non-optimum arcs: " << arc_error << "." << endl;
+    if( ( cost_diff != 0 ) || ( arc_error != 0 ) )
+      valid = false;
+  }
+  Write( dift.Label( ), argv[ 2 ], argv[ 1 ] );
+  if( !valid ) {
+    cout << "Error: differential IFT differs from the IFT from scratch." << endl;
+    return( 1 );
+  }
+  return( 0 );
+}
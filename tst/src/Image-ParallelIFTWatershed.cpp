@@ -0,0 +1,73 @@
+/* Biomedical Image Analysis Library */
+/* See README file in the root instalation directory for more information. */
+
+/* Date: 2026/Oct/17 */
+/* Content: Test file. */
+/* Description: Compares the sequential and the parallel IFT in watershed and FSum segmentations. Returns non-zero */
+/* if costs or labels differ. */
+
+#include "FileImage.hpp"
+#include "Image.hpp"
+#include "SegmentationFSum.hpp"
+#include "SegmentationWatershed.hpp"
+#include "ThreadPool.hpp"
+#include <chrono>
+
+using namespace std;
+using namespace Bial;
+
+template< class F >
+double Seconds( F segmentation ) {
+  auto start = chrono::steady_clock::now( );
+  segmentation( );
+  return( chrono::duration< double >( chrono::steady_clock::now( ) - start ).count( ) );
+}
+
+bool Compare( const string &name, double seq_time, double par_time, const Image< int > &seq_cost,
+              const Image< int > &par_cost, const Image< int > &seq_label, const Image< int > &par_label ) {
+  size_t cost_diff = 0;
+  size_t label_diff = 0;
+  for( size_t pxl = 0; pxl < seq_cost.size( ); ++pxl ) {
+    if( seq_cost[ pxl ] != par_cost[ pxl ] )
+      ++cost_diff;
+    if( seq_label[ pxl ] != par_label[ pxl ] )
+      ++label_diff;
+  }
+  cout << name << ": sequential " << seq_time << "s, parallel " << par_time << "s, speedup " << seq_time / par_time
+       << ". Different costs: " << cost_diff << ", different labels: " << label_diff << " of " << seq_cost.size( )
+       << " pixels." << endl;
+  return( ( cost_diff == 0 ) && ( label_diff == 0 ) );
+}
+
+int main( int argc, char **argv ) {
+  if( ( argc < 2 ) || ( argc > 3 ) ) {
+    cout << "Usage: " << argv[ 0 ] << " <gradient image> [<threads>]" << endl;
+    cout << "\t\t<threads>: Number of threads of the parallel IFT. Default: BIAL_THREADS, or hardware threads."
+         << endl;
+    return( 0 );
+  }
+  if( argc == 3 )
+    ThreadPool::Threads( atoi( argv[ 2 ] ) );
+  cout << "Threads: " << ThreadPool::Threads( ) << endl;
+  Image< int > gradient( Read< int >( argv[ 1 ] ) );
+
+  Image< int > seq_cost( gradient );
+  Image< int > par_cost( gradient );
+  Image< int > seq_label;
+  Image< int > par_label;
+  double seq_time = Seconds( [ & ]( ) { seq_label = Segmentation::Watershed( seq_cost ); } );
+  double par_time = Seconds( [ & ]( ) { par_label = Segmentation::Watershed( par_cost, 1.1f, true ); } );
+  bool equal = Compare( "Watershed", seq_time, par_time, seq_cost, par_cost, seq_label, par_label );
+
+  seq_cost = gradient;
+  par_cost = gradient;
+  seq_time = Seconds( [ & ]( ) { seq_label = Segmentation::FSum( seq_cost ); } );
+  par_time = Seconds( [ & ]( ) { par_label = Segmentation::FSum( par_cost, 1.1f, true ); } );
+  equal = Compare( "FSum", seq_time, par_time, seq_cost, par_cost, seq_label, par_label ) && equal;
+
+  if( !equal ) {
+    cout << "Error: parallel and sequential IFT results differ." << endl;
+    return( 1 );
+  }
+  return( 0 );
+}
@@ -0,0 +1,107 @@
+/* Biomedical Image Analysis Library */
+/* See README file in the root instalation directory for more information. */
+
+/* Date: 2026/Oct/17 */
+/* Content: Test file. */
+/* Description: Checks MatrixOp::Solve, Inverse and Determinant on symmetric positive definite matrices, solved by */
+/* Cholesky, and on matrices with a zero at the first pivot, solved by LU. Sizes go below and above the block and */
+/* update sizes of the decompositions. Matrices are built from triangular factors, so that their determinant is */
+/* known. Returns non-zero if any residual or determinant is out of tolerance. */
+
+#include "Common.hpp"
+#include "Matrix.hpp"
+#include "MatrixDeterminant.hpp"
+#include "MatrixInverse.hpp"
+#include "MatrixSolve.hpp"
+#include <random>
+
+using namespace std;
+using namespace Bial;
+
+/* Returns the maximum absolute difference between the elements of lhs and rhs. */
+double MaxDiff( const Matrix< double > &lhs, const Matrix< double > &rhs ) {
+  double diff = 0.0;
+  for( size_t elm = 0; elm < lhs.size( ); ++elm )
+    diff = std::max( diff, std::abs( lhs[ elm ] - rhs[ elm ] ) );
+  return( diff );
+}
+
+/* Lower triangular factor with unit diagonal, if unit, or with diagonal alternating 0.5 and 2.0. Off-diagonal */
+/* elements are small, so that products of factors are well conditioned. */
+Matrix< double > Lower( size_t size, bool unit, mt19937 &generator ) {
+  uniform_real_distribution< double > uniform( -1.0, 1.0 );
+  Matrix< double > res( size, size );
+  for( size_t row = 0; row < size; ++row ) {
+    for( size_t col = 0; col < row; ++col )
+      res[ row * size + col ] = uniform( generator ) / size;
+    res[ row * size + row ] = unit ? 1.0 : ( ( row % 2 == 0 ) ? 0.5 : 2.0 );
+  }
+  return( res );
+}
+
+bool Check( const string &name, const Matrix< double > &mat, double det, mt19937 &generator ) {
+  size_t size = mat.size( 0 );
+  uniform_real_distribution< double > uniform( -10.0, 10.0 );
+  Matrix< double > rhs( 3, size );
+  for( size_t elm = 0; elm < rhs.size( ); ++elm )
+    rhs[ elm ] = uniform( generator );
+  Matrix< double > identity( size, size );
+  for( size_t row = 0; row < size; ++row )
+    identity[ row * size + row ] = 1.0;
+  double solve_diff = MaxDiff( mat * MatrixOp::Solve( mat, rhs ), rhs ) / 10.0;
+  double inverse_diff = MaxDiff( mat * MatrixOp::Inverse( mat ), identity );
+  double det_diff = std::abs( MatrixOp::Determinant( mat ) - det ) / std::abs( det );
+  cout << name << " " << size << "x" << size << ": solve " << solve_diff << ", inverse " << inverse_diff
+       << ", determinant " << det_diff << "." << endl;
+  return( ( solve_diff < 1.0e-10 ) && ( inverse_diff < 1.0e-10 ) && ( det_diff < 1.0e-10 ) );
+}
+
+int main( int, char** ) {
+  mt19937 generator( 0 );
+  bool valid = true;
+  for( size_t size : { 1, 2, 3, 5, 63, 64, 65, 130, 511, 512, 513, 600 } ) {
+    /* Product of diagonals. Alternating 0.5 and 2.0 keeps it close to 1. */
+    double diagonal = 1.0;
+    for( size_t row = 0; row < size; ++row )
+      diagonal *= ( row % 2 == 0 ) ? 0.5 : 2.0;
+
+    /* Symmetric positive definite: L L^T, computed symmetric to the last bit. */
+    Matrix< double > low( Lower( size, false, generator ) );
+    Matrix< double > spd( size, size );
+    for( size_t row = 0; row < size; ++row ) {
+      for( size_t col = 0; col <= row; ++col ) {
+        double sum = 0.0;
+        for( size_t elm = 0; elm <= col; ++elm )
+          sum += low[ row * size + elm ] * low[ col * size + elm ];
+        spd[ row * size + col ] = sum;
+        spd[ col * size + row ] = sum;
+      }
+    }
+    valid = Check( "SPD", spd, diagonal * diagonal, generator ) && valid;
+
+    if( size < 2 )
+      continue;
+    /* L U with L( 1, 0 ) = 0, and rows rotated up by one, so that the first pivot is zero. */
+    Matrix< double > unit( Lower( size, true, generator ) );
+    unit[ size ] = 0.0;
+    Matrix< double > lower( Lower( size, false, generator ) );
+    Matrix< double > upper( size, size );
+    for( size_t row = 0; row < size; ++row ) {
+      for( size_t col = 0; col < size; ++col )
+        upper[ row * size + col ] = lower[ col * size + row ];
+    }
+    Matrix< double > product( unit * upper );
+    Matrix< double > pivoted( size, size );
+    for( size_t row = 0; row < size; ++row ) {
+      for( size_t col = 0; col < size; ++col )
+        pivoted[ row * size + col ] = product[ ( ( row + 1 ) % size ) * size + col ];
+    }
+    double sign = ( size % 2 == 0 ) ? -1.0 : 1.0;
+    valid = Check( "Pivoted", pivoted, sign * diagonal, generator ) && valid;
+  }
+  if( !valid ) {
+    cout << "Error: linear system solution out of tolerance." << endl;
+    return( 1 );
+  }
+  return( 0 );
+}
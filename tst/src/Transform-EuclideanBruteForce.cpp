@@ -0,0 +1,105 @@
+/* Biomedical Image Analysis Library */
+/* See README file in the root instalation directory for more information. */
+
+/* Date: 2026/Oct/17 */
+/* Content: Test file. */
+/* Description: Compares the Euclidean distance transforms, with and without mask, with a brute force search for the */
+/* closest border pixel, on random 2D and 3D borders with anisotropic pixel sizes. Returns non-zero if any distance */
+/* differs. */
+
+#include "Image.hpp"
+#include "TransformEuclDist.hpp"
+#include <random>
+
+using namespace std;
+using namespace Bial;
+
+double BruteForce( const Image< float > &border, const Image< float > &mask, size_t pxl ) {
+  Vector< size_t > pxl_crd( border.Coordinates( pxl ) );
+  double best = numeric_limits< double >::infinity( );
+  for( size_t bdr = 0; bdr < border.size( ); ++bdr ) {
+    if( ( border[ bdr ] == 0.0f ) || ( mask[ bdr ] == 0.0f ) )
+      continue;
+    Vector< size_t > bdr_crd( border.Coordinates( bdr ) );
+    double dist = 0.0;
+    for( size_t dms = 0; dms < border.Dims( ); ++dms ) {
+      double delta = ( static_cast< double >( pxl_crd[ dms ] ) - static_cast< double >( bdr_crd[ dms ] ) ) *
+                     border.PixelSize( dms );
+      dist += delta * delta;
+    }
+    best = std::min( best, dist );
+  }
+  return( best );
+}
+
+bool Equal( double value, double expected, double tolerance ) {
+  if( std::isinf( expected ) )
+    return( std::isinf( value ) );
+  return( std::abs( value - expected ) <= tolerance * std::max( 1.0, expected ) );
+}
+
+bool Compare( const string &name, const Vector< size_t > &dim, const Vector< float > &pixel_size, double density,
+              mt19937 &generator ) {
+  Image< float > border( dim, pixel_size );
+  Image< float > mask( dim, pixel_size );
+  Image< float > full( dim, pixel_size );
+  uniform_real_distribution< double > uniform( 0.0, 1.0 );
+  Vector< size_t > center( dim.size( ) );
+  for( size_t dms = 0; dms < dim.size( ); ++dms )
+    center[ dms ] = dim[ dms ] / 2;
+  for( size_t pxl = 0; pxl < border.size( ); ++pxl ) {
+    border[ pxl ] = ( uniform( generator ) < density ) ? 1.0f : 0.0f;
+    full[ pxl ] = 1.0f;
+    Vector< size_t > crd( border.Coordinates( pxl ) );
+    double radius = 0.0;
+    for( size_t dms = 0; dms < dim.size( ); ++dms ) {
+      double delta = ( static_cast< double >( crd[ dms ] ) - static_cast< double >( center[ dms ] ) ) /
+                     dim[ dms ];
+      radius += delta * delta;
+    }
+    mask[ pxl ] = ( radius < 0.16 ) ? 1.0f : 0.0f;
+  }
+  Image< double > squared( Transform::SquaredEDT( border ) );
+  Image< float > edt( Transform::EDT( border ) );
+  Image< float > masked( Transform::EDT( border, mask ) );
+  size_t squared_diff = 0;
+  size_t edt_diff = 0;
+  size_t masked_diff = 0;
+  for( size_t pxl = 0; pxl < border.size( ); ++pxl ) {
+    double expected = BruteForce( border, full, pxl );
+    if( !Equal( squared[ pxl ], expected, 1.0e-9 ) )
+      ++squared_diff;
+    double expected_edt = std::isinf( expected ) ? numeric_limits< float >::max( ) : std::sqrt( expected );
+    if( !Equal( edt[ pxl ], expected_edt, 1.0e-5 ) )
+      ++edt_diff;
+    double expected_masked = 0.0;
+    if( mask[ pxl ] != 0.0f ) {
+      expected_masked = BruteForce( border, mask, pxl );
+      expected_masked = std::isinf( expected_masked ) ? numeric_limits< float >::max( ) : std::sqrt( expected_masked );
+    }
+    if( !Equal( masked[ pxl ], expected_masked, 1.0e-5 ) )
+      ++masked_diff;
+  }
+  cout << name << ": different pixels: squared " << squared_diff << ", EDT " << edt_diff << ", masked EDT "
+       << masked_diff << " of " << border.size( ) << "." << endl;
+  return( ( squared_diff == 0 ) && ( edt_diff == 0 ) && ( masked_diff == 0 ) );
+}
+
+int main( int argc, char **argv ) {
+  if( argc > 2 ) {
+    cout << "Usage: " << argv[ 0 ] << " [<seed>]" << endl;
+    cout << "\t\t<seed>: Seed of the random borders. Default: 0." << endl;
+    return( 0 );
+  }
+  mt19937 generator( ( argc == 2 ) ? atoi( argv[ 1 ] ) : 0 );
+  bool equal = true;
+  equal = Compare( "2D", { 41, 37 }, { 0.5f, 1.75f }, 0.02, generator ) && equal;
+  equal = Compare( "3D", { 23, 19, 17 }, { 1.0f, 0.6f, 2.5f }, 0.005, generator ) && equal;
+  equal = Compare( "3D, sparse border", { 15, 13, 11 }, { 0.75f, 1.5f, 1.25f }, 0.001, generator ) && equal;
+  equal = Compare( "2D, no border", { 9, 7 }, { 1.5f, 0.5f }, 0.0, generator ) && equal;
+  if( !equal ) {
+    cout << "Error: Euclidean distance transform differs from brute force." << endl;
+    return( 1 );
+  }
+  return( 0 );
+}